@@ -125,6 +125,7 @@ set_default_value with_ccache false
 set_default_value with_hdf5 true
 set_default_value with_fftw true
 set_default_value with_gsl true
+set_default_value with_openmp false
 set_default_value with_scafacos false
 set_default_value with_walberla false
 set_default_value with_walberla_avx false
@@ -157,6 +158,7 @@ cmake_params="${cmake_params} -D ESPRESSO_BUILD_WITH_CALIPER=${with_caliper}"
 cmake_params="${cmake_params} -D ESPRESSO_BUILD_WITH_HDF5=${with_hdf5}"
 cmake_params="${cmake_params} -D ESPRESSO_BUILD_WITH_FFTW=${with_fftw}"
 cmake_params="${cmake_params} -D ESPRESSO_BUILD_WITH_GSL=${with_gsl}"
+cmake_params="${cmake_params} -D ESPRESSO_BUILD_WITH_OPENMP=${with_openmp}"
 cmake_params="${cmake_params} -D ESPRESSO_BUILD_WITH_SCAFACOS=${with_scafacos}"
 cmake_params="${cmake_params} -D ESPRESSO_BUILD_WITH_STOKESIAN_DYNAMICS=${with_stokesian_dynamics}"
 cmake_params="${cmake_params} -D ESPRESSO_BUILD_WITH_WALBERLA=${with_walberla}"
@@ -33,6 +33,20 @@ parser.add_argument("--volume_fraction", metavar="FRAC", action="store",
                     "particles (range: [0.01-0.74], default: 0.50)")
 parser.add_argument("--bonds", action="store_true",
                     help="Add bonds between particle pairs, default: false")
+parser.add_argument("--particle_sort_interval", metavar="N", action="store",
+                    type=int, default=0, required=False,
+                    help="Number of particle resorts between two spatial "
+                    "sorts of the particles in memory, to compare the cache "
+                    "efficiency of the steady state, e.g. with 'perf stat "
+                    "-e cache-misses' (default: 0, disabled)")
+parser.add_argument("--tabulated", choices=["linear", "cubic"],
+                    required=False,
+                    help="Replace the Lennard-Jones potential by a table with "
+                    "the given interpolation scheme, and report the force "
+                    "error with respect to the analytic potential")
+parser.add_argument("--table_points", metavar="N", action="store",
+                    type=int, default=100, required=False,
+                    help="Number of points of the table (default: 100)")
 group = parser.add_mutually_exclusive_group()
 group.add_argument("--output", metavar="FILEPATH", action="store",
                    type=str, required=False, default="benchmarks.csv",
@@ -55,6 +69,8 @@ if not args.visualizer:
         f"{measurement_steps} steps per tick are too short"
 
 required_features = ["LENNARD_JONES"]
+if args.tabulated:
+    required_features.append("TABULATED")
 espressomd.assert_features(required_features)
 
 # make simulation deterministic
@@ -70,6 +86,17 @@ system = espressomd.System(box_l=[1, 1, 1])
 lj_eps = 1.0  # LJ epsilon
 lj_sig = 1.0  # particle diameter
 lj_cut = lj_sig * 2**(1. / 6.)  # cutoff distance
+lj_min = 0.8 * lj_sig  # first point of the tabulated potential
+
+
+def lj_force(r):
+    return 24. * lj_eps * (2. * (lj_sig / r)**12 - (lj_sig / r)**6) / r
+
+
+def lj_energy(r):
+    return 4. * lj_eps * ((lj_sig / r)**12 - (lj_sig / r)**6 -
+                          (lj_sig / lj_cut)**12 + (lj_sig / lj_cut)**6)
+
 
 # System parameters
 #############################################################
@@ -87,6 +114,7 @@ system.box_l = 3 * (box_l,)
 #############################################################
 system.time_step = 0.01
 system.cell_system.skin = 0.5
+system.cell_system.particle_sort_interval = args.particle_sort_interval
 
 # Interaction setup
 #############################################################
@@ -115,6 +143,13 @@ else:
 # warmup
 benchmarks.minimize(system, n_part / 2.)
 
+if args.tabulated:
+    r = np.linspace(lj_min, lj_cut, args.table_points)
+    system.non_bonded_inter[0, 0].lennard_jones.deactivate()
+    system.non_bonded_inter[0, 0].tabulated.set_params(
+        min=lj_min, max=lj_cut, force=lj_force(r), energy=lj_energy(r),
+        interpolation=args.tabulated)
+
 system.integrator.set_vv()
 system.thermostat.set_langevin(kT=1.0, gamma=1.0, seed=42)
 
@@ -158,3 +193,18 @@ print(f"average: {avg:.3e} +/- {ci:.3e} (95% C.I.)")
 
 # write report
 benchmarks.write_report(args.output, n_proc, timings, measurement_steps)
+
+if args.tabulated:
+    # accuracy of the table with respect to the analytic potential
+    system.thermostat.turn_off()
+    system.integrator.run(0, recalc_forces=True)
+    f_tab = np.copy(system.part.all().f)
+    system.non_bonded_inter[0, 0].tabulated.deactivate()
+    system.non_bonded_inter[0, 0].lennard_jones.set_params(
+        epsilon=lj_eps, sigma=lj_sig, cutoff=lj_cut, shift="auto")
+    system.integrator.run(0, recalc_forces=True)
+    f_lj = np.copy(system.part.all().f)
+    rms_error = np.sqrt(np.mean(np.sum((f_tab - f_lj)**2, axis=1)) /
+                        np.mean(np.sum(f_lj**2, axis=1)))
+    print(f"{args.tabulated} table with {args.table_points} points: "
+          f"relative RMS force error {rms_error:.3e}")
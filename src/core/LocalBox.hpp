@@ -24,6 +24,11 @@
 #include <utils/Array.hpp>
 #include <utils/Vector.hpp>
 
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
 class LocalBox {
   Utils::Vector3d m_local_box_l = {1., 1., 1.};
   Utils::Vector3d m_lower_corner = {0., 0., 0.};
@@ -81,6 +86,45 @@ public:
       boundaries[2u * dir + 1u] = -(node_index[dir] + 1 == node_grid[dir]);
     }
 
-    return {my_left, local_length, boundaries, CellStructureType::REGULAR};
+    /* calculate the upper corner like the lower corner of the next node */
+    LocalBox local_box{my_left, local_length, boundaries,
+                       CellStructureType::REGULAR};
+    local_box.m_upper_corner =
+        Utils::hadamard_product(node_index + Utils::Vector3i::broadcast(1),
+                                local_length);
+    return local_box;
+  }
+
+  /**
+   * @brief Local box of a rectilinear partition of the box.
+   *
+   * Along each direction, the box is split into one slab per node of
+   * the node grid, whose boundaries are given as fractions of the box
+   * length in ascending order, starting with 0 and ending with 1.
+   * The upper corner is calculated like the lower corner of the next
+   * node, such that neighboring local boxes share their faces exactly.
+   */
+  static LocalBox
+  make_rectilinear_decomposition(Utils::Vector3d const &box_l,
+                                 Utils::Vector3i const &node_index,
+                                 Utils::Vector3i const &node_grid,
+                                 std::array<std::vector<double>, 3> const &
+                                     slab_boundaries) {
+    Utils::Vector3d my_left{}, my_right{};
+    decltype(LocalBox::m_boundaries) boundaries;
+    for (unsigned int dir = 0u; dir < 3u; dir++) {
+      auto const &fractions = slab_boundaries[dir];
+      auto const index = static_cast<std::size_t>(node_index[dir]);
+      assert(fractions.size() == static_cast<std::size_t>(node_grid[dir]) + 1);
+      my_left[dir] = fractions[index] * box_l[dir];
+      my_right[dir] = fractions[index + 1u] * box_l[dir];
+      boundaries[2u * dir] = (node_index[dir] == 0);
+      boundaries[2u * dir + 1u] = -(node_index[dir] + 1 == node_grid[dir]);
+    }
+
+    LocalBox local_box{my_left, my_right - my_left, boundaries,
+                       CellStructureType::REGULAR};
+    local_box.m_upper_corner = my_right;
+    return local_box;
   }
 };
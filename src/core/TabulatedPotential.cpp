@@ -21,13 +21,69 @@
 
 #include "TabulatedPotential.hpp"
 
+#include <array>
+#include <cstddef>
 #include <stdexcept>
 #include <vector>
 
+namespace {
+/** Slope at the first of the values @p y, in units of the interval. */
+template <class Range> double boundary_slope(Range const &y) {
+  if (y.size() >= 4u) {
+    return (-11. * y[0] + 18. * y[1] - 9. * y[2] + 2. * y[3]) / 6.;
+  }
+  if (y.size() == 3u) {
+    return -1.5 * y[0] + 2. * y[1] - 0.5 * y[2];
+  }
+  return y[1] - y[0];
+}
+
+/** Coefficients of the interpolating cubic spline on each interval of a
+ *  table, in the fraction of the interval. The slopes at the boundaries
+ *  are estimated by one-sided finite differences (clamped spline).
+ */
+std::vector<std::array<double, 4>>
+cubic_spline_coefficients(std::vector<double> const &y) {
+  auto const n = y.size();
+  /* the slopes at the nodes follow from the continuity of the second
+   * derivative, a tridiagonal system which is solved by elimination */
+  std::vector<double> m(n);
+  m[0] = boundary_slope(y);
+  m[n - 1u] = -boundary_slope(std::vector<double>(y.rbegin(), y.rend()));
+  std::vector<double> diag(n, 4.);
+  for (std::size_t i = 1u; i + 1u < n; ++i) {
+    m[i] = 3. * (y[i + 1u] - y[i - 1u]);
+  }
+  if (n > 2u) {
+    m[1] -= m[0];
+    m[n - 2u] -= m[n - 1u];
+  }
+  for (std::size_t i = 2u; i + 1u < n; ++i) {
+    auto const w = 1. / diag[i - 1u];
+    diag[i] -= w;
+    m[i] -= w * m[i - 1u];
+  }
+  for (std::size_t i = n - 2u; i >= 1u; --i) {
+    if (i + 2u < n) {
+      m[i] -= m[i + 1u];
+    }
+    m[i] /= diag[i];
+  }
+  std::vector<std::array<double, 4>> coefficients(n - 1u);
+  for (std::size_t i = 0u; i + 1u < n; ++i) {
+    auto const dy = y[i + 1u] - y[i];
+    coefficients[i] = {y[i], m[i], 3. * dy - 2. * m[i] - m[i + 1u],
+                       -2. * dy + m[i] + m[i + 1u]};
+  }
+  return coefficients;
+}
+} // namespace
+
 TabulatedPotential::TabulatedPotential(double minval, double maxval,
                                        std::vector<double> const &force,
-                                       std::vector<double> const &energy)
-    : minval{minval}, maxval{maxval} {
+                                       std::vector<double> const &energy,
+                                       Interpolation interpolation)
+    : minval{minval}, maxval{maxval}, interpolation{interpolation} {
 
   if (minval > maxval) {
     throw std::domain_error("TabulatedPotential parameter 'max' must be "
@@ -52,4 +108,13 @@ TabulatedPotential::TabulatedPotential(double minval, double maxval,
   }
   force_tab = force;
   energy_tab = energy;
+  if (interpolation == Interpolation::CUBIC and minval != -1. and
+      force.size() >= 2u) {
+    auto const force_coefficients = cubic_spline_coefficients(force);
+    auto const energy_coefficients = cubic_spline_coefficients(energy);
+    splines.resize(force_coefficients.size());
+    for (std::size_t i = 0u; i < splines.size(); ++i) {
+      splines[i] = {force_coefficients[i], energy_coefficients[i]};
+    }
+  }
 }
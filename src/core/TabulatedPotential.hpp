@@ -25,15 +25,31 @@
 #include <boost/serialization/vector.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <vector>
 
 /** Evaluate forces and energies using a custom potential profile.
  *
- *  Forces and energies are evaluated by linear interpolation. The curves
- *  @ref force_tab and @ref energy_tab must be sampled uniformly between
- *  @ref minval and @ref maxval.
+ *  The curves @ref force_tab and @ref energy_tab must be sampled uniformly
+ *  between @ref minval and @ref maxval. Forces and energies are evaluated
+ *  by linear interpolation, or by interpolating cubic splines, which
+ *  reproduce smooth potentials much more accurately at the same
+ *  resolution.
  */
 struct TabulatedPotential {
+  /** Interpolation scheme of the tables. */
+  enum class Interpolation : int { LINEAR = 0, CUBIC = 1 };
+
+  /** Polynomial coefficients of the force and the energy on an interval
+   *  of the tables, in the fraction of the interval. Both polynomials
+   *  of an interval share a cache line.
+   */
+  struct alignas(64) SplineInterval {
+    std::array<double, 4> force;
+    std::array<double, 4> energy;
+  };
+
   /** Position on the x-axis of the first tabulated value. */
   double minval = -1.0;
   /** Position on the x-axis of the last tabulated value. */
@@ -44,17 +60,25 @@ struct TabulatedPotential {
   std::vector<double> force_tab;
   /** Tabulated energies. */
   std::vector<double> energy_tab;
+  /** Interpolation scheme. */
+  Interpolation interpolation = Interpolation::LINEAR;
+  /** Spline coefficients, only used for cubic interpolation. */
+  std::vector<SplineInterval> splines;
 
   TabulatedPotential() = default;
   TabulatedPotential(double minval, double maxval,
                      std::vector<double> const &force,
-                     std::vector<double> const &energy);
+                     std::vector<double> const &energy,
+                     Interpolation interpolation = Interpolation::LINEAR);
 
   /** Evaluate the force at position @p x.
    *  @param x  Bond length/angle
    *  @return Interpolated force.
    */
   double force(double x) const {
+    if (not splines.empty()) {
+      return spline_interpolation(&SplineInterval::force, x);
+    }
     return Utils::linear_interpolation(force_tab, invstepsize, minval,
                                        std::clamp(x, minval, maxval));
   }
@@ -64,11 +88,25 @@ struct TabulatedPotential {
    *  @return Interpolated energy.
    */
   double energy(double x) const {
+    if (not splines.empty()) {
+      return spline_interpolation(&SplineInterval::energy, x);
+    }
     return Utils::linear_interpolation(energy_tab, invstepsize, minval,
                                        std::clamp(x, minval, maxval));
   }
 
   double cutoff() const { return maxval; }
+
+private:
+  double spline_interpolation(std::array<double, 4> SplineInterval::*curve,
+                              double x) const {
+    auto const dind = (std::clamp(x, minval, maxval) - minval) * invstepsize;
+    auto const ind = std::min(static_cast<std::size_t>(dind),
+                              splines.size() - 1u);
+    auto const t = dind - static_cast<double>(ind);
+    auto const &c = splines[ind].*curve;
+    return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+  }
 };
 
 #endif
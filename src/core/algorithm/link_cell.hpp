@@ -19,10 +19,38 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <unordered_map>
+#include <vector>
 
 namespace Algorithm {
 
+/**
+ * @brief Iterates over all pairs within a cell
+ *        and with its red neighbors.
+ */
+template <typename Cell, typename PairKernel>
+void link_cell_pairs(Cell &cell, PairKernel &&pair_kernel) {
+  auto &local_particles = cell.particles();
+  for (auto it = local_particles.begin(); it != local_particles.end(); ++it) {
+    auto &p1 = *it;
+
+    /* Pairs in this cell */
+    for (auto jt = std::next(it); jt != local_particles.end(); ++jt) {
+      pair_kernel(p1, *jt);
+    }
+
+    /* Pairs with neighbors */
+    for (auto &neighbor : cell.neighbors().red()) {
+      for (auto &p2 : neighbor->particles()) {
+        pair_kernel(p1, p2);
+      }
+    }
+  }
+}
+
 /**
  * @brief Iterates over all particles in the cell range,
  *        and over all pairs within the cells and with
@@ -32,23 +60,60 @@ template <typename CellIterator, typename PairKernel>
 void link_cell(CellIterator first, CellIterator last,
                PairKernel &&pair_kernel) {
   for (auto cell = first; cell != last; ++cell) {
-    auto &local_particles = cell->particles();
-    for (auto it = local_particles.begin(); it != local_particles.end(); ++it) {
-      auto &p1 = *it;
+    link_cell_pairs(*cell, pair_kernel);
+  }
+}
 
-      /* Pairs in this cell */
-      for (auto jt = std::next(it); jt != local_particles.end(); ++jt) {
-        pair_kernel(p1, *jt);
-      }
+/**
+ * @brief Partition cells into sets of independent cells.
+ *
+ * Two cells are independent if the link-cell pairs of the first
+ * cell and the link-cell pairs of the second cell have no particle
+ * in common, i.e. neither the cells themselves nor their red
+ * neighbors overlap. The pair loops of all cells within one color
+ * can thus run concurrently without synchronization of the particle
+ * forces, including those of ghost particles. The colors are found
+ * with a greedy graph coloring in cell order.
+ *
+ * @param cells  Pointers to the cells to partition.
+ * @return Cell pointers, grouped by color.
+ */
+template <typename CellPtr>
+std::vector<std::vector<CellPtr>>
+color_cells(std::vector<CellPtr> const &cells) {
+  /* colors already taken by the cells that touch a given cell */
+  std::unordered_map<CellPtr, std::vector<std::size_t>> taken;
+  std::vector<std::vector<CellPtr>> colors;
+  std::vector<CellPtr> touched;
 
-      /* Pairs with neighbors */
-      for (auto &neighbor : cell->neighbors().red()) {
-        for (auto &p2 : neighbor->particles()) {
-          pair_kernel(p1, p2);
+  for (auto const cell : cells) {
+    touched.clear();
+    touched.push_back(cell);
+    for (auto const neighbor : cell->neighbors().red()) {
+      touched.push_back(neighbor);
+    }
+
+    std::vector<bool> forbidden(colors.size(), false);
+    for (auto const other : touched) {
+      if (auto const it = taken.find(other); it != taken.end()) {
+        for (auto const color : it->second) {
+          forbidden[color] = true;
         }
       }
     }
+
+    auto const color = static_cast<std::size_t>(std::distance(
+        forbidden.begin(), std::ranges::find(forbidden, false)));
+    if (color == colors.size()) {
+      colors.emplace_back();
+    }
+    colors[color].push_back(cell);
+    for (auto const other : touched) {
+      taken[other].push_back(color);
+    }
   }
+
+  return colors;
 }
 
 } // namespace Algorithm
@@ -200,6 +200,7 @@ void BondBreakage::process_queue_impl(System::System &system) {
   // Execute actions
   for (auto const &a : actions) {
     boost::apply_visitor(execute(cell_structure), a);
+    cell_structure.on_bonds_change();
     system.on_particle_change();
   }
 }
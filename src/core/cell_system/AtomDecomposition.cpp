@@ -23,33 +23,150 @@
 
 #include "cell_system/Cell.hpp"
 
+#include "BoxGeometry.hpp"
+#include "Particle.hpp"
+
 #include <utils/Vector.hpp>
+#include <utils/index.hpp>
 
 #include <boost/mpi/collectives/all_to_all.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstddef>
+#include <iterator>
 #include <limits>
 #include <utility>
 #include <vector>
 
-void AtomDecomposition::configure_neighbors() {
-  std::vector<Cell *> red_neighbors;
-  std::vector<Cell *> black_neighbors;
-
-  /* distribute force calculation work  */
-  for (int n = 0; n < m_comm.size(); n++) {
-    if (m_comm.rank() == n) {
-      continue;
+void AtomDecomposition::create_bin_grid() {
+  auto const &box_l = m_box.length();
+  m_bin_grid = {1, 1, 1};
+  if (m_range > 0. and std::isfinite(m_range)) {
+    /* bins are at least as large as the range, and large enough to limit
+     * the number of bins */
+    auto const bin_size = std::max(
+        m_range, std::cbrt(Utils::product(box_l) / double{max_num_bins}));
+    for (auto i = 0u; i < 3u; ++i) {
+      m_bin_grid[i] = std::max(1, static_cast<int>(box_l[i] / bin_size));
     }
+    /* the position offset along the shear direction changes over time,
+     * such that the bins can't be coupled along that direction */
+    if (m_box.type() == BoxType::LEES_EDWARDS) {
+      m_bin_grid[m_box.lees_edwards_bc().shear_direction] = 1;
+    }
+  }
+  for (auto i = 0u; i < 3u; ++i) {
+    m_inv_bin_size[i] = static_cast<double>(m_bin_grid[i]) / box_l[i];
+  }
+}
+
+std::size_t AtomDecomposition::bin_index(Utils::Vector3d const &pos) const {
+  Utils::Vector3i index;
+  for (auto i = 0u; i < 3u; ++i) {
+    index[i] = static_cast<int>(
+        std::clamp(std::floor(pos[i] * m_inv_bin_size[i]), 0.,
+                   static_cast<double>(m_bin_grid[i] - 1)));
+  }
+  return static_cast<std::size_t>(Utils::get_linear_index(index, m_bin_grid));
+}
 
-    if (n < m_comm.rank()) {
-      red_neighbors.push_back(&cells.at(n));
+std::vector<std::size_t>
+AtomDecomposition::bins_in_range(Utils::Vector3d const &lower,
+                                 Utils::Vector3d const &upper) const {
+  std::array<std::vector<int>, 3> indices;
+  for (auto i = 0u; i < 3u; ++i) {
+    auto const n_bins_dir = m_bin_grid[i];
+    /* first and last bin which overlap with the enlarged box */
+    auto const first = std::floor((lower[i] - m_range) * m_inv_bin_size[i]);
+    auto const last = std::ceil((upper[i] + m_range) * m_inv_bin_size[i]) - 1.;
+    auto const span = last - first + 1.;
+    if (n_bins_dir == 1 or
+        (m_box.periodic(i) and span >= static_cast<double>(n_bins_dir))) {
+      for (int j = 0; j < n_bins_dir; ++j) {
+        indices[i].emplace_back(j);
+      }
+    } else if (m_box.periodic(i)) {
+      for (auto j = static_cast<int>(first); j <= static_cast<int>(last); ++j) {
+        indices[i].emplace_back(((j % n_bins_dir) + n_bins_dir) % n_bins_dir);
+      }
     } else {
-      black_neighbors.push_back(&cells.at(n));
+      /* positions outside of the box are in the boundary bins */
+      auto const max_index = static_cast<double>(n_bins_dir - 1);
+      auto const begin = static_cast<int>(std::clamp(first, 0., max_index));
+      auto const end = static_cast<int>(std::clamp(last, 0., max_index));
+      for (int j = begin; j <= end; ++j) {
+        indices[i].emplace_back(j);
+      }
+    }
+  }
+
+  std::vector<std::size_t> bins;
+  for (auto const i : indices[0]) {
+    for (auto const j : indices[1]) {
+      for (auto const k : indices[2]) {
+        bins.emplace_back(static_cast<std::size_t>(
+            Utils::get_linear_index(i, j, k, m_bin_grid)));
+      }
     }
   }
+  return bins;
+}
 
-  local().m_neighbors = Neighbors<Cell *>(red_neighbors, black_neighbors);
+std::vector<Cell *>
+AtomDecomposition::cells_in_range(Utils::Vector3d const &lower,
+                                  Utils::Vector3d const &upper) {
+  auto const bins = bins_in_range(lower, upper);
+  std::vector<Cell *> result;
+  result.reserve(bins.size() * static_cast<std::size_t>(m_comm.size()));
+  for (int n = 0; n < m_comm.size(); n++) {
+    for (auto const index : bins) {
+      result.emplace_back(std::addressof(bin(n, index)));
+    }
+  }
+  return result;
+}
+
+void AtomDecomposition::configure_neighbors() {
+  auto const bin_size = Utils::hadamard_division(
+      m_box.length(), static_cast<Utils::Vector3d>(m_bin_grid));
+  for (int i = 0; i < m_bin_grid[0]; i++) {
+    for (int j = 0; j < m_bin_grid[1]; j++) {
+      for (int k = 0; k < m_bin_grid[2]; k++) {
+        auto const index = static_cast<std::size_t>(
+            Utils::get_linear_index(i, j, k, m_bin_grid));
+        auto const lower = Utils::hadamard_product(
+            static_cast<Utils::Vector3d>(Utils::Vector3i{i, j, k}), bin_size);
+        auto const upper = lower + bin_size;
+
+        auto const bins = bins_in_range(lower, upper);
+        std::vector<Cell *> red_neighbors;
+        std::vector<Cell *> black_neighbors;
+
+        /* distribute force calculation work: pairs of local bins are
+         * visited from the bin with the lower index, pairs with bins of
+         * other nodes on the node with the higher rank */
+        for (int n = 0; n < m_comm.size(); n++) {
+          for (auto const other : bins) {
+            if (n == m_comm.rank() and other == index) {
+              continue;
+            }
+            auto const is_red =
+                (n == m_comm.rank()) ? (index < other) : (n < m_comm.rank());
+            if (is_red) {
+              red_neighbors.push_back(std::addressof(bin(n, other)));
+            } else {
+              black_neighbors.push_back(std::addressof(bin(n, other)));
+            }
+          }
+        }
+
+        local(index).m_neighbors =
+            Neighbors<Cell *>(red_neighbors, black_neighbors);
+      }
+    }
+  }
 }
 
 GhostCommunicator AtomDecomposition::prepare_comm() {
@@ -62,9 +179,12 @@ GhostCommunicator AtomDecomposition::prepare_comm() {
       GhostCommunicator{m_comm, static_cast<std::size_t>(m_comm.size())};
   /* every node has its dedicated comm step */
   for (int n = 0; n < m_comm.size(); n++) {
-    ghost_comm.communications[n].part_lists.resize(1);
-    ghost_comm.communications[n].part_lists[0] = &(cells.at(n).particles());
-    ghost_comm.communications[n].node = n;
+    auto &comm = ghost_comm.communications[n];
+    comm.part_lists.resize(n_bins());
+    for (std::size_t index = 0u; index < n_bins(); ++index) {
+      comm.part_lists[index] = &(bin(n, index).particles());
+    }
+    comm.node = n;
   }
 
   return ghost_comm;
@@ -94,53 +214,73 @@ void AtomDecomposition::configure_comms() {
 }
 
 void AtomDecomposition::mark_cells() {
-  m_local_cells.resize(1, std::addressof(local()));
+  m_local_cells.clear();
   m_ghost_cells.clear();
   for (int n = 0; n < m_comm.size(); n++) {
-    if (n != m_comm.rank()) {
-      m_ghost_cells.push_back(std::addressof(cells.at(n)));
+    for (std::size_t index = 0u; index < n_bins(); ++index) {
+      auto const cell = std::addressof(bin(n, index));
+      if (n == m_comm.rank()) {
+        m_local_cells.push_back(cell);
+      } else {
+        m_ghost_cells.push_back(cell);
+      }
     }
   }
 }
 
 void AtomDecomposition::resort(bool global_flag,
                                std::vector<ParticleChange> &diff) {
-  for (auto &p : local().particles()) {
-    m_box.fold_position(p.pos(), p.image_box());
-
-    p.pos_at_last_verlet_update() = p.pos();
-  }
-
-  /* Local updates are a NoOp for this decomposition. */
-  if (not global_flag) {
-    return;
-  }
-
+  std::vector<Particle> displaced_parts;
   /* Sort displaced particles by the node they belong to. */
   std::vector<std::vector<Particle>> send_buf(m_comm.size());
-  for (auto it = local().particles().begin();
-       it != local().particles().end();) {
-    auto const target_node = id_to_rank(it->id());
-    if (target_node != m_comm.rank()) {
-      diff.emplace_back(RemovedParticle{it->id()});
-      send_buf.at(target_node).emplace_back(std::move(*it));
-      it = local().particles().erase(it);
-    } else {
-      ++it;
+  for (auto cell : m_local_cells) {
+    auto &parts = cell->particles();
+    auto modified = false;
+    for (auto it = parts.begin(); it != parts.end();) {
+      m_box.fold_position(it->pos(), it->image_box());
+      it->pos_at_last_verlet_update() = it->pos();
+
+      /* Particles only change node on global updates. */
+      auto const target_node = id_to_rank(it->id());
+      if (global_flag and target_node != m_comm.rank()) {
+        diff.emplace_back(RemovedParticle{it->id()});
+        send_buf.at(target_node).emplace_back(std::move(*it));
+      } else if (auto const target_cell = particle_to_cell(*it);
+                 target_cell != nullptr and target_cell != cell) {
+        displaced_parts.emplace_back(std::move(*it));
+      } else {
+        ++it;
+        continue;
+      }
+      it = parts.erase(it);
+      modified = true;
+    }
+    if (modified) {
+      diff.emplace_back(ModifiedList{parts});
     }
   }
 
   /* Exchange particles */
-  std::vector<std::vector<Particle>> recv_buf(m_comm.size());
-  boost::mpi::all_to_all(m_comm, send_buf, recv_buf);
-
-  diff.emplace_back(ModifiedList{local().particles()});
+  if (global_flag) {
+    std::vector<std::vector<Particle>> recv_buf(m_comm.size());
+    boost::mpi::all_to_all(m_comm, send_buf, recv_buf);
+    for (auto &parts : recv_buf) {
+      std::ranges::move(parts, std::back_inserter(displaced_parts));
+    }
+  }
 
   /* Add new particles belonging to this node */
-  for (auto &parts : recv_buf) {
-    for (auto &p : parts) {
-      local().particles().insert(std::move(p));
-    }
+  std::vector<Cell *> modified_cells;
+  for (auto &p : displaced_parts) {
+    auto const target_cell = particle_to_cell(p);
+    target_cell->particles().insert(std::move(p));
+    modified_cells.emplace_back(target_cell);
+  }
+  std::ranges::sort(modified_cells);
+  auto const duplicates = std::ranges::unique(modified_cells);
+  modified_cells.erase(duplicates.begin(), duplicates.end());
+  for (auto cell : modified_cells) {
+    diff.emplace_back(ModifiedList{cell->particles()});
   }
 }
 
@@ -148,8 +288,11 @@ AtomDecomposition::AtomDecomposition(BoxGeometry const &box_geo)
     : m_box(box_geo) {}
 
 AtomDecomposition::AtomDecomposition(boost::mpi::communicator comm,
-                                     BoxGeometry const &box_geo)
-    : m_comm(std::move(comm)), cells(m_comm.size()), m_box(box_geo) {
+                                     BoxGeometry const &box_geo, double range)
+    : m_comm(std::move(comm)), m_range(range), m_box(box_geo) {
+  /* create the bins of all nodes */
+  create_bin_grid();
+  cells.resize(static_cast<std::size_t>(m_comm.size()) * n_bins());
   /* create communicators */
   configure_comms();
   /* configure neighbor relations */
@@ -33,6 +33,7 @@
 
 #include <boost/mpi/communicator.hpp>
 
+#include <cstddef>
 #include <optional>
 #include <span>
 #include <utility>
@@ -49,10 +50,25 @@
  * complexity in the number of particles.
  *
  * For a more detailed discussion please see @cite plimpton95a.
+ *
+ * When an interaction range is given, the particles of each node are
+ * additionally sorted into a grid of spatial bins, which are stored as
+ * the local cells of the node. Each bin is only coupled to the bins of
+ * all nodes which are within the interaction range. The bins are updated
+ * on every resort, i.e. when a particle has moved by more than half the
+ * Verlet skin. Without a range, each node has a single bin, and all
+ * pairs are considered.
  */
 class AtomDecomposition : public ParticleDecomposition {
   boost::mpi::communicator m_comm;
+  /** Bins of all nodes, in the order of the MPI ranks. */
   std::vector<Cell> cells;
+  /** Interaction range used to couple the bins. */
+  double m_range = -1.;
+  /** Number of bins in each direction. */
+  Utils::Vector3i m_bin_grid = {1, 1, 1};
+  /** Inverse bin length in each direction. */
+  Utils::Vector3d m_inv_bin_size = {};
 
   std::vector<Cell *> m_local_cells;
   std::vector<Cell *> m_ghost_cells;
@@ -64,7 +80,14 @@ class AtomDecomposition : public ParticleDecomposition {
 
 public:
   AtomDecomposition(BoxGeometry const &m_box);
-  AtomDecomposition(boost::mpi::communicator comm, BoxGeometry const &box_geo);
+  /**
+   * @param comm     Communicator to distribute the particles over.
+   * @param box_geo  Box geometry.
+   * @param range    Interaction range used to bin the particles, a
+   *                 non-positive or infinite value disables the binning.
+   */
+  AtomDecomposition(boost::mpi::communicator comm, BoxGeometry const &box_geo,
+                    double range = -1.);
 
   void resort(bool global_flag, std::vector<ParticleChange> &diff) override;
 
@@ -82,19 +105,35 @@ public:
   auto const &get_local_cells() const { return m_local_cells; }
   auto const &get_ghost_cells() const { return m_ghost_cells; }
 
+  /** @brief Number of bins in each direction. */
+  auto const &get_bin_grid() const { return m_bin_grid; }
+
+  /**
+   * @brief Bins of all nodes which are within the interaction range
+   * of a box, including the bins of this node.
+   *
+   * @param lower  Lower corner of the box.
+   * @param upper  Upper corner of the box.
+   */
+  std::vector<Cell *> cells_in_range(Utils::Vector3d const &lower,
+                                     Utils::Vector3d const &upper);
+
   /**
-   * @brief Determine which cell a particle id belongs to.
+   * @brief Determine which cell a particle belongs to.
    *
-   * Since there is only one local cell this is trivial.
+   * The node is determined by the particle id, and the bin
+   * by the particle position.
    *
    * @param p Particle to find cell for.
    * @return Pointer to cell or nullptr if not local.
    */
   Cell *particle_to_cell(Particle const &p) override {
-    return id_to_cell(p.id());
+    return has_id(p.id()) ? std::addressof(local(bin_index(p.pos())))
+                          : nullptr;
   }
   Cell const *particle_to_cell(Particle const &p) const override {
-    return id_to_cell(p.id());
+    return has_id(p.id()) ? std::addressof(local(bin_index(p.pos())))
+                          : nullptr;
   }
 
   Utils::Vector3d max_cutoff() const override;
@@ -110,26 +149,44 @@ public:
 
 private:
   /**
-   * @brief Find cell for id.
-   * @param id to find cell for.
-   * @return Cell for id.
+   * @brief Maximal number of bins per node, which limits the memory
+   * of the bins of all nodes and the number of ghost communications.
    */
-  Cell *id_to_cell(int id) {
-    return has_id(id) ? std::addressof(local()) : nullptr;
+  static constexpr int max_num_bins = 512;
+
+  /** @brief Total number of bins per node. */
+  std::size_t n_bins() const {
+    return static_cast<std::size_t>(Utils::product(m_bin_grid));
   }
 
-  Cell const *id_to_cell(int id) const {
-    return has_id(id) ? std::addressof(local()) : nullptr;
+  /** @brief Get a bin of a node. */
+  Cell &bin(int rank, std::size_t index) {
+    return cells.at(static_cast<std::size_t>(rank) * n_bins() + index);
   }
 
   /**
-   * @brief Get the local cell.
+   * @brief Get a local bin.
    */
-  Cell &local() { return cells.at(static_cast<unsigned int>(m_comm.rank())); }
-  Cell const &local() const {
-    return cells.at(static_cast<unsigned int>(m_comm.rank()));
+  Cell &local(std::size_t index) { return bin(m_comm.rank(), index); }
+  Cell const &local(std::size_t index) const {
+    return cells.at(static_cast<std::size_t>(m_comm.rank()) * n_bins() +
+                    index);
   }
 
+  /**
+   * @brief Index of the local bin of a position.
+   * Positions outside of the box are put into the boundary bins.
+   */
+  std::size_t bin_index(Utils::Vector3d const &pos) const;
+
+  /**
+   * @brief Linear indices of the bins which overlap with a box
+   * enlarged by the interaction range.
+   */
+  std::vector<std::size_t> bins_in_range(Utils::Vector3d const &lower,
+                                         Utils::Vector3d const &upper) const;
+
+  void create_bin_grid();
   void configure_neighbors();
   GhostCommunicator prepare_comm();
 
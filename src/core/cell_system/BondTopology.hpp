@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "BondList.hpp"
+#include "Particle.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bonds of the local particles with resolved partners,
+ * grouped by bond id.
+ *
+ * The particles of the bonds of a group are stored in one flat array,
+ * each bond as the particle which holds the bond followed by its
+ * partners. This allows the bond kernels to evaluate all bonds of a
+ * type in one loop, without resolving the partner ids and without
+ * dispatching on the bond parameters for every bond. The groups are
+ * ordered by the type of their bond parameters.
+ *
+ * The particle pointers are only valid as long as the particle index
+ * doesn't change, the topology has to be rebuilt after each resort
+ * and after changes of the bond lists.
+ */
+struct BondTopology {
+  /** @brief Bonds with the same bond id. */
+  struct Group {
+    int bond_id;
+    /** Number of partners of each bond. */
+    std::size_t n_partners;
+    /** Particles of the bonds, @c n_partners + 1 entries per bond. */
+    std::vector<Particle *> particles;
+
+    /** @brief Number of bonds in the group. */
+    std::size_t size() const { return particles.size() / (n_partners + 1u); }
+
+    /** @brief Particles of the @p i-th bond, the bond holder first. */
+    std::span<Particle *> bond(std::size_t i) {
+      return {particles.data() + i * (n_partners + 1u), n_partners + 1u};
+    }
+  };
+
+  std::vector<Group> groups;
+  /**
+   * Bonds with partners which are not available on this node, as the
+   * id of the particle which holds the bond and the partner ids.
+   */
+  std::vector<std::pair<int, std::vector<int>>> unresolved;
+
+  void clear() {
+    groups.clear();
+    unresolved.clear();
+  }
+
+  /**
+   * @brief Collect the bonds of the particles.
+   *
+   * @param particles  Particles whose bonds are collected.
+   * @param resolve    Map from particle id to particle, returning
+   *                   a null pointer if the particle is not available.
+   * @param bond_type  Map from bond id to the type of the bond
+   *                   parameters, by which the groups are ordered.
+   */
+  template <class ParticleRange, class Resolver, class BondType>
+  void build(ParticleRange &&particles, Resolver const &resolve,
+             BondType const &bond_type) {
+    clear();
+    std::unordered_map<int, std::size_t> group_index;
+    std::vector<Particle *> bond_particles;
+    for (auto &p : particles) {
+      for (BondView const bond : p.bonds()) {
+        auto const partner_ids = bond.partner_ids();
+        bond_particles.clear();
+        bond_particles.emplace_back(&p);
+        for (auto const pid : partner_ids) {
+          bond_particles.emplace_back(resolve(pid));
+        }
+        if (std::ranges::find(bond_particles, nullptr) !=
+            bond_particles.end()) {
+          unresolved.emplace_back(
+              p.id(), std::vector<int>(partner_ids.begin(), partner_ids.end()));
+          continue;
+        }
+        auto const [it, inserted] =
+            group_index.try_emplace(bond.bond_id(), groups.size());
+        if (inserted) {
+          groups.emplace_back(Group{bond.bond_id(), partner_ids.size(), {}});
+        }
+        auto &group = groups[it->second];
+        assert(group.n_partners == partner_ids.size());
+        group.particles.insert(group.particles.end(), bond_particles.begin(),
+                               bond_particles.end());
+      }
+    }
+    std::ranges::sort(groups, [&bond_type](Group const &a, Group const &b) {
+      return std::tuple(bond_type(a.bond_id), a.bond_id) <
+             std::tuple(bond_type(b.bond_id), b.bond_id);
+    });
+  }
+};
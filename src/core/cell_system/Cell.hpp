@@ -106,8 +106,20 @@ public:
 
   neighbors_type m_neighbors;
 
-  /** Interaction pairs */
-  std::vector<std::pair<Particle *, Particle *>> m_verlet_list;
+  /**
+   * @brief Verlet list of the cell in compressed sparse row format.
+   *
+   * The interaction partners of the k-th particle of the cell are
+   * <tt>m_verlet_partners[m_verlet_offsets[k]:m_verlet_offsets[k + 1]]</tt>,
+   * as indices into the particle arrays.
+   */
+  std::vector<unsigned int> m_verlet_offsets;
+  std::vector<unsigned int> m_verlet_partners;
+
+  /** Interaction cluster pairs, as cluster indices into the particle arrays */
+  std::vector<std::pair<unsigned int, unsigned int>> m_cluster_pairs;
+  /** Number of leading pairs in @ref m_cluster_pairs without ghost cluster */
+  std::size_t m_n_local_cluster_pairs = 0;
 
   /**
    * @brief All neighbors of the cell.
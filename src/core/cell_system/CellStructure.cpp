@@ -29,25 +29,34 @@
 #include "BoxGeometry.hpp"
 #include "LocalBox.hpp"
 #include "Particle.hpp"
+#include "bonded_interactions/bonded_interaction_data.hpp"
 #include "cell_system/CellStructureType.hpp"
 #include "communication.hpp"
+#include "electrostatics/coulomb.hpp"
 #include "lees_edwards/lees_edwards.hpp"
+#include "magnetostatics/dipoles.hpp"
 #include "system/System.hpp"
 
+#include <utils/Vector.hpp>
 #include <utils/contains.hpp>
+#include <utils/morton.hpp>
+#include <utils/mpi/cart_comm.hpp>
 
+#include <boost/mpi/collectives/all_gather.hpp>
 #include <boost/mpi/collectives/all_reduce.hpp>
 #include <boost/variant.hpp>
 
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <memory>
 #include <optional>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -99,6 +108,7 @@ void CellStructure::check_particle_sorting() const {
 }
 
 void CellStructure::remove_particle(int id) {
+  on_bonds_change();
   auto remove_all_bonds_to = [id](BondList &bl) {
     for (auto it = bl.begin(); it != bl.end();) {
       if (Utils::contains(it->partner_ids(), id)) {
@@ -184,19 +194,23 @@ unsigned map_data_parts(unsigned data_parts) {
 }
 
 void CellStructure::ghosts_count() {
+  ghosts_update_wait();
   ghost_communicator(decomposition().exchange_ghosts_comm(),
                      *get_system().box_geo, GHOSTTRANS_PARTNUM);
 }
 void CellStructure::ghosts_update(unsigned data_parts) {
+  ghosts_update_wait();
   ghost_communicator(decomposition().exchange_ghosts_comm(),
                      *get_system().box_geo, map_data_parts(data_parts));
 }
 void CellStructure::ghosts_reduce_forces() {
+  ghosts_update_wait();
   ghost_communicator(decomposition().collect_ghost_force_comm(),
                      *get_system().box_geo, GHOSTTRANS_FORCE);
 }
 #ifdef BOND_CONSTRAINT
 void CellStructure::ghosts_reduce_rattle_correction() {
+  ghosts_update_wait();
   ghost_communicator(decomposition().collect_ghost_force_comm(),
                      *get_system().box_geo, GHOSTTRANS_RATTLE);
 }
@@ -217,6 +231,7 @@ struct UpdateParticleIndexVisitor {
 } // namespace
 
 void CellStructure::resort_particles(bool global_flag) {
+  ghosts_update_wait();
   invalidate_ghosts();
 
   static std::vector<ParticleChange> diff;
@@ -228,8 +243,14 @@ void CellStructure::resort_particles(bool global_flag) {
     boost::apply_visitor(UpdateParticleIndexVisitor{this}, d);
   }
 
+  if (m_particle_sort_interval > 0 and
+      ++m_resorts_since_particle_sort >= m_particle_sort_interval) {
+    sort_particles_spatially();
+  }
+
   auto const &lebc = get_system().box_geo->lees_edwards_bc();
   m_rebuild_verlet_list = true;
+  m_rebuild_bond_topology = true;
   m_le_pos_offset_at_last_resort = lebc.pos_offset;
 
 #ifdef ADDITIONAL_CHECKS
@@ -238,6 +259,66 @@ void CellStructure::resort_particles(bool global_flag) {
 #endif
 }
 
+void CellStructure::rebuild_bond_topology() {
+  auto const &bonded_ias = *get_system().bonded_ias;
+  m_bond_topology.build(
+      local_particles(), [this](int id) { return get_local_particle(id); },
+      [&bonded_ias](int bond_id) {
+        return bonded_ias.get_zero_based_type(bond_id);
+      });
+  m_rebuild_bond_topology = false;
+}
+
+void CellStructure::sort_particles_spatially() {
+  auto const &box_geo = *get_system().box_geo;
+  auto constexpr max_bin = (1u << Utils::morton_bits) - 1u;
+  auto const bins_per_length = Utils::hadamard_division(
+      Utils::Vector3d::broadcast(static_cast<double>(max_bin) + 1.),
+      box_geo.length());
+  auto const morton_key = [&](Particle const &p) {
+    Utils::Vector<uint32_t, 3> bin;
+    for (auto i = 0u; i < 3u; ++i) {
+      /* positions outside of a non-periodic box are clamped */
+      auto const x = std::clamp(p.pos()[i] * bins_per_length[i], 0.,
+                                static_cast<double>(max_bin));
+      bin[i] = static_cast<uint32_t>(x);
+    }
+    return Utils::morton_code(bin[0], bin[1], bin[2]);
+  };
+
+  /* the particles are ordered by key, ties are broken by id */
+  std::vector<std::tuple<uint64_t, int, std::size_t>> keys;
+  std::vector<Particle> buffer;
+  for (auto const cell : decomposition().local_cells()) {
+    auto &particles = cell->particles();
+    keys.clear();
+    for (std::size_t i = 0u; auto const &p : particles) {
+      keys.emplace_back(morton_key(p), p.id(), i++);
+    }
+    if (std::ranges::is_sorted(keys)) {
+      continue;
+    }
+    std::ranges::sort(keys);
+    buffer.clear();
+    buffer.reserve(keys.size());
+    for (auto const &key : keys) {
+      buffer.emplace_back(std::move(particles.begin()[std::get<2>(key)]));
+    }
+    std::ranges::move(buffer, particles.begin());
+    update_particle_index(particles);
+  }
+  m_resorts_since_particle_sort = 0;
+  m_rebuild_verlet_list = true;
+}
+
+void CellStructure::set_particle_sort_interval(int value) {
+  if (value < 0) {
+    throw std::domain_error("Parameter 'particle_sort_interval' must be >= 0");
+  }
+  m_particle_sort_interval = value;
+  m_resorts_since_particle_sort = 0;
+}
+
 void CellStructure::set_atom_decomposition() {
   auto &system = get_system();
   auto &local_geo = *system.local_geo;
@@ -268,6 +349,7 @@ void CellStructure::set_hybrid_decomposition(double cutoff_regular,
   auto const &box_geo = *system.box_geo;
   set_particle_decomposition(std::make_unique<HybridDecomposition>(
       ::comm_cart, cutoff_regular, m_verlet_skin,
+      system.get_interaction_range(),
       [&system]() { return system.get_global_ghost_flags(); }, box_geo,
       local_geo, n_square_types));
   m_type = CellStructureType::HYBRID;
@@ -277,7 +359,9 @@ void CellStructure::set_hybrid_decomposition(double cutoff_regular,
 
 void CellStructure::set_verlet_skin(double value) {
   assert(value >= 0.);
+  m_verlet_skin_tuner.reset();
   m_verlet_skin = value;
+  m_verlet_list_skin = value;
   m_verlet_skin_set = true;
   get_system().on_verlet_skin_change();
 }
@@ -296,7 +380,158 @@ void CellStructure::set_verlet_skin_heuristic() {
   set_verlet_skin(new_skin);
 }
 
-void CellStructure::update_ghosts_and_resort_particle(unsigned data_parts) {
+/** Maximal number of trials of the online skin tuning. */
+static constexpr int max_skin_trials = 16;
+
+void CellStructure::start_verlet_skin_tuning(double tol, int steps_per_trial,
+                                             bool verbose) {
+  auto &system = get_system();
+  auto const max_cut = system.maximal_cutoff();
+  if (max_cut <= 0.) {
+    throw std::runtime_error(
+        "cannot automatically determine skin, please set it manually");
+  }
+  if (steps_per_trial < 2) {
+    throw std::domain_error("Parameter 'int_steps' must be >= 2");
+  }
+  if (tol <= 0.) {
+    throw std::domain_error("Parameter 'tol' must be > 0");
+  }
+  /* same upper bound as in System::tune_verlet_skin() */
+  auto const max_skin =
+      std::min(std::ranges::min(max_cutoff()) - max_cut,
+               0.5 * std::ranges::max(system.box_geo->length()));
+  /* size the cells and the long-range meshes once for the largest trial,
+   * such that the trials only need to rebuild the Verlet lists */
+  set_verlet_skin(std::max(max_skin, 0.));
+  m_verlet_skin_tuner = std::make_unique<VerletSkinTuner>(
+      0., std::max(max_skin, 0.), tol, steps_per_trial, max_skin_trials,
+      verbose and ::comm_cart.rank() == 0);
+  set_trial_verlet_skin(m_verlet_skin_tuner->trial_skin());
+}
+
+void CellStructure::set_trial_verlet_skin(double value) {
+  assert(value >= 0. and value <= m_verlet_skin);
+  m_verlet_list_skin = value;
+  clear_verlet_lists();
+  set_resort_particles(Cells::RESORT_LOCAL);
+}
+
+void CellStructure::update_verlet_skin_tuning(double time, bool rebuilt) {
+  assert(m_verlet_skin_tuner);
+  auto &tuner = *m_verlet_skin_tuner;
+  if (not tuner.add_step(time, rebuilt)) {
+    return;
+  }
+  /* the slowest rank determines the cost of the integration */
+  tuner.end_trial(boost::mpi::all_reduce(::comm_cart, tuner.trial_time(),
+                                         boost::mpi::maximum<double>()));
+  if (auto const skin = tuner.result()) {
+    set_verlet_skin(*skin);
+  } else {
+    set_trial_verlet_skin(tuner.trial_skin());
+  }
+}
+
+/**
+ * @brief Throw if methods are active which require a uniform partition.
+ * The lattices of LB and EK and the meshes of the long-range solvers
+ * are distributed over the local boxes of the uniform partition.
+ */
+static void check_non_uniform_partition_support(System::System const &system) {
+  if (system.lb.is_solver_set() or system.ek.is_solver_set()) {
+    throw std::runtime_error("Load balancing is not supported by LB and EK");
+  }
+#ifdef ELECTROSTATICS
+  if (system.coulomb.impl->solver) {
+    throw std::runtime_error(
+        "Load balancing is not supported by electrostatics methods");
+  }
+#endif
+#ifdef DIPOLES
+  if (system.dipoles.impl->solver) {
+    throw std::runtime_error(
+        "Load balancing is not supported by magnetostatics methods");
+  }
+#endif
+}
+
+/** Safety margin of the minimal slab width over the interaction range. */
+static constexpr double min_slab_width_margin = 1.01;
+/** Minimal slab width in units of the slab width of the uniform partition. */
+static constexpr double min_slab_width_fraction = 0.1;
+
+void CellStructure::start_load_balancing(int interval, bool verbose) {
+  auto &system = get_system();
+  if (interval < 1) {
+    throw std::domain_error("Parameter 'interval' must be >= 1");
+  }
+  if (m_type != CellStructureType::REGULAR) {
+    throw std::runtime_error(
+        "Load balancing requires the regular decomposition");
+  }
+  check_non_uniform_partition_support(system);
+  m_load_balancer = std::make_unique<DomainLoadBalancer>(
+      ::communicator.node_grid, interval, verbose and ::comm_cart.rank() == 0);
+  system.on_domain_partition_change();
+}
+
+void CellStructure::stop_load_balancing() {
+  auto &system = get_system();
+  m_load_balancer.reset();
+  system.on_domain_partition_change();
+}
+
+void CellStructure::check_load_balancing_support() const {
+  if (m_load_balancer) {
+    check_non_uniform_partition_support(get_system());
+  }
+}
+
+DomainLoadBalancer::Boundaries const *
+CellStructure::get_domain_boundaries() const {
+  /* the partition is reset when the node grid changes */
+  if (m_load_balancer and
+      m_load_balancer->node_grid() == ::communicator.node_grid) {
+    return &m_load_balancer->boundaries();
+  }
+  return nullptr;
+}
+
+void CellStructure::update_load_balancing() {
+  assert(m_load_balancer);
+  auto &balancer = *m_load_balancer;
+  if (not balancer.add_step()) {
+    return;
+  }
+  auto &system = get_system();
+  check_non_uniform_partition_support(system);
+  auto const &node_grid = ::communicator.node_grid;
+  if (balancer.node_grid() != node_grid) {
+    m_load_balancer = std::make_unique<DomainLoadBalancer>(
+        node_grid, balancer.interval(), balancer.verbose());
+    return;
+  }
+  std::vector<double> times;
+  boost::mpi::all_gather(::comm_cart, balancer.time(), times);
+  std::vector<Utils::Vector3i> node_pos;
+  for (int rank = 0; rank < ::comm_cart.size(); ++rank) {
+    node_pos.emplace_back(Utils::Mpi::cart_coords<3>(::comm_cart, rank));
+  }
+  auto const &box_l = system.box_geo->length();
+  auto const range = min_slab_width_margin * system.get_interaction_range();
+  Utils::Vector3d min_width;
+  for (auto i = 0u; i < 3u; ++i) {
+    min_width[i] = std::max(range / box_l[i],
+                            min_slab_width_fraction / node_grid[i]);
+  }
+  if (balancer.rebalance(node_pos, times, min_width)) {
+    system.on_domain_partition_change();
+  }
+}
+
+void CellStructure::update_ghosts_and_resort_particle(unsigned data_parts,
+                                                      bool overlap) {
   /* data parts that are only updated on resort */
   auto constexpr resort_only_parts =
       Cells::DATA_PART_PROPERTIES | Cells::DATA_PART_BONDS;
@@ -324,6 +559,12 @@ void CellStructure::update_ghosts_and_resort_particle(unsigned data_parts) {
     clear_resort_particles();
   } else {
     /* Communication step: ghost information */
-    ghosts_update(data_parts & ~resort_only_parts);
+    auto const &gcr = decomposition().exchange_ghosts_comm();
+    auto const ghost_parts = map_data_parts(data_parts & ~resort_only_parts);
+    if (overlap and AsyncGhostCommunication::is_supported(gcr, ghost_parts)) {
+      m_ghost_update.start(gcr, *get_system().box_geo, ghost_parts);
+    } else {
+      ghosts_update(data_parts & ~resort_only_parts);
+    }
   }
 }
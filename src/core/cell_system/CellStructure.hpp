@@ -30,8 +30,12 @@
 #include "ParticleRange.hpp"
 #include "algorithm/link_cell.hpp"
 #include "bond_error.hpp"
+#include "cell_system/BondTopology.hpp"
 #include "cell_system/Cell.hpp"
 #include "cell_system/CellStructureType.hpp"
+#include "cell_system/DomainLoadBalancer.hpp"
+#include "cell_system/ParticleArrays.hpp"
+#include "cell_system/VerletSkinTuner.hpp"
 #include "config/config.hpp"
 #include "ghosts.hpp"
 #include "system/Leaf.hpp"
@@ -39,11 +43,16 @@
 #include <utils/math/sqr.hpp>
 
 #include <boost/container/static_vector.hpp>
-#include <boost/iterator/indirect_iterator.hpp>
 #include <boost/range/algorithm/transform.hpp>
 
+#ifdef OPENMP
+#include <omp.h>
+#endif
+
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstddef>
 #include <iterator>
 #include <memory>
 #include <optional>
@@ -113,15 +122,30 @@ struct MinimalImageDistance {
   BoxGeometry const box;
 
   Distance operator()(Particle const &p1, Particle const &p2) const {
-    return Distance(box.get_mi_vector(p1.pos(), p2.pos()));
+    return (*this)(p1.pos(), p2.pos());
+  }
+
+  Distance operator()(Utils::Vector3d const &pos1,
+                      Utils::Vector3d const &pos2) const {
+    return Distance(box.get_mi_vector(pos1, pos2));
   }
 };
 
 struct EuclidianDistance {
   Distance operator()(Particle const &p1, Particle const &p2) const {
-    return Distance(p1.pos() - p2.pos());
+    return (*this)(p1.pos(), p2.pos());
+  }
+
+  Distance operator()(Utils::Vector3d const &pos1,
+                      Utils::Vector3d const &pos2) const {
+    return Distance(pos1 - pos2);
   }
 };
+
+/** @brief Functor that does nothing. */
+struct Nop {
+  void operator()() const {}
+};
 } // namespace detail
 
 /** Describes a cell structure / cell system. Contains information
@@ -142,18 +166,48 @@ private:
   /** One of @ref Cells::Resort, announces the level of resort needed.
    */
   unsigned m_resort_particles = Cells::RESORT_NONE;
+  /** Whether particles were resorted since the last Verlet list update */
   bool m_rebuild_verlet_list = true;
-  std::vector<std::pair<Particle *, Particle *>> m_verlet_list;
+  bool m_rebuild_pair_list = true;
+  bool m_rebuild_cluster_list = true;
+  /** Independent sets of local cells, see @ref Algorithm::color_cells */
+  std::vector<std::vector<Cell *>> m_cell_colors;
+  /** Particle data of the Verlet lists, indexed by the Verlet list pairs */
+  ParticleArrays m_particle_arrays;
+  /** Bonds of the local particles, grouped by bond id */
+  BondTopology m_bond_topology;
+  /** Whether the particle index changed since the last topology build */
+  bool m_rebuild_bond_topology = true;
   double m_le_pos_offset_at_last_resort = 0.;
+  /** Number of resorts between two spatial sorts of the particles. */
+  int m_particle_sort_interval = 0;
+  int m_resorts_since_particle_sort = 0;
   /** @brief Verlet list skin. */
   double m_verlet_skin = 0.;
+  /**
+   * @brief Skin of the Verlet criterion and of the resort check. Smaller
+   * than @ref m_verlet_skin during a skin tuning trial, such that the
+   * cells and the long-range meshes remain sized for the largest trial.
+   */
+  double m_verlet_list_skin = 0.;
   bool m_verlet_skin_set = false;
   double m_verlet_reuse = 0.;
+  /** @brief Online Verlet skin tuner, only set while tuning. */
+  std::unique_ptr<VerletSkinTuner> m_verlet_skin_tuner;
+  /** @brief Dynamic load balancer, only set while balancing. */
+  std::unique_ptr<DomainLoadBalancer> m_load_balancer;
+  /** @brief Ghost update which overlaps with the force calculation. */
+  AsyncGhostCommunication m_ghost_update;
 
 public:
   CellStructure(BoxGeometry const &box);
 
   bool use_verlet_list = true;
+  /** Whether the ghost update of the integration step may overlap with
+   *  the non-bonded force calculation of the local particles. All other
+   *  ghost communications are blocking.
+   */
+  bool overlap_ghost_communication = false;
 
   /**
    * @brief Update local particle index.
@@ -173,6 +227,7 @@ public:
       m_particle_index.resize(static_cast<unsigned int>(id + 1));
 
     m_particle_index[static_cast<unsigned int>(id)] = p;
+    m_rebuild_bond_topology = true;
   }
 
   /**
@@ -201,7 +256,10 @@ public:
   /**
    * @brief Clear the particles index.
    */
-  void clear_particle_index() { m_particle_index.clear(); }
+  void clear_particle_index() {
+    m_particle_index.clear();
+    m_rebuild_bond_topology = true;
+  }
 
 private:
   /**
@@ -363,6 +421,14 @@ private:
     return assert(m_decomposition), *m_decomposition;
   }
 
+  /**
+   * @brief Change the Verlet list skin for a tuning trial. Only the Verlet
+   * lists are rebuilt: the cells and the long-range meshes keep the largest
+   * trial skin, which is stored in @ref m_verlet_skin until the tuning
+   * has converged.
+   */
+  void set_trial_verlet_skin(double value);
+
 public:
   /**
    * @brief Increase the local resort level at least to @p level.
@@ -372,6 +438,22 @@ public:
     assert(m_resort_particles >= level);
   }
 
+  /**
+   * @brief Discard the Verlet lists, such that they are rebuilt from
+   * scratch after the next resort. Needed when particle properties change.
+   */
+  void clear_verlet_lists() {
+    m_particle_arrays.clear();
+    m_rebuild_verlet_list = true;
+    m_rebuild_bond_topology = true;
+  }
+
+  /**
+   * @brief Rebuild the @ref BondTopology before the next bonded loop.
+   * Needed when the bond lists of local particles are changed in place.
+   */
+  void on_bonds_change() { m_rebuild_bond_topology = true; }
+
   /**
    * @brief Get the currently scheduled resort level.
    */
@@ -393,7 +475,8 @@ public:
   bool
   check_resort_required(Utils::Vector3d const &additional_offset = {}) const {
     auto const particles = local_particles();
-    auto const lim = Utils::sqr(m_verlet_skin / 2.) - additional_offset.norm2();
+    auto const lim =
+        Utils::sqr(m_verlet_list_skin / 2.) - additional_offset.norm2();
     return std::any_of(
         particles.begin(), particles.end(), [lim](const auto &p) {
           return ((p.pos() - p.pos_at_last_verlet_update()).norm2() > lim);
@@ -427,8 +510,18 @@ public:
    *
    * @param data_parts Particle parts to update, combination of @ref
    * Cells::DataPart
+   * @param overlap    If no resort is due, only start the ghost update.
+   * It has to be completed by @ref ghosts_update_wait before the ghost
+   * particles are accessed. The cluster pair loop does this after the
+   * pairs of local particles, see @ref non_bonded_loop_clusters.
    */
-  void update_ghosts_and_resort_particle(unsigned data_parts);
+  void update_ghosts_and_resort_particle(unsigned data_parts,
+                                         bool overlap = false);
+
+  /** @brief Complete a ghost update started by
+   *  @ref update_ghosts_and_resort_particle.
+   */
+  void ghosts_update_wait() { m_ghost_update.wait(); }
 
   /**
    * @brief Add forces from ghost particles to real particles.
@@ -444,16 +537,30 @@ public:
 
   /**
    * @brief Resort particles.
+   * Every @ref get_particle_sort_interval resorts, the particles are
+   * also sorted spatially within their cells.
    */
   void resort_particles(bool global_flag);
 
+  /** @brief Number of resorts between two spatial sorts, 0 if disabled. */
+  auto get_particle_sort_interval() const { return m_particle_sort_interval; }
+
+  /** @brief Set the number of resorts between two spatial sorts. */
+  void set_particle_sort_interval(int value);
+
   /** @brief Whether the Verlet skin is set. */
   auto is_verlet_skin_set() const { return m_verlet_skin_set; }
 
   /** @brief Get the Verlet skin. */
   auto get_verlet_skin() const { return m_verlet_skin; }
 
-  /** @brief Set the Verlet skin. */
+  /**
+   * @brief Get the skin of the Verlet criterion. Smaller than the Verlet
+   * skin while a skin tuning trial is running.
+   */
+  auto get_verlet_list_skin() const { return m_verlet_list_skin; }
+
+  /** @brief Set the Verlet skin. Stops an ongoing skin tuning. */
   void set_verlet_skin(double value);
 
   /** @brief Set the Verlet skin using a heuristic. */
@@ -470,6 +577,81 @@ public:
   /** @brief Average number of integration steps the Verlet list was re-used */
   auto get_verlet_reuse() const { return m_verlet_reuse; }
 
+  /**
+   * @brief Start tuning the Verlet skin during the next integration steps.
+   * The skin is chosen between zero and the maximal permissible skin by
+   * timing the integration, see @ref VerletSkinTuner.
+   * The Verlet skin remains at the maximal skin until the tuning has
+   * converged, and the trial skins only apply to the Verlet criterion.
+   * Since every trial runs on cells sized for the maximal skin, the small
+   * trial skins pay for candidate pairs they don't need, which biases
+   * the result towards larger skins.
+   *
+   * @param tol              Accuracy in skin to tune to.
+   * @param steps_per_trial  Number of integration steps to time per skin.
+   * @param verbose          Whether to print the trials on the head node.
+   */
+  void start_verlet_skin_tuning(double tol, int steps_per_trial, bool verbose);
+
+  /** @brief Whether the Verlet skin is being tuned. */
+  bool is_verlet_skin_tuning() const {
+    return static_cast<bool>(m_verlet_skin_tuner);
+  }
+
+  /**
+   * @brief Feed the timing of an integration step to the skin tuner,
+   * and change the skin when the current trial is complete.
+   * The cell system and the long-range solvers are only notified
+   * of the skin change once the tuning has converged.
+   * Needs to be called on all MPI ranks.
+   *
+   * @param time     Time spent in the resort, ghost communication
+   *                 and force calculation of the step, in seconds.
+   * @param rebuilt  Whether the particles were resorted in the step.
+   */
+  void update_verlet_skin_tuning(double time, bool rebuilt);
+
+  /**
+   * @brief Start the dynamic load balancing of the regular decomposition.
+   * Every @p interval integration steps, the local boxes are resized
+   * from the measured force calculation times, see @ref DomainLoadBalancer.
+   *
+   * @param interval  Number of integration steps between two rebalances.
+   * @param verbose   Whether to print the rebalances on the head node.
+   */
+  void start_load_balancing(int interval, bool verbose);
+
+  /** @brief Stop the load balancing and restore the uniform partition. */
+  void stop_load_balancing();
+
+  /** @brief Whether the local boxes are being balanced. */
+  bool is_load_balancing() const { return static_cast<bool>(m_load_balancer); }
+
+  /**
+   * @brief Throw if the load balancing is active together with methods
+   * which require a uniform partition of the box.
+   */
+  void check_load_balancing_support() const;
+
+  /**
+   * @brief Slab boundaries of the balanced partition, in units of the box
+   * length, or a nullptr for the uniform partition.
+   */
+  DomainLoadBalancer::Boundaries const *get_domain_boundaries() const;
+
+  /** @brief Account for time spent in the force calculation. */
+  void add_load_balancing_time(double time) {
+    if (m_load_balancer) {
+      m_load_balancer->add_time(time);
+    }
+  }
+
+  /**
+   * @brief Account for one integration step, and resize the local boxes
+   * when a rebalance is due. Needs to be called on all MPI ranks.
+   */
+  void update_load_balancing();
+
 private:
   /**
    * @brief Resolve ids to particles.
@@ -536,10 +718,13 @@ private:
   /** @brief Set the particle decomposition, keeping the particles. */
   void set_particle_decomposition(
       std::unique_ptr<ParticleDecomposition> &&decomposition) {
+    ghosts_update_wait();
     clear_particle_index();
 
     /* Swap in new cell system */
     std::swap(m_decomposition, decomposition);
+    m_cell_colors.clear();
+    clear_verlet_lists();
 
     /* Add particles to new system */
     for (auto &p : Cells::particles(decomposition->local_cells())) {
@@ -574,77 +759,305 @@ public:
 
 private:
   /**
-   * @brief Run link_cell algorithm for local cells.
+   * @brief Sort the particles of each local cell along a Morton curve.
    *
-   * @tparam Kernel Needs to be callable with (Particle, Particle, Distance).
-   * @param kernel Pair kernel functor.
+   * Particles which are close in space are then also close in memory,
+   * which improves the cache reuse of the loops over the particles of a
+   * cell, e.g. of the pair loop and of the ghost communication, after
+   * the insertion order has been scrambled by many resorts. Together
+   * with the traversal order of the cells, this approximates a global
+   * space-filling curve. The particle index is updated, the ghosts
+   * have to be exchanged afterwards.
    */
-  template <class Kernel> void link_cell(Kernel kernel) {
-    auto const maybe_box = decomposition().minimum_image_distance();
-    auto const local_cells_span = decomposition().local_cells();
-    auto const first = boost::make_indirect_iterator(local_cells_span.begin());
-    auto const last = boost::make_indirect_iterator(local_cells_span.end());
+  void sort_particles_spatially();
+
+  /**
+   * @brief Get the local cells partitioned into independent sets.
+   *
+   * The partition only depends on the neighborship relations of the
+   * cells, which are fixed for the lifetime of the decomposition.
+   */
+  auto const &cell_colors() {
+    if (m_cell_colors.empty()) {
+      auto const local_cells = decomposition().local_cells();
+      m_cell_colors = Algorithm::color_cells(
+          std::vector<Cell *>(local_cells.begin(), local_cells.end()));
+    }
+    return m_cell_colors;
+  }
 
+  /**
+   * @brief Run a kernel on all local cells.
+   *
+   * With @p parallel set and more than one OpenMP thread available,
+   * the cells are processed color by color, the cells of the same
+   * color being distributed among the threads. The kernel may then
+   * write to the particles of the cell and of its red neighbors,
+   * but must not have any other side effects.
+   *
+   * The @p progress callback is called regularly from the calling
+   * thread, e.g. to make progress on pending communications.
+   *
+   * @tparam CellKernel Needs to be callable with (Cell).
+   * @param cell_kernel Cell kernel functor.
+   * @param parallel    Whether @p cell_kernel is thread-safe.
+   * @param progress    Callback, between colors resp. groups of cells.
+   */
+  template <class CellKernel, class Progress = detail::Nop>
+  void for_each_local_cell(CellKernel const &cell_kernel,
+                           [[maybe_unused]] bool parallel,
+                           Progress const &progress = {}) {
+#ifdef OPENMP
+    if (parallel and omp_get_max_threads() > 1) {
+      for (auto const &cells : cell_colors()) {
+        auto const n_cells = static_cast<long>(cells.size());
+#pragma omp parallel for schedule(dynamic)
+        for (long i = 0; i < n_cells; ++i) {
+          cell_kernel(*cells[static_cast<std::size_t>(i)]);
+        }
+        progress();
+      }
+      return;
+    }
+#endif
+    auto constexpr cells_per_progress = 16u;
+    auto n_cells = 0u;
+    for (auto const cell : decomposition().local_cells()) {
+      cell_kernel(*cell);
+      if (++n_cells % cells_per_progress == 0u) {
+        progress();
+      }
+    }
+  }
+
+  /**
+   * @brief Run a kernel with the distance function of the decomposition.
+   *
+   * @tparam Kernel Needs to be callable with a distance function.
+   * @param kernel Functor.
+   */
+  template <class Kernel> void visit_distance_function(Kernel &&kernel) {
+    auto const maybe_box = decomposition().minimum_image_distance();
     if (maybe_box) {
-      Algorithm::link_cell(
-          first, last,
-          [&kernel, df = detail::MinimalImageDistance{decomposition().box()}](
-              Particle &p1, Particle &p2) { kernel(p1, p2, df(p1, p2)); });
+      kernel(detail::MinimalImageDistance{decomposition().box()});
     } else {
       if (decomposition().box().type() != BoxType::CUBOID) {
         throw std::runtime_error("Non-cuboid box type is not compatible with a "
                                  "particle decomposition that relies on "
                                  "EuclideanDistance for distance calculation.");
       }
-      Algorithm::link_cell(
-          first, last,
-          [&kernel, df = detail::EuclidianDistance{}](
-              Particle &p1, Particle &p2) { kernel(p1, p2, df(p1, p2)); });
+      kernel(detail::EuclidianDistance{});
     }
   }
 
+  /**
+   * @brief Run link_cell algorithm for local cells.
+   *
+   * @tparam Kernel Needs to be callable with (Particle, Particle, Distance).
+   * @param kernel Pair kernel functor.
+   * @param parallel Whether @p kernel is thread-safe.
+   */
+  template <class Kernel> void link_cell(Kernel kernel, bool parallel = false) {
+    visit_distance_function([&](auto const &df) {
+      for_each_local_cell(
+          [&kernel, &df](Cell &cell) {
+            Algorithm::link_cell_pairs(cell, [&](Particle &p1, Particle &p2) {
+              kernel(p1, p2, df(p1, p2));
+            });
+          },
+          parallel);
+    });
+  }
+
+  /**
+   * @brief Gather the particles into @ref m_particle_arrays after a resort.
+   *
+   * Remaps or discards the Verlet list of each cell, and invalidates
+   * the cluster pair list.
+   */
+  void update_particle_arrays() {
+    if (m_rebuild_verlet_list) {
+      auto const &arrays = m_particle_arrays;
+      m_particle_arrays.gather_particles(decomposition().local_cells(),
+                                         decomposition().ghost_cells());
+      /* Keep the Verlet lists of cells whose neighborhood is unchanged */
+      auto const is_unchanged = [&arrays](Cell const *cell) {
+        return arrays.unchanged(*cell);
+      };
+      for (auto const cell : decomposition().local_cells()) {
+        if (is_unchanged(cell) and
+            std::ranges::all_of(cell->neighbors().red(), is_unchanged)) {
+          for (auto &j : cell->m_verlet_partners) {
+            j = arrays.remap(j);
+          }
+        } else {
+          cell->m_verlet_offsets.clear();
+          cell->m_verlet_partners.clear();
+        }
+      }
+      m_rebuild_pair_list = true;
+      m_rebuild_cluster_list = true;
+      m_rebuild_verlet_list = false;
+    }
+  }
+
+  /**
+   * @brief Rebuild the Verlet list of the local cells.
+   *
+   * The Verlet list is stored per cell, such that it can be
+   * traversed in the same order as the link cell algorithm.
+   * Partners are stored as indices into @ref m_particle_arrays.
+   *
+   * Only the lists of cells discarded by @ref update_particle_arrays
+   * are rebuilt. The list of a cell is kept if the cell and its neighbors
+   * hold the same particles at the same positions as when the list was
+   * built, e.g. for frozen particles.
+   *
+   * @param verlet_criterion Filter for verlet lists.
+   * @param parallel Whether to use OpenMP threads.
+   */
+  template <class VerletCriterion>
+  void rebuild_verlet_list(const VerletCriterion &verlet_criterion,
+                           bool parallel) {
+    auto const &arrays = m_particle_arrays;
+    auto const &particles = arrays.particles;
+    auto const &reference_pos = arrays.reference_pos;
+    visit_distance_function([&](auto const &df) {
+      for_each_local_cell(
+          [&](Cell &cell) {
+            auto &offsets = cell.m_verlet_offsets;
+            auto &partners = cell.m_verlet_partners;
+            if (not offsets.empty()) {
+              return;
+            }
+            auto const [first, last] = arrays.range(cell);
+            for (auto i = first; i < last; ++i) {
+              offsets.emplace_back(static_cast<unsigned int>(partners.size()));
+              auto &p1 = *particles[i];
+              auto const add_pair = [&](auto j) {
+                auto &p2 = *particles[j];
+                auto const dist = df(reference_pos[i], reference_pos[j]);
+                if (verlet_criterion(p1, p2, dist)) {
+                  partners.emplace_back(j);
+                }
+              };
+              /* Pairs in this cell */
+              for (auto j = i + 1u; j < last; ++j) {
+                add_pair(j);
+              }
+              /* Pairs with neighbors */
+              for (auto const neighbor : cell.neighbors().red()) {
+                auto const [n_first, n_last] = arrays.range(*neighbor);
+                for (auto j = n_first; j < n_last; ++j) {
+                  add_pair(j);
+                }
+              }
+            }
+            offsets.emplace_back(static_cast<unsigned int>(partners.size()));
+          },
+          parallel);
+    });
+
+    m_rebuild_pair_list = false;
+  }
+
+  /**
+   * @brief Rebuild the cluster pair list of the local cells.
+   *
+   * Two clusters are paired if their bounding spheres are closer than
+   * the maximal interaction range plus the skin.
+   *
+   * @param verlet_criterion Filter for verlet lists.
+   * @param parallel Whether to use OpenMP threads.
+   */
+  template <class VerletCriterion>
+  void rebuild_cluster_list(const VerletCriterion &verlet_criterion,
+                            bool parallel) {
+    auto &arrays = m_particle_arrays;
+    auto const n_local_clusters =
+        arrays.n_local() / ParticleArrays::cluster_size;
+    arrays.update_cluster_bounds();
+    visit_distance_function([&](auto const &df) {
+      for_each_local_cell(
+          [&](Cell &cell) {
+            auto &cluster_pairs = cell.m_cluster_pairs;
+            cluster_pairs.clear();
+            auto const add_pair = [&](auto ci, auto cj) {
+              auto const gap =
+                  std::sqrt(df(arrays.cluster_center[ci],
+                               arrays.cluster_center[cj])
+                                .dist2) -
+                  arrays.cluster_radius[ci] - arrays.cluster_radius[cj];
+              if (gap <= 0. or verlet_criterion.within_max_range(gap * gap)) {
+                cluster_pairs.emplace_back(ci, cj);
+              }
+            };
+            auto const [first, last] = arrays.clusters(cell);
+            for (auto ci = first; ci < last; ++ci) {
+              /* Pairs in this cell, including the cluster itself */
+              for (auto cj = ci; cj < last; ++cj) {
+                add_pair(ci, cj);
+              }
+              /* Pairs with neighbors */
+              for (auto const neighbor : cell.neighbors().red()) {
+                auto const [n_first, n_last] = arrays.clusters(*neighbor);
+                for (auto cj = n_first; cj < n_last; ++cj) {
+                  add_pair(ci, cj);
+                }
+              }
+            }
+            /* Pairs of local clusters first, they can be processed
+             * while the ghost update is in flight */
+            auto const ghost_pairs =
+                std::ranges::stable_partition(cluster_pairs, [&](auto pair) {
+                  return pair.second < n_local_clusters;
+                });
+            cell.m_n_local_cluster_pairs = static_cast<std::size_t>(
+                std::distance(cluster_pairs.begin(), ghost_pairs.begin()));
+          },
+          parallel);
+    });
+
+    m_rebuild_cluster_list = false;
+  }
+
   /** Non-bonded pair loop with verlet lists.
    *
    * @param pair_kernel Kernel to apply
    * @param verlet_criterion Filter for verlet lists.
+   * @param parallel Whether @p pair_kernel is thread-safe.
    */
   template <class PairKernel, class VerletCriterion>
   void verlet_list_loop(PairKernel pair_kernel,
-                        const VerletCriterion &verlet_criterion) {
-    /* In this case the verlet list update is attached to
-     * the pair kernel, and the verlet list is rebuilt as
-     * we go. */
-    if (m_rebuild_verlet_list) {
-      m_verlet_list.clear();
-
-      link_cell([&](Particle &p1, Particle &p2, Distance const &d) {
-        if (verlet_criterion(p1, p2, d)) {
-          m_verlet_list.emplace_back(&p1, &p2);
-          pair_kernel(p1, p2, d);
-        }
-      });
-
-      m_rebuild_verlet_list = false;
-    } else {
-      auto const maybe_box = decomposition().minimum_image_distance();
-      /* In this case the pair kernel is just run over the verlet list. */
-      if (maybe_box) {
-        auto const distance_function =
-            detail::MinimalImageDistance{decomposition().box()};
-        for (auto &pair : m_verlet_list) {
-          pair_kernel(*pair.first, *pair.second,
-                      distance_function(*pair.first, *pair.second));
-        }
-      } else {
-        auto const distance_function = detail::EuclidianDistance{};
-        for (auto &pair : m_verlet_list) {
-          pair_kernel(*pair.first, *pair.second,
-                      distance_function(*pair.first, *pair.second));
-        }
-      }
+                        const VerletCriterion &verlet_criterion,
+                        bool parallel) {
+    update_particle_arrays();
+    if (m_rebuild_pair_list) {
+      rebuild_verlet_list(verlet_criterion, parallel);
     }
+
+    auto const &particles = m_particle_arrays.particles;
+    visit_distance_function([&](auto const &df) {
+      for_each_local_cell(
+          [&](Cell &cell) {
+            auto const &offsets = cell.m_verlet_offsets;
+            auto const &partners = cell.m_verlet_partners;
+            auto const first = m_particle_arrays.range(cell).first;
+            for (std::size_t k = 0u; k + 1u < offsets.size(); ++k) {
+              auto &p1 = *particles[first + k];
+              for (auto n = offsets[k]; n < offsets[k + 1u]; ++n) {
+                auto &p2 = *particles[partners[n]];
+                pair_kernel(p1, p2, df(p1, p2));
+              }
+            }
+          },
+          parallel);
+    });
   }
 
+  /** @brief Collect the bonds of the local particles by bond id. */
+  void rebuild_bond_topology();
+
 public:
   /** Bonded pair loop.
    * @param bond_kernel Kernel to apply
@@ -655,6 +1068,25 @@ public:
     }
   }
 
+  /** Bonded loop over the bonds grouped by bond id.
+   *  The @ref BondTopology is cached until the particle index or the
+   *  bond lists change. Bonds with partners which are not available
+   *  are reported as broken.
+   *  @param group_kernel Kernel to apply to each @ref BondTopology::Group
+   */
+  template <class GroupKernel>
+  void bond_group_loop(GroupKernel const &group_kernel) {
+    if (m_rebuild_bond_topology) {
+      rebuild_bond_topology();
+    }
+    for (auto const &[id, partner_ids] : m_bond_topology.unresolved) {
+      bond_broken_error(id, partner_ids);
+    }
+    for (auto &group : m_bond_topology.groups) {
+      group_kernel(group);
+    }
+  }
+
   /** Non-bonded pair loop.
    * @param pair_kernel Kernel to apply
    */
@@ -666,16 +1098,80 @@ public:
    * of verlet lists.
    * @param pair_kernel Kernel to apply
    * @param verlet_criterion Filter for verlet lists.
+   * @param parallel Whether @p pair_kernel is thread-safe, in which case
+   *        the loop is distributed among OpenMP threads (if available).
    */
   template <class PairKernel, class VerletCriterion>
   void non_bonded_loop(PairKernel pair_kernel,
-                       const VerletCriterion &verlet_criterion) {
+                       const VerletCriterion &verlet_criterion,
+                       bool parallel = false) {
     if (use_verlet_list) {
-      verlet_list_loop(pair_kernel, verlet_criterion);
+      verlet_list_loop(pair_kernel, verlet_criterion, parallel);
     } else {
       /* No verlet lists, just run the kernel with pairs from the cells. */
-      link_cell(pair_kernel);
+      link_cell(pair_kernel, parallel);
+    }
+  }
+
+  /** Non-bonded pair loop with cluster pair lists over the
+   * structure-of-arrays mirror of the particle data.
+   *
+   * The kernel is called for each pair of clusters, reads positions,
+   * types and charges from the @ref ParticleArrays and accumulates the
+   * pair forces there, which are added to the particles at the end of
+   * the loop. This avoids streaming the full particle objects through
+   * the cache, and gives the kernel fixed-size blocks of pairs.
+   *
+   * @param cluster_kernel Kernel to apply, needs to be callable with
+   *        (ParticleArrays, cluster index, cluster index, distance function).
+   *        For a pair of identical clusters, the kernel must only consider
+   *        each particle pair once.
+   * @param verlet_criterion Filter for verlet lists.
+   * @param parallel Whether @p cluster_kernel is thread-safe.
+   */
+  template <class ClusterKernel, class VerletCriterion>
+  void non_bonded_loop_clusters(ClusterKernel cluster_kernel,
+                                const VerletCriterion &verlet_criterion,
+                                bool parallel = false) {
+    assert(use_verlet_list);
+    if (m_rebuild_verlet_list) {
+      /* gathering the particles reads the ghost positions */
+      ghosts_update_wait();
+    }
+    update_particle_arrays();
+
+    auto &arrays = m_particle_arrays;
+    if (m_rebuild_cluster_list) {
+      rebuild_cluster_list(verlet_criterion, parallel);
     }
+    auto const n_local = arrays.n_local();
+    auto const n_part = static_cast<ParticleArrays::index_type>(arrays.size());
+    arrays.reset_forces();
+    arrays.gather_properties(0u, n_local);
+    visit_distance_function([&](auto const &df) {
+      /* Pairs of local particles, while the ghost update is in flight */
+      for_each_local_cell(
+          [&](Cell &cell) {
+            auto const &pairs = cell.m_cluster_pairs;
+            for (std::size_t k = 0; k < cell.m_n_local_cluster_pairs; ++k) {
+              cluster_kernel(arrays, pairs[k].first, pairs[k].second, df);
+            }
+          },
+          parallel, [this]() { m_ghost_update.test(); });
+      ghosts_update_wait();
+      arrays.gather_properties(n_local, n_part);
+      /* Pairs with ghost particles */
+      for_each_local_cell(
+          [&](Cell &cell) {
+            auto const &pairs = cell.m_cluster_pairs;
+            for (auto k = cell.m_n_local_cluster_pairs; k < pairs.size();
+                 ++k) {
+              cluster_kernel(arrays, pairs[k].first, pairs[k].second, df);
+            }
+          },
+          parallel);
+    });
+    arrays.scatter_forces();
   }
 
   /**
@@ -734,6 +1230,26 @@ public:
       return false;
     }
 
+    run_on_cell_short_range_neighbors(p, cell, kernel);
+    return true;
+  }
+
+  /**
+   * @brief Run kernel on all particles inside a given local cell and its
+   * neighbors.
+   *
+   * Unlike @ref run_on_particle_short_range_neighbors, the cell is not
+   * derived from the particle position, e.g. for a particle which was
+   * displaced out of the cell it is stored in since the last resort.
+   *
+   * @param p      Particle to run the kernel on
+   * @param cell   Local cell whose neighborhood is visited
+   * @param kernel Function with signature <tt>double(Particle const&,
+   *               Particle const&, Utils::Vector3d const&)</tt>
+   */
+  template <class Kernel>
+  void run_on_cell_short_range_neighbors(Particle const &p, Cell *const cell,
+                                         Kernel &kernel) {
     auto const maybe_box = decomposition().minimum_image_distance();
 
     if (maybe_box) {
@@ -744,7 +1260,6 @@ public:
       auto const distance_function = detail::EuclidianDistance{};
       short_range_neighbor_loop(p, cell, kernel, distance_function);
     }
-    return true;
   }
 
 private:
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <utils/Vector.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+/**
+ * @brief Dynamic load balancer for the regular decomposition.
+ *
+ * Along each direction, the box is split into one slab per node of the
+ * node grid, and the local box of a node is the intersection of its
+ * three slabs. Unlike a recursive bisection, this rectilinear partition
+ * keeps a single neighbor per face of the local box, as required by the
+ * ghost communication of the regular decomposition. The slab boundaries
+ * are stored as fractions of the box length.
+ *
+ * The balancer accumulates the force calculation time of the local node
+ * over @ref interval integration steps. The caller then gathers the
+ * times of all nodes, and @ref rebalance moves the slab boundaries along
+ * each direction such that each slab gets the same share of the time,
+ * assuming that the time is uniformly distributed within each slab.
+ * The boundaries are only moved part of the way, to damp oscillations,
+ * and the slabs never get thinner than a minimal width.
+ *
+ * The balancer does not communicate: all nodes have to pass the same
+ * times to @ref rebalance, such that they agree on the partition.
+ */
+class DomainLoadBalancer {
+public:
+  using Boundaries = std::array<std::vector<double>, 3>;
+
+  /**
+   * @param node_grid  Number of nodes in each direction.
+   * @param interval   Number of integration steps between two rebalances.
+   * @param verbose    Whether to print the rebalances on stdout.
+   */
+  DomainLoadBalancer(Utils::Vector3i const &node_grid, int interval,
+                     bool verbose)
+      : m_node_grid{node_grid}, m_interval{interval}, m_verbose{verbose},
+        m_boundaries{uniform_boundaries(node_grid)} {
+    assert(interval >= 1);
+  }
+
+  /** @brief Slab boundaries of the uniform partition. */
+  static Boundaries uniform_boundaries(Utils::Vector3i const &node_grid) {
+    Boundaries boundaries;
+    for (auto i = 0u; i < 3u; ++i) {
+      auto const n_slabs = node_grid[i];
+      for (int j = 0; j <= n_slabs; ++j) {
+        boundaries[i].emplace_back(static_cast<double>(j) / n_slabs);
+      }
+    }
+    return boundaries;
+  }
+
+  /** @brief Slab boundaries in each direction, in units of the box length. */
+  Boundaries const &boundaries() const { return m_boundaries; }
+
+  auto const &node_grid() const { return m_node_grid; }
+  auto interval() const { return m_interval; }
+  auto verbose() const { return m_verbose; }
+
+  /** @brief Ratio of the largest to the mean time of the last rebalance. */
+  auto imbalance() const { return m_imbalance; }
+
+  /** @brief Account for time spent in the force calculation. */
+  void add_time(double time) { m_time += time; }
+
+  /** @brief Local time since the last rebalance in seconds. */
+  double time() const { return m_time; }
+
+  /**
+   * @brief Account for one integration step.
+   * @return Whether it is time to rebalance.
+   */
+  bool add_step() { return ++m_n_steps >= m_interval; }
+
+  /**
+   * @brief Move the slab boundaries to balance the measured times.
+   * The partition is only changed when the slowest node is slower than
+   * the average by more than the tolerance.
+   *
+   * @param node_pos   Position of each node in the node grid.
+   * @param times      Time of each node since the last rebalance.
+   * @param min_width  Minimal slab width in each direction, in units
+   *                   of the box length.
+   * @return Whether the slab boundaries changed.
+   */
+  bool rebalance(std::vector<Utils::Vector3i> const &node_pos,
+                 std::vector<double> const &times,
+                 Utils::Vector3d const &min_width) {
+    assert(node_pos.size() == times.size() and not times.empty());
+    m_n_steps = 0;
+    m_time = 0.;
+    auto const total = std::accumulate(times.begin(), times.end(), 0.);
+    auto const mean = total / static_cast<double>(times.size());
+    auto const slowest = *std::ranges::max_element(times);
+    m_imbalance = (total > 0.) ? slowest / mean : 1.;
+    if (m_imbalance <= 1. + tolerance) {
+      return false;
+    }
+    auto changed = false;
+    for (auto i = 0u; i < 3u; ++i) {
+      auto const n_slabs = static_cast<std::size_t>(m_node_grid[i]);
+      if (n_slabs == 1u or static_cast<double>(n_slabs) * min_width[i] > 1.) {
+        continue;
+      }
+      std::vector<double> slab_times(n_slabs, 0.);
+      for (std::size_t k = 0u; k < times.size(); ++k) {
+        slab_times[static_cast<std::size_t>(node_pos[k][i])] += times[k];
+      }
+      m_boundaries[i] =
+          balance_slabs(m_boundaries[i], slab_times, min_width[i]);
+      changed = true;
+    }
+    if (m_verbose) {
+      std::printf("load balancing: imbalance %.3f\n", m_imbalance);
+      for (auto i = 0u; i < 3u; ++i) {
+        std::printf("  %c:", "xyz"[i]);
+        for (auto const value : m_boundaries[i]) {
+          std::printf(" %.4f", value);
+        }
+        std::printf("\n");
+      }
+    }
+    return changed;
+  }
+
+private:
+  /** Imbalance below which the partition is kept. */
+  static constexpr double tolerance = 0.05;
+  /** Fraction of the way to the balanced boundaries that is moved. */
+  static constexpr double relaxation = 0.5;
+
+  /**
+   * @brief Boundaries of slabs with equal time, by inversion of the
+   * piecewise linear cumulative time along the direction.
+   */
+  static std::vector<double>
+  balance_slabs(std::vector<double> const &boundaries,
+                std::vector<double> const &slab_times, double min_width) {
+    auto const n_slabs = slab_times.size();
+    std::vector<double> cumulative(n_slabs + 1u, 0.);
+    std::partial_sum(slab_times.begin(), slab_times.end(),
+                     std::next(cumulative.begin()));
+    auto const total = cumulative.back();
+    auto result = boundaries;
+    std::size_t k = 0u;
+    for (std::size_t j = 1u; j < n_slabs; ++j) {
+      auto const target =
+          total * static_cast<double>(j) / static_cast<double>(n_slabs);
+      while (k + 1u < n_slabs and cumulative[k + 1u] < target) {
+        ++k;
+      }
+      auto const fraction = (target - cumulative[k]) / slab_times[k];
+      auto const balanced =
+          boundaries[k] + fraction * (boundaries[k + 1u] - boundaries[k]);
+      result[j] = boundaries[j] + relaxation * (balanced - boundaries[j]);
+    }
+    /* enforce the minimal width from both ends, which is always possible
+     * since the box can hold all slabs at minimal width */
+    for (std::size_t j = 1u; j < n_slabs; ++j) {
+      result[j] = std::max(result[j], result[j - 1u] + min_width);
+    }
+    for (std::size_t j = n_slabs - 1u; j > 0u; --j) {
+      result[j] = std::min(result[j], result[j + 1u] - min_width);
+    }
+    return result;
+  }
+
+  Utils::Vector3i m_node_grid;
+  int m_interval;
+  bool m_verbose;
+  Boundaries m_boundaries;
+  int m_n_steps = 0;
+  double m_time = 0.;
+  double m_imbalance = 1.;
+};
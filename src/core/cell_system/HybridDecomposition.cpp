@@ -28,6 +28,7 @@
 #include "LocalBox.hpp"
 
 #include <utils/Vector.hpp>
+#include <utils/index.hpp>
 #include <utils/mpi/sendrecv.hpp>
 
 #include <boost/mpi/collectives/reduce.hpp>
@@ -43,6 +44,7 @@
 
 HybridDecomposition::HybridDecomposition(boost::mpi::communicator comm,
                                          double cutoff_regular, double skin,
+                                         double range,
                                          std::function<bool()> get_ghost_flags,
                                          BoxGeometry const &box_geo,
                                          LocalBox const &local_box,
@@ -50,7 +52,7 @@ HybridDecomposition::HybridDecomposition(boost::mpi::communicator comm,
     : m_comm(std::move(comm)), m_box(box_geo), m_cutoff_regular(cutoff_regular),
       m_regular_decomposition(RegularDecomposition(
           m_comm, cutoff_regular + skin, m_box, local_box, std::nullopt)),
-      m_n_square(AtomDecomposition(m_comm, m_box)),
+      m_n_square(AtomDecomposition(m_comm, m_box, range)),
       m_n_square_types(std::move(n_square_types)),
       m_get_global_ghost_flags(std::move(get_ghost_flags)) {
 
@@ -81,18 +83,32 @@ HybridDecomposition::HybridDecomposition(boost::mpi::communicator comm,
             collect_ghost_force_comm_n_square.communications.end(),
             std::back_inserter(m_collect_ghost_force_comm.communications));
 
-  /* coupling between the child decompositions via neighborship relation */
-  std::vector<Cell *> additional_reds = m_n_square.get_local_cells();
-  std::copy(ghost_cells_n_square.begin(), ghost_cells_n_square.end(),
-            std::back_inserter(additional_reds));
-  for (auto &local_cell : m_regular_decomposition.local_cells()) {
-    std::vector<Cell *> red_neighbors(local_cell->m_neighbors.red().begin(),
-                                      local_cell->m_neighbors.red().end());
-    std::vector<Cell *> black_neighbors(local_cell->m_neighbors.black().begin(),
-                                        local_cell->m_neighbors.black().end());
-    std::copy(additional_reds.begin(), additional_reds.end(),
-              std::back_inserter(red_neighbors));
-    local_cell->m_neighbors = Neighbors<Cell *>(red_neighbors, black_neighbors);
+  /* coupling between the child decompositions via neighborship relation,
+   * restricted to the N-square bins within range of each regular cell */
+  auto &regular = m_regular_decomposition;
+  for (int m = 1; m <= regular.cell_grid[0]; m++) {
+    for (int n = 1; n <= regular.cell_grid[1]; n++) {
+      for (int o = 1; o <= regular.cell_grid[2]; o++) {
+        auto &local_cell = regular.cells.at(static_cast<std::size_t>(
+            Utils::get_linear_index(m, n, o, regular.ghost_cell_grid)));
+        auto const lower =
+            regular.m_local_box.my_left() +
+            Utils::hadamard_product(
+                static_cast<Utils::Vector3d>(Utils::Vector3i{m - 1, n - 1,
+                                                             o - 1}),
+                regular.cell_size);
+        auto const upper = lower + regular.cell_size;
+        std::vector<Cell *> red_neighbors(local_cell.m_neighbors.red().begin(),
+                                          local_cell.m_neighbors.red().end());
+        std::vector<Cell *> black_neighbors(
+            local_cell.m_neighbors.black().begin(),
+            local_cell.m_neighbors.black().end());
+        std::ranges::copy(m_n_square.cells_in_range(lower, upper),
+                          std::back_inserter(red_neighbors));
+        local_cell.m_neighbors =
+            Neighbors<Cell *>(red_neighbors, black_neighbors);
+      }
+    }
   }
 }
 
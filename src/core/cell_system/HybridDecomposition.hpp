@@ -51,7 +51,10 @@
  * in a @ref RegularDecomposition cell system and
  * particles with long-range interactions
  * in a @ref AtomDecomposition (N-square) cell system.
- * All regular cells are coupled to the N-square cells.
+ * The particles of the N-square cell system are sorted into spatial
+ * bins, and each regular cell is only coupled to the bins within the
+ * interaction range, such that finding the pairs between both kinds
+ * of particles doesn't scale with the product of their numbers.
  */
 class HybridDecomposition : public ParticleDecomposition {
   boost::mpi::communicator m_comm;
@@ -77,8 +80,20 @@ class HybridDecomposition : public ParticleDecomposition {
   }
 
 public:
+  /**
+   * @param comm            Communicator to distribute the particles over.
+   * @param cutoff_regular  Interaction cutoff of the regular particles.
+   * @param skin            Verlet skin.
+   * @param range           Interaction range of all particles, used to
+   *                        bin the N-square particles.
+   * @param get_ghost_flags Callback for the global ghost flags.
+   * @param box_geo         Box geometry.
+   * @param local_box       Local box geometry.
+   * @param n_square_types  Particle types to put into the N-square cells.
+   */
   HybridDecomposition(boost::mpi::communicator comm, double cutoff_regular,
-                      double skin, std::function<bool()> get_ghost_flags,
+                      double skin, double range,
+                      std::function<bool()> get_ghost_flags,
                       BoxGeometry const &box_geo, LocalBox const &local_box,
                       std::set<int> n_square_types);
 
@@ -88,6 +103,9 @@ public:
 
   auto get_n_square_types() const { return m_n_square_types; }
 
+  /** @brief Number of bins of the N-square particles in each direction. */
+  auto get_n_square_bin_grid() const { return m_n_square.get_bin_grid(); }
+
   void resort(bool global, std::vector<ParticleChange> &diff) override;
 
   auto get_cutoff_regular() const { return m_cutoff_regular; }
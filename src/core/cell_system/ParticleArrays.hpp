@@ -0,0 +1,366 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "config/config.hpp"
+
+#include "Particle.hpp"
+#include "cell_system/Cell.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Structure-of-arrays mirror of the particle properties
+ * needed by the central short-range force kernels.
+ *
+ * The particles of each cell occupy a contiguous range of the arrays,
+ * local cells first, then ghost cells. The range of a cell and the
+ * back-references to the particles only change on particle resort,
+ * while positions, types and charges are refreshed before each pair
+ * loop, i.e. after the ghost update. Forces are accumulated in
+ * @ref ParticleArrays::force and added to the particles afterwards.
+ *
+ * Within a cell, particles are ordered such that consecutive groups of
+ * @ref ParticleArrays::cluster_size particles are spatially compact.
+ * These groups form the clusters of the cluster pair list. The range of
+ * each cell is padded to a multiple of the cluster size with empty
+ * entries, which have a null back-reference.
+ */
+struct ParticleArrays {
+  /** Index of a particle in the arrays. */
+  using index_type = unsigned int;
+  /** Number of particles per cluster. */
+  static constexpr index_type cluster_size = 4u;
+
+  /** Back-references to the particles. */
+  std::vector<Particle *> particles;
+  std::vector<Utils::Vector3d> pos;
+  std::vector<int> type;
+#ifdef ELECTROSTATICS
+  std::vector<double> q;
+#endif
+  std::vector<Utils::Vector3d> force;
+#ifdef EXCLUSIONS
+  /** Whether the particle has non-bonded interaction exclusions. */
+  std::vector<char> has_exclusions;
+#endif
+
+  /**
+   * Positions at the last @ref gather_particles, i.e. at the last resort.
+   * The Verlet lists are built from these positions, since the resort
+   * criterion limits the displacement with respect to them.
+   */
+  std::vector<Utils::Vector3d> reference_pos;
+  /** Bounding sphere centers of the clusters. */
+  std::vector<Utils::Vector3d> cluster_center;
+  /** Bounding sphere radii of the clusters. */
+  std::vector<double> cluster_radius;
+
+  auto size() const { return particles.size(); }
+
+  /**
+   * @brief Number of entries of the local cells. The entries of the
+   * ghost cells follow them.
+   */
+  index_type n_local() const { return m_n_local; }
+
+  /**
+   * @brief Range of indices of the particles of a cell.
+   */
+  std::pair<index_type, index_type> range(Cell const &cell) const {
+    assert(m_cell_ranges.contains(&cell));
+    auto const &cell_range = m_cell_ranges.at(&cell);
+    return {cell_range.first, cell_range.last};
+  }
+
+  /**
+   * @brief Range of indices of the clusters of a cell.
+   */
+  std::pair<index_type, index_type> clusters(Cell const &cell) const {
+    auto const [first, last] = range(cell);
+    return {first / cluster_size, (last + cluster_size - 1u) / cluster_size};
+  }
+
+  /**
+   * @brief Collect the particles of the cells, in cell order.
+   *
+   * Needs to be called after every particle resort. A cell that holds
+   * the same particles at the same positions as in the previous call
+   * keeps its particle order and is marked as unchanged, see
+   * @ref ParticleArrays::unchanged and @ref ParticleArrays::remap.
+   */
+  void gather_particles(std::span<Cell *const> local_cells,
+                        std::span<Cell *const> ghost_cells) {
+    auto const prev_ranges = std::exchange(m_cell_ranges, {});
+    auto const prev_ids = std::exchange(m_ids, {});
+    auto const prev_pos = std::exchange(reference_pos, {});
+    particles.clear();
+    m_remap.assign(prev_ids.size(), invalid_index);
+    auto const gather_cells = [&](std::span<Cell *const> cells) {
+      for (auto const cell : cells) {
+        auto const first = static_cast<index_type>(particles.size());
+        for (auto &p : cell->particles()) {
+          particles.push_back(&p);
+        }
+        auto const last = static_cast<index_type>(particles.size());
+        auto const cell_particles =
+            std::span(particles).subspan(first, last - first);
+        auto unchanged = false;
+        if (auto const prev = prev_ranges.find(cell);
+            prev != prev_ranges.end()) {
+          auto const prev_first = prev->second.first;
+          auto const prev_size = prev->second.last - prev_first;
+          unchanged = restore_order(
+              cell_particles,
+              std::span(prev_ids).subspan(prev_first, prev_size),
+              std::span(prev_pos).subspan(prev_first, prev_size));
+          if (unchanged) {
+            for (index_type k = 0u; k < prev_size; ++k) {
+              m_remap[prev_first + k] = first + k;
+            }
+          }
+        }
+        if (not unchanged) {
+          sort_spatially(cell_particles.begin(), cell_particles.end());
+        }
+        particles.resize((last + cluster_size - 1u) / cluster_size *
+                         cluster_size);
+        m_cell_ranges[cell] = {first, last, unchanged};
+      }
+    };
+    gather_cells(local_cells);
+    m_n_local = static_cast<index_type>(particles.size());
+    gather_cells(ghost_cells);
+    m_ids.resize(particles.size());
+    reference_pos.resize(particles.size());
+    for (std::size_t i = 0u; i < particles.size(); ++i) {
+      m_ids[i] = particles[i] ? particles[i]->id() : -1;
+      reference_pos[i] =
+          particles[i] ? particles[i]->pos() : Utils::Vector3d{};
+    }
+#ifdef EXCLUSIONS
+    has_exclusions.resize(particles.size());
+    std::ranges::transform(particles, has_exclusions.begin(),
+                           [](Particle const *p) -> char {
+                             return p and not p->exclusions().empty();
+                           });
+#endif
+  }
+
+  /**
+   * @brief Forget the previous particle layout, such that all cells
+   * are marked as changed by the next @ref gather_particles.
+   */
+  void clear() {
+    m_cell_ranges.clear();
+    m_ids.clear();
+    reference_pos.clear();
+  }
+
+  /**
+   * @brief Whether a cell holds the same particles at the same positions
+   * as before the last @ref gather_particles.
+   */
+  bool unchanged(Cell const &cell) const {
+    assert(m_cell_ranges.contains(&cell));
+    return m_cell_ranges.at(&cell).unchanged;
+  }
+
+  /**
+   * @brief Map an index from before the last @ref gather_particles to the
+   * current index. Only valid for particles of unchanged cells.
+   */
+  index_type remap(index_type old_index) const {
+    assert(m_remap[old_index] != invalid_index);
+    return m_remap[old_index];
+  }
+
+  /**
+   * @brief Compute the bounding spheres of the clusters
+   * from the reference positions.
+   */
+  void update_cluster_bounds() {
+    auto const n_clusters = particles.size() / cluster_size;
+    cluster_center.assign(n_clusters, Utils::Vector3d{});
+    cluster_radius.assign(n_clusters, 0.);
+    for (std::size_t c = 0u; c < n_clusters; ++c) {
+      auto const first = c * cluster_size;
+      auto n_valid = 0u;
+      for (auto i = first; i < first + cluster_size and particles[i]; ++i) {
+        cluster_center[c] += reference_pos[i];
+        ++n_valid;
+      }
+      if (n_valid == 0u) {
+        continue;
+      }
+      cluster_center[c] /= static_cast<double>(n_valid);
+      for (auto i = first; i < first + n_valid; ++i) {
+        cluster_radius[c] = std::max(cluster_radius[c],
+                                     (reference_pos[i] - cluster_center[c])
+                                         .norm());
+      }
+    }
+  }
+
+  /**
+   * @brief Refresh the particle properties and reset the forces.
+   */
+  void gather_properties() {
+    reset_forces();
+    gather_properties(0u, static_cast<index_type>(size()));
+  }
+
+  /**
+   * @brief Reset the forces, and size the property arrays
+   * for @ref gather_properties(index_type, index_type).
+   */
+  void reset_forces() {
+    auto const n_part = particles.size();
+    pos.resize(n_part);
+    type.resize(n_part);
+#ifdef ELECTROSTATICS
+    q.resize(n_part);
+#endif
+    force.assign(n_part, Utils::Vector3d{});
+  }
+
+  /**
+   * @brief Refresh the particle properties of a range of indices,
+   * e.g. of the local particles only, see @ref n_local.
+   */
+  void gather_properties(index_type first, index_type last) {
+    assert(last <= size() and pos.size() == size());
+    for (std::size_t i = first; i < last; ++i) {
+      if (particles[i] == nullptr) {
+        pos[i] = Utils::Vector3d{};
+        type[i] = 0;
+#ifdef ELECTROSTATICS
+        q[i] = 0.;
+#endif
+        continue;
+      }
+      auto const &p = *particles[i];
+      pos[i] = p.pos();
+      type[i] = p.type();
+#ifdef ELECTROSTATICS
+      q[i] = p.q();
+#endif
+    }
+  }
+
+  /**
+   * @brief Add the accumulated forces to the particles.
+   */
+  void scatter_forces() const {
+    auto const n_part = particles.size();
+    for (std::size_t i = 0u; i < n_part; ++i) {
+      if (particles[i]) {
+        particles[i]->force() += force[i];
+      }
+    }
+  }
+
+private:
+  static constexpr auto invalid_index = static_cast<index_type>(-1);
+
+  struct CellRange {
+    index_type first;
+    index_type last;
+    bool unchanged;
+  };
+
+  /**
+   * @brief Restore the previous order of the particles of a cell.
+   *
+   * @return Whether the cell holds the same particles at the same
+   * positions as before, otherwise @p cell_particles is left unordered.
+   */
+  bool restore_order(std::span<Particle *> cell_particles,
+                     std::span<int const> prev_ids,
+                     std::span<Utils::Vector3d const> prev_pos) {
+    if (cell_particles.size() != prev_ids.size()) {
+      return false;
+    }
+    auto const by_id = [](Particle const *p) { return p->id(); };
+    std::ranges::sort(cell_particles, {}, by_id);
+    m_buffer.resize(cell_particles.size());
+    for (std::size_t k = 0u; k < prev_ids.size(); ++k) {
+      auto const it =
+          std::ranges::lower_bound(cell_particles, prev_ids[k], {}, by_id);
+      if (it == cell_particles.end() or (**it).id() != prev_ids[k] or
+          (**it).pos() != prev_pos[k]) {
+        return false;
+      }
+      m_buffer[k] = *it;
+    }
+    std::ranges::copy(m_buffer, cell_particles.begin());
+    return true;
+  }
+
+  /**
+   * @brief Order particles by recursive bisection along the longest
+   * extent of their bounding box, with split points at multiples of
+   * the cluster size.
+   */
+  template <class It> static void sort_spatially(It first, It last) {
+    auto const n = static_cast<index_type>(std::distance(first, last));
+    if (n <= cluster_size) {
+      return;
+    }
+    Utils::Vector3d lower = (*first)->pos();
+    Utils::Vector3d upper = lower;
+    for (auto it = first; it != last; ++it) {
+      for (unsigned int k = 0u; k < 3u; ++k) {
+        lower[k] = std::min(lower[k], (*it)->pos()[k]);
+        upper[k] = std::max(upper[k], (*it)->pos()[k]);
+      }
+    }
+    auto const extent = upper - lower;
+    auto const axis = static_cast<unsigned int>(std::distance(
+        extent.begin(), std::max_element(extent.begin(), extent.end())));
+    auto const n_left =
+        (n / 2u + cluster_size - 1u) / cluster_size * cluster_size;
+    auto const middle = first + n_left;
+    std::nth_element(first, middle, last,
+                     [axis](Particle const *a, Particle const *b) {
+                       return a->pos()[axis] < b->pos()[axis];
+                     });
+    sort_spatially(first, middle);
+    sort_spatially(middle, last);
+  }
+
+  std::unordered_map<Cell const *, CellRange> m_cell_ranges;
+  index_type m_n_local = 0u;
+  /** Particle ids at the last @ref gather_particles. */
+  std::vector<int> m_ids;
+  /** Map from the previous to the current particle indices. */
+  std::vector<index_type> m_remap;
+  std::vector<Particle *> m_buffer;
+};
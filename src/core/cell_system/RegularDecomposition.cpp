@@ -30,6 +30,7 @@
 
 #include <utils/Vector.hpp>
 #include <utils/index.hpp>
+#include <utils/morton.hpp>
 #include <utils/mpi/cart_comm.hpp>
 #include <utils/mpi/sendrecv.hpp>
 
@@ -41,10 +42,14 @@
 
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -53,26 +58,30 @@ int RegularDecomposition::position_to_cell_index(
   Utils::Vector3i cpos;
 
   for (auto i = 0u; i < 3u; i++) {
-    cpos[i] = static_cast<int>(std::floor(pos[i] * inv_cell_size[i])) + 1 -
-              cell_offset[i];
-
     /* particles outside our box. Still take them if
        nonperiodic boundary. We also accept the particle if we are at
        the box boundary, and the particle is within the box. In this case
        the particle belongs here and could otherwise potentially be dismissed
        due to rounding errors. */
-    if (cpos[i] < 1) {
+    if (pos[i] < m_local_box.my_left()[i]) {
       if ((!m_box.periodic(i) or (pos[i] >= m_box.length()[i])) and
           m_local_box.boundary()[2u * i])
         cpos[i] = 1;
       else
         return -1;
-    } else if (cpos[i] > cell_grid[i]) {
+    } else if (pos[i] >= m_local_box.my_right()[i]) {
       if ((!m_box.periodic(i) or (pos[i] < m_box.length()[i])) and
           m_local_box.boundary()[2u * i + 1u])
         cpos[i] = cell_grid[i];
       else
         return -1;
+    } else {
+      /* the cell sizes of the nodes can differ, hence the cell index
+         is relative to the local box, and clamped against rounding */
+      auto const local_pos = pos[i] - m_local_box.my_left()[i];
+      cpos[i] = std::clamp(
+          static_cast<int>(std::floor(local_pos * inv_cell_size[i])) + 1, 1,
+          cell_grid[i]);
     }
   }
 
@@ -251,6 +260,24 @@ void RegularDecomposition::mark_cells() {
         else
           m_ghost_cells.push_back(&cells.at(cnt_c++));
       }
+
+  std::ranges::sort(m_local_cells, {}, [this](Cell const *cell) {
+    auto const pos = cell_position(cell);
+    return Utils::morton_code(static_cast<uint32_t>(pos[0]),
+                              static_cast<uint32_t>(pos[1]),
+                              static_cast<uint32_t>(pos[2]));
+  });
+}
+
+Utils::Vector3i RegularDecomposition::cell_position(Cell const *cell) const {
+  auto index = static_cast<int>(std::distance(cells.data(), cell));
+  assert(index >= 0 and index < Utils::product(ghost_cell_grid));
+  Utils::Vector3i pos;
+  for (auto i = 0u; i < 3u; i++) {
+    pos[i] = index % ghost_cell_grid[i];
+    index /= ghost_cell_grid[i];
+  }
+  return pos;
 }
 
 void RegularDecomposition::fill_comm_cell_lists(ParticleList **part_lists,
@@ -265,15 +292,48 @@ void RegularDecomposition::fill_comm_cell_lists(ParticleList **part_lists,
       }
 }
 
+std::vector<std::vector<Cell *>>
+RegularDecomposition::checkerboard_colors() const {
+  Utils::Vector3i n_colors;
+  for (auto i = 0u; i < 3u; i++) {
+    n_colors[i] = (global_cell_grid[i] % 2 == 0) ? 2 : 3;
+    if (global_cell_grid[i] < 2) {
+      return {};
+    }
+  }
+  if (m_fully_connected_boundary) {
+    return {};
+  }
+
+  std::vector<std::vector<Cell *>> colors(
+      static_cast<std::size_t>(Utils::product(n_colors)));
+  for (auto const local_cell : m_local_cells) {
+    auto const local_index = cell_position(local_cell);
+    Utils::Vector3i color;
+    for (auto i = 0u; i < 3u; i++) {
+      auto const global_index = local_index[i] - 1 + cell_offset[i];
+      color[i] =
+          (global_index == global_cell_grid[i] - 1 and n_colors[i] == 3)
+              ? 2
+              : global_index % 2;
+    }
+    colors[Utils::get_linear_index(color, n_colors)].push_back(local_cell);
+  }
+  return colors;
+}
+
 Utils::Vector3d RegularDecomposition::max_cutoff() const {
   auto dir_max_range = [this](unsigned int i) {
-    return std::min(0.5 * m_box.length()[i], m_local_box.length()[i]);
+    return std::min(0.5 * m_box.length()[i], m_min_local_box_l[i]);
   };
 
   return {dir_max_range(0u), dir_max_range(1u), dir_max_range(2u)};
 }
 
-Utils::Vector3d RegularDecomposition::max_range() const { return cell_size; }
+Utils::Vector3d RegularDecomposition::max_range() const {
+  return m_min_cell_size;
+}
+
 int RegularDecomposition::calc_processor_min_num_cells() const {
   /* the minimal number of cells can be lower if there are at least two nodes
      serving a direction,
@@ -365,7 +425,30 @@ void RegularDecomposition::create_cell_grid(double range) {
     runtimeErrorMsg() << "no suitable cell grid found";
   }
 
+  /* The nodes in a slab of the node grid have to agree on the number of
+     cells across the slab, such that the cell layers of neighboring nodes
+     match. This is only guaranteed for local boxes of equal size, hence
+     the smallest number of cells in each slab is used. */
   auto const node_pos = cart_info.coords;
+  std::vector<int> node_cell_grids;
+  boost::mpi::all_gather(m_comm, cell_grid.data(), 3, node_cell_grids);
+  for (auto i = 0u; i < 3u; i++) {
+    std::vector<int> slab_cells(static_cast<std::size_t>(cart_info.dims[i]),
+                                std::numeric_limits<int>::max());
+    for (int rank = 0; rank < m_comm.size(); ++rank) {
+      auto const slab = static_cast<std::size_t>(
+          Utils::Mpi::cart_coords<3>(m_comm, rank)[i]);
+      slab_cells[slab] = std::min(
+          slab_cells[slab],
+          node_cell_grids[3u * static_cast<std::size_t>(rank) + i]);
+    }
+    cell_grid[i] = slab_cells[static_cast<std::size_t>(node_pos[i])];
+    cell_offset[i] = std::accumulate(slab_cells.begin(),
+                                     slab_cells.begin() + node_pos[i], 0);
+    global_cell_grid[i] =
+        std::accumulate(slab_cells.begin(), slab_cells.end(), 0);
+  }
+  n_local_cells = Utils::product(cell_grid);
 
   /* now set all dependent variables */
   int new_cells = 1;
@@ -374,9 +457,15 @@ void RegularDecomposition::create_cell_grid(double range) {
     new_cells *= ghost_cell_grid[i];
     cell_size[i] = m_local_box.length()[i] / static_cast<double>(cell_grid[i]);
     inv_cell_size[i] = 1.0 / cell_size[i];
-    cell_offset[i] = node_pos[i] * cell_grid[i];
   }
 
+  /* the range of the cell system is limited by the smallest node */
+  boost::mpi::all_reduce(m_comm, m_local_box.length().data(), 3,
+                         m_min_local_box_l.data(),
+                         boost::mpi::minimum<double>());
+  boost::mpi::all_reduce(m_comm, cell_size.data(), 3, m_min_cell_size.data(),
+                         boost::mpi::minimum<double>());
+
   /* allocate cell array and cell pointer arrays */
   cells.clear();
   cells.resize(static_cast<unsigned int>(new_cells));
@@ -392,11 +481,9 @@ template <class K, class Comparator> auto make_flat_set(Comparator &&comp) {
 void RegularDecomposition::init_cell_interactions() {
 
   auto const halo = Utils::Vector3i{1, 1, 1};
-  auto const cart_info = Utils::Mpi::cart_get<3>(m_comm);
-  auto const &node_pos = cart_info.coords;
   auto const &node_grid = ::communicator.node_grid;
-  auto const global_halo_offset = hadamard_product(node_pos, cell_grid) - halo;
-  auto const global_size = hadamard_product(node_grid, cell_grid);
+  auto const global_halo_offset = cell_offset - halo;
+  auto const global_size = global_cell_grid;
   auto const at_boundary = [&global_size](int coord, Utils::Vector3i cell_idx) {
     return (cell_idx[coord] == 0 or cell_idx[coord] == global_size[coord]);
   };
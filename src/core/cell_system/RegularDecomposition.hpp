@@ -63,6 +63,12 @@
  * blue). Caution: This implementation needs double sided ghost
  * communication! For single sided ghost communication one would need
  * some ghost-ghost cell interaction as well, which we do not need!
+ *
+ * The local boxes don't need to be of equal size, as long as they form
+ * a rectilinear partition of the box, see
+ * @ref LocalBox::make_rectilinear_decomposition. The cell size then
+ * differs between the nodes, while the number of cells is the same for
+ * all nodes in a slab of the node grid.
  */
 struct RegularDecomposition : public ParticleDecomposition {
   /** Grid dimensions per node. */
@@ -71,6 +77,8 @@ struct RegularDecomposition : public ParticleDecomposition {
   Utils::Vector3d cell_size = {};
   /** Offset in global grid */
   Utils::Vector3i cell_offset = {};
+  /** Dimensions of the global grid. */
+  Utils::Vector3i global_cell_grid = {};
   /** linked cell grid with ghost frame. */
   Utils::Vector3i ghost_cell_grid = {};
   /** inverse @ref RegularDecomposition::cell_size "cell_size". */
@@ -85,6 +93,9 @@ struct RegularDecomposition : public ParticleDecomposition {
   std::vector<Cell *> m_ghost_cells;
   GhostCommunicator m_exchange_ghosts_comm;
   GhostCommunicator m_collect_ghost_force_comm;
+  /** Smallest local box and cell size of all nodes. */
+  Utils::Vector3d m_min_local_box_l = {};
+  Utils::Vector3d m_min_cell_size = {};
 
 public:
   RegularDecomposition(boost::mpi::communicator comm, double range,
@@ -119,6 +130,20 @@ public:
 
   auto fully_connected_boundary() const { return m_fully_connected_boundary; }
 
+  /**
+   * @brief Partition the local cells by a checkerboard coloring of the
+   * global cell grid.
+   *
+   * Two cells of the same color are never neighbors, such that particles
+   * in cells of the same color don't interact with each other and can be
+   * changed concurrently. Each color has the same index on all ranks.
+   * Directions with an odd number of cells need a third color for the
+   * last cell. An empty list is returned if no such coloring exists,
+   * i.e. with a single cell in some direction or a fully connected
+   * boundary.
+   */
+  std::vector<std::vector<Cell *>> checkerboard_colors() const;
+
   std::optional<BoxGeometry> minimum_image_distance() const override {
     return {m_box};
   }
@@ -127,10 +152,14 @@ public:
 
 private:
   /** Fill @c m_local_cells list and @c m_ghost_cells list for use with regular
-   *  decomposition.
+   *  decomposition. The local cells are ordered along a Morton curve, such
+   *  that cells which are traversed one after the other are close in space.
    */
   void mark_cells();
 
+  /** Position of a cell in the cell grid with ghost frame. */
+  Utils::Vector3i cell_position(Cell const *cell) const;
+
   /** Fill a communication cell pointer list. Fill the cell pointers of
    *  all cells which are inside a rectangular subgrid of the 3D cell
    *  grid starting from the
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <optional>
+
+/**
+ * @brief Online tuner for the Verlet list skin.
+ *
+ * A larger skin makes the pair loop more expensive, since more pairs are
+ * visited, but reduces the number of particle resorts and Verlet list
+ * rebuilds. The tuner measures the cost of the integration steps, i.e.
+ * the time spent in the resort and ghost communication plus the time spent
+ * in the force calculation, while the system is being integrated. Each skin
+ * value is timed over a trial of @ref steps_per_trial steps, and the skin
+ * range is narrowed down by golden-section search until it is smaller than
+ * the tolerance. The first step of each trial is not timed, since it pays
+ * for the cell system rebuild after the skin change.
+ *
+ * The tuner does not communicate: the caller has to reduce the trial
+ * timings over all MPI ranks before passing them to @ref end_trial,
+ * such that all ranks take the same decisions.
+ */
+class VerletSkinTuner {
+public:
+  /**
+   * @param min_skin         Smallest skin to consider.
+   * @param max_skin         Largest skin to consider.
+   * @param tol              Width of the skin range at which to stop.
+   * @param steps_per_trial  Number of integration steps to time per skin.
+   * @param max_trials       Stop after that many trials, even when the
+   *                         skin range is still larger than @p tol.
+   * @param verbose          Whether to print the trials on stdout.
+   */
+  VerletSkinTuner(double min_skin, double max_skin, double tol,
+                  int steps_per_trial, int max_trials, bool verbose)
+      : m_lower{min_skin}, m_upper{max_skin}, m_tol{tol},
+        m_steps_per_trial{steps_per_trial}, m_max_trials{max_trials},
+        m_verbose{verbose} {
+    assert(min_skin >= 0. and max_skin >= min_skin);
+    assert(steps_per_trial >= 2 and max_trials >= 1);
+    m_x1 = m_upper - golden_ratio * (m_upper - m_lower);
+    m_x2 = m_lower + golden_ratio * (m_upper - m_lower);
+    if (m_verbose) {
+      std::printf("Verlet skin tuning: range [%.4e, %.4e], %d steps per trial"
+                  "\nskin       time [ms]  reuse\n",
+                  m_lower, m_upper, m_steps_per_trial);
+    }
+  }
+
+  /** @brief Skin to be timed in the current trial. */
+  double trial_skin() const { return m_f1 ? m_x2 : m_x1; }
+
+  /** @brief Whether the tuning has converged. */
+  bool converged() const { return m_result.has_value(); }
+
+  /** @brief Tuned skin, or an empty optional until converged. */
+  std::optional<double> result() const { return m_result; }
+
+  /**
+   * @brief Account for one integration step of the current trial.
+   * @param time     Time spent in the step in seconds.
+   * @param rebuilt  Whether the particles were resorted in the step.
+   * @return Whether the trial is complete.
+   */
+  bool add_step(double time, bool rebuilt) {
+    assert(not converged());
+    if (m_n_steps++ > 0) {
+      m_time += time;
+      m_n_rebuilds += static_cast<int>(rebuilt);
+    }
+    return m_n_steps >= m_steps_per_trial;
+  }
+
+  /** @brief Local time of the current trial in seconds. */
+  double trial_time() const { return m_time; }
+
+  /**
+   * @brief Finish the current trial and select the next skin.
+   * @param time  Time of the trial in seconds, reduced over all ranks.
+   */
+  void end_trial(double time) {
+    assert(not converged());
+    auto const n_timed = m_steps_per_trial - 1;
+    auto const cost = time / n_timed;
+    if (m_verbose) {
+      auto const reuse =
+          (m_n_rebuilds > 0) ? static_cast<double>(n_timed) / m_n_rebuilds : 0.;
+      std::printf("%.4e %-10.4f %-6.1f\n", trial_skin(), 1000. * cost, reuse);
+    }
+    if (not m_f1) {
+      m_f1 = cost;
+    } else {
+      m_f2 = cost;
+    }
+    m_n_steps = 0;
+    m_n_rebuilds = 0;
+    m_time = 0.;
+    ++m_n_trials;
+    if (m_f1 and m_f2) {
+      /* shrink the range to the side of the best skin */
+      if (*m_f1 < *m_f2) {
+        m_upper = m_x2;
+        m_x2 = m_x1;
+        m_f2 = m_f1;
+        m_x1 = m_upper - golden_ratio * (m_upper - m_lower);
+        m_f1.reset();
+      } else {
+        m_lower = m_x1;
+        m_x1 = m_x2;
+        m_f1 = m_f2;
+        m_x2 = m_lower + golden_ratio * (m_upper - m_lower);
+        m_f2.reset();
+      }
+    }
+    if (m_upper - m_lower <= m_tol or m_n_trials >= m_max_trials) {
+      m_result = (m_f1 and (not m_f2 or *m_f1 <= *m_f2)) ? m_x1 : m_x2;
+      if (m_verbose) {
+        std::printf("\nresulting skin: %.4e after %d trials\n", *m_result,
+                    m_n_trials);
+      }
+    }
+  }
+
+private:
+  static constexpr double golden_ratio = 0.6180339887498949;
+
+  /** Current search range. */
+  double m_lower;
+  double m_upper;
+  double m_tol;
+  int m_steps_per_trial;
+  int m_max_trials;
+  bool m_verbose;
+  /** Inner points of the search range and their timings. */
+  double m_x1;
+  double m_x2;
+  std::optional<double> m_f1;
+  std::optional<double> m_f2;
+  /** Statistics of the current trial. */
+  int m_n_steps = 0;
+  int m_n_rebuilds = 0;
+  double m_time = 0.;
+  int m_n_trials = 0;
+  std::optional<double> m_result;
+};
@@ -172,6 +172,7 @@ void BindAtPointOfCollision::handle_collisions(
         p->bonds().insert({bond_vs, bondG});
     }
   } // Loop over all collisions in the queue
+  cell_structure.on_bonds_change();
 
 #ifdef ADDITIONAL_CHECKS
   assert(Utils::Mpi::all_compare(::comm_cart, current_vs_pid) &&
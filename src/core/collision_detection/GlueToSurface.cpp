@@ -193,6 +193,7 @@ void GlueToSurface::handle_collisions(
     int const bondG[] = {current_vs_pid - 1};
     get_part(cell_structure, p->id()).bonds().insert({bond_vs, bondG});
   } // Loop over all collisions in the queue
+  cell_structure.on_bonds_change();
 
 #ifdef ADDITIONAL_CHECKS
   assert(Utils::Mpi::all_compare(::comm_cart, current_vs_pid) &&
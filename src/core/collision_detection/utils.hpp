@@ -92,6 +92,7 @@ inline void add_bind_centers(std::vector<CollisionPair> &collision_queue,
     // Insert the bond for the non-ghost particle
     get_part(cell_structure, c.first).bonds().insert({bond_centers, bondG});
   }
+  cell_structure.on_bonds_change();
 }
 
 } // namespace CollisionDetection
@@ -73,6 +73,7 @@ void dpd_init(double kT, double time_step) {
           sqrt(24.0 * kT * ia_params.dpd.trans.gamma / time_step);
     }
   }
+  nonbonded_ias.update_ia_params_table();
 }
 
 static double weight(int type, double r_cut, double k, double r) {
@@ -26,6 +26,7 @@
 #include "ek/EKNone.hpp"
 #include "ek/EKWalberla.hpp"
 
+#include "cell_system/CellStructure.hpp"
 #include "system/System.hpp"
 
 #include <utils/Vector.hpp>
@@ -55,6 +56,18 @@ static void check_solver(std::unique_ptr<Solver::Implementation> const &ptr) {
   }
 }
 
+/** @brief Deactivate the solver if the load balancing is active. */
+static void
+check_load_balancing_support(System::System const &system,
+                             std::unique_ptr<Solver::Implementation> &ptr) {
+  try {
+    system.cell_structure->check_load_balancing_support();
+  } catch (...) {
+    ptr->solver = std::nullopt;
+    throw;
+  }
+}
+
 bool Solver::is_solver_set() const { return EK::is_solver_set(impl); }
 
 void Solver::reset() { System::get_system().ek.impl->solver = std::nullopt; }
@@ -136,6 +149,7 @@ template <> void Solver::set<EKNone>(std::shared_ptr<EKNone> ek_instance) {
   assert(impl);
   assert(not impl->solver.has_value());
   impl->solver = ek_instance;
+  check_load_balancing_support(get_system(), impl);
 }
 
 #ifdef WALBERLA
@@ -146,6 +160,7 @@ void Solver::set<EKWalberla>(std::shared_ptr<EKWalberla> ek_instance) {
   auto const &system = get_system();
   ek_instance->sanity_checks(system);
   impl->solver = ek_instance;
+  check_load_balancing_support(system, impl);
 }
 #endif // WALBERLA
 
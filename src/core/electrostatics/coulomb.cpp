@@ -50,6 +50,7 @@
 #include <limits>
 #include <memory>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <type_traits>
@@ -71,6 +72,18 @@ void Solver::sanity_checks() const {
   }
 }
 
+bool Solver::has_gpu_long_range_forces() const {
+#ifdef P3M
+  if (impl->solver) {
+    if (auto const *actor =
+            std::get_if<std::shared_ptr<CoulombP3M>>(&*impl->solver)) {
+      return (**actor).is_gpu();
+    }
+  }
+#endif // P3M
+  return false;
+}
+
 void Solver::on_coulomb_change() {
   reinit_on_observable_calc = true;
   if (impl->solver) {
@@ -266,6 +279,73 @@ double Solver::calc_energy_long_range(ParticleRange const &particles) const {
   return 0.;
 }
 
+struct HasLongRangeEnergyDifference {
+  template <typename T> bool operator()(std::shared_ptr<T> const &) const {
+    return false;
+  }
+#ifdef P3M
+  bool operator()(std::shared_ptr<CoulombP3M> const &actor) const {
+    return not actor->is_gpu() and
+           actor->p3m_params.epsilon == P3M_EPSILON_METALLIC;
+  }
+#endif // P3M
+  /* Several algorithms only provide near-field kernels */
+  bool operator()(std::shared_ptr<CoulombMMM1D> const &) const { return true; }
+  bool operator()(std::shared_ptr<DebyeHueckel> const &) const { return true; }
+  bool operator()(std::shared_ptr<ReactionField> const &) const {
+    return true;
+  }
+};
+
+bool Solver::has_long_range_energy_difference() const {
+  if (impl->extension) {
+    return false;
+  }
+  if (impl->solver) {
+    return std::visit(HasLongRangeEnergyDifference(), *impl->solver);
+  }
+  return true;
+}
+
+void Solver::prepare_energy_difference(ParticleRange const &particles) const {
+  assert(has_long_range_energy_difference());
+#ifdef P3M
+  if (auto const actor = get_actor_by_type<CoulombP3M>(impl->solver)) {
+    actor->prepare_energy_difference(particles);
+  }
+#endif // P3M
+}
+
+double Solver::calc_long_range_potential(Utils::Vector3d const &pos) const {
+#ifdef P3M
+  if (auto const actor = get_actor_by_type<CoulombP3M>(impl->solver)) {
+    return actor->mesh_potential(pos);
+  }
+#endif // P3M
+  return 0.;
+}
+
+double Solver::calc_energy_difference_long_range(
+    std::span<ChargeSite const> removed,
+    std::span<ChargeSite const> added) const {
+#ifdef P3M
+  if (auto const actor = get_actor_by_type<CoulombP3M>(impl->solver)) {
+    return actor->long_range_energy_difference(removed, added);
+  }
+#endif // P3M
+  return 0.;
+}
+
+void Solver::update_energy_difference(
+    std::span<ChargeSite const> removed,
+    std::span<ChargeSite const> added) const {
+#ifdef P3M
+  if (auto const actor = get_actor_by_type<CoulombP3M>(impl->solver)) {
+    actor->update_energy_difference(removed, added);
+  }
+#endif // P3M
+}
+
 /** @brief Compute the net charge rescaled by the smallest non-zero charge. */
 static auto calc_charge_excess_ratio(std::vector<double> const &charges) {
   using namespace boost::accumulators;
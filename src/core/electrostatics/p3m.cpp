@@ -63,7 +63,9 @@
 #include "tuning.hpp"
 
 #include <utils/Vector.hpp>
+#include <utils/index.hpp>
 #include <utils/integral_parameter.hpp>
+#include <utils/math/bspline.hpp>
 #include <utils/math/int_pow.hpp>
 #include <utils/math/sqr.hpp>
 
@@ -82,6 +84,7 @@
 #include <functional>
 #include <initializer_list>
 #include <numbers>
+#include <numeric>
 #include <optional>
 #include <span>
 #include <sstream>
@@ -89,6 +92,11 @@
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
+
+#ifdef OPENMP
+#include <omp.h>
+#endif
 
 #ifdef FFTW3_H
 #error "The FFTW3 library shouldn't be visible in this translation unit"
@@ -304,14 +312,59 @@ template <int cao> struct AssignCharge {
     this->operator()(p3m, q, real_pos, w);
   }
 
-  template <typename combined_ranges>
-  void operator()(auto &p3m, combined_ranges const &p_q_pos_range) {
-    for (auto zipped : p_q_pos_range) {
-      auto const p_q = boost::get<0>(zipped);
-      auto const &p_pos = boost::get<1>(zipped);
-      if (p_q != 0.0) {
-        this->operator()(p3m, p_q, p_pos, p3m.inter_weights);
+  void operator()(auto &p3m, std::span<double const> charges,
+                  std::span<Utils::Vector3d const> positions) {
+    using value_type =
+        typename std::remove_reference_t<decltype(p3m)>::value_type;
+    auto &inter_weights = p3m.inter_weights;
+    assert(inter_weights.size() == 0ul);
+    assert(charges.size() == positions.size());
+    inter_weights.resize(positions.size());
+
+    /* interpolation weights, vectorized over batches of particles */
+    auto constexpr chunk_size = 256ul;
+    auto const n_chunks =
+        static_cast<long>((positions.size() + chunk_size - 1ul) / chunk_size);
+#ifdef OPENMP
+#pragma omp parallel for
+#endif
+    for (long chunk = 0; chunk < n_chunks; ++chunk) {
+      auto const first = static_cast<std::size_t>(chunk) * chunk_size;
+      auto const n = std::min(chunk_size, positions.size() - first);
+      p3m_calculate_interpolation_weights<cao>(positions.subspan(first, n),
+                                               p3m.params.ai, p3m.local_mesh,
+                                               inter_weights, first);
+    }
+
+    auto const assign = [&p3m, charges](std::size_t i) {
+      auto const q = charges[i];
+      auto const w = p3m.inter_weights.template load<cao>(i);
+      p3m_interpolate(p3m.local_mesh, w, [q, &p3m](int ind, double w) {
+        p3m.mesh.rs_scalar[ind] += value_type(w * q);
+      });
+    };
+
+#ifdef OPENMP
+    if (omp_get_max_threads() > 1) {
+      /* tiles of the same color don't share mesh points */
+      auto &tiles = p3m.inter_tiles;
+      tiles.build(inter_weights, p3m.local_mesh);
+      for (int color = 0; color < tiles.colors(); ++color) {
+        auto const &color_tiles = tiles.tiles(color);
+        auto const n_tiles = static_cast<long>(color_tiles.size());
+#pragma omp parallel for schedule(dynamic)
+        for (long t = 0; t < n_tiles; ++t) {
+          for (auto const i :
+               tiles.points(color_tiles[static_cast<std::size_t>(t)])) {
+            assign(i);
+          }
+        }
       }
+      return;
+    }
+#endif
+    for (std::size_t i = 0ul; i < charges.size(); ++i) {
+      assign(i);
     }
   }
 };
@@ -322,11 +375,18 @@ void CoulombP3MImpl<FloatType, Architecture>::charge_assign(
     ParticleRange const &particles) {
   prepare_fft_mesh(true);
 
-  auto p_q_range = ParticlePropertyRange::charge_range(particles);
-  auto p_pos_range = ParticlePropertyRange::pos_range(particles);
+  p3m.ca_charges.clear();
+  p3m.ca_positions.clear();
+  for (auto const &p : particles) {
+    if (p.q() != 0.) {
+      p3m.ca_charges.emplace_back(p.q());
+      p3m.ca_positions.emplace_back(p.pos());
+    }
+  }
 
   Utils::integral_parameter<int, AssignCharge, 1, 7>(
-      p3m.params.cao, p3m, boost::combine(p_q_range, p_pos_range));
+      p3m.params.cao, p3m, std::span<double const>(p3m.ca_charges),
+      std::span<Utils::Vector3d const>(p3m.ca_positions));
 }
 
 template <typename FloatType, Arch Architecture>
@@ -342,32 +402,31 @@ void CoulombP3MImpl<FloatType, Architecture>::assign_charge(
 }
 
 template <int cao> struct AssignForces {
-  template <typename combined_ranges>
   void operator()(auto &p3m, double force_prefac,
-                  combined_ranges const &p_q_force_range) const {
+                  std::span<Particle *const> charged_particles) const {
 
     assert(cao == p3m.inter_weights.cao());
+    assert(charged_particles.size() <= p3m.inter_weights.size());
 
-    /* charged particle counter */
-    auto p_index = std::size_t{0ul};
-
-    for (auto zipped : p_q_force_range) {
-      auto p_q = boost::get<0>(zipped);
-      auto &p_force = boost::get<1>(zipped);
-      if (p_q != 0.0) {
-        auto const pref = p_q * force_prefac;
-        auto const w = p3m.inter_weights.template load<cao>(p_index);
-
-        Utils::Vector3d force{};
-        p3m_interpolate(p3m.local_mesh, w, [&force, &p3m](int ind, double w) {
-          force[0u] += w * double(p3m.mesh.rs_fields[0u][ind]);
-          force[1u] += w * double(p3m.mesh.rs_fields[1u][ind]);
-          force[2u] += w * double(p3m.mesh.rs_fields[2u][ind]);
-        });
-
-        p_force -= pref * force;
-        ++p_index;
-      }
+    /* each particle only reads the mesh and writes its own force */
+    auto const n_part = static_cast<long>(charged_particles.size());
+#ifdef OPENMP
+#pragma omp parallel for
+#endif
+    for (long i = 0; i < n_part; ++i) {
+      auto const p_index = static_cast<std::size_t>(i);
+      auto &p = *charged_particles[p_index];
+      auto const pref = p.q() * force_prefac;
+      auto const w = p3m.inter_weights.template load<cao>(p_index);
+
+      Utils::Vector3d force{};
+      p3m_interpolate(p3m.local_mesh, w, [&force, &p3m](int ind, double w) {
+        force[0u] += w * double(p3m.mesh.rs_fields[0u][ind]);
+        force[1u] += w * double(p3m.mesh.rs_fields[1u][ind]);
+        force[2u] += w * double(p3m.mesh.rs_fields[2u][ind]);
+      });
+
+      p.force() -= pref * force;
     }
   }
 };
@@ -530,10 +589,18 @@ double CoulombP3MImpl<FloatType, Architecture>::long_range_kernel(
     p3m.fft_buffers->perform_vector_halo_spread();
     p3m.fft->check_complex_residuals = false;
 
+    /* charged particles, in the order of the interpolation cache */
+    std::vector<Particle *> charged_particles;
+    for (auto &p : particles) {
+      if (p.q() != 0.) {
+        charged_particles.emplace_back(&p);
+      }
+    }
+
     auto const force_prefac = prefactor / volume;
     Utils::integral_parameter<int, AssignForces, 1, 7>(
         p3m.params.cao, p3m, force_prefac,
-        boost::combine(p_q_range, p_force_range));
+        std::span<Particle *const>(charged_particles));
 
     // add dipole forces
     // Eq. (3.19) @cite deserno00b
@@ -591,6 +658,247 @@ double CoulombP3MImpl<FloatType, Architecture>::long_range_kernel(
   return 0.;
 }
 
+namespace {
+template <int cao> struct MeshPotential {
+  double operator()(auto const &p3m, Utils::Vector3d const &pos) const {
+    auto const w = p3m_calculate_interpolation_weights<cao>(
+        pos, p3m.params.ai, p3m.local_mesh);
+    auto potential = 0.;
+    p3m_interpolate(p3m.local_mesh, w, [&potential, &p3m](int ind, double w) {
+      potential += w * double(p3m.mesh_potential[ind]);
+    });
+    return potential;
+  }
+};
+
+/**
+ * @brief Mesh energy of a few charges among themselves.
+ *
+ * Calculates @f$ \sum_{s,t} q_s q_t W_s \cdot G * W_t @f$, where
+ * @f$ W_s @f$ is the charge assignment of charge @f$ s @f$ on the global
+ * mesh and @f$ G @f$ the energy influence function in real space.
+ */
+template <int cao> struct MeshPairEnergy {
+  double operator()(auto const &p3m, std::span<double const> charges,
+                    std::span<Utils::Vector3d const> positions) const {
+    struct Site {
+      double q;
+      Utils::Vector3i corner;
+      std::array<double, Utils::int_pow<3>(cao)> w;
+    };
+    auto const &mesh = p3m.params.mesh;
+    auto const pos_shift = std::floor((cao - 1) / 2.0) - (cao % 2) / 2.0;
+
+    std::vector<Site> sites(charges.size());
+    for (std::size_t s = 0ul; s < sites.size(); ++s) {
+      auto &site = sites[s];
+      std::array<Utils::Array<double, cao>, 3u> w;
+      for (unsigned int d = 0u; d < 3u; d++) {
+        auto const pos = positions[s][d] * p3m.params.ai[d] -
+                         p3m.params.mesh_off[d] - pos_shift;
+        auto const corner = std::floor(pos);
+        site.corner[d] = static_cast<int>(corner);
+        for (int i = 0; i < cao; i++) {
+          w[d][i] = Utils::bspline<cao>(i, (pos - corner) - 0.5);
+        }
+      }
+      auto it = site.w.begin();
+      for (int i0 = 0; i0 < cao; i0++) {
+        for (int i1 = 0; i1 < cao; i1++) {
+          for (int i2 = 0; i2 < cao; i2++) {
+            *it++ = w[0u][i0] * w[1u][i1] * w[2u][i2];
+          }
+        }
+      }
+      site.q = charges[s];
+    }
+
+    auto const wrap = [&mesh](int i, unsigned int d) {
+      return (i % mesh[d] + mesh[d]) % mesh[d];
+    };
+    auto const &g = p3m.g_energy_real_space;
+    auto energy = 0.;
+    for (auto const &s : sites) {
+      for (auto const &t : sites) {
+        auto const offset = s.corner - t.corner;
+        auto pair_energy = 0.;
+        auto ws = s.w.begin();
+        for (int i0 = 0; i0 < cao; i0++) {
+          for (int i1 = 0; i1 < cao; i1++) {
+            for (int i2 = 0; i2 < cao; i2++) {
+              auto wt = t.w.begin();
+              for (int j0 = 0; j0 < cao; j0++) {
+                auto const m0 = wrap(offset[0] + i0 - j0, 0u);
+                for (int j1 = 0; j1 < cao; j1++) {
+                  auto const m1 = wrap(offset[1] + i1 - j1, 1u);
+                  auto const row = (m0 * mesh[1] + m1) * mesh[2];
+                  for (int j2 = 0; j2 < cao; j2++) {
+                    auto const m2 = wrap(offset[2] + i2 - j2, 2u);
+                    pair_energy += *ws * *wt++ * g[row + m2];
+                  }
+                }
+              }
+              ++ws;
+            }
+          }
+        }
+        energy += s.q * t.q * pair_energy;
+      }
+    }
+    return energy;
+  }
+};
+} // namespace
+
+template <typename FloatType, Arch Architecture>
+void CoulombP3MImpl<FloatType,
+                    Architecture>::calc_influence_function_energy_real_space() {
+  auto const &local_mesh = p3m.local_mesh;
+  auto const &mesh = p3m.params.mesh;
+  auto const data = p3m.fft_buffers->get_scalar_mesh();
+  auto const ks_mesh_length = Utils::product(p3m.mesh.size);
+  for (int i = 0; i < ks_mesh_length; i++) {
+    data[2 * i + 0] = p3m.g_energy[i];
+    data[2 * i + 1] = FloatType(0);
+  }
+  p3m.fft->backward_fft(data);
+
+  auto const mesh_length = Utils::product(mesh);
+  std::vector<double> local_values(static_cast<std::size_t>(mesh_length), 0.);
+  for (int i0 = local_mesh.in_ld[0]; i0 < local_mesh.in_ur[0]; ++i0) {
+    for (int i1 = local_mesh.in_ld[1]; i1 < local_mesh.in_ur[1]; ++i1) {
+      for (int i2 = local_mesh.in_ld[2]; i2 < local_mesh.in_ur[2]; ++i2) {
+        auto const local_index = Utils::Vector3i{i0, i1, i2};
+        auto const global_index =
+            local_index + Utils::Vector3i(local_mesh.ld_ind);
+        local_values[Utils::get_linear_index(global_index, mesh,
+                                             Utils::MemoryOrder::ROW_MAJOR)] =
+            double(data[Utils::get_linear_index(
+                local_index, local_mesh.dim, Utils::MemoryOrder::ROW_MAJOR)]);
+      }
+    }
+  }
+  p3m.g_energy_real_space.resize(local_values.size());
+  boost::mpi::all_reduce(comm_cart, local_values.data(), mesh_length,
+                         p3m.g_energy_real_space.data(), std::plus<>());
+}
+
+template <typename FloatType, Arch Architecture>
+FloatType const *
+CoulombP3MImpl<FloatType, Architecture>::calc_mesh_potential() {
+  p3m.fft_buffers->perform_scalar_halo_gather();
+  p3m.fft->forward_fft(p3m.fft_buffers->get_scalar_mesh());
+  p3m.update_mesh_views();
+  auto const mesh_length = Utils::product(p3m.mesh.size);
+  for (int i = 0; i < mesh_length; i++) {
+    p3m.mesh.rs_scalar[2 * i + 0] *= p3m.g_energy[i];
+    p3m.mesh.rs_scalar[2 * i + 1] *= p3m.g_energy[i];
+  }
+  p3m.fft->backward_fft(p3m.fft_buffers->get_scalar_mesh());
+  p3m.fft_buffers->perform_scalar_halo_spread();
+  return p3m.fft_buffers->get_scalar_mesh();
+}
+
+template <typename FloatType, Arch Architecture>
+void CoulombP3MImpl<FloatType, Architecture>::prepare_energy_difference(
+    ParticleRange const &particles) {
+  assert(Architecture == Arch::CPU);
+  assert(p3m.params.epsilon == P3M_EPSILON_METALLIC);
+  /* the real-space influence function only depends on the parameters */
+  auto const params =
+      std::make_tuple(p3m.params.mesh, p3m.params.cao, p3m.params.alpha_L,
+                      get_system().box_geo->length());
+  if (p3m.g_energy_real_space.empty() or
+      params != p3m.g_energy_real_space_params) {
+    calc_influence_function_energy_real_space();
+    p3m.g_energy_real_space_params = params;
+  }
+
+  charge_assign(particles);
+  auto const potential = calc_mesh_potential();
+  p3m.mesh_potential.assign(potential, potential + p3m.local_mesh.size);
+
+  auto const local_q = std::accumulate(
+      p3m.ca_charges.begin(), p3m.ca_charges.end(), 0.);
+  p3m.mesh_potential_sum_q =
+      boost::mpi::all_reduce(comm_cart, local_q, std::plus<>());
+}
+
+template <typename FloatType, Arch Architecture>
+void CoulombP3MImpl<FloatType, Architecture>::update_energy_difference(
+    std::span<Coulomb::ChargeSite const> removed,
+    std::span<Coulomb::ChargeSite const> added) {
+  assert(Architecture == Arch::CPU);
+  assert(p3m.mesh_potential.size() ==
+         static_cast<std::size_t>(p3m.local_mesh.size));
+  /* only the charge change is assigned, the linearity of the convolution
+   * yields the potential of the new state */
+  prepare_fft_mesh(false);
+  auto local_delta_q = 0.;
+  for (auto const &site : removed) {
+    assign_charge(-site.q, site.pos, true);
+    local_delta_q -= site.q;
+  }
+  for (auto const &site : added) {
+    assign_charge(site.q, site.pos, true);
+    local_delta_q += site.q;
+  }
+  auto const potential = calc_mesh_potential();
+  for (int i = 0; i < p3m.local_mesh.size; i++) {
+    p3m.mesh_potential[i] += potential[i];
+  }
+  p3m.mesh_potential_sum_q +=
+      boost::mpi::all_reduce(comm_cart, local_delta_q, std::plus<>());
+}
+
+template <typename FloatType, Arch Architecture>
+double CoulombP3MImpl<FloatType, Architecture>::mesh_potential(
+    Utils::Vector3d const &pos) const {
+  assert(not p3m.mesh_potential.empty());
+  return Utils::integral_parameter<int, MeshPotential, 1, 7>(p3m.params.cao,
+                                                             p3m, pos);
+}
+
+template <typename FloatType, Arch Architecture>
+double CoulombP3MImpl<FloatType, Architecture>::long_range_energy_difference(
+    std::span<Coulomb::ChargeSite const> removed,
+    std::span<Coulomb::ChargeSite const> added) {
+  auto const volume = get_system().box_geo->volume();
+  std::vector<double> charges;
+  std::vector<Utils::Vector3d> positions;
+  auto energy = 0.;
+  auto delta_q = 0.;
+  auto delta_q2 = 0.;
+  auto const add_sites = [&](std::span<Coulomb::ChargeSite const> sites,
+                             double sign) {
+    for (auto const &site : sites) {
+      charges.emplace_back(sign * site.q);
+      positions.emplace_back(site.pos);
+      energy += sign * site.q * site.potential / volume;
+      delta_q += sign * site.q;
+      delta_q2 += sign * Utils::sqr(site.q);
+    }
+  };
+  add_sites(removed, -1.);
+  add_sites(added, +1.);
+  if (charges.empty()) {
+    return 0.;
+  }
+
+  /* interaction of the changed charges among themselves */
+  energy += Utils::integral_parameter<int, MeshPairEnergy, 1, 7>(
+                p3m.params.cao, p3m, std::span<double const>(charges),
+                std::span<Utils::Vector3d const>(positions)) /
+            (2. * volume);
+  /* self energy correction */
+  energy -= delta_q2 * p3m.params.alpha * std::numbers::inv_sqrtpi;
+  /* net charge correction */
+  auto const sum_q = p3m.mesh_potential_sum_q;
+  energy -= (Utils::sqr(sum_q + delta_q) - Utils::sqr(sum_q)) *
+            std::numbers::pi / (2. * volume * Utils::sqr(p3m.params.alpha));
+  return prefactor * energy;
+}
+
 template <typename FloatType, Arch Architecture>
 class CoulombTuningAlgorithm : public TuningAlgorithm {
   p3m_data_struct_coulomb<FloatType> &p3m;
@@ -39,6 +39,7 @@
 #ifdef P3M
 
 #include "electrostatics/actor.hpp"
+#include "electrostatics/solver.hpp"
 
 #include "p3m/common.hpp"
 #include "p3m/data_struct.hpp"
@@ -50,6 +51,7 @@
 
 #include <cmath>
 #include <numbers>
+#include <span>
 
 /** @brief P3M solver. */
 struct CoulombP3M : public Coulomb::Actor<CoulombP3M> {
@@ -188,6 +190,47 @@ public:
   /** Compute the k-space part of forces. */
   virtual void add_long_range_forces(ParticleRange const &) = 0;
 
+  /**
+   * @brief Calculate the mesh potential of the current charge distribution,
+   * which is needed by @ref long_range_energy_difference.
+   */
+  virtual void prepare_energy_difference(ParticleRange const &) = 0;
+
+  /**
+   * @brief Mesh potential at a position inside the local domain.
+   * Only valid after @ref prepare_energy_difference.
+   */
+  virtual double mesh_potential(Utils::Vector3d const &pos) const = 0;
+
+  /**
+   * @brief Change of the k-space energy when the charges @p removed are
+   * replaced by the charges @p added.
+   *
+   * With the charge assignment @f$ \rho @f$ of the state prepared by
+   * @ref prepare_energy_difference, the mesh potential
+   * @f$ \phi = G * \rho @f$ and the mesh representation @f$ \delta\rho @f$
+   * of the charge change, the energy difference is
+   * @f$ \delta\rho \cdot \phi + \frac{1}{2} \delta\rho \cdot G *
+   * \delta\rho @f$, plus the change of the self energy and of the net
+   * charge correction. The first term is given by the potentials stored
+   * in the charge sites, the second term only couples the few changed
+   * charges via the real-space representation of the influence function.
+   * Only available on the CPU and with metallic boundary conditions.
+   */
+  virtual double
+  long_range_energy_difference(std::span<Coulomb::ChargeSite const> removed,
+                               std::span<Coulomb::ChargeSite const> added) = 0;
+
+  /**
+   * @brief Add the potential @f$ G * \delta\rho @f$ of an accepted charge
+   * change to the mesh potential of @ref prepare_energy_difference, such
+   * that it describes the new state without a new charge assignment of all
+   * particles. Each rank passes the changed charges of its local domain.
+   */
+  virtual void
+  update_energy_difference(std::span<Coulomb::ChargeSite const> removed,
+                           std::span<Coulomb::ChargeSite const> added) = 0;
+
 protected:
   virtual void calc_influence_function_force() = 0;
   virtual void calc_influence_function_energy() = 0;
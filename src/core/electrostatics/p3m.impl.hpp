@@ -36,9 +36,12 @@
 #include <utils/Vector.hpp>
 
 #include <memory>
+#include <span>
 #include <stdexcept>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 template <typename FloatType>
 struct p3m_data_struct_coulomb : public p3m_data_struct<FloatType> {
@@ -52,6 +55,22 @@ struct p3m_data_struct_coulomb : public p3m_data_struct<FloatType> {
   double square_sum_q = 0.;
 
   p3m_interpolation_cache inter_weights;
+  /** Tiles of the charged particles for the parallel charge assignment. */
+  p3m_interpolation_tiles inter_tiles;
+  /** Charges of the charged particles, in the order of the cache. */
+  std::vector<double> ca_charges;
+  /** Positions of the charged particles, in the order of the cache. */
+  std::vector<Utils::Vector3d> ca_positions;
+
+  /** Mesh potential of the local charge assignment mesh. */
+  std::vector<FloatType> mesh_potential;
+  /** Sum of charges of the state the mesh potential was calculated for. */
+  double mesh_potential_sum_q = 0.;
+  /** Energy influence function in real space, on the full global mesh. */
+  std::vector<double> g_energy_real_space;
+  /** Mesh, cao, alpha_L and box length of @ref g_energy_real_space. */
+  std::tuple<Utils::Vector3i, int, double, Utils::Vector3d>
+      g_energy_real_space_params;
 };
 
 #ifdef CUDA
@@ -155,6 +174,15 @@ public:
 
   Utils::Vector9d long_range_pressure(ParticleRange const &particles) override;
 
+  void prepare_energy_difference(ParticleRange const &particles) override;
+  double mesh_potential(Utils::Vector3d const &pos) const override;
+  double long_range_energy_difference(
+      std::span<Coulomb::ChargeSite const> removed,
+      std::span<Coulomb::ChargeSite const> added) override;
+  void update_energy_difference(
+      std::span<Coulomb::ChargeSite const> removed,
+      std::span<Coulomb::ChargeSite const> added) override;
+
   void charge_assign(ParticleRange const &particles) override;
   void assign_charge(double q, Utils::Vector3d const &real_pos,
                      bool skip_cache) override;
@@ -173,6 +201,12 @@ protected:
                            ParticleRange const &particles);
   void calc_influence_function_force() override;
   void calc_influence_function_energy() override;
+  void calc_influence_function_energy_real_space();
+  /**
+   * @brief Convolve the charge assignment mesh with the energy influence
+   * function. Overwrites the charge assignment mesh with the potential.
+   */
+  FloatType const *calc_mesh_potential();
   void scaleby_box_l() override;
   void init_cpu_kernels();
 #ifdef CUDA
@@ -32,10 +32,25 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <type_traits>
 
 namespace Coulomb {
 
+#ifdef ELECTROSTATICS
+/** @brief Charge changed by a Monte Carlo move. */
+struct ChargeSite {
+  double q;
+  Utils::Vector3d pos;
+  /** Long-range potential at @ref pos before the move. */
+  double potential;
+
+  template <class Archive> void serialize(Archive &ar, long int) {
+    ar & q & pos & potential;
+  }
+};
+#endif // ELECTROSTATICS
+
 struct Solver {
 #ifdef ELECTROSTATICS
   struct Implementation;
@@ -49,6 +64,8 @@ struct Solver {
 
   void sanity_checks() const;
   double cutoff() const;
+  /** @brief Whether the long-range forces are calculated on the GPU. */
+  bool has_gpu_long_range_forces() const;
 
   void on_observable_calc();
   void on_coulomb_change();
@@ -60,6 +77,32 @@ struct Solver {
 
   void calc_long_range_force(ParticleRange const &particles) const;
   double calc_energy_long_range(ParticleRange const &particles) const;
+
+  /**
+   * @brief Whether the long-range energy change of a few charges can be
+   * calculated without a full energy calculation.
+   */
+  bool has_long_range_energy_difference() const;
+  /** @brief Set up the long-range potential of the current system state. */
+  void prepare_energy_difference(ParticleRange const &particles) const;
+  /** @brief Long-range potential at a position inside the local domain. */
+  double calc_long_range_potential(Utils::Vector3d const &pos) const;
+  /**
+   * @brief Long-range energy change when the charges @p removed are
+   * replaced by the charges @p added, relative to the state set up by
+   * @ref prepare_energy_difference.
+   */
+  double calc_energy_difference_long_range(
+      std::span<ChargeSite const> removed,
+      std::span<ChargeSite const> added) const;
+  /**
+   * @brief Update the long-range potential set up by
+   * @ref prepare_energy_difference after an accepted move, which replaced
+   * the charges @p removed by the charges @p added. Each rank passes the
+   * changed charges of its local domain.
+   */
+  void update_energy_difference(std::span<ChargeSite const> removed,
+                                std::span<ChargeSite const> added) const;
   Solver();
 #else  // ELECTROSTATICS
   Solver() = default;
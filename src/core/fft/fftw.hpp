@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2010-2024 The ESPResSo project
+ * Copyright (C) 2002,2003,2004,2005,2006,2007,2008,2009,2010
+ *   Max-Planck-Institute for Polymer Research, Theory Group
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/** \file
+ *  Precision-dependent aliases of the FFTW3 functions.
+ *  Only include this header in the FFT translation units.
+ */
+
+#include <fftw3.h>
+
+namespace fft {
+
+template <typename FloatType = double> struct fftw {
+  using complex = fftw_complex;
+  static auto constexpr plan_many_dft = fftw_plan_many_dft;
+  static auto constexpr destroy_plan = fftw_destroy_plan;
+  static auto constexpr execute_dft = fftw_execute_dft;
+  static auto constexpr malloc = fftw_malloc;
+  static auto constexpr free = fftw_free;
+};
+template <> struct fftw<float> {
+  using complex = fftwf_complex;
+  static auto constexpr plan_many_dft = fftwf_plan_many_dft;
+  static auto constexpr destroy_plan = fftwf_destroy_plan;
+  static auto constexpr execute_dft = fftwf_execute_dft;
+  static auto constexpr malloc = fftwf_malloc;
+  static auto constexpr free = fftwf_free;
+};
+
+} // namespace fft
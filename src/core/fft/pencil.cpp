@@ -0,0 +1,609 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** \file
+ *
+ *  Pencil-decomposed 3D-FFT, see pencil.hpp.
+ */
+
+#include "pencil.hpp"
+#include "fft.hpp"
+#include "fftw.hpp"
+#include "vector.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <boost/mpi/collectives/all_gather.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/datatype.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/** @name MPI tags for FFT communication */
+/**@{*/
+/** Tag for communication in block_to_pencil() */
+#define REQ_FFT_PENCIL_FORW 303
+/** Tag for communication in pencil_to_block() */
+#define REQ_FFT_PENCIL_BACK 304
+/**@}*/
+
+namespace fft {
+
+/** Number of chunks of x-planes in which the transposes are split. */
+static constexpr int n_chunks = 4;
+
+std::array<int, 2u> pencil_grid(int n_nodes) {
+  auto p1 = 1;
+  while ((p1 + 1) * (p1 + 1) <= n_nodes) {
+    ++p1;
+  }
+  while (n_nodes % p1 != 0) {
+    --p1;
+  }
+  return {p1, n_nodes / p1};
+}
+
+std::array<int, 2u> pencil_split(int n, int parts, int i) {
+  auto const quot = n / parts;
+  auto const rem = n % parts;
+  return {i * quot + std::min(i, rem), quot + ((i < rem) ? 1 : 0)};
+}
+
+namespace {
+
+pencil_box intersection(pencil_box const &a, pencil_box const &b) {
+  pencil_box box;
+  for (unsigned int i = 0u; i < 3u; ++i) {
+    box.start[i] = std::max(a.start[i], b.start[i]);
+    auto const stop = std::min(a.start[i] + a.size[i], b.start[i] + b.size[i]);
+    box.size[i] = std::max(stop - box.start[i], 0);
+  }
+  return box;
+}
+
+/**
+ * @brief Visit a box of mesh points in row-major order.
+ * The kernel is called with the index of the point in the box and
+ * its index in the mesh, which has the given strides.
+ */
+template <class Kernel>
+void for_each_box(Utils::Vector3i const &start, Utils::Vector3i const &size,
+                  Utils::Vector3i const &strides, Kernel &&kernel) {
+  int index = 0;
+  for (int i = 0; i < size[0]; ++i) {
+    for (int j = 0; j < size[1]; ++j) {
+      auto mesh_index =
+          (start[0] + i) * strides[0] + (start[1] + j) * strides[1] +
+          start[2] * strides[2];
+      for (int k = 0; k < size[2]; ++k) {
+        kernel(index++, mesh_index);
+        mesh_index += strides[2];
+      }
+    }
+  }
+}
+
+/** @brief Compute the displacements and chunk offsets from the counts. */
+void calc_displacements(pencil_transpose &t) {
+  auto const calc = [](std::vector<std::vector<int>> const &counts,
+                       std::vector<std::vector<int>> &displs,
+                       std::vector<int> &offset) {
+    displs.resize(counts.size());
+    offset.resize(counts.size() + 1u);
+    offset[0] = 0;
+    for (std::size_t c = 0u; c < counts.size(); ++c) {
+      displs[c].resize(counts[c].size());
+      auto total = 0;
+      for (std::size_t j = 0u; j < counts[c].size(); ++j) {
+        displs[c][j] = total;
+        total += counts[c][j];
+      }
+      offset[c + 1u] = offset[c] + total;
+    }
+  };
+  calc(t.send_counts, t.send_displs, t.send_offset);
+  calc(t.recv_counts, t.recv_displs, t.recv_offset);
+}
+
+/**
+ * @brief Start the all-to-all communication of one chunk of a transpose.
+ * The backward transpose swaps the roles of the send and receive buffers.
+ */
+template <typename FloatType>
+void post_transpose(boost::mpi::communicator const &comm,
+                    pencil_transpose const &t, int chunk, bool backward,
+                    FloatType const *send_buf, FloatType *recv_buf,
+                    MPI_Request &request) {
+  auto const type = boost::mpi::get_mpi_datatype<FloatType>(FloatType{});
+  auto const c = static_cast<std::size_t>(chunk);
+  auto const &send_counts = backward ? t.recv_counts[c] : t.send_counts[c];
+  auto const &send_displs = backward ? t.recv_displs[c] : t.send_displs[c];
+  auto const &recv_counts = backward ? t.send_counts[c] : t.recv_counts[c];
+  auto const &recv_displs = backward ? t.send_displs[c] : t.recv_displs[c];
+  auto const send_offset = backward ? t.recv_offset[c] : t.send_offset[c];
+  auto const recv_offset = backward ? t.send_offset[c] : t.recv_offset[c];
+  MPI_Ialltoallv(send_buf + send_offset, send_counts.data(),
+                 send_displs.data(), type, recv_buf + recv_offset,
+                 recv_counts.data(), recv_displs.data(), type, comm, &request);
+}
+
+/** @brief Drive the progress of the pending communication. */
+void poke(std::vector<MPI_Request> &requests, int n_posted) {
+  int flag;
+  MPI_Testall(n_posted, requests.data(), &flag, MPI_STATUSES_IGNORE);
+}
+
+template <typename FloatType>
+void execute(fft_plan<FloatType> const &plan, FloatType *data) {
+  if (plan.plan_handle) {
+    auto *c_data = reinterpret_cast<typename fftw<FloatType>::complex *>(data);
+    fftw<FloatType>::execute_dft(plan.plan_handle, c_data, c_data);
+  }
+}
+
+template <typename FloatType>
+void create_plan(fft_plan<FloatType> &plan, int dir, int n, int howmany,
+                 FloatType *scratch) {
+  plan.destroy_plan();
+  plan.dir = dir;
+  if (n * howmany == 0) {
+    return;
+  }
+  auto *c_data =
+      reinterpret_cast<typename fftw<FloatType>::complex *>(scratch);
+  /* plans are executed on several mesh planes, which may not share
+   * the alignment of the scratch buffer */
+  plan.plan_handle = fftw<FloatType>::plan_many_dft(
+      1, &n, howmany, c_data, nullptr, 1, n, c_data, nullptr, 1, n, dir,
+      FFTW_PATIENT | FFTW_UNALIGNED);
+  assert(plan.plan_handle);
+}
+
+} // namespace
+
+template <typename FloatType>
+fft_pencil_struct<FloatType>::fft_pencil_struct(decltype(m_mpi_env) mpi_env)
+    : m_mpi_env{std::move(mpi_env)} {}
+
+template <typename FloatType>
+fft_pencil_struct<FloatType>::~fft_pencil_struct() = default;
+
+template <typename FloatType>
+int fft_pencil_struct<FloatType>::initialize_fft(
+    boost::mpi::communicator const &comm,
+    Utils::Vector3i const &global_mesh_dim, Utils::Vector3i const &inner_start,
+    Utils::Vector3i const &inner_size, Utils::Vector3i const &ca_mesh_dim,
+    Utils::Vector3i const &ca_mesh_offset) {
+  auto const &n = global_mesh_dim;
+  m_mesh = global_mesh_dim;
+  m_ca_mesh_dim = ca_mesh_dim;
+  m_ca_mesh_offset = ca_mesh_offset;
+
+  /* === process grid === */
+  auto const [p1, p2] = pencil_grid(comm.size());
+  auto const grid_pos = [p2 = p2](int rank) {
+    return std::array<int, 2u>{rank / p2, rank % p2};
+  };
+  auto const [row, col] = grid_pos(comm.rank());
+  m_comm = std::make_unique<boost::mpi::communicator>(comm);
+  m_row_comm = std::make_unique<boost::mpi::communicator>(comm.split(row, col));
+  m_col_comm = std::make_unique<boost::mpi::communicator>(comm.split(col, row));
+
+  /* === pencils === */
+  auto const z_pencil = [&, p1 = p1, p2 = p2](int rank) {
+    auto const [i, j] = grid_pos(rank);
+    auto const [x0, nx] = pencil_split(n[0], p1, i);
+    auto const [y0, ny] = pencil_split(n[1], p2, j);
+    return pencil_box{{x0, y0, 0}, {nx, ny, n[2]}};
+  };
+  m_z_pencil = z_pencil(comm.rank());
+  {
+    auto const [z0, nz] = pencil_split(n[2], p2, col);
+    auto const [y0, ny] = pencil_split(n[1], p1, row);
+    m_y_pencil = pencil_box{{m_z_pencil.start[0], 0, z0},
+                            {m_z_pencil.size[0], n[1], nz}};
+    m_x_pencil = pencil_box{{0, y0, z0}, {n[0], ny, nz}};
+  }
+  auto const nx = m_z_pencil.size[0];
+  auto const ny = m_z_pencil.size[1];
+  auto const nz = m_y_pencil.size[2];
+  auto const nyy = m_x_pencil.size[1];
+
+  /* === real-space mesh to z-pencil === */
+  std::vector<int> blocks(6ul * static_cast<std::size_t>(comm.size()));
+  {
+    std::array<int, 6u> const block = {inner_start[0], inner_start[1],
+                                       inner_start[2], inner_size[0],
+                                       inner_size[1],  inner_size[2]};
+    boost::mpi::all_gather(comm, block.data(), 6, blocks.data());
+  }
+  auto const get_block = [&blocks](int rank) {
+    auto const *b = &blocks[6ul * static_cast<std::size_t>(rank)];
+    return pencil_box{{b[0], b[1], b[2]}, {b[3], b[4], b[5]}};
+  };
+  m_block = get_block(comm.rank());
+  m_block_sends.clear();
+  m_block_recvs.clear();
+  auto n_send = 0;
+  auto n_recv = 0;
+  for (int rank = 0; rank < comm.size(); ++rank) {
+    auto const send_box = intersection(m_block, z_pencil(rank));
+    if (Utils::product(send_box.size) > 0) {
+      m_block_sends.emplace_back(rank, send_box);
+      n_send += Utils::product(send_box.size);
+    }
+    auto const recv_box = intersection(get_block(rank), m_z_pencil);
+    if (Utils::product(recv_box.size) > 0) {
+      m_block_recvs.emplace_back(rank, recv_box);
+      n_recv += Utils::product(recv_box.size);
+    }
+  }
+  /* the backward FFT sends the received blocks back */
+  m_send_buf.resize(static_cast<std::size_t>(std::max(n_send, n_recv)));
+  m_recv_buf.resize(static_cast<std::size_t>(std::max(n_send, n_recv)));
+
+  /* === transposes === */
+  m_zy = {};
+  m_yx = {};
+  for (int c = 0; c < n_chunks; ++c) {
+    auto const cnx = pencil_split(nx, n_chunks, c)[1];
+    auto &zy_send = m_zy.send_counts.emplace_back();
+    auto &zy_recv = m_zy.recv_counts.emplace_back();
+    for (int j = 0; j < p2; ++j) {
+      zy_send.push_back(2 * cnx * ny * pencil_split(n[2], p2, j)[1]);
+      zy_recv.push_back(2 * cnx * pencil_split(n[1], p2, j)[1] * nz);
+    }
+    auto &yx_send = m_yx.send_counts.emplace_back();
+    auto &yx_recv = m_yx.recv_counts.emplace_back();
+    for (int i = 0; i < p1; ++i) {
+      auto const nx_i = pencil_split(n[0], p1, i)[1];
+      auto const cnx_i = pencil_split(nx_i, n_chunks, c)[1];
+      yx_send.push_back(2 * cnx * nz * pencil_split(n[1], p1, i)[1]);
+      yx_recv.push_back(2 * cnx_i * nz * nyy);
+    }
+  }
+  calc_displacements(m_zy);
+  calc_displacements(m_yx);
+  m_zy_send_buf.resize(static_cast<std::size_t>(m_zy.send_offset.back()));
+  m_zy_recv_buf.resize(static_cast<std::size_t>(m_zy.recv_offset.back()));
+  m_yx_send_buf.resize(static_cast<std::size_t>(m_yx.send_offset.back()));
+  m_yx_recv_buf.resize(static_cast<std::size_t>(m_yx.recv_offset.back()));
+
+  /* === FFT Routines (Using FFTW / RFFTW package)=== */
+  auto const z_size = 2 * Utils::product(m_z_pencil.size);
+  auto const y_size = 2 * Utils::product(m_y_pencil.size);
+  auto const x_size = 2 * Utils::product(m_x_pencil.size);
+  m_z_buf.resize(static_cast<std::size_t>(z_size));
+  m_y_buf.resize(static_cast<std::size_t>(y_size));
+  {
+    fft::vector<FloatType> scratch(
+        static_cast<std::size_t>(std::max({z_size, y_size, x_size, 2})));
+    create_plan(forw[0], FFTW_FORWARD, n[2], ny, scratch.data());
+    create_plan(forw[1], FFTW_FORWARD, n[1], nz, scratch.data());
+    create_plan(forw[2], FFTW_FORWARD, n[0], nyy * nz, scratch.data());
+    create_plan(back[0], FFTW_BACKWARD, n[2], ny, scratch.data());
+    create_plan(back[1], FFTW_BACKWARD, n[1], nz, scratch.data());
+    create_plan(back[2], FFTW_BACKWARD, n[0], nyy * nz, scratch.data());
+  }
+
+  /* k-space data is stored in YZX order */
+  m_ks_size = {nyy, nz, n[0]};
+  m_ks_start = {m_x_pencil.start[1], m_x_pencil.start[2], 0};
+
+  return std::max(Utils::product(ca_mesh_dim), x_size);
+}
+
+template <typename FloatType>
+void fft_pencil_struct<FloatType>::block_to_pencil(FloatType const *data) {
+  auto const type = boost::mpi::get_mpi_datatype<FloatType>(FloatType{});
+  std::vector<MPI_Request> requests;
+  requests.reserve(m_block_sends.size() + m_block_recvs.size());
+  auto offset = 0;
+  for (auto const &[rank, box] : m_block_recvs) {
+    auto const size = Utils::product(box.size);
+    MPI_Irecv(m_recv_buf.data() + offset, size, type, rank,
+              REQ_FFT_PENCIL_FORW, *m_comm, &requests.emplace_back());
+    offset += size;
+  }
+  auto const ca_strides = Utils::Vector3i{
+      {m_ca_mesh_dim[1] * m_ca_mesh_dim[2], m_ca_mesh_dim[2], 1}};
+  offset = 0;
+  for (auto const &[rank, box] : m_block_sends) {
+    auto *const buf = m_send_buf.data() + offset;
+    for_each_box(box.start - m_block.start + m_ca_mesh_offset, box.size,
+                 ca_strides, [buf, data](int i, int j) { buf[i] = data[j]; });
+    auto const size = Utils::product(box.size);
+    MPI_Isend(buf, size, type, rank, REQ_FFT_PENCIL_FORW, *m_comm,
+              &requests.emplace_back());
+    offset += size;
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(),
+              MPI_STATUSES_IGNORE);
+
+  /* complexify the real data */
+  std::ranges::fill(m_z_buf, FloatType(0));
+  auto const z_strides =
+      Utils::Vector3i{{m_z_pencil.size[1] * m_mesh[2], m_mesh[2], 1}};
+  offset = 0;
+  for (auto const &[rank, box] : m_block_recvs) {
+    auto const *const buf = m_recv_buf.data() + offset;
+    auto *const z_buf = m_z_buf.data();
+    for_each_box(box.start - m_z_pencil.start, box.size, z_strides,
+                 [buf, z_buf](int i, int j) { z_buf[2 * j] = buf[i]; });
+    offset += Utils::product(box.size);
+  }
+}
+
+template <typename FloatType>
+void fft_pencil_struct<FloatType>::pencil_to_block(FloatType *data,
+                                                   bool check_complex) {
+  auto const type = boost::mpi::get_mpi_datatype<FloatType>(FloatType{});
+  std::vector<MPI_Request> requests;
+  requests.reserve(m_block_sends.size() + m_block_recvs.size());
+  auto offset = 0;
+  for (auto const &[rank, box] : m_block_sends) {
+    auto const size = Utils::product(box.size);
+    MPI_Irecv(m_recv_buf.data() + offset, size, type, rank,
+              REQ_FFT_PENCIL_BACK, *m_comm, &requests.emplace_back());
+    offset += size;
+  }
+  /* throw away the (hopefully) empty complex component */
+  if (check_complex) {
+    auto const n_points = static_cast<int>(m_z_buf.size() / 2ul);
+    for (int i = 0; i < n_points; i++) {
+      if (std::abs(m_z_buf[2 * i + 1]) > 1e-5) {
+        printf("Complex value is not zero (i=%d,data=%g)!!!\n", i,
+               m_z_buf[2 * i + 1]);
+        if (i > 100)
+          throw std::runtime_error("Complex value is not zero");
+      }
+    }
+  }
+  auto const z_strides =
+      Utils::Vector3i{{m_z_pencil.size[1] * m_mesh[2], m_mesh[2], 1}};
+  offset = 0;
+  for (auto const &[rank, box] : m_block_recvs) {
+    auto *const buf = m_send_buf.data() + offset;
+    auto const *const z_buf = m_z_buf.data();
+    for_each_box(box.start - m_z_pencil.start, box.size, z_strides,
+                 [buf, z_buf](int i, int j) { buf[i] = z_buf[2 * j]; });
+    auto const size = Utils::product(box.size);
+    MPI_Isend(buf, size, type, rank, REQ_FFT_PENCIL_BACK, *m_comm,
+              &requests.emplace_back());
+    offset += size;
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(),
+              MPI_STATUSES_IGNORE);
+
+  auto const ca_strides = Utils::Vector3i{
+      {m_ca_mesh_dim[1] * m_ca_mesh_dim[2], m_ca_mesh_dim[2], 1}};
+  offset = 0;
+  for (auto const &[rank, box] : m_block_sends) {
+    auto const *const buf = m_recv_buf.data() + offset;
+    for_each_box(box.start - m_block.start + m_ca_mesh_offset, box.size,
+                 ca_strides, [buf, data](int i, int j) { data[j] = buf[i]; });
+    offset += Utils::product(box.size);
+  }
+}
+
+template <typename FloatType>
+void fft_pencil_struct<FloatType>::forward_fft(FloatType *data) {
+  auto const &n = m_mesh;
+  auto const nx = m_z_pencil.size[0];
+  auto const ny = m_z_pencil.size[1];
+  auto const nz = m_y_pencil.size[2];
+  auto const nyy = m_x_pencil.size[1];
+  auto const [p1, p2] = pencil_grid(m_comm->size());
+  std::vector<MPI_Request> zy_requests(n_chunks, MPI_REQUEST_NULL);
+  std::vector<MPI_Request> yx_requests(n_chunks, MPI_REQUEST_NULL);
+
+  /* communication to z-pencil format (in is data) */
+  block_to_pencil(data);
+
+  /* ===== first direction  ===== */
+  for (int c = 0; c < n_chunks; ++c) {
+    auto const [cx0, cnx] = pencil_split(nx, n_chunks, c);
+    for (int x = cx0; x < cx0 + cnx; ++x) {
+      execute(forw[0], m_z_buf.data() + 2 * x * ny * n[2]);
+    }
+    auto const *const z_buf = m_z_buf.data();
+    auto const z_strides = Utils::Vector3i{{ny * n[2], n[2], 1}};
+    for (int j = 0; j < p2; ++j) {
+      auto const [z0, nz_j] = pencil_split(n[2], p2, j);
+      auto *const buf = m_zy_send_buf.data() + m_zy.send_offset[c] +
+                        m_zy.send_displs[c][j];
+      for_each_box({cx0, 0, z0}, {cnx, ny, nz_j}, z_strides,
+                   [buf, z_buf](int i, int k) {
+                     buf[2 * i] = z_buf[2 * k];
+                     buf[2 * i + 1] = z_buf[2 * k + 1];
+                   });
+    }
+    post_transpose(*m_row_comm, m_zy, c, false, m_zy_send_buf.data(),
+                   m_zy_recv_buf.data(), zy_requests[c]);
+    poke(zy_requests, c + 1);
+  }
+
+  /* ===== second direction ===== */
+  for (int c = 0; c < n_chunks; ++c) {
+    auto const [cx0, cnx] = pencil_split(nx, n_chunks, c);
+    MPI_Wait(&zy_requests[c], MPI_STATUS_IGNORE);
+    auto *const y_buf = m_y_buf.data();
+    auto const y_strides = Utils::Vector3i{{nz * n[1], 1, n[1]}};
+    for (int j = 0; j < p2; ++j) {
+      auto const [y0, ny_j] = pencil_split(n[1], p2, j);
+      auto const *const buf = m_zy_recv_buf.data() + m_zy.recv_offset[c] +
+                              m_zy.recv_displs[c][j];
+      for_each_box({cx0, y0, 0}, {cnx, ny_j, nz}, y_strides,
+                   [buf, y_buf](int i, int k) {
+                     y_buf[2 * k] = buf[2 * i];
+                     y_buf[2 * k + 1] = buf[2 * i + 1];
+                   });
+    }
+    for (int x = cx0; x < cx0 + cnx; ++x) {
+      execute(forw[1], m_y_buf.data() + 2 * x * nz * n[1]);
+    }
+    auto const send_strides = Utils::Vector3i{{nz * n[1], n[1], 1}};
+    for (int i = 0; i < p1; ++i) {
+      auto const [y0, ny_i] = pencil_split(n[1], p1, i);
+      auto *const buf = m_yx_send_buf.data() + m_yx.send_offset[c] +
+                        m_yx.send_displs[c][i];
+      for_each_box({cx0, 0, y0}, {cnx, nz, ny_i}, send_strides,
+                   [buf, y_buf](int l, int k) {
+                     buf[2 * l] = y_buf[2 * k];
+                     buf[2 * l + 1] = y_buf[2 * k + 1];
+                   });
+    }
+    post_transpose(*m_col_comm, m_yx, c, false, m_yx_send_buf.data(),
+                   m_yx_recv_buf.data(), yx_requests[c]);
+    poke(zy_requests, n_chunks);
+    poke(yx_requests, c + 1);
+  }
+
+  /* ===== third direction  ===== */
+  auto const x_strides = Utils::Vector3i{{1, n[0], nz * n[0]}};
+  for (int c = 0; c < n_chunks; ++c) {
+    MPI_Wait(&yx_requests[c], MPI_STATUS_IGNORE);
+    for (int i = 0; i < p1; ++i) {
+      auto const x0_i = pencil_split(n[0], p1, i)[0];
+      auto const nx_i = pencil_split(n[0], p1, i)[1];
+      auto const [cx0_i, cnx_i] = pencil_split(nx_i, n_chunks, c);
+      auto const *const buf = m_yx_recv_buf.data() + m_yx.recv_offset[c] +
+                              m_yx.recv_displs[c][i];
+      for_each_box({x0_i + cx0_i, 0, 0}, {cnx_i, nz, nyy}, x_strides,
+                   [buf, data](int l, int k) {
+                     data[2 * k] = buf[2 * l];
+                     data[2 * k + 1] = buf[2 * l + 1];
+                   });
+    }
+  }
+  execute(forw[2], data);
+
+  /* REMARK: Result has to be in data. */
+}
+
+template <typename FloatType>
+void fft_pencil_struct<FloatType>::backward_fft(FloatType *data,
+                                                bool check_complex) {
+  auto const &n = m_mesh;
+  auto const nx = m_z_pencil.size[0];
+  auto const ny = m_z_pencil.size[1];
+  auto const nz = m_y_pencil.size[2];
+  auto const nyy = m_x_pencil.size[1];
+  auto const [p1, p2] = pencil_grid(m_comm->size());
+  std::vector<MPI_Request> yx_requests(n_chunks, MPI_REQUEST_NULL);
+  std::vector<MPI_Request> zy_requests(n_chunks, MPI_REQUEST_NULL);
+
+  /* ===== third direction  ===== */
+  execute(back[2], data);
+  auto const x_strides = Utils::Vector3i{{1, n[0], nz * n[0]}};
+  for (int c = 0; c < n_chunks; ++c) {
+    for (int i = 0; i < p1; ++i) {
+      auto const x0_i = pencil_split(n[0], p1, i)[0];
+      auto const nx_i = pencil_split(n[0], p1, i)[1];
+      auto const [cx0_i, cnx_i] = pencil_split(nx_i, n_chunks, c);
+      auto *const buf = m_yx_recv_buf.data() + m_yx.recv_offset[c] +
+                        m_yx.recv_displs[c][i];
+      for_each_box({x0_i + cx0_i, 0, 0}, {cnx_i, nz, nyy}, x_strides,
+                   [buf, data](int l, int k) {
+                     buf[2 * l] = data[2 * k];
+                     buf[2 * l + 1] = data[2 * k + 1];
+                   });
+    }
+    post_transpose(*m_col_comm, m_yx, c, true, m_yx_recv_buf.data(),
+                   m_yx_send_buf.data(), yx_requests[c]);
+    poke(yx_requests, c + 1);
+  }
+
+  /* ===== second direction ===== */
+  for (int c = 0; c < n_chunks; ++c) {
+    auto const [cx0, cnx] = pencil_split(nx, n_chunks, c);
+    MPI_Wait(&yx_requests[c], MPI_STATUS_IGNORE);
+    auto *const y_buf = m_y_buf.data();
+    auto const recv_strides = Utils::Vector3i{{nz * n[1], n[1], 1}};
+    for (int i = 0; i < p1; ++i) {
+      auto const [y0, ny_i] = pencil_split(n[1], p1, i);
+      auto const *const buf = m_yx_send_buf.data() + m_yx.send_offset[c] +
+                              m_yx.send_displs[c][i];
+      for_each_box({cx0, 0, y0}, {cnx, nz, ny_i}, recv_strides,
+                   [buf, y_buf](int l, int k) {
+                     y_buf[2 * k] = buf[2 * l];
+                     y_buf[2 * k + 1] = buf[2 * l + 1];
+                   });
+    }
+    for (int x = cx0; x < cx0 + cnx; ++x) {
+      execute(back[1], m_y_buf.data() + 2 * x * nz * n[1]);
+    }
+    auto const y_strides = Utils::Vector3i{{nz * n[1], 1, n[1]}};
+    for (int j = 0; j < p2; ++j) {
+      auto const [y0, ny_j] = pencil_split(n[1], p2, j);
+      auto *const buf = m_zy_recv_buf.data() + m_zy.recv_offset[c] +
+                        m_zy.recv_displs[c][j];
+      for_each_box({cx0, y0, 0}, {cnx, ny_j, nz}, y_strides,
+                   [buf, y_buf](int i, int k) {
+                     buf[2 * i] = y_buf[2 * k];
+                     buf[2 * i + 1] = y_buf[2 * k + 1];
+                   });
+    }
+    post_transpose(*m_row_comm, m_zy, c, true, m_zy_recv_buf.data(),
+                   m_zy_send_buf.data(), zy_requests[c]);
+    poke(yx_requests, n_chunks);
+    poke(zy_requests, c + 1);
+  }
+
+  /* ===== first direction  ===== */
+  for (int c = 0; c < n_chunks; ++c) {
+    auto const [cx0, cnx] = pencil_split(nx, n_chunks, c);
+    MPI_Wait(&zy_requests[c], MPI_STATUS_IGNORE);
+    auto *const z_buf = m_z_buf.data();
+    auto const z_strides = Utils::Vector3i{{ny * n[2], n[2], 1}};
+    for (int j = 0; j < p2; ++j) {
+      auto const [z0, nz_j] = pencil_split(n[2], p2, j);
+      auto const *const buf = m_zy_send_buf.data() + m_zy.send_offset[c] +
+                              m_zy.send_displs[c][j];
+      for_each_box({cx0, 0, z0}, {cnx, ny, nz_j}, z_strides,
+                   [buf, z_buf](int i, int k) {
+                     z_buf[2 * k] = buf[2 * i];
+                     z_buf[2 * k + 1] = buf[2 * i + 1];
+                   });
+    }
+    for (int x = cx0; x < cx0 + cnx; ++x) {
+      execute(back[0], m_z_buf.data() + 2 * x * ny * n[2]);
+    }
+  }
+
+  /* communication to real-space mesh format (out is data) */
+  pencil_to_block(data, check_complex);
+
+  /* REMARK: Result has to be in data. */
+}
+
+template struct fft_pencil_struct<float>;
+template struct fft_pencil_struct<double>;
+
+} // namespace fft
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/** \file
+ *
+ *  Pencil-decomposed 3D-FFT.
+ *
+ *  The MPI ranks are arranged on a 2D process grid of size
+ *  @f$ P_1 \times P_2 @f$. Each rank holds a pencil of the mesh which is
+ *  complete along the direction of the current 1D-FFT and split along the
+ *  two other directions. The forward FFT goes through three pencil layouts,
+ *  all stored in row-major order:
+ *  - z-pencil: [x][y][z], x split over @f$ P_1 @f$, y split over @f$ P_2 @f$
+ *  - y-pencil: [x][z][y], x split over @f$ P_1 @f$, z split over @f$ P_2 @f$
+ *  - x-pencil: [y][z][x], y split over @f$ P_1 @f$, z split over @f$ P_2 @f$
+ *
+ *  The two transposes only involve the @f$ P_2 @f$ ranks of a row of the
+ *  process grid, resp. the @f$ P_1 @f$ ranks of a column, instead of all
+ *  ranks. Both transposes are split in chunks of x-planes and carried out
+ *  with non-blocking all-to-all communication, such that the 1D-FFTs of
+ *  one chunk overlap with the communication of the previous chunk.
+ *
+ *  The k-space data is stored in the x-pencil layout, which is the same
+ *  YZX order as in the legacy FFT (see fft.hpp).
+ */
+
+#include "fft.hpp"
+#include "vector.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace boost::mpi {
+class environment;
+class communicator;
+} // namespace boost::mpi
+
+namespace fft {
+
+/** @brief Data exchange of a transpose, split in chunks of x-planes. */
+struct pencil_transpose {
+  /** Send and receive counts in floating-point numbers, per chunk and rank. */
+  std::vector<std::vector<int>> send_counts, recv_counts;
+  /** Send and receive displacements relative to the chunk offset. */
+  std::vector<std::vector<int>> send_displs, recv_displs;
+  /** Offset of each chunk in the send and receive buffers. */
+  std::vector<int> send_offset, recv_offset;
+};
+
+/** @brief Box of mesh points in global mesh coordinates. */
+struct pencil_box {
+  Utils::Vector3i start;
+  Utils::Vector3i size;
+};
+
+template <typename FloatType> struct fft_pencil_struct {
+private:
+  /**
+   * @brief Handle to the MPI environment.
+   * Has to be the first member in the class definition, so that FFT plans
+   * and communicators are destroyed before the MPI environment expires.
+   */
+  std::shared_ptr<boost::mpi::environment> m_mpi_env;
+
+  /** Communicator of all ranks. */
+  std::unique_ptr<boost::mpi::communicator> m_comm;
+  /** Communicator of the ranks in the same row of the process grid. */
+  std::unique_ptr<boost::mpi::communicator> m_row_comm;
+  /** Communicator of the ranks in the same column of the process grid. */
+  std::unique_ptr<boost::mpi::communicator> m_col_comm;
+
+  /** Global mesh size. */
+  Utils::Vector3i m_mesh;
+  /** Local part of the real-space mesh in global mesh coordinates. */
+  pencil_box m_block;
+  /** Parts of the local real-space mesh that go to the z-pencil of a rank. */
+  std::vector<std::pair<int, pencil_box>> m_block_sends;
+  /** Parts of the local z-pencil that come from the real-space mesh of a
+   *  rank. */
+  std::vector<std::pair<int, pencil_box>> m_block_recvs;
+  /** Size of the local charge assignment mesh. */
+  Utils::Vector3i m_ca_mesh_dim;
+  /** Offset of the local mesh part in the charge assignment mesh. */
+  Utils::Vector3i m_ca_mesh_offset;
+  /** Local z-pencil, y-pencil and x-pencil in global mesh coordinates. */
+  pencil_box m_z_pencil, m_y_pencil, m_x_pencil;
+
+  /** Transpose z-pencil to y-pencil within a process grid row. */
+  pencil_transpose m_zy;
+  /** Transpose y-pencil to x-pencil within a process grid column. */
+  pencil_transpose m_yx;
+
+  /** Forward FFT plans along z, y and x. */
+  std::array<fft_plan<FloatType>, 3u> forw;
+  /** Backward FFT plans along z, y and x. */
+  std::array<fft_plan<FloatType>, 3u> back;
+
+  /** Mesh size and start of the local k-space mesh, in storage order. */
+  std::array<int, 3u> m_ks_size;
+  std::array<int, 3u> m_ks_start;
+
+  /** Complex z-pencil. */
+  fft::vector<FloatType> m_z_buf;
+  /** Complex y-pencil. */
+  fft::vector<FloatType> m_y_buf;
+  /** Communication buffers. */
+  std::vector<FloatType> m_send_buf, m_recv_buf;
+  std::vector<FloatType> m_zy_send_buf, m_zy_recv_buf;
+  std::vector<FloatType> m_yx_send_buf, m_yx_recv_buf;
+
+public:
+  explicit fft_pencil_struct(decltype(m_mpi_env) mpi_env);
+  ~fft_pencil_struct();
+
+  // disable copy construction: unsafe because we store raw pointers
+  // to FFT plans (avoids double-free and use-after-free)
+  fft_pencil_struct &operator=(fft_pencil_struct<FloatType> const &) = delete;
+  fft_pencil_struct(fft_pencil_struct<FloatType> const &) = delete;
+
+  /** Initialize everything connected to the 3D-FFT.
+   *
+   *  \param[in]  comm            MPI communicator.
+   *  \param[in]  global_mesh_dim Global CA mesh dimensions.
+   *  \param[in]  inner_start     Global index of the first local mesh point.
+   *  \param[in]  inner_size      Number of local mesh points.
+   *  \param[in]  ca_mesh_dim     Local CA mesh dimensions.
+   *  \param[in]  ca_mesh_offset  Index of the first local mesh point
+   *                              in the local CA mesh.
+   *  \return Maximal size of local fft mesh (needed for allocation of ca_mesh).
+   */
+  int initialize_fft(boost::mpi::communicator const &comm,
+                     Utils::Vector3i const &global_mesh_dim,
+                     Utils::Vector3i const &inner_start,
+                     Utils::Vector3i const &inner_size,
+                     Utils::Vector3i const &ca_mesh_dim,
+                     Utils::Vector3i const &ca_mesh_offset);
+
+  /** Perform an in-place forward 3D FFT.
+   *  \warning The content of \a data is overwritten.
+   *  \param[in,out] data  Mesh.
+   */
+  void forward_fft(FloatType *data);
+
+  /** Perform an in-place backward 3D FFT.
+   *  \warning The content of \a data is overwritten.
+   *  \param[in,out] data           Mesh.
+   *  \param[in]     check_complex  Throw an error if the complex component is
+   *                                non-zero.
+   */
+  void backward_fft(FloatType *data, bool check_complex);
+
+  auto const &get_mesh_size() const { return m_ks_size; }
+
+  auto const &get_mesh_start() const { return m_ks_start; }
+
+private:
+  void block_to_pencil(FloatType const *data);
+  void pencil_to_block(FloatType *data, bool check_complex);
+};
+
+/**
+ * @brief Process grid of the pencil decomposition.
+ * @param n_nodes  Number of MPI ranks.
+ * @return Most square grid @f$ P_1 \times P_2 @f$ with @f$ P_1 \leq P_2 @f$.
+ */
+std::array<int, 2u> pencil_grid(int n_nodes);
+
+/**
+ * @brief Balanced split of a mesh dimension.
+ * @param n      Number of mesh points.
+ * @param parts  Number of parts.
+ * @param i      Index of the part.
+ * @return First mesh point and number of mesh points of part @p i.
+ */
+std::array<int, 2u> pencil_split(int n, int parts, int i);
+
+} // namespace fft
@@ -29,6 +29,7 @@
 #include "ParticleRange.hpp"
 #include "PropagationMode.hpp"
 #include "bond_breakage/bond_breakage.hpp"
+#include "cell_system/BondTopology.hpp"
 #include "cell_system/CellStructure.hpp"
 #include "cells.hpp"
 #include "collision_detection/CollisionDetection.hpp"
@@ -55,6 +56,8 @@
 
 #include <boost/variant.hpp>
 
+#include <mpi.h>
+
 #ifdef CALIPER
 #include <caliper/cali.h>
 #endif
@@ -64,6 +67,7 @@
 #include <memory>
 #include <span>
 #include <variant>
+#include <vector>
 
 /** External particle forces */
 static ParticleForce external_force(Particle const &p) {
@@ -142,6 +146,7 @@ void System::System::calculate_forces() {
   if (coulomb.impl->extension) {
     if (auto icc = std::get_if<std::shared_ptr<ICCStar>>(
             get_ptr(coulomb.impl->extension))) {
+      cell_structure->ghosts_update_wait();
       (**icc).iteration(*cell_structure, particles, ghost_particles);
     }
   }
@@ -152,7 +157,11 @@ void System::System::calculate_forces() {
   init_forces(particles, ghost_particles);
   thermostat_force_init();
 
-  calc_long_range_forces(particles);
+  if (propagation->long_range_steps == 1) {
+    calc_long_range_forces(particles);
+  } else {
+    calc_long_range_impulse(particles, *propagation);
+  }
 
   auto const elc_kernel = coulomb.pair_force_elc_kernel();
   auto const coulomb_kernel = coulomb.pair_force_kernel();
@@ -175,37 +184,90 @@ void System::System::calculate_forces() {
   auto const collision_detection_cutoff = INACTIVE_CUTOFF;
 #endif
 
-  short_range_loop(
-      [coulomb_kernel_ptr = get_ptr(coulomb_kernel), &bonded_ias = *bonded_ias,
-       &bond_breakage = *bond_breakage, &box_geo = *box_geo](
-          Particle &p1, int bond_id, std::span<Particle *> partners) {
-        return add_bonded_force(p1, bond_id, partners, bonded_ias,
-                                bond_breakage, box_geo, coulomb_kernel_ptr);
-      },
-      [coulomb_kernel_ptr = get_ptr(coulomb_kernel),
-       dipoles_kernel_ptr = get_ptr(dipoles_kernel),
-       elc_kernel_ptr = get_ptr(elc_kernel), &nonbonded_ias = *nonbonded_ias,
-       &thermostat = *thermostat, &bonded_ias = *bonded_ias,
-#ifdef COLLISION_DETECTION
-       &collision_detection = *collision_detection,
+  /* The pair kernel can only be distributed among threads when it
+   * writes exclusively to the forces of the particle pair. */
+  auto thread_safe_pair_kernel = true;
+#ifdef NPT
+  if (propagation->used_propagations & PropagationMode::TRANS_LANGEVIN_NPT) {
+    thread_safe_pair_kernel = false; // accumulates the instantaneous virial
+  }
 #endif
-       &box_geo = *box_geo](Particle &p1, Particle &p2, Distance const &d) {
-        auto const &ia_params =
-            nonbonded_ias.get_ia_param(p1.type(), p2.type());
-        add_non_bonded_pair_force(p1, p2, d.vec21, sqrt(d.dist2), d.dist2,
-                                  ia_params, thermostat, box_geo, bonded_ias,
-                                  coulomb_kernel_ptr, dipoles_kernel_ptr,
-                                  elc_kernel_ptr);
 #ifdef COLLISION_DETECTION
-        if (not collision_detection.is_off()) {
-          collision_detection.detect_collision(p1, p2, d.dist2);
-        }
+  if (not collision_detection->is_off()) {
+    thread_safe_pair_kernel = false; // queues the detected collisions
+  }
 #endif
-      },
-      *cell_structure, maximal_cutoff(), bonded_ias->maximal_cutoff(),
-      VerletCriterion<>{*this, cell_structure->get_verlet_skin(),
+
+  /* The cluster pair kernel only handles central forces from Lennard-Jones,
+   * WCA and short-range electrostatics, and the DPD thermostat. */
+  auto const use_cluster_kernel =
+      cell_structure->use_verlet_list and thread_safe_pair_kernel and
+      nonbonded_ias->only_lj_wca() and not dipoles_kernel and not elc_kernel;
+
+  /* the bonds are evaluated on the cached topology, grouped by bond id */
+  auto const bond_kernel = [coulomb_kernel_ptr = get_ptr(coulomb_kernel),
+                            &bonded_ias = *bonded_ias,
+                            &bond_breakage = *bond_breakage,
+                            &box_geo = *box_geo](BondTopology::Group &group) {
+    add_bonded_group_forces(group, bonded_ias, bond_breakage, box_geo,
+                            coulomb_kernel_ptr);
+  };
+  auto const verlet_criterion =
+      VerletCriterion<>{*this, cell_structure->get_verlet_list_skin(),
                         get_interaction_range(), coulomb_cutoff, dipole_cutoff,
-                        collision_detection_cutoff});
+                        collision_detection_cutoff};
+
+  /* the short-range loop dominates the cost of the local particles,
+   * it is timed for the load balancing of the regular decomposition */
+  auto const tick = MPI_Wtime();
+  /* the pair kernels are specialized to the active potentials */
+  dispatch_nonbonded_potentials(
+      nonbonded_ias->active_potentials(), [&](auto potentials) {
+        using Potentials = decltype(potentials);
+        if (use_cluster_kernel) {
+          short_range_loop(
+              bond_kernel,
+              [coulomb_kernel_ptr = get_ptr(coulomb_kernel),
+               &nonbonded_ias = *nonbonded_ias, &thermostat = *thermostat,
+               &box_geo = *box_geo](
+                  ParticleArrays &arrays, ParticleArrays::index_type ci,
+                  ParticleArrays::index_type cj, auto const &df) {
+                add_cluster_pair_forces<Potentials::value>(
+                    arrays, ci, cj, df, nonbonded_ias, thermostat, box_geo,
+                    coulomb_kernel_ptr);
+              },
+              *cell_structure, maximal_cutoff(), bonded_ias->maximal_cutoff(),
+              verlet_criterion, thread_safe_pair_kernel);
+        } else {
+          short_range_loop(
+              bond_kernel,
+              [coulomb_kernel_ptr = get_ptr(coulomb_kernel),
+               dipoles_kernel_ptr = get_ptr(dipoles_kernel),
+               elc_kernel_ptr = get_ptr(elc_kernel),
+               &nonbonded_ias = *nonbonded_ias, &thermostat = *thermostat,
+               &bonded_ias = *bonded_ias,
+#ifdef COLLISION_DETECTION
+               &collision_detection = *collision_detection,
+#endif
+               &box_geo = *box_geo](Particle &p1, Particle &p2,
+                                    Distance const &d) {
+                auto const &ia_params =
+                    nonbonded_ias.get_ia_param_flat(p1.type(), p2.type());
+                add_non_bonded_pair_force<Potentials::value>(
+                    p1, p2, d.vec21, sqrt(d.dist2), d.dist2, ia_params,
+                    thermostat, box_geo, bonded_ias, coulomb_kernel_ptr,
+                    dipoles_kernel_ptr, elc_kernel_ptr);
+#ifdef COLLISION_DETECTION
+                if (not collision_detection.is_off()) {
+                  collision_detection.detect_collision(p1, p2, d.dist2);
+                }
+#endif
+              },
+              *cell_structure, maximal_cutoff(), bonded_ias->maximal_cutoff(),
+              verlet_criterion, thread_safe_pair_kernel);
+        }
+      });
+  cell_structure->add_load_balancing_time(MPI_Wtime() - tick);
 
   constraints->add_forces(particles, get_sim_time());
   oif_global->calculate_forces();
@@ -264,6 +326,31 @@ void calc_long_range_forces(const ParticleRange &particles) {
 #endif // DIPOLES
 }
 
+void calc_long_range_impulse(ParticleRange const &particles,
+                             Propagation &propagation) {
+  auto const n_steps = propagation.long_range_steps;
+  if (propagation.long_range_skipped_md_steps == 0) {
+    std::vector<ParticleForce> short_range_forces;
+    short_range_forces.reserve(particles.size());
+    for (auto &p : particles) {
+      short_range_forces.emplace_back(p.force_and_torque());
+      p.force_and_torque() = {};
+    }
+    calc_long_range_forces(particles);
+    auto const factor = static_cast<double>(n_steps);
+    auto it = short_range_forces.begin();
+    for (auto &p : particles) {
+      p.force() *= factor;
+#ifdef ROTATION
+      p.torque() *= factor;
+#endif
+      p.force_and_torque() += *it++;
+    }
+  }
+  propagation.long_range_skipped_md_steps =
+      (propagation.long_range_skipped_md_steps + 1) % n_steps;
+}
+
 #ifdef NPT
 void npt_add_virial_force_contribution(const Utils::Vector3d &force,
                                        const Utils::Vector3d &d) {
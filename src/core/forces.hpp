@@ -31,6 +31,8 @@
 
 #include <utils/Vector.hpp>
 
+class Propagation;
+
 /** Assign external forces/torques to real particles and zero to ghosts. */
 void init_forces(ParticleRange const &particles, double time_step);
 
@@ -40,6 +42,15 @@ void init_forces_ghosts(ParticleRange const &particles);
 /** Calculate long range forces (P3M, ...). */
 void calc_long_range_forces(ParticleRange const &particles);
 
+/**
+ * @brief Calculate long range forces for multiple time stepping.
+ * The long range forces are only calculated every
+ * @ref Propagation::long_range_steps calls and are then added to the
+ * particle forces with that factor, as an impulse.
+ */
+void calc_long_range_impulse(ParticleRange const &particles,
+                             Propagation &propagation);
+
 #ifdef NPT
 /** Update the NpT virial */
 void npt_add_virial_force_contribution(Utils::Vector3d const &force,
@@ -34,6 +34,9 @@
 #include "bond_breakage/bond_breakage.hpp"
 #include "bonded_interactions/bonded_interaction_data.hpp"
 #include "bonded_interactions/thermalized_bond_kernel.hpp"
+#include "cell_system/BondTopology.hpp"
+#include "cell_system/CellStructure.hpp"
+#include "cell_system/ParticleArrays.hpp"
 #include "electrostatics/coulomb_inline.hpp"
 #include "immersed_boundary/ibm_tribend.hpp"
 #include "immersed_boundary/ibm_triel.hpp"
@@ -70,88 +73,133 @@
 
 #include <utils/Vector.hpp>
 
+#include <boost/container/static_vector.hpp>
 #include <boost/variant.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <optional>
 #include <span>
 #include <tuple>
+#include <type_traits>
 
-inline ParticleForce calc_central_radial_force(IA_parameters const &ia_params,
-                                               Utils::Vector3d const &d,
-                                               double const dist) {
+/** Calculate the central forces of the non-bonded potentials.
+ *  @tparam potentials  Flags of the potentials to evaluate.
+ */
+template <unsigned int potentials = NB_POTENTIAL_ALL>
+ParticleForce calc_central_radial_force(IA_parameters const &ia_params,
+                                        Utils::Vector3d const &d,
+                                        double const dist) {
 
   ParticleForce pf{};
   auto force_factor = 0.;
 /* Lennard-Jones */
 #ifdef LENNARD_JONES
-  force_factor += lj_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_LJ) {
+    force_factor += lj_pair_force_factor(ia_params, dist);
+  }
 #endif
 /* WCA */
 #ifdef WCA
-  force_factor += wca_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_WCA) {
+    force_factor += wca_pair_force_factor(ia_params, dist);
+  }
 #endif
 /* Lennard-Jones generic */
 #ifdef LENNARD_JONES_GENERIC
-  force_factor += ljgen_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_LJGEN) {
+    force_factor += ljgen_pair_force_factor(ia_params, dist);
+  }
 #endif
 /* smooth step */
 #ifdef SMOOTH_STEP
-  force_factor += SmSt_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_SMOOTH_STEP) {
+    force_factor += SmSt_pair_force_factor(ia_params, dist);
+  }
 #endif
 /* Hertzian force */
 #ifdef HERTZIAN
-  force_factor += hertzian_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_HERTZIAN) {
+    force_factor += hertzian_pair_force_factor(ia_params, dist);
+  }
 #endif
 /* Gaussian force */
 #ifdef GAUSSIAN
-  force_factor += gaussian_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_GAUSSIAN) {
+    force_factor += gaussian_pair_force_factor(ia_params, dist);
+  }
 #endif
 /* BMHTF NaCl */
 #ifdef BMHTF_NACL
-  force_factor += BMHTF_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_BMHTF) {
+    force_factor += BMHTF_pair_force_factor(ia_params, dist);
+  }
 #endif
 /* Buckingham*/
 #ifdef BUCKINGHAM
-  force_factor += buck_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_BUCKINGHAM) {
+    force_factor += buck_pair_force_factor(ia_params, dist);
+  }
 #endif
 /* Morse*/
 #ifdef MORSE
-  force_factor += morse_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_MORSE) {
+    force_factor += morse_pair_force_factor(ia_params, dist);
+  }
 #endif
 /*soft-sphere potential*/
 #ifdef SOFT_SPHERE
-  force_factor += soft_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_SOFT_SPHERE) {
+    force_factor += soft_pair_force_factor(ia_params, dist);
+  }
 #endif
 /*hat potential*/
 #ifdef HAT
-  force_factor += hat_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_HAT) {
+    force_factor += hat_pair_force_factor(ia_params, dist);
+  }
 #endif
 /* Lennard-Jones cosine */
 #ifdef LJCOS
-  force_factor += ljcos_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_LJCOS) {
+    force_factor += ljcos_pair_force_factor(ia_params, dist);
+  }
 #endif
 /* Lennard-Jones cosine */
 #ifdef LJCOS2
-  force_factor += ljcos2_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_LJCOS2) {
+    force_factor += ljcos2_pair_force_factor(ia_params, dist);
+  }
 #endif
 /* tabulated */
 #ifdef TABULATED
-  force_factor += tabulated_pair_force_factor(ia_params, dist);
+  if constexpr (potentials & NB_POTENTIAL_TABULATED) {
+    force_factor += tabulated_pair_force_factor(ia_params, dist);
+  }
 #endif
   pf.f += force_factor * d;
   return pf;
 }
 
-inline ParticleForce calc_non_central_force(Particle const &p1,
-                                            Particle const &p2,
-                                            IA_parameters const &ia_params,
-                                            Utils::Vector3d const &d,
-                                            double const dist) {
+/** Calculate the non-central forces of the non-bonded potentials.
+ *  @tparam potentials  Flags of the potentials to evaluate.
+ */
+template <unsigned int potentials = NB_POTENTIAL_ALL>
+ParticleForce calc_non_central_force([[maybe_unused]] Particle const &p1,
+                                     [[maybe_unused]] Particle const &p2,
+                                     [[maybe_unused]] IA_parameters const
+                                         &ia_params,
+                                     [[maybe_unused]] Utils::Vector3d const &d,
+                                     [[maybe_unused]] double const dist) {
 
   ParticleForce pf{};
 /* Gay-Berne */
 #ifdef GAY_BERNE
-  pf += gb_pair_force(p1.quat(), p2.quat(), ia_params, d, dist);
+  if constexpr (potentials & NB_POTENTIAL_GAY_BERNE) {
+    pf += gb_pair_force(p1.quat(), p2.quat(), ia_params, d, dist);
+  }
 #endif
   return pf;
 }
@@ -172,6 +220,8 @@ inline ParticleForce calc_opposing_force(ParticleForce const &pf,
 
 /** Calculate non-bonded forces between a pair of particles and update their
  *  forces and torques.
+ *  @tparam potentials     Flags of the non-bonded potentials to evaluate,
+ *                         see @ref dispatch_nonbonded_potentials.
  *  @param[in,out] p1      particle 1.
  *  @param[in,out] p2      particle 2.
  *  @param[in] d           vector between @p p1 and @p p2.
@@ -185,7 +235,8 @@ inline ParticleForce calc_opposing_force(ParticleForce const &pf,
  *  @param[in] dipoles_kernel  Dipolar force kernel.
  *  @param[in] elc_kernel      ELC force correction kernel.
  */
-inline void add_non_bonded_pair_force(
+template <unsigned int potentials = NB_POTENTIAL_ALL>
+void add_non_bonded_pair_force(
     Particle &p1, Particle &p2, Utils::Vector3d const &d, double dist,
     double dist2, IA_parameters const &ia_params,
     Thermostat::Thermostat const &thermostat, BoxGeometry const &box_geo,
@@ -200,19 +251,23 @@ inline void add_non_bonded_pair_force(
   /* non-bonded pair potentials                  */
   /***********************************************/
 
-  if (dist < ia_params.max_cut) {
+  if constexpr (potentials != NB_POTENTIAL_NONE) {
+    if (dist < ia_params.max_cut) {
 #ifdef EXCLUSIONS
-    if (do_nonbonded(p1, p2)) {
+      if (do_nonbonded(p1, p2)) {
 #endif
-      pf += calc_central_radial_force(ia_params, d, dist);
+        pf += calc_central_radial_force<potentials>(ia_params, d, dist);
 #ifdef THOLE
-      pf.f += thole_pair_force(p1, p2, ia_params, d, dist, bonded_ias,
-                               coulomb_kernel);
+        if constexpr (potentials & NB_POTENTIAL_THOLE) {
+          pf.f += thole_pair_force(p1, p2, ia_params, d, dist, bonded_ias,
+                                   coulomb_kernel);
+        }
 #endif
-      pf += calc_non_central_force(p1, p2, ia_params, d, dist);
+        pf += calc_non_central_force<potentials>(p1, p2, ia_params, d, dist);
 #ifdef EXCLUSIONS
-    }
+      }
 #endif
+    }
   }
 
   /***********************************************/
@@ -272,6 +327,212 @@ inline void add_non_bonded_pair_force(
   p2.force_and_torque() += calc_opposing_force(pf, d);
 }
 
+/** Calculate non-bonded forces between two clusters of particles stored
+ *  in the structure-of-arrays mirror and update the force arrays.
+ *  Only valid when all non-bonded potentials are Lennard-Jones or WCA,
+ *  and the only other pair contributions are short-range electrostatics
+ *  and DPD. The particle pairs are processed as a fixed-size block.
+ *  Positions are loaded into per-coordinate arrays, and the interaction
+ *  parameters are looked up once per pair of particle types, such that
+ *  the Lennard-Jones and WCA forces are evaluated in loops without calls
+ *  or branches, which the compiler can vectorize. The square roots of the
+ *  distances are only vectorized when math functions don't set errno
+ *  (e.g. with -fno-math-errno). The Coulomb and DPD contributions are
+ *  added pair by pair afterwards, since they go through the solver and
+ *  thermostat kernels.
+ *  @tparam potentials     Flags of the non-bonded potentials to evaluate,
+ *                         only Lennard-Jones and WCA are supported.
+ *  @param[in,out] arrays  particle arrays.
+ *  @param[in] ci          index of cluster 1.
+ *  @param[in] cj          index of cluster 2.
+ *  @param[in] df          distance function.
+ *  @param[in] nonbonded_ias   non-bonded interaction kernels.
+ *  @param[in] thermostat      thermostat.
+ *  @param[in] box_geo         box geometry.
+ *  @param[in] coulomb_kernel  Coulomb force kernel.
+ */
+template <unsigned int potentials, class DistanceFunction>
+void add_cluster_pair_forces(
+    ParticleArrays &arrays, ParticleArrays::index_type ci,
+    ParticleArrays::index_type cj, DistanceFunction const &df,
+    InteractionsNonBonded const &nonbonded_ias,
+    [[maybe_unused]] Thermostat::Thermostat const &thermostat,
+    [[maybe_unused]] BoxGeometry const &box_geo,
+    [[maybe_unused]] Coulomb::ShortRangeForceKernel::kernel_type const
+        *coulomb_kernel) {
+  constexpr auto M = ParticleArrays::cluster_size;
+  constexpr auto N = M * M;
+  auto const i0 = ci * M;
+  auto const j0 = cj * M;
+
+  /* pair distances; padding entries and, on the diagonal,
+   * pairs that are counted twice are masked out */
+  std::array<double, N> dx, dy, dz, dist;
+  std::array<bool, N> mask;
+  if constexpr (std::is_same_v<DistanceFunction, detail::EuclidianDistance>) {
+    std::array<double, M> xi, yi, zi, xj, yj, zj;
+    for (unsigned int m = 0u; m < M; ++m) {
+      xi[m] = arrays.pos[i0 + m][0];
+      yi[m] = arrays.pos[i0 + m][1];
+      zi[m] = arrays.pos[i0 + m][2];
+      xj[m] = arrays.pos[j0 + m][0];
+      yj[m] = arrays.pos[j0 + m][1];
+      zj[m] = arrays.pos[j0 + m][2];
+    }
+    for (unsigned int k = 0u; k < N; ++k) {
+      dx[k] = xi[k / M] - xj[k % M];
+      dy[k] = yi[k / M] - yj[k % M];
+      dz[k] = zi[k / M] - zj[k % M];
+    }
+  } else {
+    for (unsigned int k = 0u; k < N; ++k) {
+      auto const d =
+          df(arrays.pos[i0 + k / M], arrays.pos[j0 + k % M]).vec21;
+      dx[k] = d[0];
+      dy[k] = d[1];
+      dz[k] = d[2];
+    }
+  }
+  for (unsigned int k = 0u; k < N; ++k) {
+    dist[k] = std::sqrt(dx[k] * dx[k] + dy[k] * dy[k] + dz[k] * dz[k]);
+  }
+  for (unsigned int k = 0u; k < N; ++k) {
+    mask[k] = (arrays.particles[i0 + k / M] != nullptr) &
+              (arrays.particles[j0 + k % M] != nullptr) &
+              ((ci != cj) | (k % M > k / M));
+  }
+
+  /* The force factors are evaluated for all pairs, and the pairs outside
+   * of the cutoffs are discarded in a separate loop: compilers sink the
+   * arithmetic into a conditional branch otherwise, which prevents the
+   * vectorization. Masked pairs get a negative cutoff. */
+  std::array<double, N> force_factor{};
+  if constexpr (potentials != NB_POTENTIAL_NONE) {
+    /* interaction parameters, looked up once per pair of types */
+    std::array<IA_parameters const *, N> ia_params;
+    auto const *type_i = &arrays.type[i0];
+    auto const *type_j = &arrays.type[j0];
+    auto const uniform = [](int const *types) {
+      return std::all_of(types, types + M, [=](int t) { return t == *types; });
+    };
+    if (uniform(type_i) and uniform(type_j)) {
+      ia_params.fill(&nonbonded_ias.get_ia_param_flat(*type_i, *type_j));
+    } else {
+      for (unsigned int k = 0u; k < N; ++k) {
+        ia_params[k] =
+            &nonbonded_ias.get_ia_param_flat(type_i[k / M], type_j[k % M]);
+      }
+    }
+    /* pairs which interact through the non-bonded potentials */
+    std::array<bool, N> nb_mask = mask;
+#ifdef EXCLUSIONS
+    // exclusions are symmetric, the first particle is always local
+    for (unsigned int k = 0u; k < N; ++k) {
+      auto const i = i0 + k / M;
+      if (nb_mask[k] and arrays.has_exclusions[i]) {
+        nb_mask[k] =
+            do_nonbonded(*arrays.particles[i], *arrays.particles[j0 + k % M]);
+      }
+    }
+#endif
+    std::array<double, N> factor;
+#ifdef LENNARD_JONES
+    if constexpr (potentials & NB_POTENTIAL_LJ) {
+      std::array<double, N> eps, sig, offset, min_cut, max_cut;
+      for (unsigned int k = 0u; k < N; ++k) {
+        auto const &lj = ia_params[k]->lj;
+        eps[k] = lj.eps;
+        sig[k] = lj.sig;
+        offset[k] = lj.offset;
+        min_cut[k] = lj.min_cutoff();
+        max_cut[k] = nb_mask[k] ? lj.max_cutoff() : -1.;
+      }
+      for (unsigned int k = 0u; k < N; ++k) {
+        auto const r_off = dist[k] - offset[k];
+        auto const frac2 = sig[k] * sig[k] / (r_off * r_off);
+        auto const frac6 = frac2 * frac2 * frac2;
+        factor[k] = 48.0 * eps[k] * frac6 * (frac6 - 0.5) / (r_off * dist[k]);
+      }
+      for (unsigned int k = 0u; k < N; ++k) {
+        auto const f = factor[k];
+        auto const in_range = (dist[k] < max_cut[k]) & (dist[k] > min_cut[k]);
+        force_factor[k] += in_range ? f : 0.;
+      }
+    }
+#endif
+#ifdef WCA
+    if constexpr (potentials & NB_POTENTIAL_WCA) {
+      std::array<double, N> eps, sig, cut;
+      for (unsigned int k = 0u; k < N; ++k) {
+        auto const &wca = ia_params[k]->wca;
+        eps[k] = wca.eps;
+        sig[k] = wca.sig;
+        cut[k] = nb_mask[k] ? wca.cut : -1.;
+      }
+      for (unsigned int k = 0u; k < N; ++k) {
+        auto const dist2 = dist[k] * dist[k];
+        auto const frac2 = sig[k] * sig[k] / dist2;
+        auto const frac6 = frac2 * frac2 * frac2;
+        factor[k] = 48.0 * eps[k] * frac6 * (frac6 - 0.5) / dist2;
+      }
+      for (unsigned int k = 0u; k < N; ++k) {
+        auto const f = factor[k];
+        force_factor[k] += (dist[k] < cut[k]) ? f : 0.;
+      }
+    }
+#endif
+  }
+
+  /* pair forces */
+  std::array<double, N> fx, fy, fz;
+  for (unsigned int k = 0u; k < N; ++k) {
+    fx[k] = force_factor[k] * dx[k];
+    fy[k] = force_factor[k] * dy[k];
+    fz[k] = force_factor[k] * dz[k];
+  }
+  auto const add_pair_force = [&](unsigned int k, Utils::Vector3d const &f) {
+    fx[k] += f[0];
+    fy[k] += f[1];
+    fz[k] += f[2];
+  };
+#ifdef ELECTROSTATICS
+  if (coulomb_kernel != nullptr) {
+    for (unsigned int k = 0u; k < N; ++k) {
+      auto const q1q2 = arrays.q[i0 + k / M] * arrays.q[j0 + k % M];
+      if (mask[k] and q1q2 != 0.) {
+        auto const d = Utils::Vector3d{dx[k], dy[k], dz[k]};
+        add_pair_force(k, (*coulomb_kernel)(q1q2, d, dist[k]));
+      }
+    }
+  }
+#endif
+#ifdef DPD
+  if (thermostat.thermo_switch & THERMO_DPD) {
+    for (unsigned int k = 0u; k < N; ++k) {
+      if (mask[k]) {
+        auto const &p1 = *arrays.particles[i0 + k / M];
+        auto const &p2 = *arrays.particles[j0 + k % M];
+        auto const &ia_params =
+            nonbonded_ias.get_ia_param_flat(p1.type(), p2.type());
+        auto const d = Utils::Vector3d{dx[k], dy[k], dz[k]};
+        add_pair_force(k, dpd_pair_force(p1, p2, *thermostat.dpd, box_geo,
+                                         ia_params, d, dist[k], d.norm2()));
+      }
+    }
+  }
+#endif
+
+  /* force reduction */
+  for (unsigned int ii = 0u; ii < M; ++ii) {
+    for (unsigned int jj = 0u; jj < M; ++jj) {
+      auto const k = ii * M + jj;
+      auto const f = Utils::Vector3d{fx[k], fy[k], fz[k]};
+      arrays.force[i0 + ii] += f;
+      arrays.force[j0 + jj] -= f;
+    }
+  }
+}
+
 /** Compute the bonded interaction force between particle pairs.
  *
  *  @param[in] p1          First particle.
@@ -485,3 +746,113 @@ add_bonded_force(Particle &p1, int bond_id, std::span<Particle *> partners,
     throw BondInvalidSizeError{number_of_partners(iaparams)};
   }
 }
+
+/** Report a bond of a @ref BondTopology::Group as broken. */
+inline void bond_group_broken_error(std::span<Particle *> bond) {
+  boost::container::static_vector<int, 3> partner_ids;
+  for (auto const p : bond.subspan(1u)) {
+    partner_ids.emplace_back(p->id());
+  }
+  bond_broken_error(bond[0]->id(), {partner_ids.data(), partner_ids.size()});
+}
+
+/** Compute the forces of a group of pair bonds of type @p Bond. */
+template <class Bond>
+void add_bonded_pair_group_forces(Bond const &iap,
+                                  BondTopology::Group &group,
+                                  BoxGeometry const &box_geo) {
+  auto const &particles = group.particles;
+  for (std::size_t i = 0u; i + 1u < particles.size(); i += 2u) {
+    auto &p1 = *particles[i];
+    auto &p2 = *particles[i + 1u];
+    auto const dx = box_geo.get_mi_vector(p1.pos(), p2.pos());
+    auto const result = iap.force(dx);
+    if (not result) {
+      bond_group_broken_error(group.bond(i / 2u));
+      continue;
+    }
+    p1.force() += *result;
+    p2.force() -= *result;
+#ifdef NPT
+    npt_add_virial_force_contribution(*result, dx);
+#endif
+  }
+}
+
+/** Compute the forces of a group of harmonic angle bonds. */
+inline void add_bonded_angle_group_forces(AngleHarmonicBond const &iap,
+                                          BondTopology::Group &group,
+                                          BoxGeometry const &box_geo) {
+  auto const &particles = group.particles;
+  for (std::size_t i = 0u; i + 2u < particles.size(); i += 3u) {
+    auto &p1 = *particles[i];
+    auto &p2 = *particles[i + 1u];
+    auto &p3 = *particles[i + 2u];
+    auto const vec1 = box_geo.get_mi_vector(p2.pos(), p1.pos());
+    auto const vec2 = box_geo.get_mi_vector(p3.pos(), p1.pos());
+    auto const [f1, f2, f3] = iap.forces(vec1, vec2);
+    p1.force() += f1;
+    p2.force() += f2;
+    p3.force() += f3;
+  }
+}
+
+/** Compute the forces of a group of dihedral bonds. */
+inline void add_bonded_dihedral_group_forces(DihedralBond const &iap,
+                                             BondTopology::Group &group,
+                                             BoxGeometry const &box_geo) {
+  auto const &particles = group.particles;
+  for (std::size_t i = 0u; i + 3u < particles.size(); i += 4u) {
+    auto &p1 = *particles[i];
+    auto &p2 = *particles[i + 1u];
+    auto &p3 = *particles[i + 2u];
+    auto &p4 = *particles[i + 3u];
+    // note: particles in a dihedral bond are ordered as p2-p1-p3-p4
+    auto const v12 = box_geo.get_mi_vector(p1.pos(), p2.pos());
+    auto const v23 = box_geo.get_mi_vector(p3.pos(), p1.pos());
+    auto const v34 = box_geo.get_mi_vector(p4.pos(), p3.pos());
+    auto const result = iap.forces(v12, v23, v34);
+    if (not result) {
+      bond_group_broken_error(group.bond(i / 4u));
+      continue;
+    }
+    auto const &[f1, f2, f3, f4] = *result;
+    p1.force() += f1;
+    p2.force() += f2;
+    p3.force() += f3;
+    p4.force() += f4;
+  }
+}
+
+/** Compute the forces of a group of bonds with the same bond id.
+ *  Harmonic, FENE, harmonic angle and dihedral bonds are evaluated in a
+ *  loop specialized to their type. Other bonds, and bonds which can
+ *  break, are evaluated one by one with @ref add_bonded_force.
+ */
+inline void add_bonded_group_forces(
+    BondTopology::Group &group, BondedInteractionsMap const &bonded_ia_params,
+    BondBreakage::BondBreakage &bond_breakage, BoxGeometry const &box_geo,
+    Coulomb::ShortRangeForceKernel::kernel_type const *kernel) {
+  auto const &iaparams = *bonded_ia_params.at(group.bond_id);
+  if (not bond_breakage.breakage_specs.contains(group.bond_id)) {
+    if (auto const *iap = boost::get<HarmonicBond>(&iaparams)) {
+      return add_bonded_pair_group_forces(*iap, group, box_geo);
+    }
+    if (auto const *iap = boost::get<FeneBond>(&iaparams)) {
+      return add_bonded_pair_group_forces(*iap, group, box_geo);
+    }
+    if (auto const *iap = boost::get<AngleHarmonicBond>(&iaparams)) {
+      return add_bonded_angle_group_forces(*iap, group, box_geo);
+    }
+    if (auto const *iap = boost::get<DihedralBond>(&iaparams)) {
+      return add_bonded_dihedral_group_forces(*iap, group, box_geo);
+    }
+  }
+  for (std::size_t i = 0u; i < group.size(); ++i) {
+    auto const bond = group.bond(i);
+    if (add_bonded_force(*bond[0], group.bond_id, bond.subspan(1u),
+                         bonded_ia_params, bond_breakage, box_geo, kernel)) {
+      bond_group_broken_error(bond);
+    }
+  }
+}
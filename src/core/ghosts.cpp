@@ -42,15 +42,22 @@
 #include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <boost/mpi/collectives.hpp>
+#include <boost/mpi/nonblocking.hpp>
+#include <boost/mpi/request.hpp>
 #include <boost/range/numeric.hpp>
 #include <boost/serialization/vector.hpp>
 
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <iterator>
+#include <memory>
 #include <span>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 /** Tag for ghosts communications. */
@@ -226,8 +233,214 @@ serialize_and_reduce(Archive &ar, Particle &p, unsigned int data_parts,
 #endif
 }
 
+/** @brief Data parts that only consist of fixed-size particle fields. */
+static constexpr unsigned int kinematic_data_parts =
+    GHOSTTRANS_POSITION | GHOSTTRANS_MOMENTUM | GHOSTTRANS_FORCE;
+
+/**
+ * @brief Whether a communication only transfers positions, momenta
+ * and forces, i.e. the hot halo updates of the integration step.
+ * These are packed by the kinematic fast path below, which writes
+ * the same bytes as @ref serialize_and_reduce.
+ */
+static bool is_kinematic(unsigned int data_parts) {
+  return data_parts != GHOSTTRANS_NONE and
+         (data_parts & ~kinematic_data_parts) == 0u;
+}
+
+/**
+ * @brief Call a kernel with the data parts as a compile-time constant.
+ * Only valid for kinematic data parts, see @ref is_kinematic.
+ */
+template <class Kernel>
+static void visit_kinematic(unsigned int data_parts, Kernel &&kernel) {
+  using std::integral_constant;
+  switch (data_parts) {
+  case GHOSTTRANS_POSITION:
+    return kernel(integral_constant<unsigned int, GHOSTTRANS_POSITION>{});
+  case GHOSTTRANS_MOMENTUM:
+    return kernel(integral_constant<unsigned int, GHOSTTRANS_MOMENTUM>{});
+  case GHOSTTRANS_FORCE:
+    return kernel(integral_constant<unsigned int, GHOSTTRANS_FORCE>{});
+  case GHOSTTRANS_POSITION | GHOSTTRANS_MOMENTUM:
+    return kernel(integral_constant<unsigned int, GHOSTTRANS_POSITION |
+                                                      GHOSTTRANS_MOMENTUM>{});
+  case GHOSTTRANS_POSITION | GHOSTTRANS_FORCE:
+    return kernel(integral_constant<unsigned int, GHOSTTRANS_POSITION |
+                                                      GHOSTTRANS_FORCE>{});
+  case GHOSTTRANS_MOMENTUM | GHOSTTRANS_FORCE:
+    return kernel(integral_constant<unsigned int, GHOSTTRANS_MOMENTUM |
+                                                      GHOSTTRANS_FORCE>{});
+  default:
+    assert(data_parts == kinematic_data_parts);
+    return kernel(integral_constant<unsigned int, kinematic_data_parts>{});
+  }
+}
+
+/** @brief Size of the kinematic data parts of one particle. */
+template <unsigned int parts> static constexpr std::size_t kinematic_size() {
+  std::size_t size = 0;
+  if constexpr ((parts & GHOSTTRANS_POSITION) != 0u) {
+    size += sizeof(Utils::Vector3d) + sizeof(Utils::Vector3i);
+#ifdef ROTATION
+    size += sizeof(Utils::Quaternion<double>);
+#endif
+#ifdef BOND_CONSTRAINT
+    size += sizeof(Utils::Vector3d);
+#endif
+  }
+  if constexpr ((parts & GHOSTTRANS_MOMENTUM) != 0u) {
+    size += sizeof(Utils::Vector3d);
+#ifdef ROTATION
+    size += sizeof(Utils::Vector3d);
+#endif
+  }
+  if constexpr ((parts & GHOSTTRANS_FORCE) != 0u) {
+    size += sizeof(Utils::Vector3d);
+#ifdef ROTATION
+    size += sizeof(Utils::Vector3d);
+#endif
+  }
+  return size;
+}
+
+template <class T> static char *pack_value(char *out, T const &value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  std::memcpy(out, &value, sizeof(T));
+  return out + sizeof(T);
+}
+
+template <class T> static char const *unpack_value(char const *in, T &value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  std::memcpy(&value, in, sizeof(T));
+  return in + sizeof(T);
+}
+
+template <class T> static char const *unpack_add(char const *in, T &value) {
+  T increment;
+  in = unpack_value(in, increment);
+  value += increment;
+  return in;
+}
+
+/**
+ * @brief Pack the kinematic data parts of a particle,
+ * applying the ghost shift to the position.
+ */
+template <unsigned int parts>
+static char *pack_kinematic(char *out, Particle const &p,
+                            BoxGeometry const &box_geo,
+                            Utils::Vector3d const &ghost_shift) {
+  if constexpr ((parts & GHOSTTRANS_POSITION) != 0u) {
+    auto pos = p.pos() + ghost_shift;
+    auto img = p.image_box();
+    box_geo.fold_position(pos, img);
+    out = pack_value(out, pos);
+    out = pack_value(out, img);
+#ifdef ROTATION
+    out = pack_value(out, p.quat());
+#endif
+#ifdef BOND_CONSTRAINT
+    out = pack_value(out, p.pos_last_time_step());
+#endif
+  }
+  if constexpr ((parts & GHOSTTRANS_MOMENTUM) != 0u) {
+    out = pack_value(out, p.v());
+#ifdef ROTATION
+    out = pack_value(out, p.omega());
+#endif
+  }
+  if constexpr ((parts & GHOSTTRANS_FORCE) != 0u) {
+    out = pack_value(out, p.force());
+#ifdef ROTATION
+    out = pack_value(out, p.torque());
+#endif
+  }
+  return out;
+}
+
+/**
+ * @brief Unpack the kinematic data parts of a particle. Forces
+ * and torques are added up for @ref ReductionPolicy::UPDATE.
+ */
+template <unsigned int parts, ReductionPolicy policy>
+static char const *unpack_kinematic(char const *in, Particle &p) {
+  if constexpr ((parts & GHOSTTRANS_POSITION) != 0u) {
+    in = unpack_value(in, p.pos());
+    in = unpack_value(in, p.image_box());
+#ifdef ROTATION
+    in = unpack_value(in, p.quat());
+#endif
+#ifdef BOND_CONSTRAINT
+    in = unpack_value(in, p.pos_last_time_step());
+#endif
+  }
+  if constexpr ((parts & GHOSTTRANS_MOMENTUM) != 0u) {
+    in = unpack_value(in, p.v());
+#ifdef ROTATION
+    in = unpack_value(in, p.omega());
+#endif
+  }
+  if constexpr ((parts & GHOSTTRANS_FORCE) != 0u) {
+    if constexpr (policy == ReductionPolicy::UPDATE) {
+      in = unpack_add(in, p.force());
+#ifdef ROTATION
+      in = unpack_add(in, p.torque());
+#endif
+    } else {
+      in = unpack_value(in, p.force());
+#ifdef ROTATION
+      in = unpack_value(in, p.torque());
+#endif
+    }
+  }
+  return in;
+}
+
+/**
+ * @brief Copy the kinematic data parts between two particles,
+ * applying the ghost shift to the position and adding up forces.
+ */
+template <unsigned int parts>
+static void copy_kinematic(Particle const &src, Particle &dst,
+                           BoxGeometry const &box_geo,
+                           Utils::Vector3d const &ghost_shift) {
+  if constexpr ((parts & GHOSTTRANS_POSITION) != 0u) {
+    auto pos = src.pos() + ghost_shift;
+    auto img = src.image_box();
+    box_geo.fold_position(pos, img);
+    dst.pos() = pos;
+    dst.image_box() = img;
+#ifdef ROTATION
+    dst.quat() = src.quat();
+#endif
+#ifdef BOND_CONSTRAINT
+    dst.pos_last_time_step() = src.pos_last_time_step();
+#endif
+  }
+  if constexpr ((parts & GHOSTTRANS_MOMENTUM) != 0u) {
+    dst.v() = src.v();
+#ifdef ROTATION
+    dst.omega() = src.omega();
+#endif
+  }
+  if constexpr ((parts & GHOSTTRANS_FORCE) != 0u) {
+    dst.force() += src.force();
+#ifdef ROTATION
+    dst.torque() += src.torque();
+#endif
+  }
+}
+
 static auto calc_transmit_size(BoxGeometry const &box_geo,
                                unsigned data_parts) {
+  if (is_kinematic(data_parts)) {
+    std::size_t size = 0;
+    visit_kinematic(data_parts, [&size](auto parts) {
+      size = kinematic_size<decltype(parts)::value>();
+    });
+    return size;
+  }
   SerializationSizeCalculator sizeof_archive;
   Particle p{};
   serialize_and_reduce(sizeof_archive, p, data_parts, ReductionPolicy::MOVE,
@@ -257,13 +470,21 @@ static void prepare_send_buffer(CommBuf &send_buffer,
   send_buffer.resize(calc_transmit_size(ghost_comm, box_geo, data_parts));
   send_buffer.bonds().clear();
 
-  auto archiver = Utils::MemcpyOArchive{send_buffer.make_span()};
+  if (is_kinematic(data_parts)) {
+    visit_kinematic(data_parts, [&](auto parts) {
+      auto out = send_buffer.data();
+      for (auto part_list : ghost_comm.part_lists) {
+        for (auto const &p : *part_list) {
+          out = pack_kinematic<decltype(parts)::value>(out, p, box_geo,
+                                                       ghost_comm.shift);
+        }
+      }
+      assert(out == send_buffer.data() + send_buffer.size());
+    });
+    return;
+  }
 
-  /* Construct archive that pushes back to the bond buffer */
-  namespace io = boost::iostreams;
-  io::stream<io::back_insert_device<std::vector<char>>> os{
-      io::back_inserter(send_buffer.bonds())};
-  boost::archive::binary_oarchive bond_archiver{os};
+  auto archiver = Utils::MemcpyOArchive{send_buffer.make_span()};
 
   /* put in data */
   for (auto part_list : ghost_comm.part_lists) {
@@ -276,14 +497,25 @@ static void prepare_send_buffer(CommBuf &send_buffer,
         serialize_and_reduce(archiver, p, data_parts, ReductionPolicy::MOVE,
                              SerializationDirection::SAVE, box_geo,
                              &ghost_comm.shift);
-        if (data_parts & GHOSTTRANS_BONDS) {
-          bond_archiver << p.bonds();
-        }
       }
     }
   }
 
   assert(archiver.bytes_written() == send_buffer.size());
+
+  if ((data_parts & GHOSTTRANS_BONDS) and !(data_parts & GHOSTTRANS_PARTNUM)) {
+    /* Construct archive that pushes back to the bond buffer */
+    namespace io = boost::iostreams;
+    io::stream<io::back_insert_device<std::vector<char>>> os{
+        io::back_inserter(send_buffer.bonds())};
+    boost::archive::binary_oarchive bond_archiver{os};
+
+    for (auto part_list : ghost_comm.part_lists) {
+      for (auto &p : *part_list) {
+        bond_archiver << p.bonds();
+      }
+    }
+  }
 }
 
 static void prepare_ghost_cell(ParticleList *cell, std::size_t size) {
@@ -310,6 +542,20 @@ static void put_recv_buffer(CommBuf &recv_buffer,
                             GhostCommunication const &ghost_comm,
                             BoxGeometry const &box_geo,
                             unsigned int data_parts) {
+  if (is_kinematic(data_parts)) {
+    visit_kinematic(data_parts, [&](auto parts) {
+      char const *in = recv_buffer.data();
+      for (auto part_list : ghost_comm.part_lists) {
+        for (auto &p : *part_list) {
+          in = unpack_kinematic<decltype(parts)::value, ReductionPolicy::MOVE>(
+              in, p);
+        }
+      }
+      assert(in == recv_buffer.data() + recv_buffer.size());
+    });
+    return;
+  }
+
   /* put back data */
   auto archiver = Utils::MemcpyIArchive{recv_buffer.make_span()};
 
@@ -363,20 +609,37 @@ add_rattle_correction_from_recv_buffer(CommBuf &recv_buffer,
 
 static void add_forces_from_recv_buffer(CommBuf &recv_buffer,
                                         const GhostCommunication &ghost_comm) {
-  /* put back data */
-  auto archiver = Utils::MemcpyIArchive{recv_buffer.make_span()};
+  /* add up data */
+  char const *in = recv_buffer.data();
   for (auto &part_list : ghost_comm.part_lists) {
     for (Particle &part : *part_list) {
-      ParticleForce pf;
-      archiver >> pf;
-      part.force_and_torque() += pf;
+      in = unpack_kinematic<GHOSTTRANS_FORCE, ReductionPolicy::UPDATE>(in,
+                                                                       part);
     }
   }
+  assert(in == recv_buffer.data() + recv_buffer.size());
 }
 
 static void cell_cell_transfer(GhostCommunication const &ghost_comm,
                                BoxGeometry const &box_geo,
                                unsigned int data_parts) {
+  if (is_kinematic(data_parts)) {
+    visit_kinematic(data_parts, [&](auto parts) {
+      auto const offset = ghost_comm.part_lists.size() / 2;
+      for (std::size_t pl = 0; pl < offset; pl++) {
+        auto const &src_part = *ghost_comm.part_lists[pl];
+        auto &dst_part = *ghost_comm.part_lists[pl + offset];
+        assert(src_part.size() == dst_part.size());
+        for (std::size_t i = 0; i < src_part.size(); i++) {
+          copy_kinematic<decltype(parts)::value>(
+              src_part.begin()[i], dst_part.begin()[i], box_geo,
+              ghost_comm.shift);
+        }
+      }
+    });
+    return;
+  }
+
   CommBuf buffer;
   if (!(data_parts & GHOSTTRANS_PARTNUM)) {
     buffer.resize(calc_transmit_size(box_geo, data_parts));
@@ -439,6 +702,173 @@ static bool is_poststorable(GhostCommunication const &ghost_comm,
   return is_recv_op(comm_type, node, this_node) && poststore;
 }
 
+/** @brief Write back received data, adding up forces and corrections. */
+static void unpack_recv_buffer(CommBuf &recv_buffer,
+                               GhostCommunication const &ghost_comm,
+                               BoxGeometry const &box_geo,
+                               unsigned int data_parts) {
+  if (data_parts == GHOSTTRANS_FORCE)
+    add_forces_from_recv_buffer(recv_buffer, ghost_comm);
+#ifdef BOND_CONSTRAINT
+  else if (data_parts == GHOSTTRANS_RATTLE)
+    add_rattle_correction_from_recv_buffer(recv_buffer, ghost_comm);
+#endif
+  else
+    put_recv_buffer(recv_buffer, ghost_comm, box_geo, data_parts);
+}
+
+struct AsyncGhostCommunication::Implementation {
+  GhostCommunicator const *gcr = nullptr;
+  BoxGeometry const *box_geo = nullptr;
+  unsigned int data_parts = GHOSTTRANS_NONE;
+  /** Range of the communications of the current stage. */
+  std::size_t stage_begin = 0;
+  std::size_t stage_end = 0;
+  /** Buffers of the current stage, kept to reuse their storage. */
+  std::vector<CommBuf> send_buffers;
+  std::vector<CommBuf> recv_buffers;
+  std::vector<boost::mpi::request> requests;
+  /** Cells received in the current stage. */
+  std::unordered_set<ParticleList const *> received;
+
+  /** @brief Whether a communication reads or writes a received cell. */
+  bool depends_on_stage(GhostCommunication const &ghost_comm) const {
+    return std::ranges::any_of(ghost_comm.part_lists, [this](auto part_list) {
+      return received.contains(part_list);
+    });
+  }
+
+  /**
+   * @brief Start the next stage: run the cell-to-cell transfers that
+   * precede it, post the receives, pack and send the send buffers.
+   */
+  void start_stage() {
+    auto const &comm = gcr->mpi_comm;
+    auto const &communications = gcr->communications;
+    stage_begin = stage_end;
+    while (stage_begin != communications.size() and
+           (communications[stage_begin].type & GHOST_JOBMASK) == GHOST_LOCL) {
+      cell_cell_transfer(communications[stage_begin], *box_geo, data_parts);
+      ++stage_begin;
+    }
+    received.clear();
+    stage_end = stage_begin;
+    std::size_t n_send = 0, n_recv = 0;
+    for (; stage_end != communications.size(); ++stage_end) {
+      auto const &ghost_comm = communications[stage_end];
+      auto const comm_type = ghost_comm.type & GHOST_JOBMASK;
+      if (comm_type == GHOST_LOCL or depends_on_stage(ghost_comm)) {
+        break;
+      }
+      if (comm_type == GHOST_RECV) {
+        received.insert(ghost_comm.part_lists.begin(),
+                        ghost_comm.part_lists.end());
+        ++n_recv;
+      } else {
+        ++n_send;
+      }
+    }
+    if (send_buffers.size() < n_send)
+      send_buffers.resize(n_send);
+    if (recv_buffers.size() < n_recv)
+      recv_buffers.resize(n_recv);
+    requests.clear();
+    /* post all receives before the sends */
+    n_recv = 0;
+    for (auto i = stage_begin; i != stage_end; ++i) {
+      auto const &ghost_comm = communications[i];
+      if ((ghost_comm.type & GHOST_JOBMASK) == GHOST_RECV) {
+        auto &recv_buffer = recv_buffers[n_recv++];
+        prepare_recv_buffer(recv_buffer, ghost_comm, *box_geo, data_parts);
+        requests.emplace_back(comm.irecv(ghost_comm.node, REQ_GHOST_SEND,
+                                         recv_buffer.data(),
+                                         static_cast<int>(recv_buffer.size())));
+      }
+    }
+    n_send = 0;
+    for (auto i = stage_begin; i != stage_end; ++i) {
+      auto const &ghost_comm = communications[i];
+      if ((ghost_comm.type & GHOST_JOBMASK) == GHOST_SEND) {
+        auto &send_buffer = send_buffers[n_send++];
+        prepare_send_buffer(send_buffer, ghost_comm, *box_geo, data_parts);
+        requests.emplace_back(comm.isend(ghost_comm.node, REQ_GHOST_SEND,
+                                         send_buffer.data(),
+                                         static_cast<int>(send_buffer.size())));
+      }
+    }
+  }
+
+  /** @brief Write back the received data of the completed stage. */
+  void finish_stage() {
+    auto const &communications = gcr->communications;
+    std::size_t n_recv = 0;
+    for (auto i = stage_begin; i != stage_end; ++i) {
+      auto const &ghost_comm = communications[i];
+      if ((ghost_comm.type & GHOST_JOBMASK) == GHOST_RECV) {
+        unpack_recv_buffer(recv_buffers[n_recv++], ghost_comm, *box_geo,
+                           data_parts);
+      }
+    }
+    requests.clear();
+    if (stage_end == communications.size()) {
+      gcr = nullptr;
+    } else {
+      start_stage();
+    }
+  }
+};
+
+AsyncGhostCommunication::AsyncGhostCommunication()
+    : impl{std::make_unique<Implementation>()} {}
+
+AsyncGhostCommunication::~AsyncGhostCommunication() = default;
+
+bool AsyncGhostCommunication::is_supported(GhostCommunicator const &gcr,
+                                           unsigned int data_parts) {
+  if (data_parts & (GHOSTTRANS_PARTNUM | GHOSTTRANS_BONDS))
+    return false;
+  return std::ranges::all_of(gcr.communications, [](auto const &ghost_comm) {
+    auto const comm_type = ghost_comm.type & GHOST_JOBMASK;
+    return comm_type == GHOST_SEND or comm_type == GHOST_RECV or
+           comm_type == GHOST_LOCL;
+  });
+}
+
+void AsyncGhostCommunication::start(GhostCommunicator const &gcr,
+                                    BoxGeometry const &box_geo,
+                                    unsigned int data_parts) {
+  assert(not pending());
+  assert(is_supported(gcr, data_parts));
+  if (GHOSTTRANS_NONE == data_parts)
+    return;
+  impl->gcr = &gcr;
+  impl->box_geo = &box_geo;
+  impl->data_parts = data_parts;
+  impl->stage_end = 0;
+  impl->start_stage();
+  if (impl->stage_begin == gcr.communications.size()) {
+    /* only cell-to-cell transfers */
+    impl->gcr = nullptr;
+  }
+}
+
+bool AsyncGhostCommunication::test() {
+  while (pending() and
+         boost::mpi::test_all(impl->requests.begin(), impl->requests.end())) {
+    impl->finish_stage();
+  }
+  return not pending();
+}
+
+void AsyncGhostCommunication::wait() {
+  while (pending()) {
+    boost::mpi::wait_all(impl->requests.begin(), impl->requests.end());
+    impl->finish_stage();
+  }
+}
+
+bool AsyncGhostCommunication::pending() const { return impl->gcr != nullptr; }
+
 void ghost_communicator(GhostCommunicator const &gcr,
                         BoxGeometry const &box_geo, unsigned int data_parts) {
   if (GHOSTTRANS_NONE == data_parts)
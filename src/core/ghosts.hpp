@@ -93,6 +93,7 @@
 #include <boost/mpi/communicator.hpp>
 
 #include <cstddef>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -167,7 +168,61 @@ struct GhostCommunicator {
 };
 
 /**
- * @brief Do a ghost communication with the specified data parts.
+ * @brief Do a blocking ghost communication with the specified data parts.
+ * See @ref AsyncGhostCommunication for a non-blocking variant.
  */
 void ghost_communicator(GhostCommunicator const &gcr,
                         BoxGeometry const &box_geo, unsigned int data_parts);
+
+/**
+ * @brief Non-blocking ghost communication.
+ *
+ * The communications of a @ref GhostCommunicator are split into stages of
+ * consecutive communications which do not send or receive cells that are
+ * received earlier in the same stage, e.g. the exchanges with the left and
+ * right neighbors along one direction of a regular decomposition. The
+ * receives of a stage are posted up front, then the send buffers are packed
+ * and sent, and the received data is unpacked once all messages of the
+ * stage have arrived, which also starts the next stage. Cell-to-cell
+ * transfers on the same node form stages of their own.
+ *
+ * Only the transfer of data of existing particles with point-to-point
+ * communications is supported, see @ref is_supported.
+ */
+class AsyncGhostCommunication {
+public:
+  AsyncGhostCommunication();
+  ~AsyncGhostCommunication();
+
+  /**
+   * @brief Whether a ghost communication can be carried out asynchronously.
+   * This excludes updates of the particle numbers and of the bonds, and
+   * collective communications.
+   */
+  static bool is_supported(GhostCommunicator const &gcr,
+                           unsigned int data_parts);
+
+  /**
+   * @brief Start a ghost communication.
+   * The communicator and the cells have to outlive the communication.
+   */
+  void start(GhostCommunicator const &gcr, BoxGeometry const &box_geo,
+             unsigned int data_parts);
+
+  /**
+   * @brief Make progress without blocking, i.e. finish the current stage
+   * and start the next one if all its messages have arrived.
+   * @return Whether the communication is complete.
+   */
+  bool test();
+
+  /** @brief Block until the communication is complete. */
+  void wait();
+
+  /** @brief Whether a communication was started and is not complete. */
+  bool pending() const;
+
+private:
+  struct Implementation;
+  std::unique_ptr<Implementation> impl;
+};
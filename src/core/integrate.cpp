@@ -62,6 +62,8 @@
 
 #include <boost/mpi/collectives/all_reduce.hpp>
 
+#include <mpi.h>
+
 #ifdef CALIPER
 #include <caliper/cali.h>
 #endif
@@ -113,6 +115,10 @@ void LeesEdwards::set_protocol(std::shared_ptr<ActiveProtocol> protocol) {
   update_box_params(box_geo, system.get_sim_time());
   system.propagation->recalc_forces = true;
   cell_structure.set_resort_particles(Cells::RESORT_LOCAL);
+  /* the N-square bins of the hybrid decomposition depend on the shear */
+  if (cell_structure.decomposition_type() == CellStructureType::HYBRID) {
+    system.rebuild_cell_structure();
+  }
 }
 
 void LeesEdwards::unset_protocol() {
@@ -123,6 +129,10 @@ void LeesEdwards::unset_protocol() {
   box_geo.set_type(BoxType::CUBOID);
   system.propagation->recalc_forces = true;
   cell_structure.set_resort_particles(Cells::RESORT_LOCAL);
+  /* the N-square bins of the hybrid decomposition depend on the shear */
+  if (cell_structure.decomposition_type() == CellStructureType::HYBRID) {
+    system.rebuild_cell_structure();
+  }
 }
 
 } // namespace LeesEdwards
@@ -237,6 +247,20 @@ void System::System::integrator_sanity_checks() const {
       runtimeErrorMsg() << "The LB integrator requires the LB thermostat";
     }
   }
+  if (propagation->long_range_steps > 1) {
+#ifdef ELECTROSTATICS
+    if (coulomb.has_gpu_long_range_forces()) {
+      runtimeErrorMsg() << "Multiple time stepping is not supported by "
+                           "GPU electrostatics methods";
+    }
+#endif
+#ifdef DIPOLES
+    if (dipoles.has_gpu_long_range_forces()) {
+      runtimeErrorMsg() << "Multiple time stepping is not supported by "
+                           "GPU magnetostatics methods";
+    }
+#endif
+  }
   if (bonded_ias->get_n_thermalized_bonds() >= 1 and
       (thermostat->thermalized_bond == nullptr or
        (thermo_switch & THERMO_BOND) == 0)) {
@@ -475,6 +499,9 @@ int System::System::integrate(int n_steps, int reuse_forces) {
     // Communication step: distribute ghost positions
     cell_structure->update_ghosts_and_resort_particle(get_global_ghost_flags());
 
+    // Start a new cycle of the multiple time stepping
+    propagation.long_range_skipped_md_steps = 0;
+
     calculate_forces();
 
     if (propagation.integ_switch != INTEG_METHOD_STEEPEST_DESCENT) {
@@ -575,16 +602,24 @@ int System::System::integrate(int n_steps, int reuse_forces) {
     }
 #endif // VIRTUAL_SITES_RELATIVE
 
-    if (cell_structure->get_resort_particles() >= Cells::RESORT_LOCAL)
+    auto const verlet_update =
+        cell_structure->get_resort_particles() >= Cells::RESORT_LOCAL;
+    if (verlet_update)
       n_verlet_updates++;
 
-    // Communication step: distribute ghost positions
-    cell_structure->update_ghosts_and_resort_particle(get_global_ghost_flags());
+    auto const tick = MPI_Wtime();
+
+    // Communication step: distribute ghost positions, which may overlap
+    // with the force calculation
+    cell_structure->update_ghosts_and_resort_particle(
+        get_global_ghost_flags(), cell_structure->overlap_ghost_communication);
 
     particles = cell_structure->local_particles();
 
     calculate_forces();
 
+    auto const tock = MPI_Wtime();
+
 #ifdef VIRTUAL_SITES_INERTIALESS_TRACERS
     if (thermostat->lb and
         (propagation.used_propagations & PropagationMode::TRANS_LB_TRACER)) {
@@ -664,6 +699,16 @@ int System::System::integrate(int n_steps, int reuse_forces) {
       bond_breakage->process_queue(*this);
     }
 
+    // Online Verlet skin tuning, may change the skin
+    if (cell_structure->is_verlet_skin_tuning()) {
+      cell_structure->update_verlet_skin_tuning(tock - tick, verlet_update);
+    }
+
+    // Dynamic load balancing, may change the local boxes
+    if (cell_structure->is_load_balancing()) {
+      cell_structure->update_load_balancing();
+    }
+
     integrated_steps++;
 
     if (check_runtime_errors(comm_cart)) {
@@ -30,6 +30,16 @@ public:
   int default_propagation = PropagationMode::NONE;
   int lb_skipped_md_steps = 0;
   int ek_skipped_md_steps = 0;
+  /**
+   * @brief Number of MD steps between two evaluations of the long-range
+   * forces. Values larger than 1 enable multiple time stepping (r-RESPA):
+   * the long-range forces are multiplied by this number and applied as an
+   * impulse, while all other forces are evaluated at every step.
+   * The impulse is stored in the particle forces, which therefore only
+   * contain the long-range forces after an evaluation step.
+   */
+  int long_range_steps = 1;
+  int long_range_skipped_md_steps = 0;
   /** If true, forces will be recalculated before the next integration. */
   bool recalc_forces = true;
 
@@ -44,6 +54,8 @@ public:
 
   void set_integ_switch(int value) {
     integ_switch = value;
+    long_range_steps = 1;
+    long_range_skipped_md_steps = 0;
     recalc_forces = true;
   }
 };
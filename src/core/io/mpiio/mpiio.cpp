@@ -46,6 +46,15 @@
  *   <tt>id[i]</tt>. The iteration indices for local part of 1.bonds are:
  *   <tt>subarray[i] : subarray[i+1]</tt>
  * - Take a look at the bond input code. It's easy to understand.
+ *
+ * The full particle state (all properties, bonds and exclusions) is
+ * dumped in the same way as the bonds, as one archive per rank in
+ * 1.part with the archive sizes in 1.poff. Like for the other files,
+ * each rank writes and reads its own contiguous slab collectively.
+ *
+ * Lattice data, e.g. the LB populations of the local domain, is dumped
+ * as one array of doubles per rank, with the array sizes in a second
+ * file, see @ref mpi_mpiio_write_slab.
  */
 
 #include "mpiio.hpp"
@@ -178,6 +187,47 @@ static unsigned long mpi_calculate_file_offset(unsigned long n_items) {
   return offset;
 }
 
+/**
+ * @brief Serialize an object of each particle with a binary archive and
+ * dump the archives of all ranks into one file. The archive size of each
+ * rank is dumped into a second file.
+ *
+ * @param fn The file name of the archives (must not already exist!)
+ * @param fn_size The file name of the archive sizes (must not already exist!)
+ * @param particles The particles to serialize
+ * @param get Getter of the object to serialize
+ */
+template <typename F>
+static void mpiio_dump_archive(std::string const &fn,
+                               std::string const &fn_size,
+                               ParticleRange const &particles, F const &get) {
+  std::vector<char> buffer;
+
+  /* Construct archive that pushes back to the buffer */
+  {
+    namespace io = boost::iostreams;
+    io::stream_buffer<io::back_insert_device<std::vector<char>>> os{
+        io::back_inserter(buffer)};
+    boost::archive::binary_oarchive archiver{os};
+
+    for (auto const &p : particles) {
+      archiver << get(p);
+    }
+  }
+
+  // Determine the prefixes in the archive file
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  auto const buffer_size = static_cast<unsigned long>(buffer.size());
+  auto const buffer_offset = mpi_calculate_file_offset(buffer_size);
+
+  mpiio_dump_array<unsigned long>(fn_size, &buffer_size, 1ul,
+                                  static_cast<unsigned long>(rank),
+                                  MPI_UNSIGNED_LONG);
+  mpiio_dump_array<char>(fn, buffer.data(), buffer.size(), buffer_offset,
+                         MPI_CHAR);
+}
+
 /**
  * @brief Dump the fields and bond information.
  * To be called by the head node only.
@@ -188,9 +238,11 @@ static unsigned long mpi_calculate_file_offset(unsigned long n_items) {
  */
 static void dump_info(std::string const &fn, unsigned fields,
                       BondedInteractionsMap const &bonded_ias) {
-  // MPI-IO requires consecutive bond ids
+  // MPI-IO requires consecutive bond ids to dump the bond lists,
+  // the full particle state stores the bond ids as they are
   auto const nbonds = bonded_ias.size();
-  assert(static_cast<std::size_t>(bonded_ias.get_next_key()) == nbonds);
+  assert(not(fields & MPIIO_OUT_BND) or
+         static_cast<std::size_t>(bonded_ias.get_next_key()) == nbonds);
 
   FILE *f = fopen(fn.c_str(), "wb");
   if (!f) {
@@ -274,28 +326,14 @@ void mpi_mpiio_common_write(std::string const &prefix, unsigned fields,
                           MPI_INT);
 
   if (fields & MPIIO_OUT_BND) {
-    std::vector<char> bonds;
-
-    /* Construct archive that pushes back to the bond buffer */
-    {
-      namespace io = boost::iostreams;
-      io::stream_buffer<io::back_insert_device<std::vector<char>>> os{
-          io::back_inserter(bonds)};
-      boost::archive::binary_oarchive bond_archiver{os};
-
-      for (auto const &p : particles) {
-        bond_archiver << p.bonds();
-      }
-    }
-
-    // Determine the prefixes in the bond file
-    auto const bonds_size = static_cast<unsigned long>(bonds.size());
-    auto const bonds_offset = mpi_calculate_file_offset(bonds_size);
-
-    mpiio_dump_array<unsigned long>(prefix + ".boff", &bonds_size, 1ul,
-                                    pref_offset, MPI_UNSIGNED_LONG);
-    mpiio_dump_array<char>(prefix + ".bond", bonds.data(), bonds.size(),
-                           bonds_offset, MPI_CHAR);
+    mpiio_dump_archive(prefix + ".bond", prefix + ".boff", particles,
+                       [](Particle const &p) -> auto const & {
+                         return p.bonds();
+                       });
+  }
+  if (fields & MPIIO_OUT_PRT) {
+    mpiio_dump_archive(prefix + ".part", prefix + ".poff", particles,
+                       [](Particle const &p) -> auto const & { return p; });
   }
 }
 
@@ -351,6 +389,41 @@ static void mpiio_read_array(const std::string &fn, T *arr, std::size_t len,
   MPI_File_close(&f);
 }
 
+/**
+ * @brief Read the archives dumped by @ref mpiio_dump_archive and
+ * deserialize an object of each particle.
+ *
+ * @param fn The file name of the archives
+ * @param fn_size The file name of the archive sizes
+ * @param particles The particles to populate
+ * @param get Getter of the object to deserialize
+ */
+template <typename F>
+static void mpiio_read_archive(std::string const &fn,
+                               std::string const &fn_size,
+                               std::vector<Particle> &particles, F const &get) {
+  // 1 long int per process
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  unsigned long buffer_size = 0ul;
+  mpiio_read_array<unsigned long>(fn_size, &buffer_size, 1ul,
+                                  static_cast<unsigned long>(rank),
+                                  MPI_UNSIGNED_LONG);
+  auto const buffer_offset = mpi_calculate_file_offset(buffer_size);
+
+  std::vector<char> buffer(buffer_size);
+  mpiio_read_array<char>(fn, buffer.data(), buffer_size, buffer_offset,
+                         MPI_CHAR);
+
+  boost::iostreams::array_source src(buffer.data(), buffer.size());
+  boost::iostreams::stream<boost::iostreams::array_source> ss(src);
+  boost::archive::binary_iarchive ia(ss);
+
+  for (auto &p : particles) {
+    ia >> get(p);
+  }
+}
+
 /**
  * @brief Read the header file and return the first value.
  * To be called by all processes.
@@ -448,6 +521,14 @@ void mpi_mpiio_common_read(const std::string &prefix, unsigned fields,
     }
   }
 
+  if (fields & MPIIO_OUT_PRT) {
+    // 1.poff and 1.part on all nodes:
+    // Read the full state of the local particles, which may be
+    // partially overwritten by the fields read below.
+    mpiio_read_archive(prefix + ".part", prefix + ".poff", particles,
+                       [](Particle &p) -> Particle & { return p; });
+  }
+
   if (fields & MPIIO_OUT_POS) {
     // 1.pos on all nodes:
     // Read nlocalpart * 3 doubles at defined prefix * 3
@@ -491,31 +572,52 @@ void mpi_mpiio_common_read(const std::string &prefix, unsigned fields,
   }
 
   if (fields & MPIIO_OUT_BND) {
-    // 1.boff
-    // 1 long int per process
-    auto const pref_offset = static_cast<unsigned long>(rank);
-    unsigned long bonds_size = 0u;
-    mpiio_read_array<unsigned long>(prefix + ".boff", &bonds_size, 1ul,
-                                    pref_offset, MPI_UNSIGNED_LONG);
-    auto const bonds_offset = mpi_calculate_file_offset(bonds_size);
-
-    // 1.bond
-    // nlocalbonds ints per process
-    std::vector<char> bond(bonds_size);
-    mpiio_read_array<char>(prefix + ".bond", bond.data(), bonds_size,
-                           bonds_offset, MPI_CHAR);
-
-    boost::iostreams::array_source src(bond.data(), bond.size());
-    boost::iostreams::stream<boost::iostreams::array_source> ss(src);
-    boost::archive::binary_iarchive ia(ss);
-
-    for (auto &p : particles) {
-      ia >> p.bonds();
-    }
+    // 1.boff and 1.bond on all nodes:
+    // Read the size of the local bond archive and the archive itself.
+    mpiio_read_archive(prefix + ".bond", prefix + ".boff", particles,
+                       [](Particle &p) -> auto & { return p.bonds(); });
   }
 
   for (auto &p : particles) {
     cell_structure.add_particle(std::move(p));
   }
 }
+
+void mpi_mpiio_write_slab(std::string const &fn, std::string const &fn_size,
+                          std::vector<double> const &data) {
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  auto const slab_size = static_cast<unsigned long>(data.size());
+  auto const slab_offset = mpi_calculate_file_offset(slab_size);
+
+  mpiio_dump_array<unsigned long>(fn_size, &slab_size, 1ul,
+                                  static_cast<unsigned long>(rank),
+                                  MPI_UNSIGNED_LONG);
+  mpiio_dump_array<double>(fn, data.data(), data.size(), slab_offset,
+                           MPI_DOUBLE);
+}
+
+std::vector<double> mpi_mpiio_read_slab(std::string const &fn,
+                                        std::string const &fn_size) {
+  int size, rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  auto const nproc = get_num_elem(fn_size, sizeof(unsigned long));
+
+  if (rank == 0 && nproc != static_cast<unsigned long>(size)) {
+    fatal_error("Trying to read a file with a different COMM "
+                "size than at point of writing.");
+  }
+
+  unsigned long slab_size = 0ul;
+  mpiio_read_array<unsigned long>(fn_size, &slab_size, 1ul,
+                                  static_cast<unsigned long>(rank),
+                                  MPI_UNSIGNED_LONG);
+  auto const slab_offset = mpi_calculate_file_offset(slab_size);
+
+  std::vector<double> data(slab_size);
+  mpiio_read_array<double>(fn, data.data(), slab_size, slab_offset,
+                           MPI_DOUBLE);
+  return data;
+}
 } // namespace Mpiio
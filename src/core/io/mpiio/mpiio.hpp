@@ -30,6 +30,7 @@
 #include "cell_system/CellStructure.hpp"
 
 #include <string>
+#include <vector>
 
 namespace Mpiio {
 
@@ -44,6 +45,8 @@ enum MPIIOOutputFields : unsigned int {
   MPIIO_OUT_VEL = 2u,
   MPIIO_OUT_TYP = 4u,
   MPIIO_OUT_BND = 8u,
+  /** Full particle state, including bonds and exclusions. */
+  MPIIO_OUT_PRT = 16u,
 };
 
 struct write_buffers {
@@ -83,4 +86,32 @@ void mpi_mpiio_common_write(std::string const &prefix, unsigned fields,
 void mpi_mpiio_common_read(std::string const &prefix, unsigned fields,
                            CellStructure &cell_structure);
 
+/**
+ * @brief Parallel binary output of one array of doubles per MPI rank.
+ * The arrays of all ranks are dumped as contiguous slabs into one file,
+ * and the array size of each rank is dumped into a second file.
+ * To be called by all MPI processes. Aborts ESPResSo if an error occurs.
+ * On 1 MPI rank, the error is converted to a runtime error.
+ *
+ * @param fn The file name of the slabs (must not already exist!)
+ * @param fn_size The file name of the slab sizes (must not already exist!)
+ * @param data The local array.
+ */
+void mpi_mpiio_write_slab(std::string const &fn, std::string const &fn_size,
+                          std::vector<double> const &data);
+
+/**
+ * @brief Parallel binary input of the arrays dumped by
+ * @ref mpi_mpiio_write_slab.
+ * To be called by all MPI processes, with the same number of processes
+ * that wrote the files. Aborts ESPResSo if an error occurs.
+ * On 1 MPI rank, the error is converted to a runtime error.
+ *
+ * @param fn The file name of the slabs.
+ * @param fn_size The file name of the slab sizes.
+ * @return The array written by the same rank.
+ */
+std::vector<double> mpi_mpiio_read_slab(std::string const &fn,
+                                        std::string const &fn_size);
+
 } // namespace Mpiio
@@ -277,6 +277,7 @@ void File::create_file(const std::string &file_path) {
 }
 
 void File::close() {
+  write_frames();
   if (m_comm.rank() == 0)
     boost::filesystem::remove(m_backup_filename);
 }
@@ -286,196 +287,306 @@ namespace detail {
 template <std::size_t rank> struct slice_info {};
 
 template <> struct slice_info<3> {
-  static auto extent(hsize_t n_part_diff) {
-    return Vector3hs{1, n_part_diff, 0};
+  static auto extent(hsize_t n_frames, hsize_t n_part_diff) {
+    return Vector3hs{n_frames, n_part_diff, 0};
+  }
+  static auto count(hsize_t n_part_local) {
+    return Vector3hs{1, n_part_local, 3};
   }
-  static constexpr auto count() { return Vector3hs{1, 1, 3}; }
   static auto offset(hsize_t n_time_steps, hsize_t prefix) {
     return Vector3hs{n_time_steps, prefix, 0};
   }
 };
 
 template <> struct slice_info<2> {
-  static auto extent(hsize_t n_part_diff) { return Vector2hs{1, n_part_diff}; }
-  static constexpr auto count() { return Vector2hs{1, 1}; }
+  static auto extent(hsize_t n_frames, hsize_t n_part_diff) {
+    return Vector2hs{n_frames, n_part_diff};
+  }
+  static auto count(hsize_t n_part_local) {
+    return Vector2hs{1, n_part_local};
+  }
   static auto offset(hsize_t n_time_steps, hsize_t prefix) {
     return Vector2hs{n_time_steps, prefix};
   }
 };
 
+/** @brief Copy per-particle values to a contiguous block of one frame. */
+template <typename T> auto make_block(std::vector<T> const &values) {
+  auto const n = static_cast<boost::multi_array_types::index>(values.size());
+  boost::multi_array<T, 2> block(boost::extents[1][n]);
+  std::ranges::copy(values, block.data());
+  return block;
+}
+
+template <typename T, std::size_t N>
+auto make_block(std::vector<Utils::Vector<T, N>> const &values) {
+  auto const n = static_cast<boost::multi_array_types::index>(values.size());
+  boost::multi_array<T, 3> block(boost::extents[1][n][N]);
+  auto it = block.data();
+  for (auto const &value : values) {
+    it = std::ranges::copy(value, it).out;
+  }
+  return block;
+}
+
 } // namespace detail
 
-template <std::size_t dim, typename Op>
-void write_td_particle_property(hsize_t prefix, hsize_t n_part_global,
-                                ParticleRange const &particles,
-                                h5xx::dataset &dataset, Op op) {
+/**
+ * @brief Write a time-dependent particle property of the buffered frames.
+ * The dataset is extended once for all frames, and each node writes
+ * the values of its particles as one block per frame.
+ */
+template <std::size_t dim, typename Frames, typename Op>
+void write_td_particle_property(Frames const &frames,
+                                std::vector<int> const &prefixes,
+                                hsize_t n_part_global, h5xx::dataset &dataset,
+                                Op op) {
   auto const old_extents = static_cast<h5xx::dataspace>(dataset).extents();
   auto const extent_particle_number =
       std::max(n_part_global, old_extents[1]) - old_extents[1];
-  extend_dataset(dataset,
-                 detail::slice_info<dim>::extent(extent_particle_number));
-  auto const count = detail::slice_info<dim>::count();
-  auto offset = detail::slice_info<dim>::offset(old_extents[0], prefix);
-  for (auto const &p : particles) {
-    h5xx::write_dataset(dataset, op(p), h5xx::slice(offset, count));
-    // advance in the particle dimension
-    offset[1] += 1;
+  extend_dataset(dataset, detail::slice_info<dim>::extent(
+                              frames.size(), extent_particle_number));
+  for (std::size_t i = 0u; i < frames.size(); ++i) {
+    auto const &values = op(frames[i]);
+    if (values.empty()) {
+      continue;
+    }
+    auto const offset = detail::slice_info<dim>::offset(
+        old_extents[0] + i, static_cast<hsize_t>(prefixes[i]));
+    auto const count = detail::slice_info<dim>::count(values.size());
+    h5xx::write_dataset(dataset, detail::make_block(values),
+                        h5xx::slice(offset, count));
   }
 }
 
-static void write_box(BoxGeometry const &box_geo, h5xx::dataset &dataset) {
+/** @brief Write a time series of values which are the same on all nodes. */
+template <typename T, std::size_t N, typename Frames, typename Op>
+static void write_td_box_property(Frames const &frames, h5xx::dataset &dataset,
+                                  Op op) {
+  auto const n_frames = static_cast<hsize_t>(frames.size());
   auto const extents = static_cast<h5xx::dataspace>(dataset).extents();
-  extend_dataset(dataset, Vector2hs{1, 0});
-  h5xx::write_dataset(dataset, box_geo.length(),
-                      h5xx::slice(Vector2hs{extents[0], 0}, Vector2hs{1, 3}));
+  boost::multi_array<T, 2> block(
+      boost::extents[static_cast<boost::multi_array_types::index>(n_frames)]
+                    [N]);
+  auto it = block.data();
+  for (auto const &frame : frames) {
+    it = std::ranges::copy(op(frame), it).out;
+  }
+  extend_dataset(dataset, Vector2hs{n_frames, 0});
+  h5xx::write_dataset(dataset, block,
+                      h5xx::slice(Vector2hs{extents[0], 0},
+                                  Vector2hs{n_frames, N}));
 }
 
-static void write_le_off(LeesEdwardsBC const &lebc, h5xx::dataset &dataset) {
-  auto const extents = static_cast<h5xx::dataspace>(dataset).extents();
-  extend_dataset(dataset, Vector2hs{1, 0});
-  h5xx::write_dataset(dataset, Utils::Vector<double, 1>{lebc.pos_offset},
-                      h5xx::slice(Vector2hs{extents[0], 0}, Vector2hs{1, 1}));
-}
+void File::write(const ParticleRange &particles, double time, int step,
+                 BoxGeometry const &box_geo) {
+  auto const &lebc = box_geo.lees_edwards_bc();
+  auto &frame = m_frames.emplace_back();
+  frame.time = time;
+  frame.step = step;
+  frame.box_l = box_geo.length();
+  frame.le_offset = lebc.pos_offset;
+  frame.le_direction = static_cast<int>(lebc.shear_direction);
+  frame.le_normal = static_cast<int>(lebc.shear_plane_normal);
+
+  auto const n_part_local = particles.size();
+  frame.id.reserve(n_part_local);
+  for (auto const &p : particles) {
+    frame.id.emplace_back(p.id());
+  }
+  auto const snapshot = [&](unsigned int field, auto &values, auto op) {
+    if (m_fields & field) {
+      values.reserve(n_part_local);
+      for (auto const &p : particles) {
+        values.emplace_back(op(p));
+      }
+    }
+  };
+  snapshot(H5MD_OUT_TYPE, frame.type, [](auto const &p) { return p.type(); });
+  snapshot(H5MD_OUT_MASS, frame.mass, [](auto const &p) { return p.mass(); });
+  snapshot(H5MD_OUT_POS, frame.pos, [&](auto const &p) {
+    return box_geo.folded_position(p.pos());
+  });
+  snapshot(H5MD_OUT_IMG, frame.image, [&](auto const &p) {
+    return box_geo.folded_image_box(p.pos(), p.image_box());
+  });
+  snapshot(H5MD_OUT_VEL, frame.vel, [](auto const &p) { return p.v(); });
+  snapshot(H5MD_OUT_FORCE, frame.force,
+           [](auto const &p) { return p.force(); });
+  snapshot(H5MD_OUT_CHARGE, frame.charge,
+           [](auto const &p) { return p.q(); });
+  if (m_fields & H5MD_OUT_BONDS) {
+    for (auto const &p : particles) {
+      for (auto const b : p.bonds()) {
+        auto const partner_ids = b.partner_ids();
+        if (partner_ids.size() == 1u) {
+          frame.bonds.emplace_back(p.id());
+          frame.bonds.emplace_back(partner_ids[0]);
+        }
+      }
+    }
+  }
 
-static void write_le_dir(LeesEdwardsBC const &lebc, h5xx::dataset &dataset) {
-  auto const shear_direction = static_cast<int>(lebc.shear_direction);
-  auto const extents = static_cast<h5xx::dataspace>(dataset).extents();
-  extend_dataset(dataset, Vector2hs{1, 0});
-  h5xx::write_dataset(dataset, Utils::Vector<int, 1>{shear_direction},
-                      h5xx::slice(Vector2hs{extents[0], 0}, Vector2hs{1, 1}));
+  if (m_frames.size() >= static_cast<std::size_t>(m_buffer_size)) {
+    write_frames();
+  }
 }
 
-static void write_le_normal(LeesEdwardsBC const &lebc, h5xx::dataset &dataset) {
-  auto const shear_plane_normal = static_cast<int>(lebc.shear_plane_normal);
-  auto const extents = static_cast<h5xx::dataspace>(dataset).extents();
-  extend_dataset(dataset, Vector2hs{1, 0});
-  h5xx::write_dataset(dataset, Utils::Vector<int, 1>{shear_plane_normal},
-                      h5xx::slice(Vector2hs{extents[0], 0}, Vector2hs{1, 1}));
+/**
+ * @brief Calculate the offset of the data of this node in each frame,
+ * and the maximal total number of elements of all frames.
+ */
+static auto write_offsets(boost::mpi::communicator const &comm,
+                          std::vector<int> const &n_local) {
+  auto const n_frames = static_cast<int>(n_local.size());
+  std::vector<int> prefixes(n_local.size(), 0);
+  BOOST_MPI_CHECK_RESULT(MPI_Exscan, (n_local.data(), prefixes.data(),
+                                      n_frames, MPI_INT, MPI_SUM, comm));
+  if (comm.rank() == 0) {
+    // the receive buffer is undefined on the first rank
+    std::ranges::fill(prefixes, 0);
+  }
+  std::vector<int> n_global(n_local.size());
+  boost::mpi::all_reduce(comm, n_local.data(), n_frames, n_global.data(),
+                         std::plus<int>());
+  auto const n_max = std::ranges::max(n_global);
+  return std::make_pair(std::move(prefixes), static_cast<hsize_t>(n_max));
 }
 
-void File::write(const ParticleRange &particles, double time, int step,
-                 BoxGeometry const &box_geo) {
+void File::write_frames() {
+  if (m_frames.empty()) {
+    return;
+  }
+  auto const &frames = m_frames;
+  auto const n_frames = static_cast<hsize_t>(frames.size());
+
   if (m_fields & H5MD_OUT_BOX_L) {
-    write_box(box_geo, datasets["particles/atoms/box/edges/value"]);
+    write_td_box_property<double, 3>(
+        frames, datasets["particles/atoms/box/edges/value"],
+        [](Frame const &frame) { return frame.box_l; });
   }
-  auto const &lebc = box_geo.lees_edwards_bc();
   if (m_fields & H5MD_OUT_LE_OFF) {
-    write_le_off(lebc, datasets["particles/atoms/lees_edwards/offset/value"]);
+    write_td_box_property<double, 1>(
+        frames, datasets["particles/atoms/lees_edwards/offset/value"],
+        [](Frame const &frame) {
+          return Utils::Vector<double, 1>{frame.le_offset};
+        });
   }
   if (m_fields & H5MD_OUT_LE_DIR) {
-    write_le_dir(lebc,
-                 datasets["particles/atoms/lees_edwards/direction/value"]);
+    write_td_box_property<int, 1>(
+        frames, datasets["particles/atoms/lees_edwards/direction/value"],
+        [](Frame const &frame) {
+          return Utils::Vector<int, 1>{frame.le_direction};
+        });
   }
   if (m_fields & H5MD_OUT_LE_NORMAL) {
-    write_le_normal(lebc,
-                    datasets["particles/atoms/lees_edwards/normal/value"]);
+    write_td_box_property<int, 1>(
+        frames, datasets["particles/atoms/lees_edwards/normal/value"],
+        [](Frame const &frame) {
+          return Utils::Vector<int, 1>{frame.le_normal};
+        });
   }
 
-  auto const n_part_local = static_cast<int>(particles.size());
-  // calculate count and offset
-  int prefix = 0;
-  // calculate prefix for write of the current process
-  BOOST_MPI_CHECK_RESULT(MPI_Exscan,
-                         (&n_part_local, &prefix, 1, MPI_INT, MPI_SUM, m_comm));
-
-  auto const n_part_global =
-      boost::mpi::all_reduce(m_comm, n_part_local, std::plus<int>());
+  std::vector<int> n_part_local;
+  for (auto const &frame : frames) {
+    n_part_local.emplace_back(static_cast<int>(frame.id.size()));
+  }
+  auto const [prefixes, n_part_global] = write_offsets(m_comm, n_part_local);
 
+  auto const time_offset = static_cast<h5xx::dataspace>(
+                               datasets["particles/atoms/id/value"])
+                               .extents()[0];
   write_td_particle_property<2>(
-      prefix, n_part_global, particles, datasets["particles/atoms/id/value"],
-      [](auto const &p) { return Utils::Vector<int, 1>{p.id()}; });
+      frames, prefixes, n_part_global, datasets["particles/atoms/id/value"],
+      [](Frame const &frame) -> auto const & { return frame.id; });
 
   {
-    h5xx::dataset &dataset = datasets["particles/atoms/id/value"];
-    auto const extents = static_cast<h5xx::dataspace>(dataset).extents();
-    write_dataset(Utils::Vector<double, 1>{time},
-                  datasets["particles/atoms/id/time"], Vector1hs{1},
-                  Vector1hs{extents[0]}, Vector1hs{1});
-    write_dataset(Utils::Vector<int, 1>{step},
-                  datasets["particles/atoms/id/step"], Vector1hs{1},
-                  Vector1hs{extents[0]}, Vector1hs{1});
+    boost::multi_array<double, 1> time(boost::extents[frames.size()]);
+    boost::multi_array<int, 1> step(boost::extents[frames.size()]);
+    for (std::size_t i = 0u; i < frames.size(); ++i) {
+      time[i] = frames[i].time;
+      step[i] = frames[i].step;
+    }
+    write_dataset(time, datasets["particles/atoms/id/time"],
+                  Vector1hs{n_frames}, Vector1hs{time_offset},
+                  Vector1hs{n_frames});
+    write_dataset(step, datasets["particles/atoms/id/step"],
+                  Vector1hs{n_frames}, Vector1hs{time_offset},
+                  Vector1hs{n_frames});
   }
 
   if (m_fields & H5MD_OUT_TYPE) {
     write_td_particle_property<2>(
-        prefix, n_part_global, particles,
+        frames, prefixes, n_part_global,
         datasets["particles/atoms/species/value"],
-        [](auto const &p) { return Utils::Vector<int, 1>{p.type()}; });
+        [](Frame const &frame) -> auto const & { return frame.type; });
   }
   if (m_fields & H5MD_OUT_MASS) {
     write_td_particle_property<2>(
-        prefix, n_part_global, particles,
-        datasets["particles/atoms/mass/value"],
-        [](auto const &p) { return Utils::Vector<double, 1>{p.mass()}; });
+        frames, prefixes, n_part_global, datasets["particles/atoms/mass/value"],
+        [](Frame const &frame) -> auto const & { return frame.mass; });
   }
   if (m_fields & H5MD_OUT_POS) {
     write_td_particle_property<3>(
-        prefix, n_part_global, particles,
+        frames, prefixes, n_part_global,
         datasets["particles/atoms/position/value"],
-        [&](auto const &p) { return box_geo.folded_position(p.pos()); });
+        [](Frame const &frame) -> auto const & { return frame.pos; });
   }
   if (m_fields & H5MD_OUT_IMG) {
     write_td_particle_property<3>(
-        prefix, n_part_global, particles,
-        datasets["particles/atoms/image/value"], [&](auto const &p) {
-          return box_geo.folded_image_box(p.pos(), p.image_box());
-        });
+        frames, prefixes, n_part_global,
+        datasets["particles/atoms/image/value"],
+        [](Frame const &frame) -> auto const & { return frame.image; });
   }
   if (m_fields & H5MD_OUT_VEL) {
-    write_td_particle_property<3>(prefix, n_part_global, particles,
-                                  datasets["particles/atoms/velocity/value"],
-                                  [](auto const &p) { return p.v(); });
+    write_td_particle_property<3>(
+        frames, prefixes, n_part_global,
+        datasets["particles/atoms/velocity/value"],
+        [](Frame const &frame) -> auto const & { return frame.vel; });
   }
   if (m_fields & H5MD_OUT_FORCE) {
-    write_td_particle_property<3>(prefix, n_part_global, particles,
-                                  datasets["particles/atoms/force/value"],
-                                  [](auto const &p) { return p.force(); });
+    write_td_particle_property<3>(
+        frames, prefixes, n_part_global,
+        datasets["particles/atoms/force/value"],
+        [](Frame const &frame) -> auto const & { return frame.force; });
   }
   if (m_fields & H5MD_OUT_CHARGE) {
     write_td_particle_property<2>(
-        prefix, n_part_global, particles,
+        frames, prefixes, n_part_global,
         datasets["particles/atoms/charge/value"],
-        [](auto const &p) { return Utils::Vector<double, 1>{p.q()}; });
+        [](Frame const &frame) -> auto const & { return frame.charge; });
   }
   if (m_fields & H5MD_OUT_BONDS) {
-    write_connectivity(particles);
+    write_connectivity();
   }
+  m_frames.clear();
 }
 
-void File::write_connectivity(const ParticleRange &particles) {
-  MultiArray3i bond(boost::extents[0][0][0]);
-  for (auto const &p : particles) {
-    auto nbonds_local = static_cast<decltype(bond)::index>(bond.shape()[1]);
-    for (auto const b : p.bonds()) {
-      auto const partner_ids = b.partner_ids();
-      if (partner_ids.size() == 1u) {
-        bond.resize(boost::extents[1][nbonds_local + 1][2]);
-        bond[0][nbonds_local][0] = p.id();
-        bond[0][nbonds_local][1] = partner_ids[0];
-        nbonds_local++;
-      }
-    }
+void File::write_connectivity() {
+  auto &dataset = datasets["connectivity/atoms/value"];
+  std::vector<int> n_bonds_local;
+  for (auto const &frame : m_frames) {
+    n_bonds_local.emplace_back(static_cast<int>(frame.bonds.size() / 2u));
+  }
+  auto const [prefixes, n_bonds_total] = write_offsets(m_comm, n_bonds_local);
+  auto const extents = static_cast<h5xx::dataspace>(dataset).extents();
+  auto const n_bond_diff = std::max(n_bonds_total, extents[1]) - extents[1];
+  extend_dataset(dataset, Vector3hs{m_frames.size(), n_bond_diff, 0});
+  for (std::size_t i = 0u; i < m_frames.size(); ++i) {
+    auto const n_bonds = n_bonds_local[i];
+    MultiArray3i bond(boost::extents[1][n_bonds][2]);
+    std::ranges::copy(m_frames[i].bonds, bond.data());
+    Vector3hs offset_bonds = {extents[0] + i,
+                              static_cast<hsize_t>(prefixes[i]), 0};
+    Vector3hs count_bonds = {1, static_cast<hsize_t>(n_bonds), 2};
+    h5xx::write_dataset(dataset, bond, h5xx::slice(offset_bonds, count_bonds));
   }
-
-  auto const n_bonds_local = static_cast<int>(bond.shape()[1]);
-  int prefix_bonds = 0;
-  BOOST_MPI_CHECK_RESULT(
-      MPI_Exscan, (&n_bonds_local, &prefix_bonds, 1, MPI_INT, MPI_SUM, m_comm));
-  auto const n_bonds_total =
-      boost::mpi::all_reduce(m_comm, n_bonds_local, std::plus<int>());
-  auto const extents =
-      static_cast<h5xx::dataspace>(datasets["connectivity/atoms/value"])
-          .extents();
-  Vector3hs offset_bonds = {extents[0], static_cast<hsize_t>(prefix_bonds), 0};
-  Vector3hs count_bonds = {1, static_cast<hsize_t>(n_bonds_local), 2};
-  auto const n_bond_diff =
-      std::max(static_cast<hsize_t>(n_bonds_total), extents[1]) - extents[1];
-  Vector3hs change_extent_bonds = {1, static_cast<hsize_t>(n_bond_diff), 0};
-  write_dataset(bond, datasets["connectivity/atoms/value"], change_extent_bonds,
-                offset_bonds, count_bonds);
 }
 
-void File::flush() { m_h5md_file.flush(); }
+void File::flush() {
+  write_frames();
+  m_h5md_file.flush();
+}
 
 } /* namespace H5md */
 } /* namespace Writer */
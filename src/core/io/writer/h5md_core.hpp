@@ -39,6 +39,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace h5xx {
 template <typename T, std::size_t size>
@@ -113,12 +114,14 @@ public:
    * @param force_unit The unit for force.
    * @param velocity_unit The unit for velocity.
    * @param charge_unit The unit for charge.
+   * @param buffer_size Number of frames to buffer before writing them.
    * @param comm The MPI communicator.
    */
   File(std::string file_path, std::string script_path,
        std::vector<std::string> const &output_fields, std::string mass_unit,
        std::string length_unit, std::string time_unit, std::string force_unit,
        std::string velocity_unit, std::string charge_unit,
+       int buffer_size = 1,
        boost::mpi::communicator comm = boost::mpi::communicator())
       : m_script_path(std::move(script_path)),
         m_mass_unit(std::move(mass_unit)),
@@ -127,19 +130,26 @@ public:
         m_velocity_unit(std::move(velocity_unit)),
         m_charge_unit(std::move(charge_unit)), m_comm(std::move(comm)),
         m_fields(fields_list_to_bitfield(output_fields)),
-        m_h5md_specification(m_fields) {
+        m_buffer_size(buffer_size), m_h5md_specification(m_fields) {
+    if (m_buffer_size < 1) {
+      throw std::domain_error("Parameter 'buffer_size' must be >= 1");
+    }
     init_file(file_path);
   }
   ~File() = default;
 
   /**
-   * @brief Method to perform the renaming of the temporary file from
-   * "filename" + ".bak" to "filename".
+   * @brief Write the buffered frames and perform the renaming of the
+   * temporary file from "filename" + ".bak" to "filename".
    */
   void close();
 
   /**
    * @brief Write data to the hdf5 file.
+   *
+   * The data of the local particles is copied to the frame buffer,
+   * which is written to the file once it holds @ref buffer_size frames.
+   *
    * @param particles Particle range for which to write data.
    * @param time Simulation time.
    * @param step Simulation step (monotonically increasing).
@@ -196,6 +206,12 @@ public:
    */
   auto const &charge_unit() const { return m_charge_unit; }
 
+  /**
+   * @brief Retrieve the number of frames which are buffered before
+   * they are written to disk.
+   */
+  auto buffer_size() const { return m_buffer_size; }
+
   /**
    * @brief Build the list of valid output fields.
    * @return The list as a vector of strings.
@@ -214,6 +230,26 @@ public:
   void flush();
 
 private:
+  /** @brief Snapshot of the local particle data of one time step. */
+  struct Frame {
+    double time;
+    int step;
+    Utils::Vector3d box_l;
+    double le_offset;
+    int le_direction;
+    int le_normal;
+    std::vector<int> id;
+    std::vector<int> type;
+    std::vector<double> mass;
+    std::vector<double> charge;
+    std::vector<Utils::Vector3d> pos;
+    std::vector<Utils::Vector3i> image;
+    std::vector<Utils::Vector3d> vel;
+    std::vector<Utils::Vector3d> force;
+    /** Pair bonds, as the particle id followed by the partner id. */
+    std::vector<int> bonds;
+  };
+
   /**
    * @brief Initialize the File object.
    */
@@ -247,11 +283,16 @@ private:
    */
   void load_datasets();
 
+  /**
+   * @brief Write the buffered frames to the file and clear the buffer.
+   * Each node writes one contiguous block per dataset and frame.
+   */
+  void write_frames();
+
   /**
    * @brief Write the particle bonds (currently only pairs).
-   * @param particles Particle range for which to write bonds.
    */
-  void write_connectivity(const ParticleRange &particles);
+  void write_connectivity();
   /**
    * @brief Write the unit attributes.
    */
@@ -271,6 +312,8 @@ private:
   std::string m_charge_unit;
   boost::mpi::communicator m_comm;
   unsigned int m_fields;
+  int m_buffer_size;
+  std::vector<Frame> m_frames;
   std::string m_backup_filename;
   boost::filesystem::path m_absolute_script_path;
   h5xx::file m_h5md_file;
@@ -46,7 +46,7 @@ struct LBNone {
                         Utils::Vector3d const &) const {
     throw NoLBActive{};
   }
-  void add_forces_at_pos(std::vector<Utils::Vector3d> const &,
+  bool add_forces_at_pos(std::vector<Utils::Vector3d> const &,
                          std::vector<Utils::Vector3d> const &) const {
     throw NoLBActive{};
   }
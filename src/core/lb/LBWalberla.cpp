@@ -78,9 +78,9 @@ bool LBWalberla::add_force_at_pos(Utils::Vector3d const &pos,
   return lb_fluid->add_force_at_pos(pos, force);
 }
 
-void LBWalberla::add_forces_at_pos(std::vector<Utils::Vector3d> const &pos,
+bool LBWalberla::add_forces_at_pos(std::vector<Utils::Vector3d> const &pos,
                                    std::vector<Utils::Vector3d> const &forces) {
-  lb_fluid->add_forces_at_pos(pos, forces);
+  return lb_fluid->add_forces_at_pos(pos, forces);
 }
 
 std::vector<Utils::Vector3d>
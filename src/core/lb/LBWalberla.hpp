@@ -67,7 +67,7 @@ struct LBWalberla {
   Utils::Vector3d get_momentum() const;
   bool add_force_at_pos(Utils::Vector3d const &pos,
                         Utils::Vector3d const &force);
-  void add_forces_at_pos(std::vector<Utils::Vector3d> const &pos,
+  bool add_forces_at_pos(std::vector<Utils::Vector3d> const &pos,
                          std::vector<Utils::Vector3d> const &forces);
   std::vector<Utils::Vector3d>
   get_velocities_at_pos(std::vector<Utils::Vector3d> const &pos);
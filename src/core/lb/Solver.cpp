@@ -27,6 +27,7 @@
 #include "lb/LBWalberla.hpp"
 
 #include "BoxGeometry.hpp"
+#include "cell_system/CellStructure.hpp"
 #include "system/System.hpp"
 #include "thermostat.hpp"
 
@@ -61,6 +62,18 @@ static void check_solver(std::unique_ptr<Solver::Implementation> const &ptr) {
   }
 }
 
+/** @brief Deactivate the solver if the load balancing is active. */
+static void
+check_load_balancing_support(System::System const &system,
+                             std::unique_ptr<Solver::Implementation> &ptr) {
+  try {
+    system.cell_structure->check_load_balancing_support();
+  } catch (...) {
+    ptr->solver = std::nullopt;
+    throw;
+  }
+}
+
 bool Solver::is_solver_set() const { return LB::is_solver_set(impl); }
 
 void Solver::reset() {
@@ -232,9 +245,9 @@ std::vector<Utils::Vector3d> Solver::get_coupling_interpolated_velocities(
       *impl->solver);
 }
 
-void Solver::add_forces_at_pos(std::vector<Utils::Vector3d> const &pos,
+bool Solver::add_forces_at_pos(std::vector<Utils::Vector3d> const &pos,
                                std::vector<Utils::Vector3d> const &forces) {
-  std::visit(
+  return std::visit(
       [&](auto &ptr) {
         std::vector<Utils::Vector3d> pos_lb;
         std::vector<Utils::Vector3d> force_lb;
@@ -246,7 +259,7 @@ void Solver::add_forces_at_pos(std::vector<Utils::Vector3d> const &pos,
         for (auto const &force_md : forces) {
           force_lb.emplace_back(force_md * m_conv.force_to_lb);
         }
-        ptr->add_forces_at_pos(pos_lb, force_lb);
+        return ptr->add_forces_at_pos(pos_lb, force_lb);
       },
       *impl->solver);
 }
@@ -273,6 +286,7 @@ template <> void Solver::set<LBNone>(std::shared_ptr<LBNone> lb_instance) {
   assert(impl);
   assert(not impl->solver.has_value());
   impl->solver = lb_instance;
+  check_load_balancing_support(get_system(), impl);
 }
 
 #ifdef WALBERLA
@@ -287,6 +301,7 @@ void Solver::set<LBWalberla>(std::shared_ptr<LBWalberlaBase> lb_fluid,
   auto const &lebc = system.box_geo->lees_edwards_bc();
   lb_fluid->check_lebc(lebc.shear_direction, lebc.shear_plane_normal);
   impl->solver = lb_instance;
+  check_load_balancing_support(system, impl);
   auto const agrid = lb_instance->get_agrid();
   auto const tau = lb_instance->get_tau();
   m_conv = Conversions{1. / agrid, agrid / tau, tau * tau / agrid};
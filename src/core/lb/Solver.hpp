@@ -152,7 +152,13 @@ struct Solver : public System::Leaf<Solver> {
   std::vector<Utils::Vector3d> get_coupling_interpolated_velocities(
       std::vector<Utils::Vector3d> const &pos) const;
 
-  void add_forces_at_pos(std::vector<Utils::Vector3d> const &pos,
+  /**
+   * @brief Add forces to the fluid at the given positions.
+   * @param pos     Positions in MD units.
+   * @param forces  Forces in MD units.
+   * @return False if any position is outside the local halo.
+   */
+  bool add_forces_at_pos(std::vector<Utils::Vector3d> const &pos,
                          std::vector<Utils::Vector3d> const &forces);
 
   /**
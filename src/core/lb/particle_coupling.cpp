@@ -164,20 +164,27 @@ std::vector<Utils::Vector3d> positions_in_halo(Utils::Vector3d const &pos,
                                                BoxGeometry const &box_geo,
                                                LocalBox const &local_box,
                                                double agrid) {
+  std::vector<Utils::Vector3d> res;
+  positions_in_halo(pos, box_geo, local_box, agrid, res);
+  return res;
+}
+
+void positions_in_halo(Utils::Vector3d const &pos, BoxGeometry const &box_geo,
+                       LocalBox const &local_box, double agrid,
+                       std::vector<Utils::Vector3d> &res) {
   auto const halo = 0.5 * agrid;
   auto const halo_vec = Utils::Vector3d::broadcast(halo);
   auto const fully_inside_lower = local_box.my_left() + 2. * halo_vec;
   auto const fully_inside_upper = local_box.my_right() - 2. * halo_vec;
   auto const pos_folded = box_geo.folded_position(pos);
   if (in_box(pos_folded, fully_inside_lower, fully_inside_upper)) {
-    return {pos_folded};
+    res.emplace_back(pos_folded);
+    return;
   }
   auto const halo_lower_corner = local_box.my_left() - halo_vec;
   auto const halo_upper_corner = local_box.my_right() + halo_vec;
-  std::vector<Utils::Vector3d> res;
   positions_in_halo_impl(pos_folded, halo_lower_corner, halo_upper_corner,
                          box_geo, res);
-  return res;
 }
 
 static auto lees_edwards_vel_shift(Utils::Vector3d const &pos_shifted_by_box_l,
@@ -229,6 +236,10 @@ void ParticleCoupling::kernel(std::vector<Particle *> const &particles) {
   std::vector<Utils::Vector3d> force_coupling_forces;
   std::vector<uint8_t> positions_force_coupling_counter;
   std::vector<Particle *> coupled_particles;
+  positions_velocity_coupling.reserve(particles.size());
+  positions_force_coupling.reserve(particles.size());
+  positions_force_coupling_counter.reserve(particles.size());
+  coupled_particles.reserve(particles.size());
   for (auto ptr : particles) {
     auto &p = *ptr;
     auto span_size = 1u;
@@ -274,6 +285,7 @@ void ParticleCoupling::kernel(std::vector<Particle *> const &particles) {
   auto interpolated_velocities =
       m_lb.get_coupling_interpolated_velocities(positions_velocity_coupling);
 
+  force_coupling_forces.reserve(positions_force_coupling.size());
   auto const &domain_lower_corner = m_local_box.my_left();
   auto const &domain_upper_corner = m_local_box.my_right();
   auto it_interpolated_velocities = interpolated_velocities.begin();
@@ -49,6 +49,11 @@ std::vector<Utils::Vector3d> positions_in_halo(Utils::Vector3d const &pos,
                                                LocalBox const &local_box,
                                                double agrid);
 
+/** @brief Append the periodic images of a position inside the local halo. */
+void positions_in_halo(Utils::Vector3d const &pos, BoxGeometry const &box_geo,
+                       LocalBox const &local_box, double agrid,
+                       std::vector<Utils::Vector3d> &res);
+
 /** @brief Calculate drag force on a single particle.
  *
  *  See section II.C. and eq. 9 in @cite ahlrichs99a.
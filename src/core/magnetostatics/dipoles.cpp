@@ -38,6 +38,7 @@
 #include <cassert>
 #include <optional>
 #include <stdexcept>
+#include <variant>
 
 namespace Dipoles {
 
@@ -54,6 +55,24 @@ void Solver::sanity_checks() const {
   }
 }
 
+bool Solver::has_gpu_long_range_forces() const {
+  if (impl->solver) {
+#ifdef DIPOLAR_DIRECT_SUM
+    if (std::holds_alternative<std::shared_ptr<DipolarDirectSumGpu>>(
+            *impl->solver)) {
+      return true;
+    }
+#endif
+#ifdef DP3M
+    if (auto const *actor =
+            std::get_if<std::shared_ptr<DipolarP3M>>(&*impl->solver)) {
+      return (**actor).is_gpu();
+    }
+#endif
+  }
+  return false;
+}
+
 void Solver::on_dipoles_change() {
   reinit_on_observable_calc = true;
   if (impl->solver) {
@@ -46,6 +46,8 @@ struct Solver {
 
   void sanity_checks() const;
   double cutoff() const;
+  /** @brief Whether the long-range forces are calculated on the GPU. */
+  bool has_gpu_long_range_forces() const;
 
   void on_observable_calc();
   void on_dipoles_change();
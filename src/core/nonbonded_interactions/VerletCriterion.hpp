@@ -65,6 +65,11 @@ public:
         m_collision_cut2(eff_cutoff_sqr(collision_detection_cutoff)),
         get_nonbonded_cutoff(system) {}
 
+  /** Returns true if two particles at squared distance @p dist2
+   *  can be within any of the interaction ranges.
+   */
+  bool within_max_range(double dist2) const { return dist2 <= m_eff_max_cut2; }
+
   template <typename Distance>
   bool operator()(const Particle &p1, const Particle &p2,
                   Distance const &dist) const {
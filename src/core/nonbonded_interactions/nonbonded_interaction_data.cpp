@@ -33,86 +33,117 @@
 #include <utility>
 #include <vector>
 
-static double recalc_maximal_cutoff(IA_parameters const &data) {
-  auto max_cut_current = INACTIVE_CUTOFF;
+namespace {
+/** Maximal cutoff and active potentials of a pair of types. */
+struct PotentialsCutoff {
+  double max_cut = INACTIVE_CUTOFF;
+  unsigned int potentials = NB_POTENTIAL_NONE;
+
+  void add(double cutoff, unsigned int flag) {
+    max_cut = std::max(max_cut, cutoff);
+    if (cutoff != INACTIVE_CUTOFF) {
+      potentials |= flag;
+    }
+  }
+};
+} // namespace
+
+static PotentialsCutoff recalc_maximal_cutoff(IA_parameters const &data) {
+  PotentialsCutoff result;
 
 #ifdef LENNARD_JONES
-  max_cut_current = std::max(max_cut_current, data.lj.max_cutoff());
+  result.add(data.lj.max_cutoff(), NB_POTENTIAL_LJ);
 #endif
 
 #ifdef WCA
-  max_cut_current = std::max(max_cut_current, data.wca.max_cutoff());
-#endif
-
-#ifdef DPD
-  max_cut_current = std::max(max_cut_current, data.dpd.max_cutoff());
+  result.add(data.wca.max_cutoff(), NB_POTENTIAL_WCA);
 #endif
 
 #ifdef LENNARD_JONES_GENERIC
-  max_cut_current = std::max(max_cut_current, data.ljgen.max_cutoff());
+  result.add(data.ljgen.max_cutoff(), NB_POTENTIAL_LJGEN);
 #endif
 
 #ifdef SMOOTH_STEP
-  max_cut_current = std::max(max_cut_current, data.smooth_step.max_cutoff());
+  result.add(data.smooth_step.max_cutoff(), NB_POTENTIAL_SMOOTH_STEP);
 #endif
 
 #ifdef HERTZIAN
-  max_cut_current = std::max(max_cut_current, data.hertzian.max_cutoff());
+  result.add(data.hertzian.max_cutoff(), NB_POTENTIAL_HERTZIAN);
 #endif
 
 #ifdef GAUSSIAN
-  max_cut_current = std::max(max_cut_current, data.gaussian.max_cutoff());
+  result.add(data.gaussian.max_cutoff(), NB_POTENTIAL_GAUSSIAN);
 #endif
 
 #ifdef BMHTF_NACL
-  max_cut_current = std::max(max_cut_current, data.bmhtf.max_cutoff());
+  result.add(data.bmhtf.max_cutoff(), NB_POTENTIAL_BMHTF);
 #endif
 
 #ifdef MORSE
-  max_cut_current = std::max(max_cut_current, data.morse.max_cutoff());
+  result.add(data.morse.max_cutoff(), NB_POTENTIAL_MORSE);
 #endif
 
 #ifdef BUCKINGHAM
-  max_cut_current = std::max(max_cut_current, data.buckingham.max_cutoff());
+  result.add(data.buckingham.max_cutoff(), NB_POTENTIAL_BUCKINGHAM);
 #endif
 
 #ifdef SOFT_SPHERE
-  max_cut_current = std::max(max_cut_current, data.soft_sphere.max_cutoff());
+  result.add(data.soft_sphere.max_cutoff(), NB_POTENTIAL_SOFT_SPHERE);
 #endif
 
 #ifdef HAT
-  max_cut_current = std::max(max_cut_current, data.hat.max_cutoff());
+  result.add(data.hat.max_cutoff(), NB_POTENTIAL_HAT);
 #endif
 
 #ifdef LJCOS
-  max_cut_current = std::max(max_cut_current, data.ljcos.max_cutoff());
+  result.add(data.ljcos.max_cutoff(), NB_POTENTIAL_LJCOS);
 #endif
 
 #ifdef LJCOS2
-  max_cut_current = std::max(max_cut_current, data.ljcos2.max_cutoff());
+  result.add(data.ljcos2.max_cutoff(), NB_POTENTIAL_LJCOS2);
 #endif
 
 #ifdef GAY_BERNE
-  max_cut_current = std::max(max_cut_current, data.gay_berne.max_cutoff());
+  result.add(data.gay_berne.max_cutoff(), NB_POTENTIAL_GAY_BERNE);
 #endif
 
 #ifdef TABULATED
-  max_cut_current = std::max(max_cut_current, data.tab.cutoff());
+  result.add(data.tab.cutoff(), NB_POTENTIAL_TABULATED);
+#endif
+
+#ifdef DPD
+  result.add(data.dpd.max_cutoff(), NB_POTENTIAL_NONE);
 #endif
 
 #ifdef THOLE
   // If THOLE is active, use p3m cutoff
-  if (data.thole.scaling_coeff != 0.)
-    max_cut_current =
-        std::max(max_cut_current, Coulomb::get_coulomb().cutoff());
+  if (data.thole.scaling_coeff != 0.) {
+    result.add(Coulomb::get_coulomb().cutoff(), NB_POTENTIAL_NONE);
+    result.potentials |= NB_POTENTIAL_THOLE;
+  }
 #endif
 
-  return max_cut_current;
+  return result;
 }
 
 void InteractionsNonBonded::recalc_maximal_cutoffs() {
+  m_active_potentials = NB_POTENTIAL_NONE;
   for (auto &data : m_nonbonded_ia_params) {
-    data->max_cut = recalc_maximal_cutoff(*data);
+    auto const result = recalc_maximal_cutoff(*data);
+    data->max_cut = result.max_cut;
+    m_active_potentials |= result.potentials;
+  }
+  update_ia_params_table();
+}
+
+void InteractionsNonBonded::update_ia_params_table() {
+  auto const n_types = max_seen_particle_type + 1;
+  m_ia_params_table.resize(static_cast<std::size_t>(n_types * n_types));
+  for (int i = 0; i < n_types; i++) {
+    for (int j = 0; j < n_types; j++) {
+      m_ia_params_table[static_cast<std::size_t>(i * n_types + j)] =
+          get_ia_param(i, j);
+    }
   }
 }
 
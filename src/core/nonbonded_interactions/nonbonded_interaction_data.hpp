@@ -35,7 +35,9 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 /** Cutoff for deactivated interactions. Must be negative, so that even
@@ -43,6 +45,30 @@
  */
 constexpr double INACTIVE_CUTOFF = -1.;
 
+/** @brief Flags of the non-bonded potentials, to specialize the pair kernels
+ *  to the potentials which are active for at least one pair of types.
+ */
+enum NonBondedPotential : unsigned int {
+  NB_POTENTIAL_NONE = 0u,
+  NB_POTENTIAL_LJ = 1u << 0u,
+  NB_POTENTIAL_WCA = 1u << 1u,
+  NB_POTENTIAL_LJGEN = 1u << 2u,
+  NB_POTENTIAL_SMOOTH_STEP = 1u << 3u,
+  NB_POTENTIAL_HERTZIAN = 1u << 4u,
+  NB_POTENTIAL_GAUSSIAN = 1u << 5u,
+  NB_POTENTIAL_BMHTF = 1u << 6u,
+  NB_POTENTIAL_BUCKINGHAM = 1u << 7u,
+  NB_POTENTIAL_MORSE = 1u << 8u,
+  NB_POTENTIAL_SOFT_SPHERE = 1u << 9u,
+  NB_POTENTIAL_HAT = 1u << 10u,
+  NB_POTENTIAL_LJCOS = 1u << 11u,
+  NB_POTENTIAL_LJCOS2 = 1u << 12u,
+  NB_POTENTIAL_TABULATED = 1u << 13u,
+  NB_POTENTIAL_GAY_BERNE = 1u << 14u,
+  NB_POTENTIAL_THOLE = 1u << 15u,
+  NB_POTENTIAL_ALL = (1u << 16u) - 1u
+};
+
 /** Lennard-Jones with shift */
 struct LJ_Parameters {
   double eps = 0.0;
@@ -276,8 +302,11 @@ struct DPD_Parameters {
   double max_cutoff() const { return std::max(radial.cutoff, trans.cutoff); }
 };
 
-/** @brief Parameters for non-bonded interactions. */
-struct IA_parameters {
+/** @brief Parameters for non-bonded interactions.
+ *  Aligned to cache lines, such that the leading cutoff and the
+ *  parameters of the common potentials share as few lines as possible.
+ */
+struct alignas(64) IA_parameters {
   /** maximal cutoff for this pair of particle types. This contains
    *  contributions from the short-ranged interactions, plus any
    *  cutoffs from global interactions like electrostatics.
@@ -353,11 +382,48 @@ struct IA_parameters {
 #endif
 };
 
+/**
+ * @brief Call a functor with a set of non-bonded potentials as a
+ * compile-time constant, such that the functor can instantiate pair
+ * kernels which only evaluate these potentials.
+ *
+ * Only the common combinations of potentials are specialized,
+ * all other combinations use the kernel of all potentials.
+ *
+ * @param potentials  Flags of the active potentials.
+ * @param fun         Functor taking a @c std::integral_constant.
+ */
+template <class F>
+decltype(auto) dispatch_nonbonded_potentials(unsigned int potentials,
+                                             F &&fun) {
+  using Potentials = std::underlying_type_t<NonBondedPotential>;
+  switch (potentials) {
+  case NB_POTENTIAL_NONE:
+    return fun(std::integral_constant<Potentials, NB_POTENTIAL_NONE>{});
+  case NB_POTENTIAL_LJ:
+    return fun(std::integral_constant<Potentials, NB_POTENTIAL_LJ>{});
+  case NB_POTENTIAL_WCA:
+    return fun(std::integral_constant<Potentials, NB_POTENTIAL_WCA>{});
+  case NB_POTENTIAL_LJ | NB_POTENTIAL_WCA:
+    return fun(std::integral_constant<Potentials,
+                                      NB_POTENTIAL_LJ | NB_POTENTIAL_WCA>{});
+  default:
+    return fun(std::integral_constant<Potentials, NB_POTENTIAL_ALL>{});
+  }
+}
+
 class InteractionsNonBonded : public System::Leaf<InteractionsNonBonded> {
   /** @brief List of pairwise interactions. */
   std::vector<std::shared_ptr<IA_parameters>> m_nonbonded_ia_params{};
+  /**
+   * @brief Copy of the pairwise interactions as a full matrix,
+   * for the lookup in the pair kernels.
+   */
+  std::vector<IA_parameters> m_ia_params_table{};
   /** @brief Maximal particle type seen so far. */
   int max_seen_particle_type = -1;
+  /** @brief Potentials active for at least one pair of types. */
+  unsigned int m_active_potentials = NB_POTENTIAL_NONE;
 
   void realloc_ia_params(int type) {
     assert(type >= 0);
@@ -390,6 +456,7 @@ public:
     if (type > max_seen_particle_type) {
       realloc_ia_params(type);
       max_seen_particle_type = type;
+      update_ia_params_table();
     }
   }
 
@@ -421,19 +488,61 @@ public:
     return *m_nonbonded_ia_params[get_ia_param_key(i, j)];
   }
 
+  /**
+   * @brief Get interaction parameters between particle types i and j
+   * from the flat parameter table.
+   *
+   * The table holds a copy of the parameters of all type pairs, which
+   * is only updated by @ref update_ia_params_table, e.g. when the
+   * interactions change. It should only be used in the pair kernels.
+   *
+   * @param i First type, must exist
+   * @param j Second type, must exist
+   */
+  IA_parameters const &get_ia_param_flat(int i, int j) const {
+    assert(i >= 0 and i <= max_seen_particle_type);
+    assert(j >= 0 and j <= max_seen_particle_type);
+    auto const n_types = static_cast<std::size_t>(max_seen_particle_type) + 1u;
+    return m_ia_params_table[static_cast<std::size_t>(i) * n_types +
+                             static_cast<std::size_t>(j)];
+  }
+
   auto get_ia_param_ref_counted(int i, int j) const {
     return m_nonbonded_ia_params[get_ia_param_key(i, j)];
   }
 
   void set_ia_param(int i, int j, std::shared_ptr<IA_parameters> const &ia) {
     m_nonbonded_ia_params[get_ia_param_key(i, j)] = ia;
+    update_ia_params_table();
   }
 
+  /** @brief Copy the pairwise interactions into the flat parameter table. */
+  void update_ia_params_table();
+
   auto get_max_seen_particle_type() const { return max_seen_particle_type; }
 
-  /** @brief Recalculate cutoff of each interaction struct. */
+  /**
+   * @brief Recalculate cutoff of each interaction struct,
+   * the active potentials and the flat parameter table.
+   */
   void recalc_maximal_cutoffs();
 
+  /**
+   * @brief Flags of the potentials which are active for at least one
+   * pair of types, not counting the DPD parameters.
+   * Updated by @ref recalc_maximal_cutoffs.
+   */
+  unsigned int active_potentials() const { return m_active_potentials; }
+
+  /**
+   * @brief Whether the Lennard-Jones and WCA potentials are the only
+   * active non-bonded potentials, not counting the DPD parameters.
+   * Updated by @ref recalc_maximal_cutoffs.
+   */
+  bool only_lj_wca() const {
+    return (m_active_potentials & ~(NB_POTENTIAL_LJ | NB_POTENTIAL_WCA)) == 0u;
+  }
+
   /** @brief Get maximal cutoff. */
   double maximal_cutoff() const;
 
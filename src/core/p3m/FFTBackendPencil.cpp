@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config/config.hpp"
+
+#if defined(P3M) or defined(DP3M)
+
+#include "FFTBackendPencil.hpp"
+
+#include "communication.hpp"
+
+#include "fft/pencil.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <memory>
+
+template <typename FloatType>
+FFTBackendPencil<FloatType>::FFTBackendPencil(P3MLocalMesh const &local_mesh)
+    : FFTBackend<FloatType>(local_mesh),
+      fft{std::make_unique<fft::fft_pencil_struct<FloatType>>(
+          ::Communication::mpiCallbacksHandle()->share_mpi_env())} {}
+
+template <typename FloatType>
+FFTBackendPencil<FloatType>::~FFTBackendPencil() = default;
+
+template <typename FloatType>
+void FFTBackendPencil<FloatType>::init(P3MParameters const &params) {
+  auto const inner_start =
+      Utils::Vector3i(local_mesh.ld_ind) + Utils::Vector3i(local_mesh.in_ld);
+  auto const inner_size = Utils::Vector3i(local_mesh.inner);
+  auto const ca_mesh_offset = Utils::Vector3i{
+      {local_mesh.margin[0], local_mesh.margin[2], local_mesh.margin[4]}};
+  ca_mesh_size =
+      fft->initialize_fft(::comm_cart, params.mesh, inner_start, inner_size,
+                          local_mesh.dim, ca_mesh_offset);
+}
+
+template <typename FloatType>
+void FFTBackendPencil<FloatType>::forward_fft(FloatType *rs_mesh) {
+  fft->forward_fft(rs_mesh);
+}
+
+template <typename FloatType>
+void FFTBackendPencil<FloatType>::backward_fft(FloatType *rs_mesh) {
+  fft->backward_fft(rs_mesh, check_complex_residuals);
+}
+
+template class FFTBackendPencil<float>;
+template class FFTBackendPencil<double>;
+
+#endif // defined(P3M) or defined(DP3M)
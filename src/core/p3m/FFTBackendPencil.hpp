@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "config/config.hpp"
+
+#if defined(P3M) or defined(DP3M)
+
+#include "common.hpp"
+#include "data_struct.hpp"
+
+#include <array>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+namespace fft {
+template <typename FloatType> struct fft_pencil_struct;
+} // namespace fft
+
+/**
+ * @brief Pencil-decomposed FFT backend based on FFTW3.
+ * The 3D FFT is split into three 1D FFTs on a 2D process grid,
+ * with non-blocking transposes (see fft/pencil.hpp).
+ */
+template <typename FloatType>
+class FFTBackendPencil : public FFTBackend<FloatType> {
+  static_assert(std::is_same_v<FloatType, float> or
+                    std::is_same_v<FloatType, double>,
+                "FFTW only implements float and double");
+  std::unique_ptr<fft::fft_pencil_struct<FloatType>> fft;
+  using FFTBackend<FloatType>::local_mesh;
+  using FFTBackend<FloatType>::check_complex_residuals;
+  int ca_mesh_size = -1;
+
+public:
+  FFTBackendPencil(P3MLocalMesh const &local_mesh);
+  ~FFTBackendPencil() override;
+  void init(P3MParameters const &params) override;
+  void forward_fft(FloatType *rs_mesh) override;
+  void backward_fft(FloatType *rs_mesh) override;
+  int get_ca_mesh_size() const noexcept override { return ca_mesh_size; }
+  int get_ks_pnum() const noexcept override { return 4; }
+  std::array<int, 3u> const &get_mesh_size() const override {
+    return fft->get_mesh_size();
+  }
+  std::array<int, 3u> const &get_mesh_start() const override {
+    return fft->get_mesh_start();
+  }
+
+  /**
+   * @brief Index helpers for reciprocal space.
+   * After the FFT the data is in order YZX, which
+   * means that Y is the slowest changing index.
+   * This is the same layout as in @ref FFTBackendLegacy.
+   */
+  std::tuple<int, int, int> get_permutations() const override {
+    constexpr static int KX = 2;
+    constexpr static int KY = 0;
+    constexpr static int KZ = 1;
+    return {KX, KY, KZ};
+  }
+};
+
+#endif // defined(P3M) or defined(DP3M)
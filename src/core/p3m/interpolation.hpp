@@ -25,8 +25,12 @@
 #include <utils/math/bspline.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
+#include <iterator>
+#include <numeric>
 #include <span>
 #include <tuple>
 #include <utility>
@@ -89,6 +93,39 @@ public:
     std::ranges::copy(w.w_z, it);
   }
 
+  /**
+   * @brief Resize the cache to hold the weights of @p n_points points,
+   * to be filled by the indexed @ref p3m_interpolation_cache::store.
+   *
+   * @param n_points Number of points.
+   */
+  void resize(std::size_t n_points) {
+    ca_fmp.resize(n_points);
+    ca_frac.resize(3ul * n_points * static_cast<std::size_t>(m_cao));
+  }
+
+  /**
+   * @brief Overwrite the weights of one point.
+   *
+   * Different points can be stored concurrently.
+   *
+   * @tparam cao Interpolation order has to match the order
+   *         set at last call to @ref p3m_interpolation_cache::reset.
+   * @param i Index of the entry to store.
+   * @param w Interpolation weights to store.
+   */
+  template <int cao>
+  void store(std::size_t i, const InterpolationWeights<cao> &w) {
+    assert(cao == m_cao);
+    assert(i < size());
+
+    ca_fmp[i] = w.ind;
+    auto it = std::next(ca_frac.begin(), 3l * static_cast<long>(i) * cao);
+    it = std::ranges::copy(w.w_x, it).out;
+    it = std::ranges::copy(w.w_y, it).out;
+    std::ranges::copy(w.w_z, it);
+  }
+
   /**
    * @brief Load entry from the cache.
    *
@@ -117,6 +154,16 @@ public:
     return ret;
   }
 
+  /**
+   * @brief Linear index of the corner of the interpolation cube of a point.
+   *
+   * @param i Index of the entry.
+   */
+  int corner(std::size_t i) const {
+    assert(i < size());
+    return ca_fmp[i];
+  }
+
   /**
    * @brief Reset the cache.
    *
@@ -177,6 +224,163 @@ p3m_calculate_interpolation_weights(const Utils::Vector3d &position,
   return ret;
 }
 
+namespace detail {
+/** @brief Evaluate the B-spline of one knot for a batch of points. */
+template <int cao, int i, std::size_t N>
+void bspline_knot(std::array<double, N> const &x, std::array<double, N> &w) {
+  for (std::size_t j = 0; j < N; j++) {
+    w[j] = Utils::bspline<cao>(i, x[j]);
+  }
+}
+} // namespace detail
+
+/**
+ * @brief Calculate the P-th order interpolation weights of several points.
+ *
+ * Gives the same weights as @ref p3m_calculate_interpolation_weights,
+ * but evaluates the B-splines knot by knot for a batch of points at
+ * once, which lets the compiler vectorize the polynomials over points.
+ *
+ * @param positions Positions of the points.
+ * @param ai        Inverse mesh spacing.
+ * @param local_mesh Mesh info.
+ * @param cache     Cache to store the weights into.
+ * @param first     Cache index of the first point.
+ */
+template <int cao>
+void p3m_calculate_interpolation_weights(
+    std::span<const Utils::Vector3d> positions, const Utils::Vector3d &ai,
+    P3MLocalMesh const &local_mesh, p3m_interpolation_cache &cache,
+    std::size_t first) {
+  constexpr std::size_t batch_size = 32;
+  auto const pos_shift = std::floor((cao - 1) / 2.0) - (cao % 2) / 2.0;
+
+  std::array<std::array<double, batch_size>, 3> dist{};
+  std::array<std::array<double, batch_size>, 3 * cao> weights;
+  std::array<int, batch_size> ind;
+
+  for (std::size_t begin = 0; begin < positions.size(); begin += batch_size) {
+    auto const n = std::min(batch_size, positions.size() - begin);
+
+    for (std::size_t j = 0; j < n; j++) {
+      Utils::Vector3i nmp;
+      for (unsigned int d = 0; d < 3; d++) {
+        auto const pos =
+            ((positions[begin + j][d] - local_mesh.ld_pos[d]) * ai[d]) -
+            pos_shift;
+        nmp[d] = static_cast<int>(pos);
+        dist[d][j] = (pos - nmp[d]) - 0.5;
+      }
+      assert((nmp + Utils::Vector3i::broadcast(cao)) <= local_mesh.dim);
+      ind[j] = Utils::get_linear_index(nmp, local_mesh.dim,
+                                       Utils::MemoryOrder::ROW_MAJOR);
+    }
+
+    [&]<int... i>(std::integer_sequence<int, i...>) {
+      for (unsigned int d = 0; d < 3; d++) {
+        (detail::bspline_knot<cao, i>(dist[d], weights[d * cao + i]), ...);
+      }
+    }(std::make_integer_sequence<int, cao>{});
+
+    for (std::size_t j = 0; j < n; j++) {
+      InterpolationWeights<cao> w;
+      w.ind = ind[j];
+      for (int i = 0; i < cao; i++) {
+        w.w_x[i] = weights[0 * cao + i][j];
+        w.w_y[i] = weights[1 * cao + i][j];
+        w.w_z[i] = weights[2 * cao + i][j];
+      }
+      cache.store(first + begin + j, w);
+    }
+  }
+}
+
+/**
+ * @brief Buckets of interpolation points for concurrent mesh assignment.
+ *
+ * The local mesh is cut into tiles of @c cao mesh points along its two
+ * outer dimensions. The interpolation cube of a point spans at most two
+ * adjacent tiles per dimension, therefore the cubes of points that belong
+ * to different tiles of the same color, i.e. with the same parity of
+ * both tile coordinates, never overlap. The tiles of one color can then
+ * be assigned concurrently without atomics. The points of a tile keep
+ * their relative order, such that the result does not depend on the
+ * number of threads.
+ */
+class p3m_interpolation_tiles {
+  /** Number of colors, i.e. of parity combinations. */
+  static constexpr int n_colors = 4;
+  /** Point indices, sorted by tile. */
+  std::vector<std::size_t> m_points;
+  /** Range of each tile in @ref m_points. */
+  std::vector<std::size_t> m_offsets;
+  /** Tile indices of each color. */
+  std::array<std::vector<std::size_t>, n_colors> m_colors;
+  std::vector<std::size_t> m_tile_of_point;
+
+public:
+  /**
+   * @brief Sort the points of the cache into tiles.
+   *
+   * @param cache Interpolation weights of the points.
+   * @param local_mesh Mesh info.
+   */
+  void build(p3m_interpolation_cache const &cache,
+             P3MLocalMesh const &local_mesh) {
+    auto const cao = static_cast<std::size_t>(cache.cao());
+    auto const dim_x = static_cast<std::size_t>(local_mesh.dim[0]);
+    auto const dim_y = static_cast<std::size_t>(local_mesh.dim[1]);
+    auto const dim_yz = dim_y * static_cast<std::size_t>(local_mesh.dim[2]);
+    auto const n_tiles_x = (dim_x + cao - 1) / cao;
+    auto const n_tiles_y = (dim_y + cao - 1) / cao;
+    auto const n_points = cache.size();
+
+    /* counting sort of the points by tile */
+    m_offsets.assign(n_tiles_x * n_tiles_y + 1, 0);
+    m_tile_of_point.resize(n_points);
+    for (std::size_t i = 0; i < n_points; i++) {
+      auto const ind = static_cast<std::size_t>(cache.corner(i));
+      auto const tile_x = ind / dim_yz / cao;
+      auto const tile_y = ind % dim_yz / static_cast<std::size_t>(
+                                            local_mesh.dim[2]) / cao;
+      m_tile_of_point[i] = tile_x * n_tiles_y + tile_y;
+      ++m_offsets[m_tile_of_point[i] + 1];
+    }
+    std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+    m_points.resize(n_points);
+    auto fill = std::vector<std::size_t>(m_offsets.begin(),
+                                         std::prev(m_offsets.end()));
+    for (std::size_t i = 0; i < n_points; i++) {
+      m_points[fill[m_tile_of_point[i]]++] = i;
+    }
+
+    for (auto &tiles : m_colors) {
+      tiles.clear();
+    }
+    for (std::size_t tile_x = 0; tile_x < n_tiles_x; tile_x++) {
+      for (std::size_t tile_y = 0; tile_y < n_tiles_y; tile_y++) {
+        auto const tile = tile_x * n_tiles_y + tile_y;
+        if (m_offsets[tile] != m_offsets[tile + 1]) {
+          m_colors[2 * (tile_x % 2) + (tile_y % 2)].push_back(tile);
+        }
+      }
+    }
+  }
+
+  /** @brief Non-empty tiles of a color. */
+  auto const &tiles(int color) const {
+    return m_colors[static_cast<std::size_t>(color)];
+  }
+
+  /** @brief Indices of the points of a tile. */
+  auto points(std::size_t tile) const {
+    return std::span(m_points).subspan(
+        m_offsets[tile], m_offsets[tile + 1] - m_offsets[tile]);
+  }
+
+  static constexpr int colors() { return n_colors; }
+};
+
 /**
  * @brief P3M grid interpolation.
  *
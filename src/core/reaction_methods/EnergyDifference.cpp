@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config/config.hpp"
+
+#include "reaction_methods/EnergyDifference.hpp"
+
+#include "BoxGeometry.hpp"
+#include "Particle.hpp"
+#include "actor/optional.hpp"
+#include "actor/visitors.hpp"
+#include "bonded_interactions/bonded_interaction_data.hpp"
+#include "cell_system/Cell.hpp"
+#include "cell_system/CellStructure.hpp"
+#include "constraints/Constraints.hpp"
+#include "electrostatics/coulomb.hpp"
+#include "energy_inline.hpp"
+#include "exclusions.hpp"
+#include "magnetostatics/dipoles.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "system/System.hpp"
+
+#include <utils/Vector.hpp>
+#include <utils/contains.hpp>
+
+#include <boost/mpi/collectives/all_gather.hpp>
+#include <boost/mpi/collectives/all_reduce.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace ReactionMethods {
+
+namespace {
+void update_cell_system(System::System &system) {
+  auto &cell_structure = *system.cell_structure;
+  if (cell_structure.get_resort_particles()) {
+    cell_structure.update_ghosts_and_resort_particle(
+        system.get_global_ghost_flags());
+  }
+}
+
+bool is_changed(Particle const &p, std::span<int const> p_ids) {
+  return Utils::contains(p_ids, p.id());
+}
+
+/**
+ * @brief Non-bonded energy of a local particle with all particles,
+ * except with the particles in @p excluded. The neighbors are searched
+ * around @p cell, or around the cell of the particle position if null.
+ */
+double non_bonded_energy(System::System const &system, Particle const &p,
+                         std::span<int const> excluded,
+                         Cell *cell = nullptr) {
+  auto const &nonbonded_ias = *system.nonbonded_ias;
+  auto const &bonded_ias = *system.bonded_ias;
+  auto const coulomb_kernel = system.coulomb.pair_energy_kernel();
+  auto const coulomb_kernel_ptr = get_ptr(coulomb_kernel);
+  auto energy = 0.;
+  auto kernel = [&](Particle const &p1, Particle const &p2,
+                    Utils::Vector3d const &vec) {
+    if (is_changed(p2, excluded)) {
+      return;
+    }
+    auto const dist = vec.norm();
+#ifdef EXCLUSIONS
+    if (do_nonbonded(p1, p2))
+#endif
+    {
+      auto const &ia_params = nonbonded_ias.get_ia_param(p1.type(), p2.type());
+      energy += calc_non_bonded_pair_energy(p1, p2, ia_params, vec, dist,
+                                            bonded_ias, coulomb_kernel_ptr);
+    }
+#ifdef ELECTROSTATICS
+    if (coulomb_kernel_ptr != nullptr) {
+      energy += (*coulomb_kernel_ptr)(p1, p2, p1.q() * p2.q(), vec, dist);
+    }
+#endif
+  };
+  if (cell != nullptr) {
+    system.cell_structure->run_on_cell_short_range_neighbors(p, cell, kernel);
+  } else {
+    [[maybe_unused]] auto const is_local =
+        system.cell_structure->run_on_particle_short_range_neighbors(p,
+                                                                     kernel);
+    assert(is_local);
+  }
+  return energy;
+}
+
+/**
+ * @brief Energy of the local bonds which involve at least one particle
+ * in @p included and none of the particles in @p excluded.
+ */
+double bonded_energy(System::System const &system,
+                     std::span<int const> included,
+                     std::span<int const> excluded) {
+  auto const &bonded_ias = *system.bonded_ias;
+  if (bonded_ias.empty()) {
+    return 0.;
+  }
+  auto const &box_geo = *system.box_geo;
+  auto const coulomb_kernel = system.coulomb.pair_energy_kernel();
+  auto const coulomb_kernel_ptr = get_ptr(coulomb_kernel);
+  auto energy = 0.;
+  system.cell_structure->bond_loop(
+      [&](Particle &p1, int bond_id, std::span<Particle *> partners) {
+        auto n_included = static_cast<int>(is_changed(p1, included));
+        auto n_excluded = static_cast<int>(is_changed(p1, excluded));
+        for (auto const p2 : partners) {
+          n_included += static_cast<int>(is_changed(*p2, included));
+          n_excluded += static_cast<int>(is_changed(*p2, excluded));
+        }
+        if (n_included == 0 or n_excluded != 0) {
+          return false;
+        }
+        auto const result = calc_bonded_energy(*bonded_ias.at(bond_id), p1,
+                                               partners, box_geo,
+                                               coulomb_kernel_ptr);
+        if (result) {
+          energy += *result;
+          return false;
+        }
+        return true;
+      });
+  return energy;
+}
+
+Particle const *get_real_particle(System::System const &system, int p_id) {
+  auto const p = system.cell_structure->get_local_particle(p_id);
+  if (p == nullptr or p->is_ghost()) {
+    return nullptr;
+  }
+  return p;
+}
+
+#ifdef ELECTROSTATICS
+void add_charge_site(System::System const &system, Particle const &p,
+                     std::vector<Coulomb::ChargeSite> &charges) {
+  if (p.q() != 0.) {
+    charges.push_back({p.q(), p.pos(),
+                       system.coulomb.calc_long_range_potential(p.pos())});
+  }
+}
+
+auto gather_charge_sites(boost::mpi::communicator const &comm,
+                         std::vector<Coulomb::ChargeSite> const &charges) {
+  std::vector<std::vector<Coulomb::ChargeSite>> charges_per_rank;
+  boost::mpi::all_gather(comm, charges, charges_per_rank);
+  std::vector<Coulomb::ChargeSite> out;
+  for (auto const &charges_of_rank : charges_per_rank) {
+    std::ranges::copy(charges_of_rank, std::back_inserter(out));
+  }
+  return out;
+}
+#endif // ELECTROSTATICS
+} // namespace
+
+bool EnergyDifference::is_supported(System::System const &system) {
+  if (not std::ranges::empty(*system.constraints)) {
+    return false;
+  }
+#ifdef ELECTROSTATICS
+  if (not system.coulomb.has_long_range_energy_difference()) {
+    return false;
+  }
+#endif
+#ifdef DIPOLES
+  if (system.dipoles.impl->solver) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+bool EnergyDifference::is_short_range(System::System const &system) {
+  if (not is_supported(system)) {
+    return false;
+  }
+#ifdef P3M
+  if (get_actor_by_type<CoulombP3M>(system.coulomb.impl->solver)) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+void EnergyDifference::clear() {
+  m_p_ids.clear();
+  m_energy_old = 0.;
+#ifdef ELECTROSTATICS
+  m_charges_old.clear();
+  m_charges_removed.clear();
+  m_charges_added.clear();
+#endif
+}
+
+bool EnergyDifference::is_up_to_date(System::System const &system) const {
+  return m_prepared and system.get_state_revision() == m_revision;
+}
+
+void EnergyDifference::prepare(System::System &system) {
+  assert(is_supported(system));
+  clear();
+  system.on_observable_calc();
+#ifdef ELECTROSTATICS
+  system.coulomb.prepare_energy_difference(
+      system.cell_structure->local_particles());
+#endif
+  m_prepared = true;
+  m_revision = system.get_state_revision();
+}
+
+void EnergyDifference::accept(System::System &system) {
+  if (not m_prepared) {
+    return;
+  }
+#ifdef ELECTROSTATICS
+  system.coulomb.update_energy_difference(m_charges_removed, m_charges_added);
+#endif
+  clear();
+  m_revision = system.get_state_revision();
+}
+
+void EnergyDifference::reject(System::System const &system) {
+  if (not m_prepared) {
+    return;
+  }
+  clear();
+  m_revision = system.get_state_revision();
+}
+
+void EnergyDifference::record_old(System::System &system, int p_id) {
+  assert(m_prepared);
+  if (Utils::contains(m_p_ids, p_id)) {
+    return;
+  }
+  update_cell_system(system);
+  auto const excluded = std::span<int const>(m_p_ids);
+  if (auto const p = get_real_particle(system, p_id)) {
+    m_energy_old += non_bonded_energy(system, *p, excluded);
+#ifdef ELECTROSTATICS
+    add_charge_site(system, *p, m_charges_old);
+#endif
+  }
+  m_energy_old += bonded_energy(system, std::span(&p_id, 1ul), excluded);
+  m_p_ids.emplace_back(p_id);
+}
+
+void EnergyDifference::record_new(int p_id) {
+  assert(m_prepared);
+  if (not Utils::contains(m_p_ids, p_id)) {
+    m_p_ids.emplace_back(p_id);
+  }
+}
+
+double EnergyDifference::calculate(System::System &system) {
+  assert(m_prepared);
+  update_cell_system(system);
+  auto energy_new = 0.;
+#ifdef ELECTROSTATICS
+  std::vector<Coulomb::ChargeSite> charges_new;
+#endif
+  auto const p_ids = std::span<int const>(m_p_ids);
+  for (std::size_t i = 0u; i < p_ids.size(); ++i) {
+    if (auto const p = get_real_particle(system, p_ids[i])) {
+      energy_new += non_bonded_energy(system, *p, p_ids.first(i));
+#ifdef ELECTROSTATICS
+      add_charge_site(system, *p, charges_new);
+#endif
+    }
+  }
+  energy_new += bonded_energy(system, p_ids, {});
+  auto energy = boost::mpi::all_reduce(m_comm, energy_new - m_energy_old,
+                                       std::plus<>());
+#ifdef ELECTROSTATICS
+  energy += system.coulomb.calc_energy_difference_long_range(
+      gather_charge_sites(m_comm, m_charges_old),
+      gather_charge_sites(m_comm, charges_new));
+  auto charges_removed = std::move(m_charges_old);
+#endif
+  clear();
+#ifdef ELECTROSTATICS
+  m_charges_removed = std::move(charges_removed);
+  m_charges_added = std::move(charges_new);
+#endif
+  return energy;
+}
+
+double EnergyDifference::test_particle_energy(System::System const &system,
+                                              Particle const &p) const {
+  assert(m_prepared);
+  auto energy = non_bonded_energy(system, p, {});
+#ifdef ELECTROSTATICS
+  if (p.q() != 0.) {
+    auto const site = Coulomb::ChargeSite{
+        p.q(), p.pos(), system.coulomb.calc_long_range_potential(p.pos())};
+    energy += system.coulomb.calc_energy_difference_long_range(
+        {}, std::span(&site, 1ul));
+  }
+#endif
+  return energy;
+}
+
+double EnergyDifference::short_range_energy(System::System const &system,
+                                            Particle const &p, Cell &cell) {
+  return non_bonded_energy(system, p, {}, &cell);
+}
+
+} // namespace ReactionMethods
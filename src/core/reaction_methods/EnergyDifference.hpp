@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "config/config.hpp"
+
+#include "electrostatics/solver.hpp"
+
+#include <vector>
+
+namespace boost::mpi {
+class communicator;
+} // namespace boost::mpi
+
+namespace System {
+class System;
+} // namespace System
+
+class Cell;
+struct Particle;
+
+namespace ReactionMethods {
+
+/**
+ * @brief Potential energy difference of a Monte Carlo move which only
+ * changes a few particles.
+ *
+ * Instead of the energy of the whole system, only the interactions of
+ * the changed particles are calculated, once before and once after the
+ * move. Non-bonded and real-space Coulomb interactions are evaluated on
+ * the cell neighborhood of the particles and bonded interactions on the
+ * bonds that involve them. The k-space part of P3M is obtained from the
+ * mesh potential of the charge distribution before the move, see
+ * @ref CoulombP3M::long_range_energy_difference.
+ *
+ * Each particle changed by a move must be passed to @ref record_old
+ * right before it is changed, and each particle created by the move to
+ * @ref record_new. Interactions between two changed particles are
+ * attributed to the particle recorded first. Once the move was
+ * accepted or rejected, @ref accept or @ref reject keep the mesh
+ * potential valid for the next move. It only has to be recalculated
+ * by @ref prepare when the system was changed by other means, which
+ * is detected by @ref is_up_to_date.
+ *
+ * All methods must be called on all MPI ranks.
+ */
+class EnergyDifference {
+public:
+  explicit EnergyDifference(boost::mpi::communicator const &comm)
+      : m_comm{comm} {}
+
+  /**
+   * @brief Whether the active interactions can be evaluated locally.
+   * Magnetostatics, constraints, and electrostatics methods other than
+   * short-range methods and P3M with metallic boundary conditions on
+   * the CPU require the energy of the whole system.
+   */
+  static bool is_supported(System::System const &system);
+
+  /**
+   * @brief Whether the active interactions are supported and have no
+   * long-range part, such that the energy of a particle only depends on
+   * the particles in its cell neighborhood.
+   */
+  static bool is_short_range(System::System const &system);
+
+  /** @brief Calculate the mesh potential of the current system state. */
+  void prepare(System::System &system);
+
+  /** @brief Whether @ref prepare was called since the last @ref reset. */
+  bool is_prepared() const { return m_prepared; }
+
+  /**
+   * @brief Whether the mesh potential describes the current state of
+   * the system, i.e. the system was only changed by moves which were
+   * passed to @ref accept or @ref reject since the last @ref prepare.
+   */
+  bool is_up_to_date(System::System const &system) const;
+
+  /** @brief Invalidate the mesh potential. */
+  void reset() {
+    m_prepared = false;
+    clear();
+  }
+
+  /**
+   * @brief Update the mesh potential with the charge change of the
+   * move of the last @ref calculate, after it was accepted.
+   */
+  void accept(System::System &system);
+
+  /** @brief Keep the mesh potential after the last move was reverted. */
+  void reject(System::System const &system);
+
+  /** @brief Drop the recorded particles. */
+  void clear();
+
+  /** @brief Add the energy of a particle before it gets changed. */
+  void record_old(System::System &system, int p_id);
+
+  /** @brief Add a particle created by the move. */
+  void record_new(int p_id);
+
+  /**
+   * @brief Energy difference of the recorded particles between the
+   * current and the recorded state. Clears the recorded particles.
+   */
+  double calculate(System::System &system);
+
+  /**
+   * @brief Energy of a test particle which is not part of the system.
+   * The test particle must be in the local domain of this rank.
+   * Unlike the other methods, this one is local and thread-safe.
+   */
+  double test_particle_energy(System::System const &system,
+                              Particle const &p) const;
+
+  /**
+   * @brief Short-range non-bonded energy of a local particle with the
+   * particles in @p cell and its neighbor cells. The particle may have
+   * left the cell since the last resort, as long as all its interaction
+   * partners remain in the neighborhood. Local and thread-safe.
+   */
+  static double short_range_energy(System::System const &system,
+                                   Particle const &p, Cell &cell);
+
+private:
+  boost::mpi::communicator const &m_comm;
+  bool m_prepared = false;
+  /** State revision of the system the mesh potential describes. */
+  unsigned long m_revision = 0ul;
+  /** Ids of the changed particles, in the order they were recorded. */
+  std::vector<int> m_p_ids;
+  /** Local part of the energy of the changed particles before the move. */
+  double m_energy_old = 0.;
+#ifdef ELECTROSTATICS
+  /** Local charges of the changed particles before the move. */
+  std::vector<Coulomb::ChargeSite> m_charges_old;
+  /** Local charges removed by the move of the last @ref calculate. */
+  std::vector<Coulomb::ChargeSite> m_charges_removed;
+  /** Local charges added by the move of the last @ref calculate. */
+  std::vector<Coulomb::ChargeSite> m_charges_added;
+#endif
+};
+
+} // namespace ReactionMethods
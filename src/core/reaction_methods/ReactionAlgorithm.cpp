@@ -22,8 +22,12 @@
 #include "reaction_methods/ReactionAlgorithm.hpp"
 
 #include "BoxGeometry.hpp"
+#include "LocalBox.hpp"
 #include "Observable_stat.hpp"
+#include "cell_system/Cell.hpp"
 #include "cell_system/CellStructure.hpp"
+#include "cell_system/CellStructureType.hpp"
+#include "cell_system/RegularDecomposition.hpp"
 #include "cells.hpp"
 #include "particle_node.hpp"
 #include "system/System.hpp"
@@ -31,6 +35,7 @@
 #include <utils/Vector.hpp>
 #include <utils/contains.hpp>
 
+#include <boost/mpi/collectives/all_gather.hpp>
 #include <boost/mpi/collectives/all_reduce.hpp>
 #include <boost/mpi/collectives/broadcast.hpp>
 #include <boost/serialization/serialization.hpp>
@@ -43,7 +48,10 @@
 #include <limits>
 #include <map>
 #include <numbers>
+#include <numeric>
 #include <optional>
+#include <random>
+#include <ranges>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -172,6 +180,7 @@ void ReactionAlgorithm::make_reaction_attempt(SingleReaction const &reaction,
 #endif
     for (int j = 0; j < std::min(n_product_coef, n_reactant_coef); j++) {
       auto const p_id = get_random_p_id_of_type(old_type);
+      record_old_energy(p_id);
       on_particle_type_change(p_id, old_type, new_type);
       if (auto p = get_local_particle(p_id)) {
         p->type() = new_type;
@@ -190,6 +199,7 @@ void ReactionAlgorithm::make_reaction_attempt(SingleReaction const &reaction,
       auto const type = reaction.product_types[i];
       for (int j = 0; j < delta_n; j++) {
         auto const p_id = create_particle(type);
+        record_new_energy(p_id);
         check_exclusion_range(p_id, type);
         bookkeeping.created.emplace_back(p_id);
       }
@@ -200,6 +210,7 @@ void ReactionAlgorithm::make_reaction_attempt(SingleReaction const &reaction,
         auto const p_id = get_random_p_id_of_type(type);
         bookkeeping.hidden.emplace_back(p_id, type);
         check_exclusion_range(p_id, type);
+        record_old_energy(p_id);
         hide_particle(p_id, type);
       }
       only_local_changes = false;
@@ -215,6 +226,7 @@ void ReactionAlgorithm::make_reaction_attempt(SingleReaction const &reaction,
         auto const p_id = get_random_p_id_of_type(type);
         bookkeeping.hidden.emplace_back(p_id, type);
         check_exclusion_range(p_id, type);
+        record_old_energy(p_id);
         hide_particle(p_id, type);
       }
     } else {
@@ -222,6 +234,7 @@ void ReactionAlgorithm::make_reaction_attempt(SingleReaction const &reaction,
       auto const type = reaction.product_types[i];
       for (int j = 0; j < reaction.product_coefficients[i]; j++) {
         auto const p_id = create_particle(type);
+        record_new_energy(p_id);
         check_exclusion_range(p_id, type);
         bookkeeping.created.emplace_back(p_id);
       }
@@ -262,9 +275,14 @@ ReactionAlgorithm::create_new_trial_state(int reaction_id) {
   auto &bookkeeping = make_new_system_state();
   bookkeeping.reaction_id = reaction_id;
   bookkeeping.old_particle_numbers = get_particle_numbers(reaction);
+  auto const local_energy_update = prepare_local_energy_update();
   make_reaction_attempt(reaction, bookkeeping);
   auto E_pot_new = std::numeric_limits<double>::max();
-  if (not particle_inside_exclusion_range_touched) {
+  if (particle_inside_exclusion_range_touched) {
+    m_energy_difference.clear();
+  } else if (local_energy_update) {
+    E_pot_new = m_reference_energy + calculate_energy_difference();
+  } else {
     E_pot_new = calculate_potential_energy();
   }
   return {E_pot_new};
@@ -281,6 +299,8 @@ double ReactionAlgorithm::make_reaction_mc_move_attempt(int reaction_id,
   if (get_random_uniform_number() >= bf) {
     // reject trial move: restore previous state, energy is unchanged
     restore_old_system_state();
+    reject_energy_difference();
+    m_reference_energy = E_pot_old;
     return E_pot_old;
   }
   // accept trial move: delete hidden particles and return new system energy
@@ -289,6 +309,8 @@ double ReactionAlgorithm::make_reaction_mc_move_attempt(int reaction_id,
   }
   reaction.accepted_moves++;
   clear_old_system_state();
+  accept_energy_difference();
+  m_reference_energy = E_pot_new;
   return E_pot_new;
 }
 
@@ -318,6 +340,22 @@ void ReactionAlgorithm::hide_particle(int p_id, int p_type) const {
   }
 }
 
+/** @brief Minimal distance of two particles, zero if unrestricted. */
+double ReactionAlgorithm::get_excluded_distance(int p_type, int p2_type) {
+  if (exclusion_radius_per_type.count(p_type) != 0 and
+      exclusion_radius_per_type[p_type] == 0.) {
+    return 0.;
+  }
+  if (exclusion_radius_per_type.count(p_type) == 0 ||
+      exclusion_radius_per_type.count(p2_type) == 0) {
+    return exclusion_range;
+  }
+  if (exclusion_radius_per_type[p2_type] == 0.) {
+    return 0.;
+  }
+  return exclusion_radius_per_type[p_type] + exclusion_radius_per_type[p2_type];
+}
+
 /**
  * Check if the inserted particle is too close to neighboring particles.
  */
@@ -360,17 +398,8 @@ void ReactionAlgorithm::check_exclusion_range(int p_id, int p_type) {
     for (auto const p2_id : particle_ids) {
       if (auto const p2_ptr = cell_structure.get_local_particle(p2_id)) {
         auto const &p2 = *p2_ptr;
-        double excluded_distance;
-        if (exclusion_radius_per_type.count(p_type) == 0 ||
-            exclusion_radius_per_type.count(p2.type()) == 0) {
-          excluded_distance = exclusion_range;
-        } else if (exclusion_radius_per_type[p2.type()] == 0.) {
-          continue;
-        } else {
-          excluded_distance = exclusion_radius_per_type[p_type] +
-                              exclusion_radius_per_type[p2.type()];
-        }
-
+        auto const excluded_distance =
+            get_excluded_distance(p_type, p2.type());
         auto const d_min = box_geo.get_mi_vector(p2.pos(), p1.pos()).norm();
 
         if (d_min < excluded_distance) {
@@ -482,6 +511,36 @@ Utils::Vector3d ReactionAlgorithm::get_random_position_in_box() {
   return out_pos;
 }
 
+std::vector<Utils::Vector3d>
+ReactionAlgorithm::get_random_positions_in_local_box(int n_positions) {
+  assert(m_reaction_constraint == ReactionConstraint::NONE);
+  auto const &local_geo = *System::get_system().local_geo;
+  auto const local_volume = Utils::product(local_geo.length());
+  std::vector<double> volumes;
+  boost::mpi::all_gather(m_comm, local_volume, volumes);
+  auto const rank = m_comm.rank();
+  auto const total_volume = std::accumulate(volumes.begin(), volumes.end(), 0.);
+  auto const lower_volume =
+      std::accumulate(volumes.begin(), volumes.begin() + rank, 0.);
+  auto const split = [n_positions, total_volume](double volume) {
+    return static_cast<int>(std::floor(n_positions * volume / total_volume));
+  };
+  auto const begin = split(lower_volume);
+  auto const end = (rank + 1 == m_comm.size())
+                       ? n_positions
+                       : split(lower_volume + local_volume);
+
+  auto generator = make_local_generator();
+  std::vector<Utils::Vector3d> positions(static_cast<std::size_t>(end - begin));
+  for (auto &pos : positions) {
+    for (unsigned int i = 0u; i < 3u; ++i) {
+      pos[i] = local_geo.my_left()[i] +
+               local_geo.length()[i] * m_uniform_real_distribution(generator);
+    }
+  }
+  return positions;
+}
+
 /**
  * Creates a particle at the end of the observed particle id range.
  */
@@ -540,6 +599,7 @@ void ReactionAlgorithm::displacement_mc_move(int type, int n_particles) {
     }
     boost::mpi::broadcast(m_comm, old_state, 0);
     bookkeeping.moved.emplace_back(old_state);
+    record_old_energy(p_id);
     ::set_particle_pos(p_id, new_pos);
 
     check_exclusion_range(p_id, type);
@@ -574,11 +634,18 @@ bool ReactionAlgorithm::make_displacement_mc_move_attempt(int type,
     return false;
   }
 
-  auto const E_pot_old = calculate_potential_energy();
+  auto const local_energy_update = prepare_local_energy_update();
+  auto const E_pot_old =
+      (local_energy_update) ? 0. : calculate_potential_energy();
   displacement_mc_move(type, n_particles);
-  auto const E_pot_new = (particle_inside_exclusion_range_touched)
-                             ? std::numeric_limits<double>::max()
-                             : calculate_potential_energy();
+  auto E_pot_new = std::numeric_limits<double>::max();
+  if (particle_inside_exclusion_range_touched) {
+    m_energy_difference.clear();
+  } else if (local_energy_update) {
+    E_pot_new = calculate_energy_difference();
+  } else {
+    E_pot_new = calculate_potential_energy();
+  }
 
   // Metropolis algorithm since proposal density is symmetric
   auto const bf = std::min(1., std::exp(-(E_pot_new - E_pot_old) / kT));
@@ -598,10 +665,12 @@ bool ReactionAlgorithm::make_displacement_mc_move_attempt(int type,
     // accept
     m_accepted_configurational_MC_moves += 1;
     clear_old_system_state();
+    accept_energy_difference();
     return true;
   }
   // reject: restore original particle properties
   restore_old_system_state();
+  reject_energy_difference();
   return false;
 }
 
@@ -623,14 +692,51 @@ void ReactionAlgorithm::setup_bookkeeping_of_empty_pids() {
   }
 }
 
-double ReactionAlgorithm::calculate_potential_energy() const {
+double ReactionAlgorithm::calculate_potential_energy() {
   auto &system = System::get_system();
   auto const obs = system.calculate_energy();
   auto pot = obs->accumulate(-obs->kinetic[0]);
   boost::mpi::broadcast(m_comm, pot, 0);
+  m_reference_energy = pot;
   return pot;
 }
 
+bool ReactionAlgorithm::prepare_local_energy_update() {
+  auto &system = System::get_system();
+  if (not local_energy_updates or not EnergyDifference::is_supported(system)) {
+    m_energy_difference.reset();
+    return false;
+  }
+  if (not m_energy_difference.is_up_to_date(system)) {
+    m_energy_difference.prepare(system);
+  }
+  return true;
+}
+
+double ReactionAlgorithm::calculate_energy_difference() {
+  return m_energy_difference.calculate(System::get_system());
+}
+
+void ReactionAlgorithm::accept_energy_difference() {
+  m_energy_difference.accept(System::get_system());
+}
+
+void ReactionAlgorithm::reject_energy_difference() {
+  m_energy_difference.reject(System::get_system());
+}
+
+void ReactionAlgorithm::record_old_energy(int p_id) {
+  if (m_energy_difference.is_prepared()) {
+    m_energy_difference.record_old(System::get_system(), p_id);
+  }
+}
+
+void ReactionAlgorithm::record_new_energy(int p_id) {
+  if (m_energy_difference.is_prepared()) {
+    m_energy_difference.record_new(p_id);
+  }
+}
+
 Particle *ReactionAlgorithm::get_real_particle(int p_id) const {
   assert(p_id >= 0);
   auto const &system = System::get_system();
@@ -653,4 +759,125 @@ Particle *ReactionAlgorithm::get_local_particle(int p_id) const {
   return ptr;
 }
 
+std::mt19937 ReactionAlgorithm::make_local_generator() {
+  auto const seed = static_cast<int>(m_generator() >> 1u);
+  return Random::mt19937(std::seed_seq({seed, m_comm.rank()}));
+}
+
+int ReactionAlgorithm::make_parallel_displacement_mc_sweep(
+    int type, double max_displacement) {
+
+  if (type < 0) {
+    throw std::domain_error("Parameter 'type_mc' must be >= 0");
+  }
+  if (max_displacement <= 0.) {
+    throw std::domain_error("Parameter 'max_displacement' must be > 0");
+  }
+
+  auto &system = System::get_system();
+  auto &cell_structure = *system.cell_structure;
+  auto const &box_geo = *system.box_geo;
+  if (cell_structure.decomposition_type() != CellStructureType::REGULAR) {
+    throw std::runtime_error(
+        "Parallel displacement MC moves require the regular decomposition");
+  }
+  if (has_reaction_constraint()) {
+    throw std::runtime_error(
+        "Parallel displacement MC moves don't support reaction constraints");
+  }
+  if (not EnergyDifference::is_short_range(system)) {
+    throw std::runtime_error(
+        "Parallel displacement MC moves require short-range interactions");
+  }
+  system.on_observable_calc();
+  auto const particles = cell_structure.local_particles();
+  auto const has_local_bonds =
+      std::any_of(particles.begin(), particles.end(),
+                  [](Particle const &p) { return not p.bonds().empty(); });
+  if (boost::mpi::all_reduce(m_comm, has_local_bonds, std::logical_or<>())) {
+    throw std::runtime_error(
+        "Parallel displacement MC moves don't support bonded particles");
+  }
+  auto const &decomposition = dynamic_cast<RegularDecomposition const &>(
+      std::as_const(cell_structure).decomposition());
+  auto const colors = decomposition.checkerboard_colors();
+  if (colors.empty()) {
+    throw std::runtime_error("Parallel displacement MC moves require at "
+                             "least 2 cells in each direction");
+  }
+  // each particle is displaced at most once per sweep and stays in its
+  // cell: the cell neighborhood still contains all interaction partners,
+  // and particles in cells of the same color remain out of range
+  auto const max_exclusion_range =
+      std::max(exclusion_range, m_max_exclusion_range);
+  auto const range = std::max(system.maximal_cutoff(), max_exclusion_range);
+  auto const min_cell_size = std::ranges::min(decomposition.cell_size);
+  if (2. * max_displacement > min_cell_size - range) {
+    throw std::runtime_error(
+        "Parameter 'max_displacement' must be smaller than half the cell "
+        "size minus the interaction range (" +
+        std::to_string(0.5 * (min_cell_size - range)) + ")");
+  }
+
+  auto generator = make_local_generator();
+  auto const random_uniform = [this, &generator]() {
+    return m_uniform_real_distribution(generator);
+  };
+  auto const is_inside_exclusion_range = [&](Particle const &p1, Cell &cell) {
+    if (max_exclusion_range == 0.) {
+      return false;
+    }
+    auto touched = false;
+    auto kernel = [&](Particle const &, Particle const &p2,
+                      Utils::Vector3d const &vec) {
+      touched |= vec.norm() < get_excluded_distance(p1.type(), p2.type());
+    };
+    cell_structure.run_on_cell_short_range_neighbors(p1, &cell, kernel);
+    return touched;
+  };
+
+  int n_tried = 0;
+  int n_accepted = 0;
+  for (auto const &cells : colors) {
+    for (auto const cell : cells) {
+      for (auto &p : cell->particles()) {
+        if (p.type() != type) {
+          continue;
+        }
+        ++n_tried;
+        auto const old_pos = p.pos();
+        auto const old_image_box = p.image_box();
+        auto const E_pot_old =
+            EnergyDifference::short_range_energy(system, p, *cell);
+        for (unsigned int i = 0u; i < 3u; ++i) {
+          p.pos()[i] += max_displacement * (2. * random_uniform() - 1.);
+        }
+        box_geo.fold_position(p.pos(), p.image_box());
+        auto accept = false;
+        if (not is_inside_exclusion_range(p, *cell)) {
+          auto const E_pot_new =
+              EnergyDifference::short_range_energy(system, p, *cell);
+          // Metropolis algorithm since proposal density is symmetric
+          accept = random_uniform() < std::exp(-(E_pot_new - E_pot_old) / kT);
+        }
+        if (accept) {
+          ++n_accepted;
+        } else {
+          p.pos() = old_pos;
+          p.image_box() = old_image_box;
+        }
+      }
+    }
+    // particles stay in their cells until the end of the sweep
+    cell_structure.ghosts_update(Cells::DATA_PART_POSITION);
+  }
+  system.on_particle_change();
+
+  n_tried = boost::mpi::all_reduce(m_comm, n_tried, std::plus<>());
+  n_accepted = boost::mpi::all_reduce(m_comm, n_accepted, std::plus<>());
+  m_tried_configurational_MC_moves += n_tried;
+  m_accepted_configurational_MC_moves += n_accepted;
+  return n_accepted;
+}
+
 } // namespace ReactionMethods
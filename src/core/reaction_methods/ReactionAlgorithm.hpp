@@ -21,6 +21,7 @@
 
 #include "config/config.hpp"
 
+#include "EnergyDifference.hpp"
 #include "SingleReaction.hpp"
 
 #include "Particle.hpp"
@@ -46,7 +47,7 @@ namespace ReactionMethods {
 
 /** Base class for reaction ensemble methods */
 class ReactionAlgorithm {
-private:
+protected:
   boost::mpi::communicator const &m_comm;
 
 public:
@@ -55,6 +56,7 @@ public:
       double exclusion_range,
       std::unordered_map<int, double> const &exclusion_radius_per_type)
       : m_comm{comm}, kT{kT}, exclusion_range{exclusion_range},
+        m_energy_difference(comm),
         m_generator(Random::mt19937(std::seed_seq({seed, seed, seed}))),
         m_normal_distribution(0.0, 1.0), m_uniform_real_distribution(0.0, 1.0) {
     if (kT < 0.) {
@@ -137,6 +139,12 @@ public:
 
   bool particle_inside_exclusion_range_touched = false;
   bool neighbor_search_order_n = true;
+  /**
+   * Calculate the energy change of a move from the interactions of the
+   * changed particles only, see @ref EnergyDifference. Falls back to the
+   * energy of the whole system when the active interactions don't allow it.
+   */
+  bool local_energy_updates = false;
 
 protected:
   std::vector<int> m_empty_p_ids_smaller_than_max_seen_particle;
@@ -201,9 +209,27 @@ public:
    * @returns true if all moves were accepted.
    */
   bool make_displacement_mc_move_attempt(int type, int n_particles);
+  /**
+   * Attempt one displacement MC move for each particle of a given type,
+   * in parallel on all ranks.
+   * The local cells are visited by checkerboard color. Particles in cells
+   * of the same color are displaced concurrently on all ranks, each move
+   * is accepted or rejected locally, and the ghost positions are updated
+   * before the next color. Particles are resorted after the sweep.
+   * Requires the regular decomposition and short-range interactions
+   * without bonds.
+   * @param type               Type of particles to move.
+   * @param max_displacement   Maximal displacement in each direction.
+   * @returns Number of accepted moves on all ranks.
+   */
+  int make_parallel_displacement_mc_sweep(int type, double max_displacement);
 
-  /** @brief Compute the system potential energy. */
-  double calculate_potential_energy() const;
+  /**
+   * @brief Compute the system potential energy.
+   * With @ref local_energy_updates, the energy of subsequent reaction
+   * moves is calculated relative to this value.
+   */
+  double calculate_potential_energy();
 
 protected:
   /**
@@ -218,6 +244,20 @@ protected:
   void make_reaction_attempt(::ReactionMethods::SingleReaction const &reaction,
                              ParticleChanges &bookkeeping);
 
+  /**
+   * @brief Whether the energy of the next move can be calculated from
+   * the changed particles. Sets up @ref m_energy_difference if needed.
+   */
+  bool prepare_local_energy_update();
+  /** @brief Energy change of the move recorded by @ref m_energy_difference. */
+  double calculate_energy_difference();
+  /** @brief Update @ref m_energy_difference after an accepted move. */
+  void accept_energy_difference();
+  /** @brief Keep @ref m_energy_difference after a reverted move. */
+  void reject_energy_difference();
+
+  EnergyDifference m_energy_difference;
+
 public:
   /**
    * @brief draws a random integer from the uniform distribution in the range
@@ -245,6 +285,9 @@ private:
   int create_particle(int p_type);
   void hide_particle(int p_id, int p_type) const;
   void check_exclusion_range(int p_id, int p_type);
+  double get_excluded_distance(int p_type, int p2_type);
+  /** @brief Generator of this rank, seeded from the common generator. */
+  std::mt19937 make_local_generator();
   auto get_random_uniform_number() {
     return m_uniform_real_distribution(m_generator);
   }
@@ -262,12 +305,29 @@ private:
   double m_slab_start_z = -10.0;
   double m_slab_end_z = -10.0;
   double m_max_exclusion_range = 0.;
+  /** Potential energy the local energy updates are relative to. */
+  double m_reference_energy = 0.;
 
   Particle *get_real_particle(int p_id) const;
   Particle *get_local_particle(int p_id) const;
+  void record_old_energy(int p_id);
+  void record_new_energy(int p_id);
 
 protected:
   Utils::Vector3d get_random_position_in_box();
+  auto has_reaction_constraint() const {
+    return m_reaction_constraint != ReactionConstraint::NONE;
+  }
+  /**
+   * @brief Draw random positions in the local domain of this rank.
+   * The positions are split over the ranks in proportion to the volume
+   * of their local domain, such that the positions of all ranks are
+   * uniformly distributed in the box. The random number generator of
+   * each rank is seeded from the common generator.
+   * @param n_positions   Total number of positions on all ranks.
+   */
+  std::vector<Utils::Vector3d>
+  get_random_positions_in_local_box(int n_positions);
 };
 
 } // namespace ReactionMethods
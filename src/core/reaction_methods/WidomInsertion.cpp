@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config/config.hpp"
+
+#include "reaction_methods/WidomInsertion.hpp"
+
+#include "reaction_methods/EnergyDifference.hpp"
+#include "reaction_methods/SingleReaction.hpp"
+
+#include "Particle.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "particle_node.hpp"
+#include "system/System.hpp"
+
+#include <boost/mpi/collectives/all_reduce.hpp>
+#include <boost/mpi/communicator.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace ReactionMethods {
+
+namespace {
+bool is_single_particle_insertion(SingleReaction const &reaction) {
+  return reaction.reactant_types.empty() and
+         reaction.product_types.size() == 1ul and
+         reaction.product_coefficients[0] == 1;
+}
+
+/**
+ * @brief Unused particle id which would be owned by this rank,
+ * as required by the N-square cell system.
+ */
+int get_test_particle_id(boost::mpi::communicator const &comm) {
+  auto const p_id = ::get_maximal_particle_id() + 1;
+  return p_id + (comm.rank() - p_id % comm.size() + comm.size()) % comm.size();
+}
+} // namespace
+
+double WidomInsertion::calculate_particle_insertion_boltzmann_factor(
+    int reaction_id, int n_insertions) {
+  if (n_insertions <= 0) {
+    throw std::domain_error("Invalid value for 'n_insertions'");
+  }
+  auto const &reaction = *reactions[reaction_id];
+  auto &system = System::get_system();
+  if (not is_single_particle_insertion(reaction) or
+      has_reaction_constraint() or not EnergyDifference::is_supported(system)) {
+    auto boltzmann_factor = 0.;
+    for (int i = 0; i < n_insertions; ++i) {
+      auto const delta_E =
+          calculate_particle_insertion_potential_energy(reaction_id);
+      boltzmann_factor += std::exp(-delta_E / kT);
+    }
+    return boltzmann_factor / static_cast<double>(n_insertions);
+  }
+
+  auto const type = reaction.product_types[0];
+  system.nonbonded_ias->make_particle_type_exist(type);
+  Particle p_test;
+  p_test.id() = get_test_particle_id(m_comm);
+  p_test.type() = type;
+#ifdef ELECTROSTATICS
+  p_test.q() = charges_of_types.at(type);
+#endif
+  auto const positions = get_random_positions_in_local_box(n_insertions);
+  if (not m_energy_difference.is_up_to_date(system)) {
+    m_energy_difference.prepare(system);
+  }
+
+  auto const &energy_difference = m_energy_difference;
+  auto const n_local = static_cast<long>(positions.size());
+  std::vector<double> boltzmann_factors(positions.size());
+#ifdef OPENMP
+#pragma omp parallel for firstprivate(p_test)
+#endif
+  for (long i = 0; i < n_local; ++i) {
+    auto const index = static_cast<std::size_t>(i);
+    p_test.pos() = positions[index];
+    auto const delta_E = energy_difference.test_particle_energy(system, p_test);
+    boltzmann_factors[index] = std::exp(-delta_E / kT);
+  }
+
+  auto const local_sum =
+      std::accumulate(boltzmann_factors.begin(), boltzmann_factors.end(), 0.);
+  auto const sum = boost::mpi::all_reduce(m_comm, local_sum, std::plus<>());
+  return sum / static_cast<double>(n_insertions);
+}
+
+} // namespace ReactionMethods
@@ -45,6 +45,13 @@ public:
 
     // make reaction attempt and immediately reverse it
     setup_bookkeeping_of_empty_pids();
+    if (prepare_local_energy_update()) {
+      make_reaction_attempt(reaction, make_new_system_state());
+      auto const delta_E = calculate_energy_difference();
+      restore_old_system_state();
+      reject_energy_difference();
+      return delta_E;
+    }
     auto const E_pot_old = calculate_potential_energy();
     make_reaction_attempt(reaction, make_new_system_state());
     auto const E_pot_new = calculate_potential_energy();
@@ -52,6 +59,27 @@ public:
 
     return E_pot_new - E_pot_old;
   }
+
+  /**
+   * @brief Average Boltzmann factor of many particle insertions.
+   *
+   * Single-particle insertions are evaluated as test particles which
+   * are never added to the system. The insertion positions are
+   * distributed over the local domains of the MPI ranks and the energies
+   * are evaluated in parallel over the threads of each rank; only the
+   * sum of the Boltzmann factors is communicated. Other reactions, and
+   * interactions without a local energy (see
+   * @ref EnergyDifference::is_supported), fall back to one call of
+   * @ref calculate_particle_insertion_potential_energy per insertion.
+   * Like the latter, the batched insertions ignore the exclusion range
+   * and the exclusion radii.
+   *
+   * @param reaction_id   Index of the insertion reaction.
+   * @param n_insertions  Number of insertions on all ranks.
+   * @return Average of @f$ \exp(-\Delta E / k_B T) @f$.
+   */
+  double calculate_particle_insertion_boltzmann_factor(int reaction_id,
+                                                       int n_insertions);
 };
 
 } // namespace ReactionMethods
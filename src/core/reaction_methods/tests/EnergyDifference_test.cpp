@@ -0,0 +1,454 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_MODULE EnergyDifference test
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "config/config.hpp"
+
+#include "reaction_methods/EnergyDifference.hpp"
+#include "reaction_methods/SingleReaction.hpp"
+#include "reaction_methods/WidomInsertion.hpp"
+
+#include "LocalBox.hpp"
+#include "Observable_stat.hpp"
+#include "Particle.hpp"
+#include "actor/registration.hpp"
+#include "bonded_interactions/bonded_interaction_data.hpp"
+#include "bonded_interactions/harmonic.hpp"
+#include "cell_system/CellStructure.hpp"
+#include "cell_system/CellStructureType.hpp"
+#include "communication.hpp"
+#include "electrostatics/coulomb.hpp"
+#include "electrostatics/debye_hueckel.hpp"
+#include "electrostatics/p3m.hpp"
+#include "electrostatics/p3m.impl.hpp"
+#include "nonbonded_interactions/lj.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "p3m/FFTBackendLegacy.hpp"
+#include "p3m/FFTBuffersLegacy.hpp"
+#include "particle_node.hpp"
+#include "system/System.hpp"
+#include "unit_tests/ParticleFactory.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <boost/mpi.hpp>
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace espresso {
+// ESPResSo system instance
+static std::shared_ptr<System::System> system;
+} // namespace espresso
+
+static double calculate_potential_energy(boost::mpi::communicator const &comm) {
+  auto const obs = espresso::system->calculate_energy();
+  auto pot = obs->accumulate(-obs->kinetic[0]);
+  boost::mpi::broadcast(comm, pot, 0);
+  return pot;
+}
+
+namespace Testing {
+/** Expose the random test particle positions. */
+class WidomInsertion : public ReactionMethods::WidomInsertion {
+public:
+  using ReactionMethods::WidomInsertion::get_random_positions_in_local_box;
+  using ReactionMethods::WidomInsertion::WidomInsertion;
+};
+} // namespace Testing
+
+// Check the energy difference of local changes against the total energy.
+BOOST_FIXTURE_TEST_CASE(EnergyDifference_test, ParticleFactory) {
+  using ReactionMethods::EnergyDifference;
+  auto constexpr tol = 1e-10;
+  auto const comm = boost::mpi::communicator();
+  auto &system = *espresso::system;
+  system.set_box_l(Utils::Vector3d::broadcast(8.));
+  system.cell_structure->set_verlet_skin(0.4);
+
+  int const type_A = 0;
+  int const type_B = 1;
+  int const type_inert = 5;
+  auto const bond_id = 0;
+  {
+    auto const bond = HarmonicBond(20., 1.2, 3.);
+    auto const bond_ia = std::make_shared<Bonded_IA_Parameters>(bond);
+    system.bonded_ias->insert(bond_id, bond_ia);
+  }
+
+  // particles on both sides of the MPI domain boundary
+  std::vector<Utils::Vector3d> const positions = {
+      {3.5, 4.0, 4.0}, {4.6, 4.2, 4.0}, {3.9, 5.1, 4.3},
+      {4.3, 3.1, 3.6}, {0.3, 0.4, 7.6}, {7.5, 7.8, 0.2}};
+  std::vector<double> const charges = {1., -1., 0.5, -0.5, 1., -1.};
+  for (int p_id = 0; p_id < static_cast<int>(positions.size()); ++p_id) {
+    auto const type = (p_id % 2 == 0) ? type_A : type_B;
+    create_particle(positions[p_id], p_id, type);
+#ifdef ELECTROSTATICS
+    set_particle_property(p_id, &Particle::q, charges[p_id]);
+#endif
+  }
+  insert_particle_bond(0, bond_id, {1});
+  insert_particle_bond(2, bond_id, {3});
+  insert_particle_bond(4, bond_id, {5});
+  system.nonbonded_ias->make_particle_type_exist(type_inert);
+#ifdef LENNARD_JONES
+  {
+    auto const lj = LJ_Parameters{1., 1., 2.5, 0., 0., 0.};
+    system.nonbonded_ias->get_ia_param(type_A, type_A).lj = lj;
+    system.nonbonded_ias->get_ia_param(type_A, type_B).lj = lj;
+    system.nonbonded_ias->get_ia_param(type_B, type_B).lj = lj;
+    system.on_non_bonded_ia_change();
+  }
+#endif
+
+#ifdef ELECTROSTATICS
+  auto const solver = std::make_shared<DebyeHueckel>(2., 0.5, 3.);
+  // moves change the net charge
+  solver->charge_neutrality_tolerance = -1.;
+  add_actor(comm, espresso::system, system.coulomb.impl->solver, solver,
+            [&system]() { system.on_coulomb_change(); });
+#endif
+
+  BOOST_REQUIRE(EnergyDifference::is_supported(system));
+  auto energy_difference = EnergyDifference(comm);
+  BOOST_REQUIRE(not energy_difference.is_prepared());
+
+  // move particles, some of them in the interaction range of each other
+  {
+    auto const E_pot_old = calculate_potential_energy(comm);
+    energy_difference.prepare(system);
+    BOOST_REQUIRE(energy_difference.is_prepared());
+    energy_difference.record_old(system, 1);
+    ::set_particle_pos(1, {4.9, 4.4, 3.9});
+    energy_difference.record_old(system, 2);
+    ::set_particle_pos(2, {4.1, 4.9, 4.5});
+    energy_difference.record_old(system, 4);
+    ::set_particle_pos(4, {7.8, 7.6, 0.5});
+    // a particle recorded twice only counts once
+    energy_difference.record_old(system, 4);
+    auto const delta_E = energy_difference.calculate(system);
+    auto const E_pot_new = calculate_potential_energy(comm);
+    BOOST_CHECK_SMALL(delta_E - (E_pot_new - E_pot_old), tol);
+    BOOST_CHECK_GT(std::abs(delta_E), 1e-3);
+  }
+
+  // change type and charge, then hide a particle
+  {
+    auto const E_pot_old = calculate_potential_energy(comm);
+    energy_difference.prepare(system);
+    energy_difference.record_old(system, 0);
+    set_particle_type(0, type_B);
+#ifdef ELECTROSTATICS
+    set_particle_property(0, &Particle::q, -0.5);
+#endif
+    energy_difference.record_old(system, 3);
+    set_particle_type(3, type_inert);
+#ifdef ELECTROSTATICS
+    set_particle_property(3, &Particle::q, 0.);
+#endif
+    system.on_particle_change();
+    auto const delta_E = energy_difference.calculate(system);
+    auto const E_pot_new = calculate_potential_energy(comm);
+    BOOST_CHECK_SMALL(delta_E - (E_pot_new - E_pot_old), tol);
+  }
+
+  // create particles
+  {
+    auto const E_pot_old = calculate_potential_energy(comm);
+    energy_difference.prepare(system);
+    create_particle({4.4, 4.0, 4.8}, 6, type_A);
+    energy_difference.record_new(6);
+    create_particle({0.1, 7.9, 7.9}, 7, type_B);
+    energy_difference.record_new(7);
+#ifdef ELECTROSTATICS
+    set_particle_property(6, &Particle::q, 1.);
+    set_particle_property(7, &Particle::q, -1.);
+#endif
+    system.on_particle_change();
+    auto const delta_E = energy_difference.calculate(system);
+    auto const E_pot_new = calculate_potential_energy(comm);
+    BOOST_CHECK_SMALL(delta_E - (E_pot_new - E_pot_old), tol);
+  }
+
+  // the energy of a test particle is the energy of inserting it
+  {
+    auto const E_pot_old = calculate_potential_energy(comm);
+    energy_difference.prepare(system);
+    Particle p_test;
+    p_test.id() = 8;
+    p_test.type() = type_A;
+    p_test.pos() = {4.2, 3.8, 4.4};
+#ifdef ELECTROSTATICS
+    p_test.q() = 1.;
+#endif
+    auto energy = 0.;
+    auto const &local_geo = *system.local_geo;
+    if (p_test.pos() >= local_geo.my_left() and
+        p_test.pos() < local_geo.my_right()) {
+      energy = energy_difference.test_particle_energy(system, p_test);
+    }
+    energy = boost::mpi::all_reduce(comm, energy, std::plus<>());
+    energy_difference.reset();
+    create_particle(p_test.pos(), p_test.id(), p_test.type());
+#ifdef ELECTROSTATICS
+    set_particle_property(p_test.id(), &Particle::q, p_test.q());
+#endif
+    system.on_particle_change();
+    auto const E_pot_new = calculate_potential_energy(comm);
+    BOOST_CHECK_SMALL(energy - (E_pot_new - E_pot_old), tol);
+    BOOST_CHECK_GT(std::abs(energy), 1e-3);
+  }
+
+  // the Widom insertion energy doesn't depend on the energy algorithm;
+  // there is only one particle of the reactant type, such that both
+  // algorithms pick the same particles from the same seed
+  {
+    std::vector<std::shared_ptr<ReactionMethods::SingleReaction>> const
+        reactions = {std::make_shared<ReactionMethods::SingleReaction>(
+                         2., std::vector<int>{type_inert},
+                         std::vector<int>{1}, std::vector<int>{type_A},
+                         std::vector<int>{1}),
+                     std::make_shared<ReactionMethods::SingleReaction>(
+                         2., std::vector<int>{}, std::vector<int>{},
+                         std::vector<int>{type_A, type_B},
+                         std::vector<int>{1, 1})};
+    auto const make_widom = [&](bool local_energy_updates) {
+      auto widom = std::make_unique<ReactionMethods::WidomInsertion>(
+          comm, 42, 1., 0., std::unordered_map<int, double>{});
+      widom->non_interacting_type = type_inert;
+      widom->charges_of_types = {
+          {type_A, 1.}, {type_B, -1.}, {type_inert, 0.}};
+      widom->local_energy_updates = local_energy_updates;
+      for (auto const &reaction : reactions) {
+        widom->add_reaction(reaction);
+      }
+      return widom;
+    };
+    auto widom_ref = make_widom(false);
+    auto widom_local = make_widom(true);
+    for (int i = 0; i < 4; ++i) {
+      for (int reaction_id = 0; reaction_id < 2; ++reaction_id) {
+        auto const E_ref =
+            widom_ref->calculate_particle_insertion_potential_energy(
+                reaction_id);
+        auto const E_local =
+            widom_local->calculate_particle_insertion_potential_energy(
+                reaction_id);
+        BOOST_CHECK_SMALL(E_local - E_ref, tol);
+      }
+    }
+  }
+
+  // the batched insertions sample the energy of test particles drawn
+  // uniformly in the local domains of all ranks
+  {
+    auto constexpr n_insertions = 500;
+    auto const reaction = std::make_shared<ReactionMethods::SingleReaction>(
+        2., std::vector<int>{}, std::vector<int>{}, std::vector<int>{type_A},
+        std::vector<int>{1});
+    auto const make_widom = [&](double exclusion_range = 0.) {
+      auto widom = std::make_unique<Testing::WidomInsertion>(
+          comm, 42, 1.5, exclusion_range, std::unordered_map<int, double>{});
+      widom->charges_of_types = {{type_A, 1.}};
+      widom->add_reaction(reaction);
+      return widom;
+    };
+    auto widom_ref = make_widom();
+    auto widom = make_widom();
+    auto const &local_geo = *system.local_geo;
+    auto const positions =
+        widom_ref->get_random_positions_in_local_box(n_insertions);
+    auto energy_difference_ref = EnergyDifference(comm);
+    energy_difference_ref.prepare(system);
+    Particle p_test;
+    p_test.id() = 100 + comm.rank();
+    p_test.type() = type_A;
+#ifdef ELECTROSTATICS
+    p_test.q() = 1.;
+#endif
+    auto boltzmann_factor_ref = 0.;
+    for (auto const &pos : positions) {
+      for (auto const i : {0u, 1u, 2u}) {
+        BOOST_REQUIRE_GE(pos[i], local_geo.my_left()[i]);
+        BOOST_REQUIRE_LT(pos[i], local_geo.my_right()[i]);
+      }
+      p_test.pos() = pos;
+      auto const energy =
+          energy_difference_ref.test_particle_energy(system, p_test);
+      boltzmann_factor_ref += std::exp(-energy / widom_ref->kT);
+    }
+    energy_difference_ref.reset();
+    boltzmann_factor_ref =
+        boost::mpi::all_reduce(comm, boltzmann_factor_ref, std::plus<>()) /
+        static_cast<double>(n_insertions);
+    auto const n_positions = boost::mpi::all_reduce(
+        comm, static_cast<int>(positions.size()), std::plus<>());
+    BOOST_CHECK_EQUAL(n_positions, n_insertions);
+    auto const boltzmann_factor =
+        widom->calculate_particle_insertion_boltzmann_factor(0, n_insertions);
+    BOOST_CHECK_CLOSE(boltzmann_factor, boltzmann_factor_ref, 1e-10);
+    // exclusion radii don't apply to Widom insertions
+    auto widom_excl = make_widom(1.);
+    widom_excl->set_exclusion_radius_per_type({{type_A, 0.8}});
+    BOOST_CHECK_CLOSE(
+        widom_excl->calculate_particle_insertion_boltzmann_factor(
+            0, n_insertions),
+        boltzmann_factor_ref, 1e-10);
+    BOOST_CHECK_THROW(
+        widom->calculate_particle_insertion_boltzmann_factor(0, 0),
+        std::domain_error);
+  }
+
+  system.bonded_ias->erase(bond_id);
+#ifdef ELECTROSTATICS
+  system.coulomb.impl->solver = std::nullopt;
+  system.on_coulomb_change();
+#endif
+}
+
+BOOST_FIXTURE_TEST_CASE(EnergyDifference_reuse_test, ParticleFactory) {
+  using ReactionMethods::EnergyDifference;
+  auto constexpr tol = 1e-9;
+  auto const comm = boost::mpi::communicator();
+  auto &system = *espresso::system;
+  system.set_box_l(Utils::Vector3d::broadcast(8.));
+  system.cell_structure->set_verlet_skin(0.4);
+
+  int const type_A = 0;
+  std::vector<Utils::Vector3d> positions = {
+      {3.5, 4.0, 4.0}, {4.6, 4.2, 4.0}, {0.3, 0.4, 7.6}, {7.5, 7.8, 0.2}};
+  std::vector<double> charges = {1., -1., 0.5, -0.5};
+  for (int p_id = 0; p_id < static_cast<int>(positions.size()); ++p_id) {
+    create_particle(positions[p_id], p_id, type_A);
+#ifdef ELECTROSTATICS
+    set_particle_property(p_id, &Particle::q, charges[p_id]);
+#endif
+  }
+#ifdef LENNARD_JONES
+  system.nonbonded_ias->get_ia_param(type_A, type_A).lj =
+      LJ_Parameters{1., 1., 2.5, 0., 0., 0.};
+  system.on_non_bonded_ia_change();
+#endif
+
+  // the state prepared once remains valid across accepted and rejected
+  // moves, but not across changes by other means
+  auto const check_moves = [&]() {
+    std::vector<Utils::Vector3d> const new_positions = {
+        {4.9, 4.4, 3.9}, {3.1, 3.6, 4.4}, {7.8, 0.1, 0.3},
+        {4.2, 3.7, 4.1}, {4.8, 4.9, 3.6}, {0.2, 7.6, 7.9}};
+    auto energy_difference = EnergyDifference(comm);
+    energy_difference.prepare(system);
+    auto E_pot_old = calculate_potential_energy(comm);
+    for (int move = 0; move < static_cast<int>(new_positions.size());
+         ++move) {
+      BOOST_REQUIRE(energy_difference.is_up_to_date(system));
+      auto const p_id = move % 3;
+      auto const accepted = move % 3 != 1;
+      energy_difference.record_old(system, p_id);
+      ::set_particle_pos(p_id, new_positions[move]);
+#ifdef ELECTROSTATICS
+      // moves of the last particle change the net charge
+      auto const q_new = (p_id == 2) ? -charges[p_id] : charges[p_id];
+      set_particle_property(p_id, &Particle::q, q_new);
+      system.on_particle_change();
+#endif
+      auto const delta_E = energy_difference.calculate(system);
+      auto const E_pot_new = calculate_potential_energy(comm);
+      BOOST_CHECK_SMALL(delta_E - (E_pot_new - E_pot_old), tol);
+      if (accepted) {
+        positions[p_id] = new_positions[move];
+#ifdef ELECTROSTATICS
+        charges[p_id] = q_new;
+#endif
+        energy_difference.accept(system);
+        E_pot_old = E_pot_new;
+      } else {
+        ::set_particle_pos(p_id, positions[p_id]);
+#ifdef ELECTROSTATICS
+        set_particle_property(p_id, &Particle::q, charges[p_id]);
+        system.on_particle_change();
+#endif
+        energy_difference.reject(system);
+      }
+    }
+    BOOST_REQUIRE(energy_difference.is_up_to_date(system));
+    ::set_particle_pos(3, {7.2, 7.7, 0.4});
+    positions[3] = {7.2, 7.7, 0.4};
+    BOOST_CHECK(not energy_difference.is_up_to_date(system));
+  };
+
+#ifdef ELECTROSTATICS
+  {
+    auto const solver = std::make_shared<DebyeHueckel>(2., 0.5, 3.);
+    solver->charge_neutrality_tolerance = -1.;
+    add_actor(comm, espresso::system, system.coulomb.impl->solver, solver,
+              [&system]() { system.on_coulomb_change(); });
+  }
+#endif
+  check_moves();
+#ifdef P3M
+  {
+    // the mesh potential is updated from the charge change of the moves
+    auto p3m = P3MParameters{false,
+                             P3M_EPSILON_METALLIC,
+                             2.5,
+                             Utils::Vector3i::broadcast(16),
+                             Utils::Vector3d::broadcast(0.5),
+                             5,
+                             1.2,
+                             1e-3};
+    auto const solver =
+        new_p3m_handle<double, Arch::CPU, FFTBackendLegacy, FFTBuffersLegacy>(
+            std::move(p3m), 2., 1, false, true);
+    solver->charge_neutrality_tolerance = -1.;
+    add_actor(comm, espresso::system, system.coulomb.impl->solver, solver,
+              [&system]() { system.on_coulomb_change(); });
+  }
+  BOOST_REQUIRE(EnergyDifference::is_supported(system));
+  check_moves();
+#endif
+
+#ifdef ELECTROSTATICS
+  system.coulomb.impl->solver = std::nullopt;
+  system.on_coulomb_change();
+#endif
+#ifdef LENNARD_JONES
+  system.nonbonded_ias->get_ia_param(type_A, type_A).lj = LJ_Parameters{};
+  system.on_non_bonded_ia_change();
+#endif
+}
+
+int main(int argc, char **argv) {
+  auto const mpi_handle = MpiContainerUnitTest(argc, argv);
+  espresso::system = System::System::create();
+  espresso::system->set_cell_structure_topology(CellStructureType::REGULAR);
+  ::System::set_system(espresso::system);
+  return boost::unit_test::unit_test_main(init_unit_test, argc, argv);
+}
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_MODULE Parallel displacement MC test
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "config/config.hpp"
+
+#include "reaction_methods/ReactionAlgorithm.hpp"
+
+#include "BoxGeometry.hpp"
+#include "Observable_stat.hpp"
+#include "Particle.hpp"
+#include "bonded_interactions/bonded_interaction_data.hpp"
+#include "bonded_interactions/harmonic.hpp"
+#include "cell_system/CellStructure.hpp"
+#include "cell_system/CellStructureType.hpp"
+#include "communication.hpp"
+#include "nonbonded_interactions/lj.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "particle_node.hpp"
+#include "system/System.hpp"
+#include "unit_tests/ParticleFactory.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <boost/mpi.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace espresso {
+// ESPResSo system instance
+static std::shared_ptr<System::System> system;
+} // namespace espresso
+
+static auto get_positions(boost::mpi::communicator const &comm) {
+  std::vector<std::pair<int, Utils::Vector3d>> local_positions;
+  for (auto const &p : espresso::system->cell_structure->local_particles()) {
+    local_positions.emplace_back(p.id(), p.pos());
+  }
+  std::vector<std::vector<std::pair<int, Utils::Vector3d>>> positions;
+  boost::mpi::all_gather(comm, local_positions, positions);
+  std::map<int, Utils::Vector3d> out;
+  for (auto const &positions_of_rank : positions) {
+    out.insert(positions_of_rank.begin(), positions_of_rank.end());
+  }
+  return out;
+}
+
+static double calculate_potential_energy(boost::mpi::communicator const &comm) {
+  auto const obs = espresso::system->calculate_energy();
+  auto pot = obs->accumulate(-obs->kinetic[0]);
+  boost::mpi::broadcast(comm, pot, 0);
+  return pot;
+}
+
+// Check the parallel sweep of displacement MC moves.
+BOOST_FIXTURE_TEST_CASE(displacement_mc_sweep_test, ParticleFactory) {
+  auto constexpr tol = 1e-10;
+  auto const comm = boost::mpi::communicator();
+  auto &system = *espresso::system;
+  auto const &box_geo = *system.box_geo;
+  auto const box_l = 6.;
+  auto const max_displacement = 0.3;
+  system.set_box_l(Utils::Vector3d::broadcast(box_l));
+  system.cell_structure->set_verlet_skin(1.);
+
+  int const type_A = 0;
+  int const type_B = 1;
+  // particles on a lattice, one in eight is of type B
+  auto const n_lattice = 5;
+  auto const spacing = box_l / static_cast<double>(n_lattice);
+  int n_part_A = 0;
+  int n_part_B = 0;
+  int p_id = 0;
+  for (int i = 0; i < n_lattice; ++i) {
+    for (int j = 0; j < n_lattice; ++j) {
+      for (int k = 0; k < n_lattice; ++k) {
+        auto const type = (p_id % 8 == 0) ? type_B : type_A;
+        auto const pos = spacing * Utils::Vector3d{i + 0.5, j + 0.5, k + 0.5};
+        create_particle(pos, p_id++, type);
+        ++((type == type_A) ? n_part_A : n_part_B);
+      }
+    }
+  }
+  auto const n_part = p_id;
+  system.nonbonded_ias->make_particle_type_exist(type_B);
+#ifdef LENNARD_JONES
+  system.nonbonded_ias->get_ia_param(type_A, type_A).lj =
+      LJ_Parameters{1., 1., 1.5, 0., 0., 0.};
+  system.on_non_bonded_ia_change();
+#endif
+
+  auto r_algo = ReactionMethods::ReactionAlgorithm(comm, 42, 1., 0., {});
+
+  // invalid parameters
+  BOOST_CHECK_THROW(r_algo.make_parallel_displacement_mc_sweep(-1, 0.1),
+                    std::domain_error);
+  BOOST_CHECK_THROW(r_algo.make_parallel_displacement_mc_sweep(type_A, 0.),
+                    std::domain_error);
+  BOOST_CHECK_THROW(r_algo.make_parallel_displacement_mc_sweep(type_A, 2.),
+                    std::runtime_error);
+
+  // the exclusion range is enforced against all particles
+  {
+    r_algo.exclusion_range = 0.8;
+    for (int i = 0; i < 4; ++i) {
+      r_algo.make_parallel_displacement_mc_sweep(type_B, max_displacement);
+    }
+    auto const positions = get_positions(comm);
+    auto min_dist = box_l;
+    for (int pid = 0; pid < n_part; pid += 8) {
+      for (int pid2 = 0; pid2 < n_part; ++pid2) {
+        if (pid2 != pid) {
+          auto const dist =
+              box_geo.get_mi_vector(positions.at(pid), positions.at(pid2));
+          min_dist = std::min(min_dist, dist.norm());
+        }
+      }
+    }
+    BOOST_CHECK_GE(min_dist, r_algo.exclusion_range);
+    r_algo.exclusion_range = 0.;
+  }
+
+  // non-interacting particles: all moves are accepted, the displacement
+  // is bounded, and the other particles don't move
+  {
+    auto const old_positions = get_positions(comm);
+    auto const n_tried_old = r_algo.m_tried_configurational_MC_moves;
+    auto const n_accepted_old = r_algo.m_accepted_configurational_MC_moves;
+    auto const n_accepted =
+        r_algo.make_parallel_displacement_mc_sweep(type_B, max_displacement);
+    BOOST_CHECK_EQUAL(n_accepted, n_part_B);
+    BOOST_CHECK_EQUAL(r_algo.m_tried_configurational_MC_moves,
+                      n_tried_old + n_part_B);
+    BOOST_CHECK_EQUAL(r_algo.m_accepted_configurational_MC_moves,
+                      n_accepted_old + n_part_B);
+    auto const new_positions = get_positions(comm);
+    BOOST_REQUIRE_EQUAL(new_positions.size(), static_cast<std::size_t>(n_part));
+    for (int pid = 0; pid < n_part; ++pid) {
+      auto const displacement =
+          box_geo.get_mi_vector(new_positions.at(pid), old_positions.at(pid));
+      if (pid % 8 == 0) {
+        BOOST_CHECK_GT(displacement.norm(), 0.);
+        for (auto const value : displacement) {
+          BOOST_CHECK_LE(std::abs(value), max_displacement);
+        }
+      } else {
+        BOOST_CHECK_EQUAL(displacement.norm(), 0.);
+      }
+    }
+  }
+
+#ifdef LENNARD_JONES
+  // at vanishing temperature, only moves which lower the energy are
+  // accepted, which requires exact energy differences across all ranks
+  {
+    r_algo.kT = 1e-20;
+    auto E_pot_old = calculate_potential_energy(comm);
+    auto n_accepted_total = 0;
+    for (int i = 0; i < 5; ++i) {
+      auto const n_accepted =
+          r_algo.make_parallel_displacement_mc_sweep(type_A, max_displacement);
+      BOOST_CHECK_LE(n_accepted, n_part_A);
+      n_accepted_total += n_accepted;
+      auto const E_pot_new = calculate_potential_energy(comm);
+      BOOST_CHECK_LE(E_pot_new, E_pot_old + tol);
+      E_pot_old = E_pot_new;
+    }
+    BOOST_CHECK_GT(n_accepted_total, 0);
+    r_algo.kT = 1.;
+  }
+#endif
+
+  // unsupported systems
+  {
+    auto const bond_id = 0;
+    auto const bond = HarmonicBond(20., 1.2, 1.5);
+    system.bonded_ias->insert(bond_id,
+                              std::make_shared<Bonded_IA_Parameters>(bond));
+    insert_particle_bond(1, bond_id, {2});
+    system.on_particle_change();
+    BOOST_CHECK_THROW(
+        r_algo.make_parallel_displacement_mc_sweep(type_A, max_displacement),
+        std::runtime_error);
+    if (auto const p = system.cell_structure->get_local_particle(1)) {
+      p->bonds().clear();
+    }
+    system.bonded_ias->erase(bond_id);
+    system.set_cell_structure_topology(CellStructureType::NSQUARE);
+    BOOST_CHECK_THROW(
+        r_algo.make_parallel_displacement_mc_sweep(type_A, max_displacement),
+        std::runtime_error);
+    system.set_cell_structure_topology(CellStructureType::REGULAR);
+  }
+}
+
+int main(int argc, char **argv) {
+  auto const mpi_handle = MpiContainerUnitTest(argc, argv);
+  espresso::system = System::System::create();
+  espresso::system->set_cell_structure_topology(CellStructureType::REGULAR);
+  ::System::set_system(espresso::system);
+  return boost::unit_test::unit_test_main(init_unit_test, argc, argv);
+}
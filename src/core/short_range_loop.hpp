@@ -28,6 +28,7 @@
 #endif
 
 #include <cassert>
+#include <type_traits>
 
 namespace detail {
 /**
@@ -37,25 +38,70 @@ namespace detail {
 struct True {
   template <class... T> bool operator()(T &...) const { return true; }
 };
+
+/** Run the bonded loop, on the cached bond groups if the kernel
+ *  operates on a @ref BondTopology::Group.
+ */
+template <class BondKernel>
+void bond_loop(CellStructure &cell_structure, BondKernel const &bond_kernel) {
+  if constexpr (std::is_invocable_v<BondKernel, BondTopology::Group &>) {
+    cell_structure.bond_group_loop(bond_kernel);
+  } else {
+    cell_structure.bond_loop(bond_kernel);
+  }
+}
 } // namespace detail
 
+/**
+ * @brief Run the bonded and non-bonded short-range loops.
+ *
+ * @param bond_kernel      Kernel for bonded interactions, either on
+ *                         the bonds of a particle or on a group of
+ *                         the @ref BondTopology.
+ * @param pair_kernel      Kernel for non-bonded interactions, either on
+ *                         particle pairs or on pairs of clusters of the
+ *                         @ref ParticleArrays mirror.
+ * @param cell_structure   Cell structure.
+ * @param pair_cutoff      Non-bonded interaction cutoff.
+ * @param bond_cutoff      Bonded interaction cutoff.
+ * @param verlet_criterion Filter for Verlet lists.
+ * @param parallel         Whether @p pair_kernel is thread-safe, in which
+ *                         case the non-bonded loop may use OpenMP threads.
+ */
 template <class BondKernel, class PairKernel,
           class VerletCriterion = detail::True>
 void short_range_loop(BondKernel bond_kernel, PairKernel pair_kernel,
                       CellStructure &cell_structure, double pair_cutoff,
                       double bond_cutoff,
-                      VerletCriterion const &verlet_criterion = {}) {
+                      VerletCriterion const &verlet_criterion = {},
+                      bool parallel = false) {
 #ifdef CALIPER
   CALI_CXX_MARK_FUNCTION;
 #endif
 
   assert(cell_structure.get_resort_particles() == Cells::RESORT_NONE);
 
-  if (bond_cutoff >= 0.) {
-    cell_structure.bond_loop(bond_kernel);
-  }
-
-  if (pair_cutoff > 0.) {
-    cell_structure.non_bonded_loop(pair_kernel, verlet_criterion);
+  if constexpr (std::is_invocable_v<PairKernel, ParticleArrays &,
+                                    ParticleArrays::index_type,
+                                    ParticleArrays::index_type,
+                                    detail::EuclidianDistance const &>) {
+    /* The cluster pair loop completes a pending ghost update once it
+     * has processed the pairs of local particles, so it goes first. */
+    if (pair_cutoff > 0.) {
+      cell_structure.non_bonded_loop_clusters(pair_kernel, verlet_criterion,
+                                              parallel);
+    }
+    cell_structure.ghosts_update_wait();
+    if (bond_cutoff >= 0.) {
+      detail::bond_loop(cell_structure, bond_kernel);
+    }
+  } else {
+    cell_structure.ghosts_update_wait();
+    if (bond_cutoff >= 0.) {
+      detail::bond_loop(cell_structure, bond_kernel);
+    }
+    if (pair_cutoff > 0.) {
+      cell_structure.non_bonded_loop(pair_kernel, verlet_criterion, parallel);
+    }
   }
 }
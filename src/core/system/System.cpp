@@ -88,6 +88,7 @@ System::System(Private) {
   sim_time = 0.;
   force_cap = 0.;
   min_global_cut = INACTIVE_CUTOFF;
+  state_revision = 0ul;
 }
 
 void System::initialize() {
@@ -154,6 +155,10 @@ void System::set_min_global_cut(double value) {
 }
 
 void System::set_cell_structure_topology(CellStructureType topology) {
+  if (topology != CellStructureType::REGULAR and
+      cell_structure->is_load_balancing()) {
+    cell_structure->stop_load_balancing();
+  }
   if (topology == CellStructureType::REGULAR) {
     if (cell_structure->decomposition_type() == CellStructureType::REGULAR) {
       // get fully connected info from exising regular decomposition
@@ -228,6 +233,11 @@ void System::on_node_grid_change() {
   rebuild_cell_structure();
 }
 
+void System::on_domain_partition_change() {
+  update_local_geo();
+  rebuild_cell_structure();
+}
+
 void System::on_periodicity_change() {
 #ifdef ELECTROSTATICS
   coulomb.on_periodicity_change();
@@ -248,6 +258,7 @@ void System::on_periodicity_change() {
 }
 
 void System::on_cell_structure_change() {
+  ++state_revision;
   clear_particle_node();
   lb.on_cell_structure_change();
   ek.on_cell_structure_change();
@@ -295,6 +306,8 @@ void System::on_non_bonded_ia_change() {
 }
 
 void System::on_coulomb_change() {
+  ++state_revision;
+  cell_structure->check_load_balancing_support();
 #ifdef ELECTROSTATICS
   coulomb.on_coulomb_change();
 #endif
@@ -302,6 +315,7 @@ void System::on_coulomb_change() {
 }
 
 void System::on_dipoles_change() {
+  cell_structure->check_load_balancing_support();
 #ifdef DIPOLES
   dipoles.on_dipoles_change();
 #endif
@@ -315,16 +329,19 @@ void System::on_lb_boundary_conditions_change() {
 }
 
 void System::on_particle_local_change() {
+  ++state_revision;
   cell_structure->update_ghosts_and_resort_particle(get_global_ghost_flags());
   propagation->recalc_forces = true;
 }
 
 void System::on_particle_change() {
+  ++state_revision;
   if (cell_structure->decomposition_type() == CellStructureType::HYBRID) {
     cell_structure->set_resort_particles(Cells::RESORT_GLOBAL);
   } else {
     cell_structure->set_resort_particles(Cells::RESORT_LOCAL);
   }
+  cell_structure->clear_verlet_lists();
 #ifdef ELECTROSTATICS
   coulomb.on_particle_change();
 #endif
@@ -338,6 +355,9 @@ void System::on_particle_change() {
 }
 
 void System::on_particle_charge_change() {
+  ++state_revision;
+  /* the Verlet criterion skips uncharged particles */
+  cell_structure->clear_verlet_lists();
 #ifdef ELECTROSTATICS
   coulomb.on_particle_change();
 #endif
@@ -381,9 +401,15 @@ void System::on_observable_calc() {
 void System::on_lees_edwards_change() { lb.on_lees_edwards_change(); }
 
 void System::update_local_geo() {
-  *local_geo = LocalBox::make_regular_decomposition(
-      box_geo->length(), ::communicator.calc_node_index(),
-      ::communicator.node_grid);
+  auto const node_index = ::communicator.calc_node_index();
+  auto const &node_grid = ::communicator.node_grid;
+  if (auto const boundaries = cell_structure->get_domain_boundaries()) {
+    *local_geo = LocalBox::make_rectilinear_decomposition(
+        box_geo->length(), node_index, node_grid, *boundaries);
+  } else {
+    *local_geo = LocalBox::make_regular_decomposition(box_geo->length(),
+                                                      node_index, node_grid);
+  }
 }
 
 double System::maximal_cutoff() const {
@@ -436,6 +462,7 @@ void System::set_box_l(Utils::Vector3d const &box_l) {
 }
 
 void System::on_integration_start() {
+  ++state_revision;
   // sanity checks
   integrator_sanity_checks();
 #ifdef NPT
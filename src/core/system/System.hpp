@@ -130,6 +130,13 @@ public:
   /** @brief Rebuild cell lists. Use e.g. after a skin change. */
   void rebuild_cell_structure();
 
+  /**
+   * @brief Get @ref state_revision.
+   * Quantities derived from the particles, such as a cached mesh
+   * potential, are outdated when the revision has changed.
+   */
+  auto get_state_revision() const { return state_revision; }
+
   /** @brief Calculate the maximal cutoff of all interactions. */
   double maximal_cutoff() const;
 
@@ -225,6 +232,8 @@ public:
    */
   void on_boxl_change(bool skip_method_adaption = false);
   void on_node_grid_change();
+  /** @brief Called when the load balancer has resized the local boxes. */
+  void on_domain_partition_change();
   void on_periodicity_change();
   void on_cell_structure_change();
   void on_thermostat_param_change();
@@ -311,6 +320,11 @@ protected:
    * to be available on the same node (through ghosts).
    */
   double min_global_cut;
+  /**
+   * @brief Counter of the events which change the particles, the cell
+   * system or the long-range solvers.
+   */
+  unsigned long state_revision;
 
   void update_local_geo();
 #ifdef ELECTROSTATICS
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE BondTopology test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "BondList.hpp"
+#include "BoxGeometry.hpp"
+#include "Particle.hpp"
+#include "bond_breakage/bond_breakage.hpp"
+#include "bonded_interactions/angle_cosine.hpp"
+#include "bonded_interactions/angle_harmonic.hpp"
+#include "bonded_interactions/bonded_interaction_data.hpp"
+#include "bonded_interactions/dihedral.hpp"
+#include "bonded_interactions/fene.hpp"
+#include "bonded_interactions/harmonic.hpp"
+#include "cell_system/BondTopology.hpp"
+#include "forces_inline.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+class BondedInteractionsMapTest : public BondedInteractionsMap {
+public:
+  ~BondedInteractionsMapTest() override = default;
+  void activate_bond(mapped_type const &) override {}
+  void deactivate_bond(mapped_type const &) override {}
+};
+
+namespace {
+/** Chain of particles along a helix, bonded by @p add_bonds. */
+template <class F> std::vector<Particle> make_chain(int n_part, F add_bonds) {
+  std::vector<Particle> particles(static_cast<std::size_t>(n_part));
+  for (int pid = 0; pid < n_part; ++pid) {
+    auto &p = particles[static_cast<std::size_t>(pid)];
+    p.id() = pid;
+    p.pos() = {2. + std::cos(1.1 * pid), 2. + std::sin(1.1 * pid), 0.4 * pid};
+  }
+  for (int pid = 0; pid < n_part; ++pid) {
+    add_bonds(particles[static_cast<std::size_t>(pid)].bonds(), pid);
+  }
+  return particles;
+}
+
+auto make_resolver(std::vector<Particle> &particles) {
+  return [&particles](int pid) -> Particle * {
+    if (pid < 0 or static_cast<std::size_t>(pid) >= particles.size()) {
+      return nullptr;
+    }
+    return &particles[static_cast<std::size_t>(pid)];
+  };
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(build_and_forces) {
+  auto constexpr tol = 1e-12;
+  auto constexpr n_part = 12;
+  auto const harmonic_id = 0, fene_id = 1, angle_id = 2, dihedral_id = 3;
+  auto const cosine_id = 4, missing_id = 5;
+
+  BondedInteractionsMapTest bonded_ias{};
+  bonded_ias.insert(harmonic_id, std::make_shared<Bonded_IA_Parameters>(
+                                     HarmonicBond(20., 1.2, 5.)));
+  bonded_ias.insert(
+      fene_id, std::make_shared<Bonded_IA_Parameters>(FeneBond(3., 3., 0.5)));
+  bonded_ias.insert(angle_id, std::make_shared<Bonded_IA_Parameters>(
+                                  AngleHarmonicBond(4., 2.)));
+  bonded_ias.insert(dihedral_id, std::make_shared<Bonded_IA_Parameters>(
+                                     DihedralBond(2, 3., 0.5)));
+  bonded_ias.insert(cosine_id, std::make_shared<Bonded_IA_Parameters>(
+                                   AngleCosineBond(2., 2.5)));
+
+  auto const add_bonds = [&](BondList &bonds, int pid) {
+    if (pid + 1 < n_part) {
+      auto const partners = std::vector<int>{pid + 1};
+      bonds.insert({pid % 2 ? harmonic_id : fene_id, partners});
+    }
+    if (pid >= 1 and pid + 1 < n_part) {
+      auto const partners = std::vector<int>{pid - 1, pid + 1};
+      bonds.insert({pid % 3 ? angle_id : cosine_id, partners});
+    }
+    if (pid >= 1 and pid + 2 < n_part) {
+      auto const partners = std::vector<int>{pid - 1, pid + 1, pid + 2};
+      bonds.insert({dihedral_id, partners});
+    }
+  };
+  auto particles = make_chain(n_part, add_bonds);
+  auto const partners = std::vector<int>{n_part};
+  particles.back().bonds().insert({missing_id, partners});
+
+  BondTopology topology;
+  topology.build(particles, make_resolver(particles), [&](int bond_id) {
+    return bonded_ias.get_zero_based_type(bond_id);
+  });
+
+  /* bonds are grouped by bond id and ordered by bond type */
+  BOOST_REQUIRE_EQUAL(topology.groups.size(), 5u);
+  for (std::size_t i = 1u; i < topology.groups.size(); ++i) {
+    BOOST_CHECK_LE(
+        bonded_ias.get_zero_based_type(topology.groups[i - 1u].bond_id),
+        bonded_ias.get_zero_based_type(topology.groups[i].bond_id));
+  }
+  std::size_t n_bonds = 0u;
+  for (auto &group : topology.groups) {
+    n_bonds += group.size();
+    for (std::size_t i = 0u; i < group.size(); ++i) {
+      auto const bond = group.bond(i);
+      BOOST_REQUIRE_EQUAL(bond.size(), group.n_partners + 1u);
+      auto const &bonds = bond[0]->bonds();
+      auto const view =
+          *std::find_if(bonds.begin(), bonds.end(), [&](BondView const &b) {
+            return b.bond_id() == group.bond_id and
+                   b.partner_ids()[0] == bond[1]->id();
+          });
+      for (std::size_t j = 0u; j < group.n_partners; ++j) {
+        BOOST_CHECK_EQUAL(view.partner_ids()[j], bond[j + 1u]->id());
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(n_bonds, static_cast<std::size_t>(3 * n_part - 6));
+
+  /* bonds with missing partners are recorded separately */
+  BOOST_REQUIRE_EQUAL(topology.unresolved.size(), 1u);
+  BOOST_CHECK_EQUAL(topology.unresolved[0].first, n_part - 1);
+  BOOST_CHECK(topology.unresolved[0].second == partners);
+
+  /* the group kernels agree with the kernels of single bonds */
+  auto box_geo = BoxGeometry{};
+  box_geo.set_length({10., 10., 10.});
+  BondBreakage::BondBreakage bond_breakage;
+  auto particles_ref = make_chain(n_part, add_bonds);
+  auto const resolve_ref = make_resolver(particles_ref);
+  for (auto &p : particles_ref) {
+    for (BondView const bond : p.bonds()) {
+      std::vector<Particle *> bond_partners;
+      for (auto const pid : bond.partner_ids()) {
+        bond_partners.emplace_back(resolve_ref(pid));
+      }
+      auto const broken = add_bonded_force(
+          p, bond.bond_id(), std::span(bond_partners), bonded_ias,
+          bond_breakage, box_geo, nullptr);
+      BOOST_REQUIRE(not broken);
+    }
+  }
+  for (auto &group : topology.groups) {
+    add_bonded_group_forces(group, bonded_ias, bond_breakage, box_geo,
+                            nullptr);
+  }
+  for (std::size_t i = 0u; i < particles.size(); ++i) {
+    auto const &f_ref = particles_ref[i].force();
+    BOOST_CHECK_GT(f_ref.norm(), 0.);
+    BOOST_CHECK_SMALL((particles[i].force() - f_ref).norm(), tol);
+  }
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Domain load balancer test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "cell_system/DomainLoadBalancer.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/** Positions of the nodes of a node grid, in the order of the MPI ranks. */
+static auto make_node_positions(Utils::Vector3i const &node_grid) {
+  std::vector<Utils::Vector3i> node_pos;
+  for (int i = 0; i < node_grid[0]; ++i)
+    for (int j = 0; j < node_grid[1]; ++j)
+      for (int k = 0; k < node_grid[2]; ++k)
+        node_pos.emplace_back(Utils::Vector3i{i, j, k});
+  return node_pos;
+}
+
+/** Integral of a load density over the domain of each node. */
+static auto
+measure(DomainLoadBalancer const &balancer,
+        std::vector<Utils::Vector3i> const &node_pos,
+        std::function<double(Utils::Vector3d const &)> const &density) {
+  auto constexpr n_samples = 16;
+  auto const &boundaries = balancer.boundaries();
+  std::vector<double> times;
+  for (auto const &pos : node_pos) {
+    Utils::Vector3d lower, upper;
+    for (auto i = 0u; i < 3u; ++i) {
+      lower[i] = boundaries[i][static_cast<std::size_t>(pos[i])];
+      upper[i] = boundaries[i][static_cast<std::size_t>(pos[i]) + 1u];
+    }
+    auto const h = (upper - lower) / static_cast<double>(n_samples);
+    auto time = 0.;
+    for (int a = 0; a < n_samples; ++a)
+      for (int b = 0; b < n_samples; ++b)
+        for (int c = 0; c < n_samples; ++c) {
+          auto const x = lower + Utils::hadamard_product(
+                                     Utils::Vector3d{a + 0.5, b + 0.5, c + 0.5},
+                                     h);
+          time += density(x) * Utils::product(h);
+        }
+    times.emplace_back(time);
+  }
+  return times;
+}
+
+BOOST_AUTO_TEST_CASE(uniform_partition) {
+  auto const balancer = DomainLoadBalancer({4, 2, 1}, 10, false);
+  auto const &boundaries = balancer.boundaries();
+  auto const expected = std::vector<std::vector<double>>{
+      {0., 0.25, 0.5, 0.75, 1.}, {0., 0.5, 1.}, {0., 1.}};
+  for (auto i = 0u; i < 3u; ++i) {
+    BOOST_TEST(boundaries[i] == expected[i], boost::test_tools::per_element());
+  }
+  BOOST_CHECK_EQUAL(balancer.interval(), 10);
+  BOOST_CHECK_EQUAL(balancer.imbalance(), 1.);
+}
+
+BOOST_AUTO_TEST_CASE(step_and_time_accounting) {
+  auto balancer = DomainLoadBalancer({2, 1, 1}, 3, false);
+  balancer.add_time(0.5);
+  balancer.add_time(0.25);
+  BOOST_CHECK_EQUAL(balancer.time(), 0.75);
+  BOOST_CHECK(not balancer.add_step());
+  BOOST_CHECK(not balancer.add_step());
+  BOOST_CHECK(balancer.add_step());
+  /* a balanced load keeps the partition and resets the counters */
+  auto const node_pos = make_node_positions({2, 1, 1});
+  BOOST_CHECK(not balancer.rebalance(node_pos, {1., 1.02}, {0., 0., 0.}));
+  BOOST_CHECK_CLOSE(balancer.imbalance(), 1.02 / 1.01, 1e-10);
+  BOOST_CHECK_EQUAL(balancer.boundaries()[0][1], 0.5);
+  BOOST_CHECK_EQUAL(balancer.time(), 0.);
+  BOOST_CHECK(not balancer.add_step());
+}
+
+BOOST_AUTO_TEST_CASE(rebalance_slabs) {
+  auto constexpr tol = 1e-12;
+  auto const node_grid = Utils::Vector3i{4, 1, 1};
+  auto const node_pos = make_node_positions(node_grid);
+  auto const times = std::vector<double>{3., 1., 0., 0.};
+  /* the boundaries move half of the way to the equal share of the
+   * piecewise uniform load {0., 1. / 12., 1. / 6., 1. / 4., 1.} */
+  {
+    auto balancer = DomainLoadBalancer(node_grid, 1, false);
+    BOOST_CHECK(balancer.rebalance(node_pos, times, {0.01, 0.01, 0.01}));
+    BOOST_CHECK_CLOSE(balancer.imbalance(), 3., 1e-10);
+    auto const expected =
+        std::vector<double>{0., 1. / 6., 1. / 3., 1. / 2., 1.};
+    auto const &result = balancer.boundaries()[0];
+    for (std::size_t j = 0u; j < expected.size(); ++j) {
+      BOOST_CHECK_SMALL(result[j] - expected[j], tol);
+    }
+    /* directions with a single node are not changed */
+    BOOST_CHECK_EQUAL(balancer.boundaries()[1].size(), 2u);
+    BOOST_CHECK_EQUAL(balancer.boundaries()[1][1], 1.);
+  }
+  /* the slabs don't get thinner than the minimal width */
+  {
+    auto balancer = DomainLoadBalancer(node_grid, 1, false);
+    BOOST_CHECK(balancer.rebalance(node_pos, times, {0.2, 0.2, 0.2}));
+    auto const expected = std::vector<double>{0., 0.2, 0.4, 0.6, 1.};
+    auto const &result = balancer.boundaries()[0];
+    for (std::size_t j = 0u; j < expected.size(); ++j) {
+      BOOST_CHECK_SMALL(result[j] - expected[j], tol);
+    }
+  }
+  /* no rebalance when the slabs can't hold the minimal width */
+  {
+    auto balancer = DomainLoadBalancer(node_grid, 1, false);
+    BOOST_CHECK(not balancer.rebalance(node_pos, times, {0.3, 0.3, 0.3}));
+    BOOST_CHECK_EQUAL(balancer.boundaries()[0][1], 0.25);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(convergence) {
+  auto const node_grid = Utils::Vector3i{4, 2, 1};
+  auto const node_pos = make_node_positions(node_grid);
+  /* a droplet in the lower corner of the box */
+  auto const density = [](Utils::Vector3d const &x) {
+    return 0.1 + std::exp(-(x[0] * x[0] + x[1] * x[1]) / 0.1);
+  };
+  auto balancer = DomainLoadBalancer(node_grid, 1, false);
+  auto const initial_imbalance = [&]() {
+    balancer.rebalance(node_pos, measure(balancer, node_pos, density),
+                       {0.05, 0.05, 0.05});
+    return balancer.imbalance();
+  }();
+  BOOST_CHECK_GT(initial_imbalance, 3.);
+  for (int i = 0; i < 20; ++i) {
+    balancer.rebalance(node_pos, measure(balancer, node_pos, density),
+                       {0.05, 0.05, 0.05});
+  }
+  /* the partition is a tensor product, which can't balance every
+   * distribution, but it removes most of the imbalance */
+  BOOST_CHECK_LT(balancer.imbalance(), 1.5);
+  for (auto const &boundaries : balancer.boundaries()) {
+    for (std::size_t j = 1u; j < boundaries.size(); ++j) {
+      BOOST_CHECK_GE(boundaries[j] - boundaries[j - 1u], 0.05 - 1e-12);
+    }
+  }
+}
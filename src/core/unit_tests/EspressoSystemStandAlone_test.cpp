@@ -583,6 +583,48 @@ BOOST_FIXTURE_TEST_CASE(espresso_system_stand_alone, ParticleFactory) {
   }
 }
 
+#ifdef COLLISION_DETECTION
+BOOST_FIXTURE_TEST_CASE(bonds_created_in_place, ParticleFactory) {
+  auto constexpr tol = 1e-10;
+  auto const comm = boost::mpi::communicator();
+  auto const rank = comm.rank();
+  auto &system = *espresso::system;
+  system.set_box_l(Utils::Vector3d::broadcast(12.));
+  system.set_time_step(0.001);
+  system.cell_structure->set_verlet_skin(0.4);
+
+  auto const bond_id = 10;
+  auto const bond = HarmonicBond(200., 0.3, 1.);
+  system.bonded_ias->insert(bond_id,
+                            std::make_shared<Bonded_IA_Parameters>(bond));
+  auto const pid1 = 1;
+  auto const pid2 = 2;
+  create_particle({1.0, 1., 1.}, pid1, 0);
+  create_particle({1.2, 1., 1.}, pid2, 0);
+
+  auto const get_force = [&]() {
+    system.integrate(0, INTEG_REUSE_FORCES_NEVER);
+    auto const p_opt = copy_particle_to_head_node(comm, system, pid1);
+    return (rank == 0) ? p_opt->force() : Utils::Vector3d{};
+  };
+  BOOST_CHECK_EQUAL(get_force().norm(), 0.);
+
+  // the collision detection inserts bonds without resorting the particles
+  std::vector<CollisionDetection::CollisionPair> collision_queue;
+  auto const p1 = system.cell_structure->get_local_particle(pid1);
+  if (p1 != nullptr and not p1->is_ghost()) {
+    collision_queue.emplace_back(pid1, pid2);
+  }
+  CollisionDetection::add_bind_centers(collision_queue, *system.cell_structure,
+                                       bond_id);
+  auto const force = get_force();
+  if (rank == 0) {
+    BOOST_CHECK_CLOSE(force.norm(), bond.k * (bond.r - 0.2), tol);
+  }
+  system.bonded_ias->erase(bond_id);
+}
+#endif // COLLISION_DETECTION
+
 int main(int argc, char **argv) {
   auto const mpi_handle = MpiContainerUnitTest(argc, argv);
   espresso::system = System::System::create();
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE TabulatedPotential test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "TabulatedPotential.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using Interpolation = TabulatedPotential::Interpolation;
+
+namespace {
+double lj_force(double r) {
+  return 24. * (2. * std::pow(r, -13.) - std::pow(r, -7.));
+}
+double lj_energy(double r) {
+  return 4. * (std::pow(r, -12.) - std::pow(r, -6.));
+}
+
+template <class F>
+std::vector<double> tabulate(F f, double min, double max, std::size_t n) {
+  std::vector<double> table(n);
+  for (std::size_t i = 0u; i < n; ++i) {
+    table[i] = f(min + (max - min) * static_cast<double>(i) /
+                           static_cast<double>(n - 1u));
+  }
+  return table;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(linear_tables) {
+  auto constexpr tol = 1e-12;
+  auto const linear = [](double x) { return 5. + 2.3 * x; };
+  auto const table = tabulate(linear, 1., 2., 11u);
+  auto const pot_linear = TabulatedPotential(1., 2., table, table);
+  auto const pot_cubic =
+      TabulatedPotential(1., 2., table, table, Interpolation::CUBIC);
+  BOOST_CHECK(pot_linear.splines.empty());
+  BOOST_CHECK_EQUAL(pot_cubic.splines.size(), 10u);
+  BOOST_CHECK_EQUAL(
+      reinterpret_cast<std::uintptr_t>(pot_cubic.splines.data()) % 64u, 0u);
+  for (auto const x : {1., 1.04, 1.37, 1.5, 1.99, 2.}) {
+    BOOST_CHECK_CLOSE(pot_linear.force(x), linear(x), tol);
+    BOOST_CHECK_CLOSE(pot_cubic.force(x), linear(x), tol);
+    BOOST_CHECK_CLOSE(pot_cubic.energy(x), linear(x), tol);
+  }
+  /* values outside of the table are clamped */
+  BOOST_CHECK_CLOSE(pot_cubic.force(0.5), linear(1.), tol);
+  BOOST_CHECK_CLOSE(pot_cubic.force(2.5), linear(2.), tol);
+
+  /* inactive and single-valued tables don't use splines */
+  BOOST_CHECK(TabulatedPotential(-1., -1., {}, {}, Interpolation::CUBIC)
+                  .splines.empty());
+  auto const pot_single =
+      TabulatedPotential(1., 1., {3.}, {4.}, Interpolation::CUBIC);
+  BOOST_CHECK(pot_single.splines.empty());
+}
+
+BOOST_AUTO_TEST_CASE(lennard_jones_accuracy) {
+  auto constexpr min = 1., max = 2.5;
+  auto constexpr n_points = 50u;
+  auto const force = tabulate(lj_force, min, max, n_points);
+  auto const energy = tabulate(lj_energy, min, max, n_points);
+  auto const pot_linear = TabulatedPotential(min, max, force, energy);
+  auto const pot_cubic =
+      TabulatedPotential(min, max, force, energy, Interpolation::CUBIC);
+
+  /* splines interpolate the tabulated values */
+  for (std::size_t i = 0u; i < n_points; ++i) {
+    auto const x = min + (max - min) * static_cast<double>(i) /
+                             static_cast<double>(n_points - 1u);
+    BOOST_CHECK_SMALL(pot_cubic.force(x) - force[i], 1e-10);
+    BOOST_CHECK_SMALL(pot_cubic.energy(x) - energy[i], 1e-10);
+  }
+
+  /* and are more accurate between them */
+  auto error_linear = 0., error_cubic = 0.;
+  for (auto x = min + 0.01; x < max; x += 0.03) {
+    error_linear =
+        std::max(error_linear, std::abs(pot_linear.force(x) - lj_force(x)));
+    error_cubic =
+        std::max(error_cubic, std::abs(pot_cubic.force(x) - lj_force(x)));
+  }
+  BOOST_TEST_MESSAGE("max. force error: " << error_linear << " (linear), "
+                                           << error_cubic << " (cubic)");
+  BOOST_CHECK_LT(error_cubic, 0.1 * error_linear);
+}
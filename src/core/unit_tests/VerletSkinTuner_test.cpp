@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Verlet skin tuner test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "cell_system/VerletSkinTuner.hpp"
+
+#include <cmath>
+
+/**
+ * Model of the cost of an integration step: the pair loop cost grows
+ * with the cube of the interaction range, the rebuild cost is amortized
+ * over a number of steps that grows linearly with the skin.
+ */
+static double step_cost(double skin) {
+  auto const r_cut = 1.;
+  auto const rebuild_cost = 0.5;
+  auto const pair_cost = std::pow(r_cut + skin, 3);
+  return pair_cost + rebuild_cost * 0.05 / skin;
+}
+
+/** Integrate with the tuner, return the number of integration steps. */
+static int run(VerletSkinTuner &tuner, int max_steps) {
+  int step = 0;
+  auto first_step_of_trial = true;
+  for (; step < max_steps and not tuner.converged(); ++step) {
+    auto const skin = tuner.trial_skin();
+    /* the first step of a trial pays for the cell system rebuild */
+    auto const time = first_step_of_trial ? 100. : step_cost(skin);
+    first_step_of_trial = tuner.add_step(time, false);
+    if (first_step_of_trial) {
+      tuner.end_trial(tuner.trial_time());
+    }
+  }
+  return step;
+}
+
+BOOST_AUTO_TEST_CASE(convergence) {
+  auto const min_skin = 0.;
+  auto const max_skin = 1.;
+  auto const tol = 0.02;
+  /* analytical minimum of the cost model */
+  auto const optimum = 0.0842;
+  BOOST_REQUIRE_LT(step_cost(optimum), step_cost(optimum - tol));
+  BOOST_REQUIRE_LT(step_cost(optimum), step_cost(optimum + tol));
+
+  VerletSkinTuner tuner{min_skin, max_skin, tol, 25, 16, false};
+  BOOST_CHECK(not tuner.converged());
+  BOOST_CHECK(not tuner.result());
+  BOOST_CHECK_GT(tuner.trial_skin(), min_skin);
+  BOOST_CHECK_LT(tuner.trial_skin(), max_skin);
+  auto const n_steps = run(tuner, 1000);
+  auto const result = tuner.result();
+  BOOST_REQUIRE(result.has_value());
+  BOOST_CHECK(tuner.converged());
+  BOOST_CHECK_LE(n_steps, 300);
+  BOOST_CHECK_SMALL(*result - optimum, tol);
+}
+
+BOOST_AUTO_TEST_CASE(max_trials) {
+  VerletSkinTuner tuner{0., 1., 1e-9, 10, 3, false};
+  auto const n_steps = run(tuner, 1000);
+  auto const result = tuner.result();
+  BOOST_REQUIRE(result.has_value());
+  BOOST_CHECK_EQUAL(n_steps, 3 * 10);
+  BOOST_CHECK_GT(*result, 0.);
+  BOOST_CHECK_LT(*result, 1.);
+}
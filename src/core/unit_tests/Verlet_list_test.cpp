@@ -36,27 +36,42 @@ namespace bdata = boost::unit_test::data;
 #include "particle_management.hpp"
 
 #include "Particle.hpp"
+#include "BoxGeometry.hpp"
+#include "Observable_stat.hpp"
 #include "PropagationMode.hpp"
+#include "actor/registration.hpp"
 #include "cell_system/CellStructureType.hpp"
 #include "cells.hpp"
 #include "communication.hpp"
+#include "electrostatics/coulomb.hpp"
+#include "electrostatics/debye_hueckel.hpp"
+#include "ghosts.hpp"
 #include "integrate.hpp"
 #include "integrators/Propagation.hpp"
 #include "integrators/steepest_descent.hpp"
 #include "nonbonded_interactions/lj.hpp"
+#include "nonbonded_interactions/wca.hpp"
 #include "npt.hpp"
 #include "particle_node.hpp"
 #include "system/System.hpp"
 #include "thermostat.hpp"
 
 #include <utils/Vector.hpp>
+#include <utils/morton.hpp>
 
 #include <boost/mpi.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <ostream>
+#include <random>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace espresso {
@@ -272,6 +287,538 @@ BOOST_DATA_TEST_CASE_F(ParticleFactory, verlet_list_update,
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(verlet_list_cluster_pairs, ParticleFactory) {
+  auto constexpr tol = 1e-10;
+  auto const comm = boost::mpi::communicator();
+  auto const rank = comm.rank();
+
+  auto const box_l = 8.;
+  auto &system = *espresso::system;
+  system.set_box_l(Utils::Vector3d::broadcast(box_l));
+  ::communicator.set_node_grid({2, 2, 1});
+  system.on_node_grid_change();
+  Testing::velocity_verlet.set_integrator();
+  system.set_time_step(0.01);
+  system.cell_structure->set_verlet_skin(0.2);
+
+  // set up LJ and WCA potentials
+  system.nonbonded_ias->make_particle_type_exist(1);
+  system.nonbonded_ias->get_ia_param(0, 0).lj =
+      LJ_Parameters{1., 0.5, 1.2, 0., 0., 0.};
+  system.nonbonded_ias->get_ia_param(0, 1).lj =
+      LJ_Parameters{0.5, 0.6, 1.2, 0.1, 0.05, 0.};
+#ifdef WCA
+  system.nonbonded_ias->get_ia_param(1, 1).wca = WCA_Parameters{1., 0.7};
+#endif
+  system.on_non_bonded_ia_change();
+  BOOST_REQUIRE(system.nonbonded_ias->only_lj_wca());
+
+  // jittered lattice, to have pairs across cell and domain boundaries
+  auto const n_side = 8;
+  auto const n_part = n_side * n_side * n_side;
+  std::mt19937 gen(42u);
+  std::uniform_real_distribution<double> jitter(-0.1, 0.1);
+  for (int pid = 0; pid < n_part; ++pid) {
+    auto const pos = Utils::Vector3d{
+        (pid % n_side) + 0.5 + jitter(gen),
+        ((pid / n_side) % n_side) + 0.5 + jitter(gen),
+        (pid / (n_side * n_side)) + 0.5 + jitter(gen)};
+    create_particle(pos, pid, pid % 2);
+  }
+#ifdef EXCLUSIONS
+  set_particle_property(0, &Particle::exclusions,
+                        Utils::compact_vector<int>{1});
+  set_particle_property(1, &Particle::exclusions,
+                        Utils::compact_vector<int>{0});
+  system.on_particle_change();
+#endif
+#ifdef ELECTROSTATICS
+  // neutral system with uncharged particles
+  for (int pid = 0; pid < n_part; ++pid) {
+    auto const charges = std::vector<double>{0., 0.5, 0., -0.5};
+    set_particle_property(pid, &Particle::q, charges[pid % 4]);
+  }
+  system.on_particle_charge_change();
+  auto const solver = std::make_shared<DebyeHueckel>(2., 1.5, 1.5);
+  add_actor(comm, espresso::system, system.coulomb.impl->solver, solver,
+            [&system]() { system.on_coulomb_change(); });
+#endif
+
+  auto const get_forces = [&](bool use_verlet_list) {
+    system.cell_structure->use_verlet_list = use_verlet_list;
+    system.integrate(0, INTEG_REUSE_FORCES_NEVER);
+    std::vector<Utils::Vector3d> forces;
+    for (int pid = 0; pid < n_part; ++pid) {
+      auto const p_opt = copy_particle_to_head_node(comm, system, pid);
+      if (rank == 0) {
+        forces.emplace_back(p_opt->force());
+      }
+    }
+    return forces;
+  };
+
+  // the Verlet list path uses the cluster pair kernel,
+  // the link cell path uses the particle pair kernel
+  auto const forces_arrays = get_forces(true);
+  auto const forces_ref = get_forces(false);
+  system.cell_structure->use_verlet_list = true;
+#ifdef ELECTROSTATICS
+  system.coulomb.impl->solver = std::nullopt;
+  system.on_coulomb_change();
+#endif
+  if (rank == 0) {
+    auto total_force = Utils::Vector3d{};
+    for (std::size_t i = 0u; i < forces_ref.size(); ++i) {
+      BOOST_CHECK_SMALL((forces_arrays[i] - forces_ref[i]).norm(), tol);
+      total_force += forces_arrays[i];
+    }
+    BOOST_CHECK_SMALL(total_force.norm(), tol);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(verlet_list_overlapped_ghost_update, ParticleFactory) {
+  auto const comm = boost::mpi::communicator();
+  auto const rank = comm.rank();
+
+  auto const box_l = 8.;
+  auto &system = *espresso::system;
+  system.set_box_l(Utils::Vector3d::broadcast(box_l));
+  ::communicator.set_node_grid({2, 2, 1});
+  system.on_node_grid_change();
+  Testing::velocity_verlet.set_integrator();
+  system.set_time_step(0.01);
+  system.cell_structure->set_verlet_skin(0.2);
+
+  system.nonbonded_ias->get_ia_param(0, 0).lj =
+      LJ_Parameters{1., 0.8, 1.5, 0., 0., 0.};
+  system.on_non_bonded_ia_change();
+
+  auto const n_side = 8;
+  auto const n_part = n_side * n_side * n_side;
+  std::vector<Utils::Vector3d> initial_pos, initial_vel;
+  std::mt19937 gen(42u);
+  std::uniform_real_distribution<double> noise(-0.1, 0.1);
+  for (int pid = 0; pid < n_part; ++pid) {
+    initial_pos.emplace_back(Utils::Vector3d{
+        (pid % n_side) + 0.5 + noise(gen),
+        ((pid / n_side) % n_side) + 0.5 + noise(gen),
+        (pid / (n_side * n_side)) + 0.5 + noise(gen)});
+    initial_vel.emplace_back(
+        Utils::Vector3d{noise(gen), noise(gen), noise(gen)} * 20.);
+    create_particle(initial_pos.back(), pid, 0);
+  }
+
+  auto const get_positions = [&](bool overlap) {
+    for (int pid = 0; pid < n_part; ++pid) {
+      set_particle_pos(pid, initial_pos[pid]);
+      set_particle_v(pid, initial_vel[pid]);
+    }
+    system.on_particle_change();
+    system.cell_structure->overlap_ghost_communication = overlap;
+    system.integrate(50, INTEG_REUSE_FORCES_NEVER);
+    BOOST_REQUIRE_GT(system.cell_structure->get_verlet_reuse(), 1.);
+    std::vector<Utils::Vector3d> positions;
+    for (int pid = 0; pid < n_part; ++pid) {
+      auto const p_opt = copy_particle_to_head_node(comm, system, pid);
+      if (rank == 0) {
+        positions.emplace_back(p_opt->pos());
+      }
+    }
+    return positions;
+  };
+
+  // the same trajectory with and without overlapping the ghost update
+  // with the force calculation
+  auto const positions_ref = get_positions(false);
+  auto const positions = get_positions(true);
+  system.cell_structure->overlap_ghost_communication = false;
+  if (rank == 0) {
+    for (std::size_t i = 0u; i < positions_ref.size(); ++i) {
+      BOOST_CHECK_SMALL((positions[i] - positions_ref[i]).norm(), 1e-12);
+      BOOST_CHECK_GT((positions[i] - initial_pos[i]).norm(), 0.);
+    }
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(async_ghost_communication, ParticleFactory) {
+  auto const box_l = 8.;
+  auto &system = *espresso::system;
+  system.set_box_l(Utils::Vector3d::broadcast(box_l));
+  ::communicator.set_node_grid({2, 2, 1});
+  system.on_node_grid_change();
+  system.cell_structure->set_verlet_skin(0.2);
+
+  system.nonbonded_ias->get_ia_param(0, 0).lj =
+      LJ_Parameters{1., 0.8, 1.5, 0., 0., 0.};
+  system.on_non_bonded_ia_change();
+
+  auto const n_side = 8;
+  auto const n_part = n_side * n_side * n_side;
+  std::mt19937 gen(42u);
+  std::uniform_real_distribution<double> noise(-0.1, 0.1);
+  for (int pid = 0; pid < n_part; ++pid) {
+    auto const pos = Utils::Vector3d{(pid % n_side) + 0.5 + noise(gen),
+                                     ((pid / n_side) % n_side) + 0.5,
+                                     (pid / (n_side * n_side)) + 0.5};
+    create_particle(pos, pid, 0);
+    set_particle_v(pid, {noise(gen), noise(gen), noise(gen)});
+  }
+  system.integrate(0, INTEG_REUSE_FORCES_NEVER);
+
+  auto &cell_structure = *system.cell_structure;
+  auto const &box_geo = *system.box_geo;
+  auto const &decomposition = std::as_const(cell_structure).decomposition();
+  auto const &exchange_comm = decomposition.exchange_ghosts_comm();
+  auto const &collect_comm = decomposition.collect_ghost_force_comm();
+  auto const update_parts = GHOSTTRANS_POSITION | GHOSTTRANS_MOMENTUM;
+  BOOST_REQUIRE(
+      AsyncGhostCommunication::is_supported(exchange_comm, update_parts));
+  BOOST_REQUIRE(
+      AsyncGhostCommunication::is_supported(collect_comm, GHOSTTRANS_FORCE));
+  BOOST_CHECK(not cell_structure.ghost_particles().empty());
+
+  auto const reset_ghosts = [&]() {
+    for (auto &p : cell_structure.ghost_particles()) {
+      p.pos() = Utils::Vector3d::broadcast(-1.);
+      p.v() = Utils::Vector3d::broadcast(-1.);
+      p.force() = Utils::Vector3d{1., 2., 3.} * static_cast<double>(p.id());
+    }
+    for (auto &p : cell_structure.local_particles()) {
+      p.force() = Utils::Vector3d{};
+    }
+  };
+  auto const get_ghost_state = [&]() {
+    std::vector<Utils::Vector3d> state;
+    for (auto const &p : cell_structure.ghost_particles()) {
+      state.emplace_back(p.pos());
+      state.emplace_back(p.v());
+    }
+    for (auto const &p : cell_structure.local_particles()) {
+      state.emplace_back(p.force());
+    }
+    return state;
+  };
+
+  // move the local particles without a resort
+  for (auto &p : cell_structure.local_particles()) {
+    p.pos() += 0.01 * p.v();
+  }
+
+  // the blocking communicator is the reference
+  reset_ghosts();
+  ghost_communicator(exchange_comm, box_geo, update_parts);
+  ghost_communicator(collect_comm, box_geo, GHOSTTRANS_FORCE);
+  auto const state_ref = get_ghost_state();
+
+  // the non-blocking communication, progressed by polling
+  reset_ghosts();
+  AsyncGhostCommunication async_comm;
+  async_comm.start(exchange_comm, box_geo, update_parts);
+  while (not async_comm.test()) {
+  }
+  BOOST_CHECK(not async_comm.pending());
+  async_comm.start(collect_comm, box_geo, GHOSTTRANS_FORCE);
+  async_comm.wait();
+  BOOST_CHECK(not async_comm.pending());
+  auto const state = get_ghost_state();
+
+  BOOST_REQUIRE_EQUAL(state.size(), state_ref.size());
+  for (std::size_t i = 0u; i < state_ref.size(); ++i) {
+    BOOST_CHECK_EQUAL((state[i] - state_ref[i]).norm(), 0.);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(verlet_list_particle_sort, ParticleFactory) {
+  auto const comm = boost::mpi::communicator();
+  auto const rank = comm.rank();
+
+  auto const box_l = 8.;
+  auto &system = *espresso::system;
+  auto &cell_structure = *system.cell_structure;
+  system.set_box_l(Utils::Vector3d::broadcast(box_l));
+  ::communicator.set_node_grid({2, 2, 1});
+  system.on_node_grid_change();
+  Testing::velocity_verlet.set_integrator();
+  system.set_time_step(0.01);
+  cell_structure.set_verlet_skin(0.2);
+
+  system.nonbonded_ias->get_ia_param(0, 0).lj =
+      LJ_Parameters{1., 0.8, 1.5, 0., 0., 0.};
+  system.on_non_bonded_ia_change();
+
+  auto const n_side = 8;
+  auto const n_part = n_side * n_side * n_side;
+  std::vector<Utils::Vector3d> initial_pos, initial_vel;
+  std::mt19937 gen(42u);
+  std::uniform_real_distribution<double> noise(-0.1, 0.1);
+  for (int pid = 0; pid < n_part; ++pid) {
+    initial_pos.emplace_back(Utils::Vector3d{
+        (pid % n_side) + 0.5 + noise(gen),
+        ((pid / n_side) % n_side) + 0.5 + noise(gen),
+        (pid / (n_side * n_side)) + 0.5 + noise(gen)});
+    initial_vel.emplace_back(
+        Utils::Vector3d{noise(gen), noise(gen), noise(gen)} * 20.);
+    create_particle(initial_pos.back(), pid, 0);
+  }
+
+  auto const get_positions = [&](int sort_interval) {
+    for (int pid = 0; pid < n_part; ++pid) {
+      set_particle_pos(pid, initial_pos[pid]);
+      set_particle_v(pid, initial_vel[pid]);
+    }
+    system.on_particle_change();
+    cell_structure.set_particle_sort_interval(sort_interval);
+    system.integrate(50, INTEG_REUSE_FORCES_NEVER);
+    std::vector<Utils::Vector3d> positions;
+    for (int pid = 0; pid < n_part; ++pid) {
+      auto const p_opt = copy_particle_to_head_node(comm, system, pid);
+      if (rank == 0) {
+        positions.emplace_back(p_opt->pos());
+      }
+    }
+    return positions;
+  };
+
+  // the order of the particles in memory doesn't change the trajectory
+  auto const positions_ref = get_positions(0);
+  auto const positions = get_positions(1);
+  if (rank == 0) {
+    for (std::size_t i = 0u; i < positions_ref.size(); ++i) {
+      BOOST_CHECK_SMALL((positions[i] - positions_ref[i]).norm(), 1e-8);
+    }
+  }
+
+  // after a resort, the particles of each cell are sorted along
+  // the Morton curve, and the particle index is up to date
+  BOOST_REQUIRE_EQUAL(cell_structure.get_particle_sort_interval(), 1);
+  cell_structure.resort_particles(false);
+  auto const bins_per_length = static_cast<double>(1u << Utils::morton_bits);
+  auto const morton_key = [&](Particle const &p) {
+    auto const bin = p.pos() * (bins_per_length / box_l);
+    return Utils::morton_code(static_cast<uint32_t>(bin[0]),
+                              static_cast<uint32_t>(bin[1]),
+                              static_cast<uint32_t>(bin[2]));
+  };
+  for (auto const cell :
+       std::as_const(cell_structure).decomposition().local_cells()) {
+    auto const &particles = cell->particles();
+    BOOST_CHECK(std::is_sorted(particles.begin(), particles.end(),
+                               [&](Particle const &a, Particle const &b) {
+                                 return morton_key(a) < morton_key(b);
+                               }));
+  }
+  for (auto const &p : cell_structure.local_particles()) {
+    BOOST_CHECK_EQUAL(cell_structure.get_local_particle(p.id()), &p);
+  }
+  BOOST_CHECK_THROW(cell_structure.set_particle_sort_interval(-1),
+                    std::domain_error);
+  cell_structure.set_particle_sort_interval(0);
+  system.on_particle_change();
+}
+
+#ifdef EXTERNAL_FORCES
+BOOST_FIXTURE_TEST_CASE(verlet_list_partial_rebuild, ParticleFactory) {
+  auto constexpr tol = 1e-10;
+  auto const comm = boost::mpi::communicator();
+  auto const rank = comm.rank();
+
+  auto const box_l = 8.;
+  auto &system = *espresso::system;
+  system.set_box_l(Utils::Vector3d::broadcast(box_l));
+  ::communicator.set_node_grid({2, 2, 1});
+  system.on_node_grid_change();
+  Testing::velocity_verlet.set_integrator();
+  system.set_time_step(0.01);
+  system.cell_structure->set_verlet_skin(0.1);
+
+  system.nonbonded_ias->make_particle_type_exist(1);
+  system.nonbonded_ias->get_ia_param(0, 0).lj =
+      LJ_Parameters{1., 0.5, 1.2, 0., 0., 0.};
+  system.nonbonded_ias->get_ia_param(0, 1).lj =
+      LJ_Parameters{1., 0.3, 0.8, 0., 0., 0.};
+  system.nonbonded_ias->get_ia_param(1, 1).lj = LJ_Parameters{};
+  system.on_non_bonded_ia_change();
+
+  // frozen lattice, whose Verlet lists can be kept across resorts,
+  // traversed by fast particles that trigger the resorts
+  auto const n_side = 8;
+  auto const n_frozen = n_side * n_side * n_side;
+  for (int pid = 0; pid < n_frozen; ++pid) {
+    auto const pos = Utils::Vector3d{
+        static_cast<double>(pid % n_side),
+        static_cast<double>((pid / n_side) % n_side),
+        static_cast<double>(pid / (n_side * n_side))};
+    create_particle(pos, pid, 0);
+    set_particle_property(pid, &Particle::fixed, uint8_t{0b111u});
+  }
+  for (int k = 0; k < 4; ++k) {
+    auto const pid = n_frozen + k;
+    create_particle({0.5, 2. * k + 0.5, 0.5 + k}, pid, 1);
+    set_particle_v(pid, {5., 0., 0.});
+  }
+  system.on_particle_change();
+
+  auto const get_energy = [&](bool use_verlet_list) {
+    system.cell_structure->use_verlet_list = use_verlet_list;
+    auto const obs = system.calculate_energy();
+    return std::accumulate(obs->non_bonded_inter.begin(),
+                           obs->non_bonded_inter.end(), 0.) +
+           std::accumulate(obs->non_bonded_intra.begin(),
+                           obs->non_bonded_intra.end(), 0.);
+  };
+
+  for (int i = 0; i < 8; ++i) {
+    system.integrate(5, INTEG_REUSE_FORCES_CONDITIONALLY);
+    auto const energy_ref = get_energy(false);
+    auto const energy = get_energy(true);
+    if (rank == 0) {
+      BOOST_CHECK_CLOSE(energy, energy_ref, tol);
+    }
+  }
+}
+#endif // EXTERNAL_FORCES
+#if defined(ELECTROSTATICS) and defined(HAT)
+BOOST_FIXTURE_TEST_CASE(verlet_list_charge_change, ParticleFactory) {
+  auto constexpr tol = 1e-10;
+  auto const comm = boost::mpi::communicator();
+  auto const rank = comm.rank();
+
+  auto const box_l = 8.;
+  auto &system = *espresso::system;
+  system.set_box_l(Utils::Vector3d::broadcast(box_l));
+  ::communicator.set_node_grid({2, 2, 1});
+  system.on_node_grid_change();
+  Testing::velocity_verlet.set_integrator();
+  system.set_time_step(0.01);
+  system.cell_structure->set_verlet_skin(0.1);
+  // a potential between other types selects the particle pair kernel,
+  // which relies on the Verlet criterion
+  system.nonbonded_ias->make_particle_type_exist(1);
+  system.nonbonded_ias->get_ia_param(0, 0).lj = LJ_Parameters{};
+  system.nonbonded_ias->get_ia_param(1, 1).hat = Hat_Parameters{1., 1.};
+  system.on_non_bonded_ia_change();
+  BOOST_REQUIRE(not system.nonbonded_ias->only_lj_wca());
+
+  // particle pair at rest without short-range interaction,
+  // initially uncharged, such that it is not in the Verlet list
+  auto const pid1 = 1;
+  auto const pid2 = 2;
+  create_particle({1.5, 1.5, 1.5}, pid1, 0);
+  create_particle({2.5, 1.5, 1.5}, pid2, 0);
+  auto const solver = std::make_shared<DebyeHueckel>(2., 1.5, 1.5);
+  add_actor(comm, espresso::system, system.coulomb.impl->solver, solver,
+            [&system]() { system.on_coulomb_change(); });
+
+  auto const get_force = [&](bool use_verlet_list) {
+    system.cell_structure->use_verlet_list = use_verlet_list;
+    system.integrate(0, INTEG_REUSE_FORCES_NEVER);
+    auto const p_opt = copy_particle_to_head_node(comm, system, pid1);
+    return (rank == 0) ? p_opt->force() : Utils::Vector3d{};
+  };
+
+  BOOST_CHECK_EQUAL(get_force(true).norm(), 0.);
+
+  // change the charges in place, like the ICC algorithm; the particles
+  // don't move, therefore the Verlet lists can only be rebuilt if the
+  // charge change invalidates them
+  for (auto const &[pid, q] : {std::pair{pid1, 1.}, std::pair{pid2, -1.}}) {
+    if (auto p = system.cell_structure->get_local_particle(pid)) {
+      p->q() = q;
+    }
+  }
+  system.on_particle_charge_change();
+  auto const force = get_force(true);
+  auto const force_ref = get_force(false);
+  system.cell_structure->use_verlet_list = true;
+  system.coulomb.impl->solver = std::nullopt;
+  system.on_coulomb_change();
+  system.nonbonded_ias->get_ia_param(1, 1).hat = Hat_Parameters{};
+  system.on_non_bonded_ia_change();
+  if (rank == 0) {
+    BOOST_CHECK_GT(force_ref.norm(), 0.);
+    BOOST_CHECK_SMALL((force - force_ref).norm(), tol);
+  }
+}
+#endif // defined(ELECTROSTATICS) and defined(HAT)
+BOOST_FIXTURE_TEST_CASE(verlet_list_skin_tuning, ParticleFactory) {
+  auto const comm = boost::mpi::communicator();
+  auto const rank = comm.rank();
+
+  auto const box_l = 8.;
+  auto &system = *espresso::system;
+  system.set_box_l(Utils::Vector3d::broadcast(box_l));
+  ::communicator.set_node_grid({2, 2, 1});
+  system.on_node_grid_change();
+  Testing::velocity_verlet.set_integrator();
+  system.set_time_step(0.01);
+  system.cell_structure->set_verlet_skin(0.2);
+
+  system.nonbonded_ias->get_ia_param(0, 0).lj =
+      LJ_Parameters{1., 0.8, 1.5, 0., 0., 0.};
+  system.on_non_bonded_ia_change();
+
+  auto const n_side = 8;
+  auto const n_part = n_side * n_side * n_side;
+  std::vector<Utils::Vector3d> initial_pos, initial_vel;
+  std::mt19937 gen(42u);
+  std::uniform_real_distribution<double> noise(-0.1, 0.1);
+  for (int pid = 0; pid < n_part; ++pid) {
+    initial_pos.emplace_back(Utils::Vector3d{
+        (pid % n_side) + 0.5 + noise(gen),
+        ((pid / n_side) % n_side) + 0.5 + noise(gen),
+        (pid / (n_side * n_side)) + 0.5 + noise(gen)});
+    initial_vel.emplace_back(
+        Utils::Vector3d{noise(gen), noise(gen), noise(gen)} * 20.);
+    create_particle(initial_pos.back(), pid, 0);
+  }
+
+  auto const get_positions = [&](bool tune) {
+    for (int pid = 0; pid < n_part; ++pid) {
+      set_particle_pos(pid, initial_pos[pid]);
+      set_particle_v(pid, initial_vel[pid]);
+    }
+    system.on_particle_change();
+    if (tune) {
+      system.cell_structure->start_verlet_skin_tuning(0.01, 2, false);
+      BOOST_REQUIRE(system.cell_structure->is_verlet_skin_tuning());
+    }
+    auto const max_skin = system.cell_structure->get_verlet_skin();
+    system.integrate(5, INTEG_REUSE_FORCES_NEVER);
+    // the cell system is rebuilt between two integrations while the
+    // tuning is running, it has to keep the largest trial skin
+    BOOST_REQUIRE_EQUAL(system.cell_structure->is_verlet_skin_tuning(), tune);
+    system.on_non_bonded_ia_change();
+    BOOST_CHECK_EQUAL(system.cell_structure->get_verlet_skin(), max_skin);
+    BOOST_CHECK_EQUAL(system.get_interaction_range(),
+                      system.maximal_cutoff() + max_skin);
+    BOOST_CHECK_LE(system.cell_structure->get_verlet_list_skin(), max_skin);
+    system.integrate(45, INTEG_REUSE_FORCES_NEVER);
+    std::vector<Utils::Vector3d> positions;
+    for (int pid = 0; pid < n_part; ++pid) {
+      auto const p_opt = copy_particle_to_head_node(comm, system, pid);
+      if (rank == 0) {
+        positions.emplace_back(p_opt->pos());
+      }
+    }
+    return positions;
+  };
+
+  // the trial skins only rebuild the Verlet lists, which must
+  // not miss any pair of the force calculation; the positions
+  // are folded at different steps, depending on the skin
+  auto const positions_ref = get_positions(false);
+  auto const positions = get_positions(true);
+  BOOST_CHECK_GT(system.cell_structure->get_verlet_skin(), 0.);
+  if (rank == 0) {
+    auto const &box_geo = *system.box_geo;
+    for (std::size_t i = 0u; i < positions_ref.size(); ++i) {
+      auto const dist = box_geo.get_mi_vector(positions[i], positions_ref[i]);
+      BOOST_CHECK_SMALL(dist.norm(), 1e-10);
+    }
+  }
+}
+
+
 int main(int argc, char **argv) {
   auto const mpi_handle = MpiContainerUnitTest(argc, argv);
   espresso::system = System::System::create();
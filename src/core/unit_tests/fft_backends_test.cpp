@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE "P3M FFT backends"
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#include <boost/test/data/monomorphic.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/unit_test.hpp>
+namespace bdata = boost::unit_test::data;
+
+#include "config/config.hpp"
+
+#include "cell_system/CellStructureType.hpp"
+#include "communication.hpp"
+#include "p3m/FFTBackendLegacy.hpp"
+#include "p3m/FFTBackendPencil.hpp"
+#include "p3m/common.hpp"
+#include "p3m/data_struct.hpp"
+#include "p3m/for_each_3d.hpp"
+#include "system/System.hpp"
+
+#include <utils/Vector.hpp>
+#include <utils/index.hpp>
+
+#include <boost/mpi.hpp>
+#include <boost/mpi/collectives/all_reduce.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#if defined(P3M) or defined(DP3M)
+
+namespace espresso {
+// ESPResSo system instance
+static std::shared_ptr<System::System> system;
+} // namespace espresso
+
+/** Value of the test signal at a global mesh point. */
+static double signal(Utils::Vector3i const &index) {
+  return std::sin(1. + 0.3 * index[0] + 0.7 * index[1] * index[2]) +
+         0.1 * index[2];
+}
+
+/** Fill the local charge assignment mesh, including its margins. */
+static void fill_ca_mesh(P3MLocalMesh const &local_mesh,
+                         Utils::Vector3i const &mesh,
+                         std::vector<double> &data) {
+  auto const start = Utils::Vector3i::broadcast(0);
+  auto const &stop = local_mesh.dim;
+  auto indices = Utils::Vector3i{};
+  auto index = 0ul;
+  for_each_3d(start, stop, indices, [&]() {
+    auto global = Utils::Vector3i{};
+    for (auto i = 0u; i < 3u; ++i) {
+      global[i] = (local_mesh.ld_ind[i] + indices[i] + mesh[i]) % mesh[i];
+    }
+    data[index++] = signal(global);
+  });
+}
+
+/** Collect the local k-space meshes of all ranks in the global mesh. */
+static auto gather_ks_mesh(boost::mpi::communicator const &comm,
+                           FFTBackend<double> const &fft,
+                           Utils::Vector3i const &mesh,
+                           std::vector<double> const &data) {
+  auto const [KX, KY, KZ] = fft.get_permutations();
+  auto global_size = Utils::Vector3i{};
+  global_size[KX] = mesh[0];
+  global_size[KY] = mesh[1];
+  global_size[KZ] = mesh[2];
+  auto const start = Utils::Vector3i(fft.get_mesh_start());
+  auto const stop = start + Utils::Vector3i(fft.get_mesh_size());
+  auto const n_points = static_cast<std::size_t>(Utils::product(mesh));
+  std::vector<double> local(2ul * n_points, 0.);
+  std::vector<double> global(2ul * n_points);
+  auto indices = Utils::Vector3i{};
+  auto index = 0ul;
+  for_each_3d(start, stop, indices, [&]() {
+    auto const i = static_cast<std::size_t>(Utils::get_linear_index(
+        indices, global_size, Utils::MemoryOrder::ROW_MAJOR));
+    local[2ul * i + 0ul] = data[index++];
+    local[2ul * i + 1ul] = data[index++];
+  });
+  boost::mpi::all_reduce(comm, local.data(), static_cast<int>(local.size()),
+                         global.data(), std::plus<>());
+  return global;
+}
+
+auto const node_grids = std::vector<Utils::Vector3i>{{4, 1, 1}, {2, 2, 1}};
+
+/*
+ * The local meshes have a non-zero global offset ld_ind on every rank.
+ * The pencil backend has to redistribute them to the same global mesh
+ * points as the legacy backend.
+ */
+BOOST_DATA_TEST_CASE(fft_backends_pencil_legacy, bdata::make(node_grids),
+                     node_grid) {
+  auto constexpr tol = 1e-10;
+  auto const comm = boost::mpi::communicator();
+  auto const box_l = Utils::Vector3d{{10., 12., 14.}};
+  auto const mesh = Utils::Vector3i{{10, 12, 14}};
+  auto &system = *espresso::system;
+  system.set_box_l(box_l);
+  ::communicator.set_node_grid(node_grid);
+  system.on_node_grid_change();
+
+  auto params = P3MParameters{false,
+                              0.,
+                              2.5,
+                              mesh,
+                              Utils::Vector3d::broadcast(0.5),
+                              5,
+                              1.,
+                              1e-3};
+  params.recalc_a_ai_cao_cut(box_l);
+  auto local_mesh = P3MLocalMesh{};
+  local_mesh.calc_local_ca_mesh(params, *system.local_geo, 0.4, 0.);
+  auto const ld_ind = Utils::Vector3i(local_mesh.ld_ind);
+  auto const n_offsets = boost::mpi::all_reduce(
+      comm, static_cast<int>(ld_ind != Utils::Vector3i{}), std::plus<>());
+  BOOST_REQUIRE_EQUAL(n_offsets, comm.size());
+
+  auto legacy = FFTBackendLegacy<double>(local_mesh);
+  auto pencil = FFTBackendPencil<double>(local_mesh);
+  legacy.init(params);
+  pencil.init(params);
+  BOOST_REQUIRE_GE(legacy.get_ca_mesh_size(), local_mesh.size);
+  BOOST_REQUIRE_GE(pencil.get_ca_mesh_size(), local_mesh.size);
+
+  std::vector<double> legacy_mesh(legacy.get_ca_mesh_size());
+  std::vector<double> pencil_mesh(pencil.get_ca_mesh_size());
+  fill_ca_mesh(local_mesh, mesh, legacy_mesh);
+  fill_ca_mesh(local_mesh, mesh, pencil_mesh);
+
+  // forward transform: same k-space mesh
+  legacy.forward_fft(legacy_mesh.data());
+  pencil.forward_fft(pencil_mesh.data());
+  auto const legacy_ks = gather_ks_mesh(comm, legacy, mesh, legacy_mesh);
+  auto const pencil_ks = gather_ks_mesh(comm, pencil, mesh, pencil_mesh);
+  for (auto i = 0ul; i < legacy_ks.size(); ++i) {
+    BOOST_REQUIRE_SMALL(std::abs(pencil_ks[i] - legacy_ks[i]), tol);
+  }
+
+  // backward transform: same real-space mesh, up to the FFT normalization
+  legacy.backward_fft(legacy_mesh.data());
+  pencil.backward_fft(pencil_mesh.data());
+  auto const norm = static_cast<double>(Utils::product(mesh));
+  auto const start = Utils::Vector3i(local_mesh.in_ld);
+  auto const stop = Utils::Vector3i(local_mesh.in_ur);
+  auto indices = Utils::Vector3i{};
+  for_each_3d(start, stop, indices, [&]() {
+    auto const i = static_cast<std::size_t>(Utils::get_linear_index(
+        indices, local_mesh.dim, Utils::MemoryOrder::ROW_MAJOR));
+    auto global = Utils::Vector3i{};
+    for (auto j = 0u; j < 3u; ++j) {
+      global[j] = (ld_ind[j] + indices[j] + mesh[j]) % mesh[j];
+    }
+    BOOST_CHECK_SMALL(std::abs(legacy_mesh[i] - norm * signal(global)), tol);
+    BOOST_CHECK_SMALL(std::abs(pencil_mesh[i] - norm * signal(global)), tol);
+  });
+}
+
+int main(int argc, char **argv) {
+  auto const mpi_handle = MpiContainerUnitTest(argc, argv);
+  espresso::system = System::System::create();
+  espresso::system->set_cell_structure_topology(CellStructureType::REGULAR);
+  ::System::set_system(espresso::system);
+  // the test case only works for 4 MPI ranks
+  boost::mpi::communicator world;
+  int error_code = 0;
+  if (world.size() == 4) {
+    error_code = boost::unit_test::unit_test_main(init_unit_test, argc, argv);
+  }
+  return error_code;
+}
+#else // defined(P3M) or defined(DP3M)
+int main(int argc, char **argv) {}
+#endif
@@ -25,6 +25,7 @@
 #include "config/config.hpp"
 
 #include "fft/fft.hpp"
+#include "fft/pencil.hpp"
 #include "fft/vector.hpp"
 #include "p3m/for_each_3d.hpp"
 #include "p3m/packing.hpp"
@@ -157,6 +158,33 @@ BOOST_AUTO_TEST_CASE(fft_map_grid) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(fft_pencil_grid) {
+  using fft::pencil_grid;
+  BOOST_CHECK((pencil_grid(1) == std::array<int, 2u>{{1, 1}}));
+  BOOST_CHECK((pencil_grid(2) == std::array<int, 2u>{{1, 2}}));
+  BOOST_CHECK((pencil_grid(6) == std::array<int, 2u>{{2, 3}}));
+  BOOST_CHECK((pencil_grid(7) == std::array<int, 2u>{{1, 7}}));
+  BOOST_CHECK((pencil_grid(16) == std::array<int, 2u>{{4, 4}}));
+  BOOST_CHECK((pencil_grid(2048) == std::array<int, 2u>{{32, 64}}));
+}
+
+BOOST_AUTO_TEST_CASE(fft_pencil_split) {
+  using fft::pencil_split;
+  for (int n : {1, 5, 7, 16, 33}) {
+    for (int parts : {1, 2, 3, 4, 8}) {
+      auto next = 0;
+      for (int i = 0; i < parts; ++i) {
+        auto const [start, size] = pencil_split(n, parts, i);
+        BOOST_REQUIRE_EQUAL(start, next);
+        BOOST_REQUIRE_GE(size, n / parts);
+        BOOST_REQUIRE_LE(size, n / parts + 1);
+        next += size;
+      }
+      BOOST_REQUIRE_EQUAL(next, n);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(fft_exceptions) {
   auto constexpr size_max = std::numeric_limits<std::size_t>::max();
   auto constexpr bad_size = size_max / sizeof(float) + 1ul;
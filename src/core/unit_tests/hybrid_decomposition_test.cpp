@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Hybrid decomposition test
+
+#include "config/config.hpp"
+
+#ifdef LENNARD_JONES
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#include <boost/test/data/monomorphic.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/unit_test.hpp>
+namespace bdata = boost::unit_test::data;
+
+#include "ParticleFactory.hpp"
+#include "particle_management.hpp"
+
+#include "Particle.hpp"
+#include "cell_system/CellStructure.hpp"
+#include "cell_system/CellStructureType.hpp"
+#include "cell_system/HybridDecomposition.hpp"
+#include "communication.hpp"
+#include "integrate.hpp"
+#include "integrators/Propagation.hpp"
+#include "nonbonded_interactions/lj.hpp"
+#include "particle_node.hpp"
+#include "system/System.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <boost/mpi.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace espresso {
+// ESPResSo system instance
+static std::shared_ptr<System::System> system;
+} // namespace espresso
+
+BOOST_DATA_TEST_CASE_F(ParticleFactory, hybrid_decomposition_binning,
+                       bdata::make({true, false}), periodic_x) {
+  auto constexpr tol = 1e-10;
+  auto const comm = boost::mpi::communicator();
+  auto const rank = comm.rank();
+
+  auto const box_l = 20.;
+  auto &system = *espresso::system;
+  auto &cell_structure = *system.cell_structure;
+  system.set_box_l(Utils::Vector3d::broadcast(box_l));
+  system.box_geo->set_periodic(0u, periodic_x);
+  system.on_periodicity_change();
+  ::communicator.set_node_grid({2, 2, 1});
+  system.on_node_grid_change();
+  system.propagation->set_integ_switch(INTEG_METHOD_NVT);
+  system.set_time_step(0.01);
+  cell_structure.set_verlet_skin(0.3);
+
+  // short-range interactions of the small particles,
+  // long-range interactions of the large particles
+  system.nonbonded_ias->make_particle_type_exist(1);
+  system.nonbonded_ias->get_ia_param(0, 0).lj =
+      LJ_Parameters{1., 1., 1.2, 0., 0., 0.};
+  system.nonbonded_ias->get_ia_param(0, 1).lj =
+      LJ_Parameters{1., 1.2, 2.5, 0., 0., 0.};
+  system.nonbonded_ias->get_ia_param(1, 1).lj =
+      LJ_Parameters{1., 1.5, 3., 0., 0., 0.};
+  system.on_non_bonded_ia_change();
+
+  // small particles on a jittered lattice, large particles
+  // in the centers of randomly chosen lattice cubes
+  auto const n_side = 10;
+  auto const n_small = n_side * n_side * n_side;
+  auto const n_large = 40;
+  std::mt19937 gen(42u);
+  std::uniform_real_distribution<double> jitter(-0.1, 0.1);
+  std::uniform_int_distribution<int> lattice_cube(0, n_side - 1);
+  for (int pid = 0; pid < n_small; ++pid) {
+    auto const pos =
+        2. * Utils::Vector3d{(pid % n_side) + 0.25 + jitter(gen),
+                             ((pid / n_side) % n_side) + 0.25 + jitter(gen),
+                             (pid / (n_side * n_side)) + 0.25 + jitter(gen)};
+    create_particle(pos, pid, 0);
+  }
+  std::set<std::vector<int>> large_cubes;
+  while (large_cubes.size() < static_cast<std::size_t>(n_large)) {
+    large_cubes.insert({lattice_cube(gen), lattice_cube(gen),
+                        lattice_cube(gen)});
+  }
+  auto large_pid = n_small;
+  for (auto const &cube : large_cubes) {
+    auto const pos = 2. * Utils::Vector3d{cube[0] + 0.75, cube[1] + 0.75,
+                                          cube[2] + 0.75};
+    create_particle(pos, large_pid, 1);
+    set_particle_v(large_pid++, {-1.5, 0., 0.});
+  }
+  auto const n_part = n_small + n_large;
+
+  auto const get_forces = [&]() {
+    system.integrate(0, INTEG_REUSE_FORCES_NEVER);
+    std::vector<Utils::Vector3d> forces;
+    for (int pid = 0; pid < n_part; ++pid) {
+      auto const p_opt = copy_particle_to_head_node(comm, system, pid);
+      if (rank == 0) {
+        forces.emplace_back(p_opt->force());
+      }
+    }
+    return forces;
+  };
+  auto const check_forces = [&](std::vector<Utils::Vector3d> const &forces,
+                                std::vector<Utils::Vector3d> const &ref) {
+    if (rank == 0) {
+      for (std::size_t i = 0u; i < ref.size(); ++i) {
+        BOOST_CHECK_SMALL((forces[i] - ref[i]).norm(),
+                          tol * (1. + ref[i].norm()));
+      }
+    }
+  };
+
+  system.set_cell_structure_topology(CellStructureType::REGULAR);
+  auto const forces_ref = get_forces();
+
+  cell_structure.set_hybrid_decomposition(1.2, {1});
+  auto const &hybrid = dynamic_cast<HybridDecomposition const &>(
+      std::as_const(cell_structure).decomposition());
+
+  // the large particles are binned, and each regular cell
+  // is only coupled to the bins within range
+  BOOST_CHECK((hybrid.get_n_square_bin_grid() == Utils::Vector3i{6, 6, 6}));
+  auto const n_bins = static_cast<std::size_t>(6 * 6 * 6 * comm.size());
+  auto const first_regular_cell = hybrid.local_cells().front();
+  BOOST_CHECK_LT(first_regular_cell->neighbors().red().size(), n_bins / 2u);
+
+  check_forces(get_forces(), forces_ref);
+  auto const n_large_total = hybrid.count_particles_in_n_square();
+  if (rank == 0) {
+    BOOST_CHECK_EQUAL(n_large_total, static_cast<std::size_t>(n_large));
+  }
+
+  // the forces still agree after the large particles changed bins
+  system.integrate(40, INTEG_REUSE_FORCES_CONDITIONALLY);
+  auto const forces = get_forces();
+  system.set_cell_structure_topology(CellStructureType::REGULAR);
+  check_forces(forces, get_forces());
+
+  system.box_geo->set_periodic(0u, true);
+  system.on_periodicity_change();
+}
+
+int main(int argc, char **argv) {
+  auto const mpi_handle = MpiContainerUnitTest(argc, argv);
+  espresso::system = System::System::create();
+  espresso::system->set_cell_structure_topology(CellStructureType::REGULAR);
+  ::System::set_system(espresso::system);
+  // the test case only works for 4 MPI ranks
+  boost::mpi::communicator world;
+  int error_code = 0;
+  if (world.size() == 4) {
+    error_code = boost::unit_test::unit_test_main(init_unit_test, argc, argv);
+  }
+  return error_code;
+}
+#else // ifdef LENNARD_JONES
+int main(int argc, char **argv) {}
+#endif
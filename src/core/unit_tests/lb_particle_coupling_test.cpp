@@ -57,11 +57,13 @@ namespace utf = boost::unit_test;
 
 #include <boost/mpi.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstddef>
 #include <limits>
 #include <memory>
+#include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -523,6 +525,73 @@ BOOST_AUTO_TEST_CASE(runtime_exceptions) {
   }
 }
 
+// Check the batched force spreading against the spreading of single forces.
+BOOST_AUTO_TEST_CASE(batched_force_spreading) {
+  auto &lb_fluid = *espresso::lb_fluid;
+  auto const [lower, upper] = espresso::lb_lattice->get_local_grid_range();
+  auto const get_local_forces = [&, lower = lower, upper = upper]() {
+    std::vector<Utils::Vector3d> res;
+    for (auto x = lower[0]; x < upper[0]; ++x) {
+      for (auto y = lower[1]; y < upper[1]; ++y) {
+        for (auto z = lower[2]; z < upper[2]; ++z) {
+          auto const node = Utils::Vector3i{{x, y, z}};
+          res.emplace_back(*lb_fluid.get_node_force_to_be_applied(node));
+        }
+      }
+    }
+    return res;
+  };
+  auto const check_forces = [&](std::vector<Utils::Vector3d> const &ref) {
+    auto const values = get_local_forces();
+    BOOST_REQUIRE_EQUAL(values.size(), ref.size());
+    for (std::size_t i = 0ul; i < values.size(); ++i) {
+      BOOST_CHECK_SMALL((values[i] - ref[i]).norm(), 1e-12);
+    }
+  };
+
+  // positions in the local domain and in the halo
+  std::mt19937 gen(42u);
+  std::uniform_real_distribution<double> force_dist(-1., 1.);
+  std::vector<Utils::Vector3d> positions;
+  std::vector<Utils::Vector3d> forces;
+  for (int i = 0; i < 50; ++i) {
+    Utils::Vector3d pos{};
+    Utils::Vector3d force{};
+    for (auto const j : {0u, 1u, 2u}) {
+      std::uniform_real_distribution<double> pos_dist(lower[j] - 0.5,
+                                                      upper[j] + 0.5);
+      pos[j] = pos_dist(gen);
+      force[j] = force_dist(gen);
+    }
+    positions.emplace_back(pos);
+    forces.emplace_back(force);
+  }
+
+  // spreading the forces one by one with the opposite sign
+  // must cancel the batched spreading on every node
+  auto const forces_ref = get_local_forces();
+  BOOST_CHECK(lb_fluid.add_forces_at_pos(positions, forces));
+  auto max_change = 0.;
+  auto const forces_batch = get_local_forces();
+  for (std::size_t i = 0ul; i < forces_batch.size(); ++i) {
+    max_change = std::max(max_change, (forces_batch[i] - forces_ref[i]).norm());
+  }
+  BOOST_CHECK_GT(max_change, 0.1);
+  for (std::size_t i = 0ul; i < positions.size(); ++i) {
+    BOOST_REQUIRE(lb_fluid.add_force_at_pos(positions[i], -forces[i]));
+  }
+  check_forces(forces_ref);
+
+  // positions outside of the halo are skipped and reported
+  auto const outside =
+      Utils::Vector3d(lower) - Utils::Vector3d::broadcast(3.);
+  BOOST_CHECK(not lb_fluid.add_force_at_pos(outside, forces[0]));
+  BOOST_CHECK(not lb_fluid.add_forces_at_pos({positions[0], outside},
+                                             {forces[0], forces[1]}));
+  BOOST_REQUIRE(lb_fluid.add_force_at_pos(positions[0], -forces[0]));
+  check_forces(forces_ref);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 bool test_lb_domain_mismatch_local() {
@@ -26,6 +26,7 @@
 #include "Particle.hpp"
 #include "cell_system/Cell.hpp"
 
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -72,3 +73,45 @@ BOOST_AUTO_TEST_CASE(link_cell) {
       ++it;
     }
 }
+
+BOOST_AUTO_TEST_CASE(color_cells) {
+  /* periodic chain of cells, each cell has its right neighbor as red
+   * neighbor and its left neighbor as black neighbor */
+  auto const n_cells = 10u;
+  std::vector<Cell> cells(n_cells);
+  for (auto i = 0u; i < n_cells; ++i) {
+    std::vector<Cell *> red{&cells[(i + 1u) % n_cells]};
+    std::vector<Cell *> black{&cells[(i + n_cells - 1u) % n_cells]};
+    cells[i].m_neighbors = Neighbors<Cell *>(red, black);
+  }
+
+  std::vector<Cell *> cell_ptrs;
+  for (auto &c : cells) {
+    cell_ptrs.push_back(&c);
+  }
+
+  auto const colors = Algorithm::color_cells(cell_ptrs);
+
+  /* every cell has exactly one color */
+  std::set<Cell *> colored;
+  for (auto const &color : colors) {
+    for (auto const cell : color) {
+      BOOST_CHECK(colored.insert(cell).second);
+    }
+  }
+  BOOST_CHECK_EQUAL(colored.size(), n_cells);
+
+  /* cells of the same color don't share any particle */
+  for (auto const &color : colors) {
+    std::set<Cell *> touched;
+    for (auto const cell : color) {
+      BOOST_CHECK(touched.insert(cell).second);
+      for (auto const neighbor : cell->neighbors().red()) {
+        BOOST_CHECK(touched.insert(neighbor).second);
+      }
+    }
+  }
+
+  /* a periodic chain of even length can be colored with two colors */
+  BOOST_CHECK_EQUAL(colors.size(), 2u);
+}
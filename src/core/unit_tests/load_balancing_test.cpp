@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Load balancing of the regular decomposition
+
+#include "config/config.hpp"
+
+#ifdef LENNARD_JONES
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#include <boost/test/unit_test.hpp>
+
+#include "ParticleFactory.hpp"
+#include "particle_management.hpp"
+
+#include "LocalBox.hpp"
+#include "Particle.hpp"
+#include "cell_system/CellStructure.hpp"
+#include "cell_system/CellStructureType.hpp"
+#include "cell_system/RegularDecomposition.hpp"
+#include "communication.hpp"
+#include "ek/EKNone.hpp"
+#include "ek/Solver.hpp"
+#include "integrate.hpp"
+#include "integrators/Propagation.hpp"
+#include "lb/LBNone.hpp"
+#include "lb/Solver.hpp"
+#include "nonbonded_interactions/lj.hpp"
+#include "particle_node.hpp"
+#include "system/System.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <boost/mpi.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace espresso {
+// ESPResSo system instance
+static std::shared_ptr<System::System> system;
+} // namespace espresso
+
+BOOST_FIXTURE_TEST_CASE(load_balancing, ParticleFactory) {
+  auto constexpr tol = 1e-10;
+  auto const comm = boost::mpi::communicator();
+  auto const rank = comm.rank();
+
+  auto const box_l = 8.;
+  auto &system = *espresso::system;
+  auto &cell_structure = *system.cell_structure;
+  system.set_box_l(Utils::Vector3d::broadcast(box_l));
+  ::communicator.set_node_grid({2, 2, 1});
+  system.on_node_grid_change();
+  system.propagation->set_integ_switch(INTEG_METHOD_NVT);
+  system.set_time_step(0.01);
+  cell_structure.set_verlet_skin(0.2);
+  system.nonbonded_ias->get_ia_param(0, 0).lj =
+      LJ_Parameters{1., 0.5, 1.2, 0., 0., 0.};
+  system.on_non_bonded_ia_change();
+
+  // a jittered lattice in the lower corner of the box
+  auto const n_side = 5;
+  auto const n_part = n_side * n_side * n_side;
+  std::mt19937 gen(42u);
+  std::uniform_real_distribution<double> jitter(-0.05, 0.05);
+  for (int pid = 0; pid < n_part; ++pid) {
+    auto const pos = 0.6 * Utils::Vector3d{(pid % n_side) + 0.5 + jitter(gen),
+                                           ((pid / n_side) % n_side) + 0.5 +
+                                               jitter(gen),
+                                           (pid / (n_side * n_side)) + 0.5 +
+                                               jitter(gen)};
+    create_particle(pos, pid, 0);
+  }
+
+  auto const get_forces = [&]() {
+    system.integrate(0, INTEG_REUSE_FORCES_NEVER);
+    std::vector<Utils::Vector3d> forces;
+    for (int pid = 0; pid < n_part; ++pid) {
+      auto const p_opt = copy_particle_to_head_node(comm, system, pid);
+      if (rank == 0) {
+        forces.emplace_back(p_opt->force());
+      }
+    }
+    return forces;
+  };
+  auto const forces_ref = get_forces();
+
+  BOOST_CHECK_THROW(cell_structure.start_load_balancing(0, false),
+                    std::domain_error);
+  BOOST_REQUIRE(not cell_structure.is_load_balancing());
+  BOOST_REQUIRE(cell_structure.get_domain_boundaries() == nullptr);
+  cell_structure.start_load_balancing(1, false);
+  BOOST_REQUIRE(cell_structure.is_load_balancing());
+
+  // the time is taken as the number of local particles, which
+  // outweighs the measured force calculation time
+  for (int i = 0; i < 4; ++i) {
+    auto const n_local = cell_structure.local_particles().size();
+    cell_structure.add_load_balancing_time(static_cast<double>(n_local));
+    cell_structure.update_load_balancing();
+  }
+
+  // the domains which hold the particles shrink
+  auto const boundaries = *cell_structure.get_domain_boundaries();
+  BOOST_CHECK_LT(boundaries[0][1], 0.5);
+  BOOST_CHECK_LT(boundaries[1][1], 0.5);
+  BOOST_CHECK_EQUAL(boundaries[2].size(), 2u);
+  auto const &local_geo = *system.local_geo;
+  auto const node_index = ::communicator.calc_node_index();
+  for (auto i = 0u; i < 2u; ++i) {
+    auto const index = static_cast<std::size_t>(node_index[i]);
+    BOOST_CHECK_EQUAL(local_geo.my_left()[i], boundaries[i][index] * box_l);
+    BOOST_CHECK_EQUAL(local_geo.my_right()[i],
+                      boundaries[i][index + 1u] * box_l);
+  }
+
+  // all nodes agree on the global cell grid and on the range
+  // of the cell system, which is limited by the smallest domain
+  auto const &rd = dynamic_cast<RegularDecomposition const &>(
+      std::as_const(cell_structure).decomposition());
+  auto global_cell_grid = rd.global_cell_grid;
+  auto max_range = rd.max_range();
+  boost::mpi::broadcast(comm, global_cell_grid, 0);
+  boost::mpi::broadcast(comm, max_range, 0);
+  BOOST_CHECK(global_cell_grid == rd.global_cell_grid);
+  BOOST_CHECK(max_range == rd.max_range());
+  for (auto i = 0u; i < 3u; ++i) {
+    BOOST_CHECK_LE(max_range[i], rd.cell_size[i]);
+  }
+
+  // all particles are still there, and the forces don't depend
+  // on the partition
+  auto const n_part_total = boost::mpi::all_reduce(
+      comm, cell_structure.local_particles().size(), std::plus<>());
+  BOOST_CHECK_EQUAL(n_part_total, static_cast<std::size_t>(n_part));
+  auto const forces = get_forces();
+  if (rank == 0) {
+    for (std::size_t i = 0u; i < forces_ref.size(); ++i) {
+      BOOST_CHECK_SMALL((forces[i] - forces_ref[i]).norm(), tol);
+    }
+  }
+
+  // integration with the measured times
+  system.integrate(20, INTEG_REUSE_FORCES_CONDITIONALLY);
+  BOOST_CHECK(cell_structure.is_load_balancing());
+
+  // LB and EK cannot be activated on a non-uniform partition
+  auto const lb_none = std::make_shared<LB::LBNone>();
+  auto const ek_none = std::make_shared<EK::EKNone>();
+  BOOST_CHECK_THROW(system.lb.set<LB::LBNone>(lb_none), std::runtime_error);
+  BOOST_CHECK_THROW(system.ek.set<EK::EKNone>(ek_none), std::runtime_error);
+  BOOST_CHECK(not system.lb.is_solver_set());
+  BOOST_CHECK(not system.ek.is_solver_set());
+
+  // the uniform partition is restored
+  cell_structure.stop_load_balancing();
+  BOOST_CHECK(cell_structure.get_domain_boundaries() == nullptr);
+  auto const uniform_geo = LocalBox::make_regular_decomposition(
+      Utils::Vector3d::broadcast(box_l), node_index, ::communicator.node_grid);
+  BOOST_CHECK_EQUAL((local_geo.my_left() - uniform_geo.my_left()).norm(), 0.);
+  BOOST_CHECK_EQUAL((local_geo.my_right() - uniform_geo.my_right()).norm(),
+                    0.);
+}
+
+int main(int argc, char **argv) {
+  auto const mpi_handle = MpiContainerUnitTest(argc, argv);
+  espresso::system = System::System::create();
+  espresso::system->set_cell_structure_topology(CellStructureType::REGULAR);
+  ::System::set_system(espresso::system);
+  // the test case only works for 4 MPI ranks
+  boost::mpi::communicator world;
+  int error_code = 0;
+  if (world.size() == 4) {
+    error_code = boost::unit_test::unit_test_main(init_unit_test, argc, argv);
+  }
+  return error_code;
+}
+#else // ifdef LENNARD_JONES
+int main(int argc, char **argv) {}
+#endif
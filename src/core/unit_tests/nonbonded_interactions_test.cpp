@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Non-bonded interactions test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "config/config.hpp"
+
+#include "forces_inline.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+BOOST_AUTO_TEST_CASE(dispatch_potentials) {
+  auto const dispatch = [](unsigned int potentials) {
+    return dispatch_nonbonded_potentials(potentials, [](auto flags) {
+      static_assert(std::is_same_v<typename decltype(flags)::value_type,
+                                   unsigned int>);
+      return flags();
+    });
+  };
+  BOOST_CHECK_EQUAL(dispatch(NB_POTENTIAL_NONE), NB_POTENTIAL_NONE);
+  BOOST_CHECK_EQUAL(dispatch(NB_POTENTIAL_LJ), NB_POTENTIAL_LJ);
+  BOOST_CHECK_EQUAL(dispatch(NB_POTENTIAL_WCA), NB_POTENTIAL_WCA);
+  BOOST_CHECK_EQUAL(dispatch(NB_POTENTIAL_LJ | NB_POTENTIAL_WCA),
+                    NB_POTENTIAL_LJ | NB_POTENTIAL_WCA);
+  /* other combinations use the kernel of all potentials */
+  BOOST_CHECK_EQUAL(dispatch(NB_POTENTIAL_GAUSSIAN), NB_POTENTIAL_ALL);
+  BOOST_CHECK_EQUAL(dispatch(NB_POTENTIAL_WCA | NB_POTENTIAL_TABULATED),
+                    NB_POTENTIAL_ALL);
+}
+
+BOOST_AUTO_TEST_CASE(active_potentials_and_table) {
+  InteractionsNonBonded nonbonded_ias;
+  nonbonded_ias.make_particle_type_exist(1);
+  nonbonded_ias.recalc_maximal_cutoffs();
+  BOOST_CHECK_EQUAL(nonbonded_ias.active_potentials(), NB_POTENTIAL_NONE);
+  BOOST_CHECK(nonbonded_ias.only_lj_wca());
+
+#ifdef WCA
+  nonbonded_ias.get_ia_param(0, 1).wca = WCA_Parameters{2., 1.};
+  nonbonded_ias.recalc_maximal_cutoffs();
+  BOOST_CHECK_EQUAL(nonbonded_ias.active_potentials(), NB_POTENTIAL_WCA);
+  BOOST_CHECK(nonbonded_ias.only_lj_wca());
+
+  /* the table is a symmetric copy of the parameters */
+  for (auto const &[i, j] : {std::pair{0, 1}, std::pair{1, 0}}) {
+    auto const &ia_params = nonbonded_ias.get_ia_param_flat(i, j);
+    BOOST_CHECK_EQUAL(ia_params.wca.eps, 2.);
+    BOOST_CHECK_EQUAL(ia_params.max_cut,
+                      nonbonded_ias.get_ia_param(i, j).max_cut);
+  }
+  BOOST_CHECK_EQUAL(nonbonded_ias.get_ia_param_flat(1, 1).max_cut,
+                    INACTIVE_CUTOFF);
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(
+                        &nonbonded_ias.get_ia_param_flat(1, 0)) %
+                        64u,
+                    0u);
+
+  /* the specialized kernel matches the kernel of all potentials */
+  auto const &ia_params = nonbonded_ias.get_ia_param_flat(0, 1);
+  auto const d = Utils::Vector3d{0.3, 0.4, 0.5};
+  auto const dist = d.norm();
+  auto const force_ref = calc_central_radial_force(ia_params, d, dist).f;
+  auto const force =
+      calc_central_radial_force<NB_POTENTIAL_WCA>(ia_params, d, dist).f;
+  BOOST_CHECK_GT(force_ref.norm(), 0.);
+  BOOST_CHECK_EQUAL((force - force_ref).norm(), 0.);
+#endif // WCA
+
+  /* new types are added to the table */
+  nonbonded_ias.make_particle_type_exist(3);
+  BOOST_CHECK_EQUAL(nonbonded_ias.get_ia_param_flat(3, 2).max_cut,
+                    INACTIVE_CUTOFF);
+
+#ifdef GAUSSIAN
+  nonbonded_ias.get_ia_param(2, 3).gaussian = Gaussian_Parameters{1., 1., 2.};
+  nonbonded_ias.recalc_maximal_cutoffs();
+  BOOST_CHECK(nonbonded_ias.active_potentials() & NB_POTENTIAL_GAUSSIAN);
+  BOOST_CHECK(not nonbonded_ias.only_lj_wca());
+  BOOST_CHECK_EQUAL(nonbonded_ias.get_ia_param_flat(3, 2).max_cut, 2.);
+#endif // GAUSSIAN
+}
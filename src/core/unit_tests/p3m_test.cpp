@@ -22,11 +22,14 @@
 #include <boost/test/unit_test.hpp>
 
 #include "p3m/common.hpp"
+#include "p3m/interpolation.hpp"
 
 #include <utils/Vector.hpp>
 
 #include <array>
 #include <cstddef>
+#include <random>
+#include <set>
 #include <vector>
 
 BOOST_AUTO_TEST_CASE(calc_meshift_false) {
@@ -58,3 +61,69 @@ BOOST_AUTO_TEST_CASE(calc_meshift_true) {
     }
   }
 }
+
+#if defined(P3M) or defined(DP3M)
+BOOST_AUTO_TEST_CASE(interpolation_weights_and_tiles) {
+  auto constexpr cao = 5;
+  P3MLocalMesh local_mesh{};
+  local_mesh.dim = {{23, 17, 11}};
+  local_mesh.size = Utils::product(local_mesh.dim);
+  local_mesh.q_2_off = local_mesh.dim[2] - cao;
+  local_mesh.q_21_off = local_mesh.dim[2] * (local_mesh.dim[1] - cao);
+  auto const ai = Utils::Vector3d::broadcast(1.);
+
+  std::mt19937 gen(42);
+  std::vector<Utils::Vector3d> positions(100);
+  for (auto &pos : positions) {
+    for (auto d = 0u; d < 3u; ++d) {
+      std::uniform_real_distribution<double> dist(
+          2., static_cast<double>(local_mesh.dim[d] - cao));
+      pos[d] = dist(gen);
+    }
+  }
+
+  // batched weights match the weights of individual points
+  p3m_interpolation_cache cache;
+  cache.reset(cao);
+  cache.resize(positions.size());
+  p3m_calculate_interpolation_weights<cao>(positions, ai, local_mesh, cache,
+                                           0ul);
+  for (std::size_t i = 0ul; i < positions.size(); ++i) {
+    auto const ref =
+        p3m_calculate_interpolation_weights<cao>(positions[i], ai, local_mesh);
+    auto const w = cache.load<cao>(i);
+    BOOST_CHECK_EQUAL(w.ind, ref.ind);
+    for (int k = 0; k < cao; ++k) {
+      BOOST_CHECK_EQUAL(w.w_x[k], ref.w_x[k]);
+      BOOST_CHECK_EQUAL(w.w_y[k], ref.w_y[k]);
+      BOOST_CHECK_EQUAL(w.w_z[k], ref.w_z[k]);
+    }
+  }
+
+  // each point belongs to exactly one tile, and the interpolation
+  // cubes of tiles of the same color don't overlap
+  p3m_interpolation_tiles tiles;
+  tiles.build(cache, local_mesh);
+  std::vector<int> seen(positions.size(), 0);
+  for (int color = 0; color < tiles.colors(); ++color) {
+    std::set<int> mesh_points;
+    for (auto const tile : tiles.tiles(color)) {
+      std::set<int> tile_points;
+      for (auto const i : tiles.points(tile)) {
+        ++seen[i];
+        p3m_interpolate(local_mesh, cache.load<cao>(i),
+                        [&tile_points](int ind, double) {
+                          tile_points.insert(ind);
+                        });
+      }
+      for (auto const ind : tile_points) {
+        BOOST_CHECK(not mesh_points.contains(ind));
+      }
+      mesh_points.insert(tile_points.begin(), tile_points.end());
+    }
+  }
+  for (auto const count : seen) {
+    BOOST_CHECK_EQUAL(count, 1);
+  }
+}
+#endif // defined(P3M) or defined(DP3M)
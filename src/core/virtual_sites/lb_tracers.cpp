@@ -28,6 +28,12 @@
 #include "lb/Solver.hpp"
 #include "lb/particle_coupling.hpp"
 
+#include <utils/Vector.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
 static bool lb_sanity_checks(LB::Solver const &lb) {
   if (not lb.is_solver_set()) {
     runtimeErrorMsg() << "LB needs to be active for inertialess tracers.";
@@ -51,21 +57,24 @@ void lb_tracers_add_particle_force_to_fluid(CellStructure &cell_structure,
 
   // Keep track of ghost particles (ids) that have already been coupled
   LB::CouplingBookkeeping bookkeeping{cell_structure};
-  // Apply particle forces to the LB fluid at particle positions.
-  // For physical particles, also set particle velocity = fluid velocity.
+  // Apply particle forces to the LB fluid at particle positions,
+  // in a single batch for all tracers.
+  std::vector<Utils::Vector3d> positions;
+  std::vector<Utils::Vector3d> forces;
   for (auto const &particle_range :
        {cell_structure.local_particles(), cell_structure.ghost_particles()}) {
     for (auto const &p : particle_range) {
       if (!LB::is_tracer(p))
         continue;
       if (bookkeeping.should_be_coupled(p)) {
-        for (auto const &pos :
-             positions_in_halo(p.pos(), box_geo, local_box, agrid)) {
-          lb.add_force_density(pos, p.force());
-        }
+        positions_in_halo(p.pos(), box_geo, local_box, agrid, positions);
+        forces.resize(positions.size(), p.force());
       }
     }
   }
+  if (not lb.add_forces_at_pos(positions, forces)) {
+    throw std::runtime_error("Cannot apply force to LB");
+  }
 
   // Clear ghost forces to avoid double counting later
   init_forces_ghosts(cell_structure.ghost_particles());
@@ -76,14 +85,27 @@ void lb_tracers_propagate(CellStructure &cell_structure, LB::Solver const &lb,
   if (lb_sanity_checks(lb)) {
     return;
   }
-  auto const verlet_skin = cell_structure.get_verlet_skin();
+  auto const verlet_skin = cell_structure.get_verlet_list_skin();
   auto const verlet_skin_sq = verlet_skin * verlet_skin;
 
-  // Advect particles
+  // Interpolate the fluid velocity of all tracers in a single batch
+  std::vector<Particle *> tracers;
+  std::vector<Utils::Vector3d> positions;
   for (auto &p : cell_structure.local_particles()) {
-    if (!LB::is_tracer(p))
-      continue;
-    p.v() = lb.get_coupling_interpolated_velocity(p.pos());
+    if (LB::is_tracer(p)) {
+      tracers.emplace_back(&p);
+      positions.emplace_back(p.pos());
+    }
+  }
+  if (tracers.empty()) {
+    return;
+  }
+  auto const velocities = lb.get_coupling_interpolated_velocities(positions);
+
+  // Advect particles
+  for (std::size_t j = 0ul; j < tracers.size(); ++j) {
+    auto &p = *tracers[j];
+    p.v() = velocities[j];
     for (auto i = 0u; i < 3u; i++) {
       if (!p.is_fixed_along(i)) {
         p.pos()[i] += p.v()[i] * time_step;
@@ -32,8 +32,16 @@ class CellSystem(ScriptInterfaceHelper):
         Name of the currently active particle decomposition.
     use_verlet_lists : :obj:`bool`
         Whether to use Verlet lists.
+    overlap_ghost_communication : :obj:`bool`
+        Whether the ghost position update of the integration step overlaps
+        with the non-bonded force calculation of the local particles
+        (disabled by default).
     skin : :obj:`float`
         Verlet list skin.
+    particle_sort_interval : :obj:`int`
+        Number of particle resorts between two spatial sorts of the
+        particles in memory along a space-filling curve, or 0 to
+        disable the spatial sort (default).
     node_grid : (3,) array_like of :obj:`int`
         MPI repartition for the regular decomposition cell system.
     max_cut_bonded : :obj:`float`
@@ -85,6 +93,47 @@ class CellSystem(ScriptInterfaceHelper):
         :obj:`float` :
             The :attr:`skin`
 
+    tune_skin_online()
+        Tune the skin during the next integration steps. Each trial skin is
+        timed over ``int_steps`` steps and the range of skins is narrowed
+        down by golden-section search, starting from the range between zero
+        and the maximal permissible skin. The best skin is set in the
+        simulation core once the range is smaller than ``tol``.
+
+        Parameters
+        -----------
+        tol : :obj:`float`
+            Accuracy in skin to tune to.
+        int_steps : :obj:`int`
+            Integration steps to time per trial skin.
+        verbose : :obj:`bool`, optional
+            If ``True``, print the timings of the trials.
+            Defaults to ``False``.
+
+        Returns
+        -------
+        :obj:`float` :
+            The :attr:`skin` of the first trial
+
+    start_load_balancing()
+        Balance the load of the MPI ranks during the next integration steps.
+        The box is split along each axis into one slab per MPI rank of the
+        :attr:`node_grid`, whose boundaries are moved periodically such that
+        the time spent in the short-range force calculation is the same
+        for all slabs. Only supported by the regular decomposition, and
+        not in combination with LB, EK, electrostatics or magnetostatics.
+
+        Parameters
+        -----------
+        interval : :obj:`int`
+            Number of integration steps between two rebalances.
+        verbose : :obj:`bool`, optional
+            If ``True``, print the slab boundaries after each rebalance.
+            Defaults to ``False``.
+
+    stop_load_balancing()
+        Stop the load balancing and restore the uniform partition of the box.
+
     get_state()
         Get the current state of the cell system.
 
@@ -96,7 +145,8 @@ class CellSystem(ScriptInterfaceHelper):
     """
     _so_name = "CellSystem::CellSystem"
     _so_creation_policy = "GLOBAL"
-    _so_bind_methods = ("get_state", "tune_skin", "resort")
+    _so_bind_methods = ("get_state", "tune_skin", "tune_skin_online", "resort",
+                        "start_load_balancing", "stop_load_balancing")
 
     def set_regular_decomposition(self, **kwargs):
         """
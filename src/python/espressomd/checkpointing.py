@@ -17,6 +17,7 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #
 import collections
+import glob
 import inspect
 import pickle
 import os
@@ -24,6 +25,9 @@ import re
 import signal
 from . import utils
 from . import script_interface
+from .code_features import has_features
+from .io.mpiio import Mpiio
+from .system import System
 
 
 class Checkpoint:
@@ -196,10 +200,47 @@ class Checkpoint:
                 "No checkpoints found. Cannot return index for last checkpoint.")
         return self.counter - 1
 
+    def __get_mpiio_prefix(self, checkpoint_index, obj_name):
+        return os.path.join(
+            self.checkpoint_dir, f"{checkpoint_index}.{obj_name}")
+
+    def __save_mpiio(self, system, prefix):
+        """
+        Write the particles and the lattice populations of a system with
+        MPI-IO. Each MPI rank writes its local data, so that the data
+        doesn't go through the head node.
+
+        """
+        # MPI-IO doesn't overwrite files
+        for path in glob.glob(glob.escape(prefix) + ".*"):
+            os.remove(path)
+        Mpiio(system=system).write(prefix, particles=True)
+        if has_features("WALBERLA"):
+            if system.lb is not None:
+                system.lb.save_checkpoint_mpiio(prefix + ".lb")
+            if system.ekcontainer is not None:
+                for i, species in enumerate(system.ekcontainer):
+                    species.save_checkpoint_mpiio(f"{prefix}.ek{i}")
+
+    def __load_mpiio(self, system, prefix):
+        """
+        Read the particles and the lattice populations of a system
+        written by :meth:`__save_mpiio`.
+
+        """
+        Mpiio(system=system).read(prefix, particles=True)
+        if has_features("WALBERLA"):
+            if system.lb is not None:
+                system.lb.load_checkpoint_mpiio(prefix + ".lb")
+            if system.ekcontainer is not None:
+                for i, species in enumerate(system.ekcontainer):
+                    species.load_checkpoint_mpiio(f"{prefix}.ek{i}")
+
     def save(self, checkpoint_index=None):
         """
         Saves all registered python objects in the given checkpoint directory
-        using pickle.
+        using pickle. The particles and the LB/EK populations of registered
+        systems are written separately with MPI-IO.
 
         """
         # get attributes of registered objects
@@ -207,21 +248,36 @@ class Checkpoint:
         for obj_name in self.checkpoint_objects:
             checkpoint_data[obj_name] = self.__getattr_submodule(
                 self.calling_module, obj_name, None)
+        systems = {key: obj for key, obj in checkpoint_data.items()
+                   if isinstance(obj, System)}
 
         if checkpoint_index is None:
             checkpoint_index = self.counter
         filename = os.path.join(
             self.checkpoint_dir, f"{checkpoint_index}.checkpoint")
 
+        for obj_name, system in systems.items():
+            self.__save_mpiio(
+                system, self.__get_mpiio_prefix(checkpoint_index, obj_name))
+
         tmpname = filename + ".__tmp__"
-        with open(tmpname, "wb") as checkpoint_file:
-            pickle.dump(checkpoint_data, checkpoint_file, -1)
+        for system in systems.values():
+            system.call_method("internal_set_serialize_particles", value=False)
+        try:
+            with open(tmpname, "wb") as checkpoint_file:
+                pickle.dump(checkpoint_data, checkpoint_file, -1)
+        finally:
+            for system in systems.values():
+                system.call_method(
+                    "internal_set_serialize_particles", value=True)
         os.rename(tmpname, filename)
 
     def load(self, checkpoint_index=None):
         """
         Loads the python objects using (c)Pickle and sets them in the calling
-        module.
+        module. The particles and the LB/EK populations of systems are read
+        with MPI-IO, which requires the same number of MPI ranks as at the
+        time of writing.
 
         Parameters
         ----------
@@ -242,6 +298,12 @@ class Checkpoint:
                 self.calling_module, key, checkpoint_data[key])
             self.checkpoint_objects.append(key)
 
+        for key, obj in checkpoint_data.items():
+            prefix = self.__get_mpiio_prefix(checkpoint_index, key)
+            # checkpoints without MPI-IO files store the particles in pickle
+            if isinstance(obj, System) and os.path.isfile(prefix + ".head"):
+                self.__load_mpiio(obj, prefix)
+
     def __signal_handler(self, signum, frame):  # pylint: disable=unused-argument
         """
         Will be called when a registered signal was sent.
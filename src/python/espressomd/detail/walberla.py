@@ -86,6 +86,12 @@ class LatticeModel:
     def load_checkpoint(self, path, binary):
         return self.call_method("load_checkpoint", path=path, mode=int(binary))
 
+    def save_checkpoint_mpiio(self, prefix):
+        self.call_method("save_checkpoint_mpiio", prefix=prefix)
+
+    def load_checkpoint_mpiio(self, prefix):
+        self.call_method("load_checkpoint_mpiio", prefix=prefix)
+
     def get_nodes_inside_shape(self, shape=None):
         """
         Provide a generator for iterating over all nodes inside the given shape.
@@ -47,6 +47,108 @@ class EKFFT(ScriptInterfaceHelper):
     _so_creation_policy = "GLOBAL"
 
 
+@script_interface_register
+class EKCG(ScriptInterfaceHelper):
+    """
+    A conjugate gradient Poisson solver with a Jacobi preconditioner.
+    Supports a spatially varying permittivity, nodes with a fixed potential
+    (Dirichlet boundary condition) and insulating nodes (Neumann boundary
+    condition). Without Dirichlet nodes, the mean charge is removed and the
+    potential has zero mean, like in :class:`EKFFT`.
+
+    Parameters
+    ----------
+    lattice : :obj:`espressomd.lb.LatticeWalberla <espressomd.detail.walberla.LatticeWalberla>`
+        Lattice object.
+    permittivity : :obj:`float`
+        permittivity of the fluid :math:`\\epsilon_0 \\epsilon_{\\mathrm{r}}`.
+    tolerance : :obj:`float`, optional
+        Relative tolerance on the residual norm. Defaults to ``1e-6``.
+    max_iterations : :obj:`int`, optional
+        Maximal number of iterations per solve. Defaults to ``1000``.
+    single_precision : :obj:`bool`, optional
+        Use single-precision floating-point arithmetic.
+
+    Methods
+    -------
+    clear_boundaries()
+        Remove all boundaries and reset the relative permittivity to 1.
+
+    """
+    _so_name = "walberla::EKCG"
+    _so_features = ("WALBERLA",)
+    _so_creation_policy = "GLOBAL"
+    _so_bind_methods = ("clear_boundaries",)
+
+    def _get_values_grid(self, value, name):
+        value = np.array(value, dtype=float)
+        if np.shape(value) not in [(), (1,), tuple(self.lattice.shape)]:
+            raise ValueError(
+                f"Cannot process {name} value grid of shape {np.shape(value)}")
+        return value.flatten()
+
+    def add_dirichlet_boundary_from_shape(self, shape, potential):
+        """
+        Fix the potential of the nodes inside a shape.
+
+        Parameters
+        ----------
+        shape : :obj:`espressomd.shapes.Shape`
+            Shape to rasterize.
+        potential : :obj:`float` or (L, M, N) array_like of :obj:`float`
+            Electrostatic potential, either a single value or one value
+            per node of the EK grid.
+
+        """
+        utils.check_type_or_throw_except(
+            shape, 1, espressomd.shapes.Shape, "expected an espressomd.shapes.Shape")
+        values = self._get_values_grid(potential, "potential")
+        mask = self.lattice.get_shape_bitmask(shape=shape).astype(int)
+        self.call_method("update_dirichlet_boundary_from_shape",
+                         raster=array_variant(mask.flatten()),
+                         values=array_variant(values))
+
+    def add_neumann_boundary_from_shape(self, shape):
+        """
+        Make the nodes inside a shape insulating: the normal component
+        of the electric displacement vanishes on their surface.
+
+        Parameters
+        ----------
+        shape : :obj:`espressomd.shapes.Shape`
+            Shape to rasterize.
+
+        """
+        utils.check_type_or_throw_except(
+            shape, 1, espressomd.shapes.Shape, "expected an espressomd.shapes.Shape")
+        mask = self.lattice.get_shape_bitmask(shape=shape).astype(int)
+        self.call_method("update_neumann_boundary_from_shape",
+                         raster=array_variant(mask.flatten()))
+
+    def set_permittivity_from_shape(self, shape, relative_permittivity):
+        """
+        Set the relative permittivity of the nodes inside a shape,
+        e.g. to model a dielectric membrane.
+
+        Parameters
+        ----------
+        shape : :obj:`espressomd.shapes.Shape`
+            Shape to rasterize.
+        relative_permittivity : :obj:`float` or (L, M, N) array_like of :obj:`float`
+            Relative permittivity, either a single value or one value
+            per node of the EK grid.
+
+        """
+        utils.check_type_or_throw_except(
+            shape, 1, espressomd.shapes.Shape, "expected an espressomd.shapes.Shape")
+        values = self._get_values_grid(
+            relative_permittivity, "relative permittivity")
+        mask = self.lattice.get_shape_bitmask(shape=shape).astype(int)
+        self.call_method("update_permittivity_from_shape",
+                         raster=array_variant(mask.flatten()),
+                         values=array_variant(values))
+
+
 @script_interface_register
 class EKNone(ScriptInterfaceHelper):
     """
@@ -130,6 +232,27 @@ class EKSpecies(ScriptInterfaceHelper,
         binary : :obj:`bool`
             Whether to read in binary or ASCII mode.
 
+    save_checkpoint_mpiio()
+        Write EK densities and boundary conditions with MPI-IO.
+        Each MPI rank writes the nodes of its local domain as one slab
+        of the file ``<prefix>.data``, the slab sizes are written to
+        ``<prefix>.doff``. The files can only be read on the same number
+        of MPI ranks.
+
+        Parameters
+        ----------
+        prefix : :obj:`str`
+            Common prefix for the filenames. The files must not exist.
+
+    load_checkpoint_mpiio()
+        Load EK densities and boundary conditions written by
+        ``save_checkpoint_mpiio()``.
+
+        Parameters
+        ----------
+        prefix : :obj:`str`
+            Common prefix for the filenames.
+
     add_vtk_writer()
         Attach a VTK writer.
 
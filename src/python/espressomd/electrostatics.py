@@ -221,6 +221,9 @@ class P3M(_P3MBase):
         complex residuals when set to ``True`` (default).
     single_precision : :obj:`bool`
         Use single-precision floating-point arithmetic.
+    fft_backend : :obj:`str`, optional
+        Distributed FFT algorithm, either ``'legacy'`` (default)
+        or ``'pencil'``. See :ref:`Coulomb P3M` for more details.
 
     """
     _so_name = "Coulomb::CoulombP3M"
@@ -228,7 +231,8 @@ class P3M(_P3MBase):
     _so_features = ("P3M",)
 
     def default_params(self):
-        return {"single_precision": False, **super().default_params()}
+        return {"single_precision": False, "fft_backend": "legacy",
+                **super().default_params()}
 
 
 @script_interface_register
@@ -48,21 +48,21 @@ class IntegratorHandle(ScriptInterfaceHelper):
         """
         self.integrator = SteepestDescent(**kwargs)
 
-    def set_vv(self):
+    def set_vv(self, **kwargs):
         """
         Set the integration method to velocity Verlet, which is suitable for
         simulations in the NVT ensemble (:class:`VelocityVerlet`).
 
         """
-        self.integrator = VelocityVerlet()
+        self.integrator = VelocityVerlet(**kwargs)
 
-    def set_nvt(self):
+    def set_nvt(self, **kwargs):
         """
         Set the integration method to velocity Verlet, which is suitable for
         simulations in the NVT ensemble (:class:`VelocityVerlet`).
 
         """
-        self.integrator = VelocityVerlet()
+        self.integrator = VelocityVerlet(**kwargs)
 
     def set_isotropic_npt(self, **kwargs):
         """
@@ -175,6 +175,16 @@ class VelocityVerlet(Integrator):
     """
     Velocity Verlet integrator, suitable for simulations in the NVT ensemble.
 
+    Parameters
+    ----------
+    long_range_steps : :obj:`int`, optional
+        Number of time steps between two evaluations of the long-range
+        forces, e.g. the k-space part of P3M. Values larger than 1 enable
+        multiple time stepping, see :ref:`Multiple time stepping`.
+        The particle forces then contain the multiplied long-range forces
+        after an evaluation step and no long-range forces otherwise.
+        Default is 1.
+
     """
     _so_name = "Integrators::VelocityVerlet"
     _so_creation_policy = "GLOBAL"
@@ -339,6 +339,9 @@ class TabulatedNonBonded(NonBondedInteraction):
             The energy table.
         force: array_like of :obj:`float`
             The force table.
+        interpolation : :obj:`str`, {'linear', 'cubic'}, optional
+            Interpolation scheme of the tables, either linear or
+            by cubic splines (default: ``'linear'``).
 
     """
 
@@ -349,7 +352,7 @@ class TabulatedNonBonded(NonBondedInteraction):
         """Python dictionary of default parameters.
 
         """
-        return {}
+        return {"interpolation": "linear"}
 
     @property
     def cutoff(self):
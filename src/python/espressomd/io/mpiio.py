@@ -32,7 +32,7 @@ class Mpiio(ScriptInterfaceHelper):
     _so_creation_policy = "GLOBAL"
 
     def write(self, prefix=None, positions=False, velocities=False,
-              types=False, bonds=False):
+              types=False, bonds=False, particles=False):
         """MPI-IO write.
 
         Outputs binary data using MPI-IO to several files starting with prefix.
@@ -46,6 +46,9 @@ class Mpiio(ScriptInterfaceHelper):
         - typ: Type information (if dumped): 1 int per particle,
         - bond: Bond information (if dumped): variable amount of data,
         - boff: Bond offset information (if bonds are dumped): 1 int per particle.
+        - part: Full particle state (if dumped): variable amount of data,
+        - poff: Particle state offset information (if the particle state
+          is dumped): 1 int per process.
 
         .. note::
             Do not read the files on a machine with a different architecture!
@@ -62,6 +65,12 @@ class Mpiio(ScriptInterfaceHelper):
             Indicates if types should be dumped.
         bonds : :obj:`bool`, optional
             Indicates if bonds should be dumped.
+        particles : :obj:`bool`, optional
+            Indicates if the full particle state should be dumped, i.e.
+            all particle properties, bonds and exclusions. This can be used
+            to restart large simulations, since each process writes and
+            reads the data of its own particles. The files can only be read
+            by a build of |es| with the same features.
 
         Raises
         ------
@@ -72,14 +81,15 @@ class Mpiio(ScriptInterfaceHelper):
         if prefix is None:
             raise ValueError(
                 "Need to supply output prefix via the 'prefix' argument.")
-        if not positions and not velocities and not types and not bonds:
+        if not (positions or velocities or types or bonds or particles):
             raise ValueError("No output fields chosen.")
 
         self.call_method(
-            "write", prefix=prefix, pos=positions, vel=velocities, typ=types, bond=bonds)
+            "write", prefix=prefix, pos=positions, vel=velocities, typ=types,
+            bond=bonds, particles=particles)
 
     def read(self, prefix=None, positions=False, velocities=False,
-             types=False, bonds=False):
+             types=False, bonds=False, particles=False):
         """MPI-IO read.
 
         This function reads data dumped by :meth`write`. See the :meth`write`
@@ -93,8 +103,9 @@ class Mpiio(ScriptInterfaceHelper):
         if prefix is None:
             raise ValueError(
                 "Need to supply output prefix via the 'prefix' argument.")
-        if not positions and not velocities and not types and not bonds:
+        if not (positions or velocities or types or bonds or particles):
             raise ValueError("No output fields chosen.")
 
         self.call_method(
-            "read", prefix=prefix, pos=positions, vel=velocities, typ=types, bond=bonds)
+            "read", prefix=prefix, pos=positions, vel=velocities, typ=types,
+            bond=bonds, particles=particles)
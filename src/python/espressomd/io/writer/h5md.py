@@ -77,6 +77,11 @@ class H5md(ScriptInterfaceHelper):
         list of valid fields. This list defines the H5MD specifications.
         If the file in ``file_path`` already exists but has different
         specifications, an exception is raised.
+    buffer_size : :obj:`int`, optional
+        Number of frames to keep in memory before they are written to
+        the file in one go. Defaults to 1, i.e. every frame is written
+        immediately. Buffered frames are written by :meth:`flush()` and
+        :meth:`close()`.
 
     Methods
     -------
@@ -90,10 +95,10 @@ class H5md(ScriptInterfaceHelper):
         Call the H5md write method.
 
     flush()
-        Call the H5md flush method.
+        Write the buffered frames and flush the file to disk.
 
     close()
-        Close the H5md file.
+        Write the buffered frames and close the H5md file.
 
     Attributes
     ----------
@@ -109,6 +114,8 @@ class H5md(ScriptInterfaceHelper):
     force_unit: :obj:`str`
     velocity_unit: :obj:`str`
     charge_unit: :obj:`str`
+    buffer_size: :obj:`int`
+        Number of frames to keep in memory before they are written.
 
     """
     _so_name = "ScriptInterface::Writer::H5md"
@@ -142,17 +149,18 @@ class H5md(ScriptInterfaceHelper):
             time_unit=unit_system.time,
             force_unit=unit_system.force,
             velocity_unit=unit_system.velocity,
-            charge_unit=unit_system.charge
+            charge_unit=unit_system.charge,
+            buffer_size=params["buffer_size"]
         )
 
     def default_params(self):
-        return {"unit_system": UnitSystem(), "fields": "all"}
+        return {"unit_system": UnitSystem(), "fields": "all", "buffer_size": 1}
 
     def required_keys(self):
         return {"file_path"}
 
     def valid_keys(self):
-        return {"file_path", "unit_system", "fields"}
+        return {"file_path", "unit_system", "fields", "buffer_size"}
 
     def validate_params(self, params):
         """Check validity of given parameters.
@@ -162,3 +170,6 @@ class H5md(ScriptInterfaceHelper):
         for item in params["fields"]:
             utils.check_type_or_throw_except(
                 item, 1, str, "'fields' should be a string or a list of strings")
+        utils.check_type_or_throw_except(
+            params["buffer_size"], 1, int,
+            "'buffer_size' should be an integer")
@@ -190,6 +190,27 @@ class LBFluidWalberla(HydrodynamicInteraction,
         binary : :obj:`bool`
             Whether to read in binary or ASCII mode.
 
+    save_checkpoint_mpiio()
+        Write LB node populations and boundary conditions with MPI-IO.
+        Each MPI rank writes the nodes of its local domain as one slab
+        of the file ``<prefix>.data``, the slab sizes are written to
+        ``<prefix>.doff``. The files can only be read on the same number
+        of MPI ranks.
+
+        Parameters
+        ----------
+        prefix : :obj:`str`
+            Common prefix for the filenames. The files must not exist.
+
+    load_checkpoint_mpiio()
+        Load LB node populations and boundary conditions written by
+        ``save_checkpoint_mpiio()``.
+
+        Parameters
+        ----------
+        prefix : :obj:`str`
+            Common prefix for the filenames.
+
     add_vtk_writer()
         Attach a VTK writer.
 
@@ -83,6 +83,14 @@ class ReactionAlgorithm(ScriptInterfaceHelper):
         ``"parallel"`` method is faster. The ``"parallel"`` method is not
         recommended for simulations on 1 MPI rank, since it comes with the
         overhead of a ghost particle update.
+    energy_algorithm : :obj:`str`
+        Potential energy algorithm. Default is ``"full"``, which evaluates
+        the energy of the whole system before and after each move. The
+        ``"local"`` method only evaluates the interactions of the particles
+        changed by the move, which is much faster for large systems. It falls
+        back to the full energy for interactions without a local energy
+        difference: constraints, magnetostatics, ICC, ELC, and P3M on the
+        GPU or with non-metallic boundary conditions.
 
     Methods
     -------
@@ -229,6 +237,32 @@ class ReactionAlgorithm(ScriptInterfaceHelper):
         :obj:`bool`
             Whether all moves were accepted.
 
+    displacement_mc_sweep_for_particles_of_type()
+        Performs one displacement Monte Carlo move for each particle of a
+        given type, in parallel on all MPI ranks. Each particle is displaced
+        by a random vector drawn uniformly from a cube and its velocity is
+        not changed. Each move is accepted or rejected individually.
+
+        The moves are carried out cell by cell in a checkerboard pattern,
+        such that particles which are moved at the same time cannot
+        interact. This requires the regular decomposition cell system,
+        short-range interactions and particles without bonds.
+        The displacement must be smaller than half the difference between
+        the cell size and the interaction range, which can be achieved by
+        increasing the Verlet skin.
+
+        Parameters
+        ----------
+        type_mc : :obj:`int`
+            Particle type which should be moved
+        max_displacement : :obj:`float`
+            Maximal displacement in each direction.
+
+        Returns
+        -------
+        :obj:`int`
+            Number of accepted moves.
+
     delete_particle()
         Deletes the particle of the given p_id and makes sure that the particle
         range has no holes. This function has some restrictions, as e.g. bonds
@@ -269,6 +303,7 @@ class ReactionAlgorithm(ScriptInterfaceHelper):
                         "set_non_interacting_type",
                         "get_non_interacting_type",
                         "displacement_mc_move_for_particles_of_type",
+                        "displacement_mc_sweep_for_particles_of_type",
                         "change_reaction_constant",
                         "delete_particle",
                         )
@@ -286,8 +321,8 @@ class ReactionAlgorithm(ScriptInterfaceHelper):
         self._rebuild_reaction_cache()
 
     def valid_keys(self):
-        return {"kT", "exclusion_range", "seed",
-                "exclusion_radius_per_type", "search_algorithm"}
+        return {"kT", "exclusion_range", "seed", "exclusion_radius_per_type",
+                "search_algorithm", "energy_algorithm"}
 
     def required_keys(self):
         return {"kT", "exclusion_range", "seed"}
@@ -541,7 +576,8 @@ class ConstantpHEnsemble(ReactionAlgorithm):
 
     def valid_keys(self):
         return {"kT", "exclusion_range", "seed",
-                "constant_pH", "exclusion_radius_per_type", "search_algorithm"}
+                "constant_pH", "exclusion_radius_per_type", "search_algorithm",
+                "energy_algorithm"}
 
     def required_keys(self):
         return {"kT", "exclusion_range", "seed", "constant_pH"}
@@ -622,7 +658,7 @@ class WidomInsertion(ReactionAlgorithm):
         return {"kT", "seed"}
 
     def valid_keys(self):
-        return {"kT", "seed"}
+        return {"kT", "seed", "energy_algorithm"}
 
     def add_reaction(self, **kwargs):
         kwargs['gamma'] = 1.
@@ -656,6 +692,32 @@ class WidomInsertion(ReactionAlgorithm):
         return self.call_method(
             "calculate_particle_insertion_potential_energy", **kwargs)
 
+    def calculate_particle_insertion_boltzmann_factor(self, **kwargs):
+        """
+        Measures the average Boltzmann factor of many particle insertions
+        following the reaction provided in ``reaction_id``. Insertions of a
+        single particle are evaluated in parallel as test particles, which
+        are never added to the system. Other insertions are carried out one
+        after the other like in
+        :meth:`calculate_particle_insertion_potential_energy`.
+
+        Parameters
+        ----------
+        reaction_id : :obj:`int`
+            Reaction identifier.
+        n_insertions : :obj:`int`
+            Number of insertions.
+
+        Returns
+        -------
+        :obj:`float`
+            The average of the Boltzmann factor
+            :math:`\\exp(-\\Delta E_{\\mathrm{pot}} / k_B T)`.
+
+        """
+        return self.call_method(
+            "calculate_particle_insertion_boltzmann_factor", **kwargs)
+
     def calculate_excess_chemical_potential(self, **kwargs):
         """
         Given a set of samples of the particle insertion potential energy,
@@ -665,6 +727,9 @@ class WidomInsertion(ReactionAlgorithm):
         ----------
         particle_insertion_potential_energy_samples : array_like of :obj:`float`
             Samples of the particle insertion potential energy.
+        boltzmann_factor_samples : array_like of :obj:`float`
+            Samples of the average Boltzmann factor, as an alternative
+            to ``particle_insertion_potential_energy_samples``.
         N_blocks : :obj:`int`, optional
             Number of bins for binning analysis.
 
@@ -697,8 +762,11 @@ class WidomInsertion(ReactionAlgorithm):
 
         kT = self.kT
 
-        gamma_samples = np.exp(-1.0 * np.array(
-            kwargs["particle_insertion_potential_energy_samples"]) / kT)
+        if "boltzmann_factor_samples" in kwargs:
+            gamma_samples = np.array(kwargs["boltzmann_factor_samples"])
+        else:
+            gamma_samples = np.exp(-1.0 * np.array(
+                kwargs["particle_insertion_potential_energy_samples"]) / kT)
 
         gamma_mean, gamma_std = do_block_analysis(
             samples=gamma_samples, N_blocks=kwargs.get("N_blocks", 16))
@@ -82,6 +82,11 @@ CellSystem::CellSystem() {
          get_cell_structure().use_verlet_list = get_value<bool>(v);
        },
        [this]() { return get_cell_structure().use_verlet_list; }},
+      {"overlap_ghost_communication",
+       [this](Variant const &v) {
+         get_cell_structure().overlap_ghost_communication = get_value<bool>(v);
+       },
+       [this]() { return get_cell_structure().overlap_ghost_communication; }},
       {"node_grid",
        [this](Variant const &v) {
          context()->parallel_try_catch([this, &v]() {
@@ -119,6 +124,19 @@ CellSystem::CellSystem() {
          get_cell_structure().set_verlet_skin(new_skin);
        },
        [this]() { return get_cell_structure().get_verlet_skin(); }},
+      {"particle_sort_interval",
+       [this](Variant const &v) {
+         auto const interval = get_value<int>(v);
+         if (interval < 0) {
+           if (context()->is_head_node()) {
+             throw std::domain_error(
+                 "Parameter 'particle_sort_interval' must be >= 0");
+           }
+           throw Exception("");
+         }
+         get_cell_structure().set_particle_sort_interval(interval);
+       },
+       [this]() { return get_cell_structure().get_particle_sort_interval(); }},
       {"decomposition_type", AutoParameter::read_only,
        [this]() {
          return cs_type_to_name.at(get_cell_structure().decomposition_type());
@@ -195,6 +213,14 @@ Variant CellSystem::do_call_method(std::string const &name,
               {"n_square", hd.count_particles_in_n_square()}}};
     }
     state["verlet_reuse"] = get_cell_structure().get_verlet_reuse();
+    state["verlet_skin_tuning"] =
+        get_cell_structure().is_verlet_skin_tuning();
+    state["load_balancing"] = get_cell_structure().is_load_balancing();
+    if (auto const boundaries = get_cell_structure().get_domain_boundaries()) {
+      state["domain_boundaries"] =
+          Variant{std::vector<Variant>{(*boundaries)[0], (*boundaries)[1],
+                                       (*boundaries)[2]}};
+    }
     state["n_nodes"] = context()->get_comm().size();
     return state;
   }
@@ -272,6 +298,26 @@ Variant CellSystem::do_call_method(std::string const &name,
         get_value_or<bool>(params, "adjust_max_skin", false));
     return get_cell_structure().get_verlet_skin();
   }
+  if (name == "tune_skin_online") {
+    context()->parallel_try_catch([this, &params]() {
+      get_cell_structure().start_verlet_skin_tuning(
+          get_value<double>(params, "tol"), get_value<int>(params, "int_steps"),
+          get_value_or<bool>(params, "verbose", false));
+    });
+    return get_cell_structure().get_verlet_skin();
+  }
+  if (name == "start_load_balancing") {
+    context()->parallel_try_catch([this, &params]() {
+      get_cell_structure().start_load_balancing(
+          get_value<int>(params, "interval"),
+          get_value_or<bool>(params, "verbose", false));
+    });
+    return {};
+  }
+  if (name == "stop_load_balancing") {
+    get_cell_structure().stop_load_balancing();
+    return {};
+  }
   if (name == "get_max_range") {
     return get_cell_structure().max_range();
   }
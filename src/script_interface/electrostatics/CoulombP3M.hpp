@@ -28,6 +28,7 @@
 #include "core/electrostatics/p3m.hpp"
 #include "core/electrostatics/p3m.impl.hpp"
 #include "core/p3m/FFTBackendLegacy.hpp"
+#include "core/p3m/FFTBackendPencil.hpp"
 #include "core/p3m/FFTBuffersLegacy.hpp"
 
 #include "script_interface/get_value.hpp"
@@ -51,6 +52,7 @@ class CoulombP3M : public Actor<CoulombP3M<Architecture>, ::CoulombP3M> {
   bool m_tune_verbose;
   bool m_check_complex_residuals;
   bool m_single_precision;
+  std::string m_fft_backend;
 
 public:
   using Base = Actor<CoulombP3M<Architecture>, ::CoulombP3M>;
@@ -96,6 +98,8 @@ public:
         {"tune", AutoParameter::read_only, [this]() { return m_tune; }},
         {"check_complex_residuals", AutoParameter::read_only,
          [this]() { return m_check_complex_residuals; }},
+        {"fft_backend", AutoParameter::read_only,
+         [this]() { return m_fft_backend; }},
     });
   }
 
@@ -106,7 +110,13 @@ public:
     m_check_complex_residuals =
         get_value<bool>(params, "check_complex_residuals");
     auto const single_precision = get_value<bool>(params, "single_precision");
+    m_fft_backend =
+        get_value_or<std::string>(params, "fft_backend", std::string("legacy"));
     context()->parallel_try_catch([&]() {
+      if (m_fft_backend != "legacy" and m_fft_backend != "pencil") {
+        throw std::invalid_argument("Unknown FFT backend '" + m_fft_backend +
+                                    "'");
+      }
       if (Architecture == Arch::GPU and not single_precision) {
         throw std::invalid_argument(
             "P3M GPU only implemented in single-precision mode");
@@ -129,8 +139,13 @@ public:
 private:
   template <typename FloatType, class... Args>
   void make_handle_impl(Args &&...args) {
-    m_actor = new_p3m_handle<FloatType, Architecture, FFTBackendLegacy,
-                             FFTBuffersLegacy>(std::forward<Args>(args)...);
+    if (m_fft_backend == "pencil") {
+      m_actor = new_p3m_handle<FloatType, Architecture, FFTBackendPencil,
+                               FFTBuffersLegacy>(std::forward<Args>(args)...);
+    } else {
+      m_actor = new_p3m_handle<FloatType, Architecture, FFTBackendLegacy,
+                               FFTBuffersLegacy>(std::forward<Args>(args)...);
+    }
   }
   template <class... Args>
   void make_handle(bool single_precision, Args &&...args) {
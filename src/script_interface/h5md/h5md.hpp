@@ -52,7 +52,8 @@ public:
          {"time_unit", m_h5md, &::Writer::H5md::File::time_unit},
          {"force_unit", m_h5md, &::Writer::H5md::File::force_unit},
          {"velocity_unit", m_h5md, &::Writer::H5md::File::velocity_unit},
-         {"charge_unit", m_h5md, &::Writer::H5md::File::charge_unit}});
+         {"charge_unit", m_h5md, &::Writer::H5md::File::charge_unit},
+         {"buffer_size", m_h5md, &::Writer::H5md::File::buffer_size}});
   };
 
 private:
@@ -64,10 +65,10 @@ private:
     m_h5md = make_shared_from_args<::Writer::H5md::File, std::string,
                                    std::string, std::vector<std::string>,
                                    std::string, std::string, std::string,
-                                   std::string, std::string, std::string>(
+                                   std::string, std::string, std::string, int>(
         params, "file_path", "script_path", "fields", "mass_unit",
         "length_unit", "time_unit", "force_unit", "velocity_unit",
-        "charge_unit");
+        "charge_unit", "buffer_size");
     // MPI communicator is needed to close parallel file handles
     m_mpi_env_lock = ::Communication::mpiCallbacksHandle()->share_mpi_env();
   }
@@ -24,11 +24,31 @@
 #include "core/PropagationMode.hpp"
 #include "core/integrators/Propagation.hpp"
 
+#include <stdexcept>
+
 namespace ScriptInterface {
 namespace Integrators {
 
+VelocityVerlet::VelocityVerlet() {
+  add_parameters({
+      {"long_range_steps", AutoParameter::read_only,
+       [this]() { return m_long_range_steps; }},
+  });
+}
+
+void VelocityVerlet::do_construct(VariantMap const &params) {
+  m_long_range_steps = get_value_or<int>(params, "long_range_steps", 1);
+  context()->parallel_try_catch([&]() {
+    if (m_long_range_steps < 1) {
+      throw std::domain_error("Parameter 'long_range_steps' must be >= 1");
+    }
+  });
+}
+
 void VelocityVerlet::activate() {
-  get_system().propagation->set_integ_switch(INTEG_METHOD_NVT);
+  auto &propagation = *get_system().propagation;
+  propagation.set_integ_switch(INTEG_METHOD_NVT);
+  propagation.long_range_steps = m_long_range_steps;
 }
 
 } // namespace Integrators
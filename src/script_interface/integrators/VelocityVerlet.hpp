@@ -28,6 +28,12 @@ namespace ScriptInterface {
 namespace Integrators {
 
 class VelocityVerlet : public AutoParameters<VelocityVerlet, Integrator> {
+  int m_long_range_steps = 1;
+
+public:
+  VelocityVerlet();
+
+  void do_construct(VariantMap const &params) override;
   void activate() override;
 };
 
@@ -576,6 +576,13 @@ public:
         make_autoparameter(&CoreInteraction::maxval, "max"),
         make_autoparameter(&CoreInteraction::force_tab, "force"),
         make_autoparameter(&CoreInteraction::energy_tab, "energy"),
+        {"interpolation", AutoParameter::read_only,
+         [this]() {
+           return std::string(m_handle.get()->interpolation ==
+                                      CoreInteraction::Interpolation::CUBIC
+                                  ? "cubic"
+                                  : "linear");
+         }},
     });
   }
 
@@ -583,9 +590,19 @@ private:
   std::string inactive_parameter() const override { return "max"; }
 
   void make_new_instance(VariantMap const &params) override {
-    m_handle = make_shared_from_args<CoreInteraction, double, double,
-                                     std::vector<double>, std::vector<double>>(
-        params, "min", "max", "force", "energy");
+    auto const name = get_value<std::string>(params, "interpolation");
+    if (name != "linear" and name != "cubic") {
+      throw std::invalid_argument(
+          "TabulatedPotential parameter 'interpolation' must be 'linear' or "
+          "'cubic'");
+    }
+    auto const interpolation = (name == "cubic")
+                                   ? CoreInteraction::Interpolation::CUBIC
+                                   : CoreInteraction::Interpolation::LINEAR;
+    m_handle = std::make_shared<CoreInteraction>(
+        get_value<double>(params, "min"), get_value<double>(params, "max"),
+        get_value<std::vector<double>>(params, "force"),
+        get_value<std::vector<double>>(params, "energy"), interpolation);
   }
 
 public:
@@ -55,11 +55,13 @@ public:
     auto vel = get_value<bool>(parameters.at("vel"));
     auto typ = get_value<bool>(parameters.at("typ"));
     auto bnd = get_value<bool>(parameters.at("bond"));
+    auto prt = get_value<bool>(parameters.at("particles"));
 
     auto const fields = ((pos) ? Mpiio::MPIIO_OUT_POS : Mpiio::MPIIO_OUT_NON) |
                         ((vel) ? Mpiio::MPIIO_OUT_VEL : Mpiio::MPIIO_OUT_NON) |
                         ((typ) ? Mpiio::MPIIO_OUT_TYP : Mpiio::MPIIO_OUT_NON) |
-                        ((bnd) ? Mpiio::MPIIO_OUT_BND : Mpiio::MPIIO_OUT_NON);
+                        ((bnd) ? Mpiio::MPIIO_OUT_BND : Mpiio::MPIIO_OUT_NON) |
+                        ((prt) ? Mpiio::MPIIO_OUT_PRT : Mpiio::MPIIO_OUT_NON);
 
     if (name == "write") {
       auto const system_si = m_system.lock();
@@ -74,6 +76,7 @@ public:
       auto &system = system_si->get_system();
       auto &cell_structure = *system.cell_structure;
       Mpiio::mpi_mpiio_common_read(prefix, fields, cell_structure);
+      system.on_particle_change();
     }
 
     return {};
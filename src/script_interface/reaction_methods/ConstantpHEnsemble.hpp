@@ -67,6 +67,9 @@ public:
     do_set_parameter("search_algorithm",
                      Variant{get_value_or<std::string>(
                          params, "search_algorithm", "order_n")});
+    do_set_parameter("energy_algorithm",
+                     Variant{get_value_or<std::string>(
+                         params, "energy_algorithm", "full")});
   }
 
 protected:
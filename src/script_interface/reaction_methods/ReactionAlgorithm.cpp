@@ -78,6 +78,26 @@ ReactionAlgorithm::ReactionAlgorithm() {
           }
           return std::string("parallel");
         }},
+       {"energy_algorithm",
+        [this](Variant const &v) {
+          context()->parallel_try_catch([&]() {
+            auto const key = get_value<std::string>(v);
+            if (key == "full") {
+              RE()->local_energy_updates = false;
+            } else if (key == "local") {
+              RE()->local_energy_updates = true;
+            } else {
+              throw std::invalid_argument("Unknown energy algorithm '" + key +
+                                          "'");
+            }
+          });
+        },
+        [this]() {
+          if (RE()->local_energy_updates) {
+            return std::string("local");
+          }
+          return std::string("full");
+        }},
        {"particle_inside_exclusion_range_touched",
         [this](Variant const &v) {
           RE()->particle_inside_exclusion_range_touched = get_value<bool>(v);
@@ -195,6 +215,15 @@ Variant ReactionAlgorithm::do_call_method(std::string const &name,
       result = RE()->make_displacement_mc_move_attempt(type, n_particles);
     });
     return result;
+  } else if (name == "displacement_mc_sweep_for_particles_of_type") {
+    auto const type = get_value<int>(params, "type_mc");
+    auto const max_displacement = get_value<double>(params, "max_displacement");
+    auto result = 0;
+    context()->parallel_try_catch([&]() {
+      result =
+          RE()->make_parallel_displacement_mc_sweep(type, max_displacement);
+    });
+    return result;
   } else if (name == "delete_particle") {
     context()->parallel_try_catch(
         [&]() { RE()->delete_particle(get_value<int>(params, "p_id")); });
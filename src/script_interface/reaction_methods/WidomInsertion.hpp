@@ -62,6 +62,9 @@ public:
           get_value<double>(params, "kT"), 0.,
           std::unordered_map<int, double>{});
     });
+    do_set_parameter("energy_algorithm",
+                     Variant{get_value_or<std::string>(
+                         params, "energy_algorithm", "full")});
   }
 
   Variant do_call_method(std::string const &name,
@@ -75,6 +78,16 @@ public:
       });
       return result;
     }
+    if (name == "calculate_particle_insertion_boltzmann_factor") {
+      Variant result;
+      context()->parallel_try_catch([&]() {
+        auto const reaction_id = get_value<int>(params, "reaction_id");
+        auto const index = get_reaction_index(reaction_id);
+        result = m_re->calculate_particle_insertion_boltzmann_factor(
+            index, get_value<int>(params, "n_insertions"));
+      });
+      return result;
+    }
     return ReactionAlgorithm::do_call_method(name, params);
   }
 
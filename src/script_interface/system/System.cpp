@@ -126,7 +126,9 @@ struct System::Leaves {
   std::shared_ptr<Particles::ParticleList> part;
 };
 
-System::System() : m_instance{}, m_leaves{std::make_shared<Leaves>()} {
+System::System()
+    : m_instance{}, m_leaves{std::make_shared<Leaves>()},
+      m_serialize_particles{true} {
   auto const add_parameter =
       [this, ptr = m_leaves.get()](std::string key, auto(Leaves::*member)) {
         add_parameters({AutoParameter(
@@ -463,6 +465,10 @@ Variant System::do_call_method(std::string const &name,
     }
     return {};
   }
+  if (name == "internal_set_serialize_particles") {
+    m_serialize_particles = get_value<bool>(parameters, "value");
+    return {};
+  }
   if (name == "internal_attach_leaves") {
     m_leaves->part->attach(m_leaves->cell_system,
                            m_leaves->bonded_interactions);
@@ -479,8 +485,12 @@ Variant System::do_call_method(std::string const &name,
  * Particles need to be serialized here to reduce overhead,
  * and also to guarantee particles get instantiated after the cell structure
  * was instantiated (since they store a weak pointer to it).
+ * Particles are skipped when they are written separately with MPI-IO.
  */
 std::string System::get_internal_state() const {
+  if (not m_serialize_particles) {
+    return Utils::pack(std::vector<std::string>{});
+  }
   auto const p_ids = get_particle_ids();
   std::vector<std::string> object_states(p_ids.size());
 
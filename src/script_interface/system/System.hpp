@@ -39,6 +39,8 @@ class System : public AutoParameters<System> {
   struct Leaves;
   std::shared_ptr<::System::System> m_instance;
   std::shared_ptr<Leaves> m_leaves;
+  /** Whether the internal state contains the particles. */
+  bool m_serialize_particles;
 
 public:
   System();
@@ -48,6 +50,7 @@ public:
                          VariantMap const &parameters) override;
 
   auto const &get_system() const { return *m_instance; }
+  auto &get_system() { return *m_instance; }
 
 private:
   template <typename LeafType>
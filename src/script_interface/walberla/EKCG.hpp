@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "config/config.hpp"
+
+#ifdef WALBERLA
+
+#include "EKPoissonSolver.hpp"
+#include "LatticeWalberla.hpp"
+
+#include <walberla_bridge/electrokinetics/PoissonSolver/CGSolver.hpp>
+#include <walberla_bridge/electrokinetics/ek_poisson_cg_init.hpp>
+
+#include <script_interface/ScriptInterface.hpp>
+#include <script_interface/auto_parameters/AutoParameters.hpp>
+
+#include <utils/math/int_pow.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ScriptInterface::walberla {
+
+class EKCG : public EKPoissonSolver {
+  std::shared_ptr<::walberla::CGSolver> m_instance;
+  std::shared_ptr<LatticeWalberla> m_lattice;
+  double m_conv_permittivity;
+  double m_conv_potential;
+  bool m_single_precision;
+
+  void check_tolerance(double tolerance) const {
+    if (tolerance <= 0.) {
+      throw std::domain_error("Parameter 'tolerance' must be > 0");
+    }
+  }
+
+  void check_max_iterations(int max_iterations) const {
+    if (max_iterations <= 0) {
+      throw std::domain_error("Parameter 'max_iterations' must be > 0");
+    }
+  }
+
+public:
+  void do_construct(VariantMap const &args) override {
+    m_single_precision = get_value_or<bool>(args, "single_precision", false);
+    m_lattice = get_value<decltype(m_lattice)>(args, "lattice");
+    auto const tolerance = get_value_or<double>(args, "tolerance", 1e-6);
+    auto const max_iterations = get_value_or<int>(args, "max_iterations", 1000);
+    context()->parallel_try_catch([&]() {
+      check_tolerance(tolerance);
+      check_max_iterations(max_iterations);
+    });
+
+    // unit conversions
+    auto const agrid = get_value<double>(m_lattice->get_parameter("agrid"));
+    m_conv_permittivity = Utils::int_pow<2>(agrid);
+    m_conv_potential = 1. / agrid;
+    auto const permittivity =
+        get_value<double>(args, "permittivity") * m_conv_permittivity;
+
+    m_instance = ::walberla::new_ek_poisson_cg(
+        m_lattice->lattice(), permittivity, tolerance, max_iterations,
+        m_single_precision);
+  }
+
+  EKCG() {
+    add_parameters({
+        {"permittivity",
+         [this](Variant const &v) {
+           m_instance->set_permittivity(get_value<double>(v) *
+                                        m_conv_permittivity);
+         },
+         [this]() {
+           return m_instance->get_permittivity() / m_conv_permittivity;
+         }},
+        {"tolerance",
+         [this](Variant const &v) {
+           auto const tolerance = get_value<double>(v);
+           context()->parallel_try_catch(
+               [&]() { check_tolerance(tolerance); });
+           m_instance->set_tolerance(tolerance);
+         },
+         [this]() { return m_instance->get_tolerance(); }},
+        {"max_iterations",
+         [this](Variant const &v) {
+           auto const max_iterations = get_value<int>(v);
+           context()->parallel_try_catch(
+               [&]() { check_max_iterations(max_iterations); });
+           m_instance->set_max_iterations(max_iterations);
+         },
+         [this]() { return m_instance->get_max_iterations(); }},
+        {"iterations", AutoParameter::read_only,
+         [this]() { return m_instance->get_iterations(); }},
+        {"residual", AutoParameter::read_only,
+         [this]() { return m_instance->get_residual(); }},
+        {"single_precision", AutoParameter::read_only,
+         [this]() { return m_single_precision; }},
+        {"lattice", AutoParameter::read_only, [this]() { return m_lattice; }},
+    });
+  }
+
+  [[nodiscard]] std::shared_ptr<::walberla::PoissonSolver>
+  get_instance() const noexcept override {
+    return m_instance;
+  }
+
+protected:
+  Variant do_call_method(std::string const &method,
+                         VariantMap const &parameters) override {
+    if (method == "update_dirichlet_boundary_from_shape") {
+      auto values = get_value<std::vector<double>>(parameters, "values");
+      std::ranges::transform(values, values.begin(),
+                             [this](double v) { return v * m_conv_potential; });
+      m_instance->set_dirichlet_boundary_from_grid(
+          get_value<std::vector<int>>(parameters, "raster"), values);
+      return {};
+    }
+    if (method == "update_neumann_boundary_from_shape") {
+      m_instance->set_neumann_boundary_from_grid(
+          get_value<std::vector<int>>(parameters, "raster"));
+      return {};
+    }
+    if (method == "update_permittivity_from_shape") {
+      auto const values = get_value<std::vector<double>>(parameters, "values");
+      context()->parallel_try_catch([&values]() {
+        if (std::ranges::any_of(values, [](double v) { return v <= 0.; })) {
+          throw std::domain_error(
+              "Parameter 'relative_permittivity' must be > 0");
+        }
+      });
+      m_instance->set_relative_permittivity_from_grid(
+          get_value<std::vector<int>>(parameters, "raster"), values);
+      return {};
+    }
+    if (method == "clear_boundaries") {
+      m_instance->clear_boundaries();
+      return {};
+    }
+    return EKPoissonSolver::do_call_method(method, parameters);
+  }
+};
+
+} // namespace ScriptInterface::walberla
+
+#endif // WALBERLA
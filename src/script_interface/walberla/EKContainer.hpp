@@ -23,6 +23,7 @@
 
 #ifdef WALBERLA
 
+#include "EKCG.hpp"
 #include "EKFFT.hpp"
 #include "EKNone.hpp"
 #include "EKReactions.hpp"
@@ -53,7 +54,7 @@ class EKContainer : public ObjectList<EKSpecies> {
 #ifdef WALBERLA_FFT
       std::shared_ptr<EKFFT>,
 #endif
-      std::shared_ptr<EKNone>>
+      std::shared_ptr<EKCG>, std::shared_ptr<EKNone>>
       m_poisson_solver;
 
   std::shared_ptr<EKReactions> m_ek_reactions;
@@ -102,6 +103,9 @@ class EKContainer : public ObjectList<EKSpecies> {
       solver = std::move(ptr);
     }
 #endif
+    else if (auto ptr = std::dynamic_pointer_cast<EKCG>(so_ptr)) {
+      solver = std::move(ptr);
+    }
     assert(solver.has_value());
     return *solver;
   }
@@ -26,12 +26,15 @@
 
 #include <walberla_bridge/electrokinetics/ek_walberla_init.hpp>
 
+#include <utils/Vector.hpp>
+
 #include <boost/mpi.hpp>
 #include <boost/mpi/collectives/all_reduce.hpp>
 #include <boost/mpi/collectives/broadcast.hpp>
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -85,6 +88,14 @@ Variant EKSpecies::do_call_method(std::string const &method,
     load_checkpoint(path, mode);
     return {};
   }
+  if (method == "save_checkpoint_mpiio") {
+    save_checkpoint_mpiio(get_value<std::string>(parameters, "prefix"));
+    return {};
+  }
+  if (method == "load_checkpoint_mpiio") {
+    load_checkpoint_mpiio(get_value<std::string>(parameters, "prefix"));
+    return {};
+  }
   return Base::do_call_method(method, parameters);
 }
 
@@ -303,6 +314,56 @@ void EKSpecies::save_checkpoint(std::string const &filename, int mode) {
                          write_data, on_failure);
 }
 
+void EKSpecies::load_checkpoint_mpiio(std::string const &prefix) {
+  auto &ek_obj = *m_instance;
+
+  auto const read_data = [&ek_obj](CheckpointSlab &slab,
+                                   Utils::Vector3i const &lower_corner,
+                                   Utils::Vector3i const &upper_corner) {
+    auto const n_nodes =
+        static_cast<std::size_t>(Utils::product(upper_corner - lower_corner));
+    std::vector<double> density(n_nodes);
+    std::vector<std::optional<double>> density_boundary(n_nodes);
+    std::vector<std::optional<Utils::Vector3d>> flux_boundary(n_nodes);
+    slab.read(density);
+    for (auto &value : density_boundary) {
+      slab.read(value);
+    }
+    for (auto &value : flux_boundary) {
+      slab.read(value);
+    }
+    ek_obj.set_slice_density(lower_corner, upper_corner, density);
+    ek_obj.set_slice_density_boundary(lower_corner, upper_corner,
+                                      density_boundary);
+    ek_obj.set_slice_flux_boundary(lower_corner, upper_corner, flux_boundary);
+  };
+
+  auto const on_success = [&ek_obj]() { ek_obj.ghost_communication(); };
+
+  load_checkpoint_mpiio_common(*context(), "EK", prefix, ek_obj.get_lattice(),
+                               read_data, on_success);
+}
+
+void EKSpecies::save_checkpoint_mpiio(std::string const &prefix) {
+  auto &ek_obj = *m_instance;
+
+  auto const write_data = [&ek_obj](CheckpointSlab &slab,
+                                    Utils::Vector3i const &lower_corner,
+                                    Utils::Vector3i const &upper_corner) {
+    slab.write(ek_obj.get_slice_density(lower_corner, upper_corner));
+    for (auto const &value :
+         ek_obj.get_slice_density_at_boundary(lower_corner, upper_corner)) {
+      slab.write(value);
+    }
+    for (auto const &value :
+         ek_obj.get_slice_flux_at_boundary(lower_corner, upper_corner)) {
+      slab.write(value);
+    }
+  };
+
+  save_checkpoint_mpiio_common(prefix, ek_obj.get_lattice(), write_data);
+}
+
 } // namespace ScriptInterface::walberla
 
 #endif // WALBERLA
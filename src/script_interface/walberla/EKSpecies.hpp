@@ -154,6 +154,8 @@ public:
 private:
   void load_checkpoint(std::string const &filename, int mode);
   void save_checkpoint(std::string const &filename, int mode);
+  void load_checkpoint_mpiio(std::string const &prefix);
+  void save_checkpoint_mpiio(std::string const &prefix);
 };
 
 class EKVTKHandle : public VTKHandleBase<::EKinWalberlaBase> {
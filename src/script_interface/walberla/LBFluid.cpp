@@ -106,6 +106,14 @@ Variant LBFluid::do_call_method(std::string const &name,
     save_checkpoint(path, mode);
     return {};
   }
+  if (name == "load_checkpoint_mpiio") {
+    load_checkpoint_mpiio(get_value<std::string>(params, "prefix"));
+    return {};
+  }
+  if (name == "save_checkpoint_mpiio") {
+    save_checkpoint_mpiio(get_value<std::string>(params, "prefix"));
+    return {};
+  }
   if (name == "clear_boundaries") {
     m_instance->clear_boundaries();
     ::System::get_system().on_lb_boundary_conditions_change();
@@ -371,6 +379,65 @@ void LBFluid::save_checkpoint(std::string const &filename, int mode) {
                          write_data, on_failure);
 }
 
+void LBFluid::load_checkpoint_mpiio(std::string const &prefix) {
+  auto &lb_obj = *m_instance;
+
+  auto const read_data = [&lb_obj](CheckpointSlab &slab,
+                                   Utils::Vector3i const &lower_corner,
+                                   Utils::Vector3i const &upper_corner) {
+    auto const n_nodes =
+        static_cast<std::size_t>(Utils::product(upper_corner - lower_corner));
+    auto const expected_pop_size = lb_obj.stencil_size();
+    auto read_pop_size = 0.;
+    slab.read(read_pop_size);
+    if (static_cast<std::size_t>(read_pop_size) != expected_pop_size) {
+      throw std::runtime_error(
+          "population size mismatch, read " +
+          std::to_string(static_cast<std::size_t>(read_pop_size)) +
+          ", expected " + std::to_string(expected_pop_size) + ".");
+    }
+    std::vector<double> populations(expected_pop_size * n_nodes);
+    std::vector<double> last_applied_force(3ul * n_nodes);
+    std::vector<std::optional<Utils::Vector3d>> slip_velocity(n_nodes);
+    slab.read(populations);
+    slab.read(last_applied_force);
+    for (auto &value : slip_velocity) {
+      slab.read(value);
+    }
+    lb_obj.set_slice_population(lower_corner, upper_corner, populations);
+    lb_obj.set_slice_last_applied_force(lower_corner, upper_corner,
+                                        last_applied_force);
+    lb_obj.set_slice_velocity_at_boundary(lower_corner, upper_corner,
+                                          slip_velocity);
+  };
+
+  auto const on_success = [&lb_obj]() {
+    lb_obj.ghost_communication();
+    lb_obj.reallocate_ubb_field();
+  };
+
+  load_checkpoint_mpiio_common(*context(), "LB", prefix, lb_obj.get_lattice(),
+                               read_data, on_success);
+}
+
+void LBFluid::save_checkpoint_mpiio(std::string const &prefix) {
+  auto &lb_obj = *m_instance;
+
+  auto const write_data = [&lb_obj](CheckpointSlab &slab,
+                                    Utils::Vector3i const &lower_corner,
+                                    Utils::Vector3i const &upper_corner) {
+    slab.write(static_cast<double>(lb_obj.stencil_size()));
+    slab.write(lb_obj.get_slice_population(lower_corner, upper_corner));
+    slab.write(lb_obj.get_slice_last_applied_force(lower_corner, upper_corner));
+    for (auto const &value :
+         lb_obj.get_slice_velocity_at_boundary(lower_corner, upper_corner)) {
+      slab.write(value);
+    }
+  };
+
+  save_checkpoint_mpiio_common(prefix, lb_obj.get_lattice(), write_data);
+}
+
 } // namespace ScriptInterface::walberla
 
 #endif // WALBERLA
@@ -132,6 +132,8 @@ public:
 private:
   void load_checkpoint(std::string const &filename, int mode);
   void save_checkpoint(std::string const &filename, int mode);
+  void load_checkpoint_mpiio(std::string const &prefix);
+  void save_checkpoint_mpiio(std::string const &prefix);
   std::vector<Variant> get_average_pressure_tensor() const;
   Variant get_interpolated_velocity(Utils::Vector3d const &pos) const;
 };
@@ -25,16 +25,23 @@
 
 #include "script_interface/Context.hpp"
 
+#include "core/io/mpiio/mpiio.hpp"
+
+#include <walberla_bridge/LatticeWalberla.hpp>
+
 #include <utils/Vector.hpp>
 
 #include <boost/mpi/collectives/broadcast.hpp>
 
+#include <cstddef>
 #include <fstream>
 #include <ios>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ScriptInterface::walberla {
@@ -139,6 +146,67 @@ public:
   }
 };
 
+/**
+ * @brief Handle for the local slab of an MPI-IO checkpoint.
+ * Values are stored as doubles. Optional values are stored as a flag
+ * followed by the value, so that every node has a record of fixed size.
+ */
+class CheckpointSlab {
+private:
+  std::vector<double> m_data;
+  std::size_t m_index;
+
+public:
+  CheckpointSlab() : m_data{}, m_index{0ul} {}
+  explicit CheckpointSlab(std::vector<double> data)
+      : m_data{std::move(data)}, m_index{0ul} {}
+
+  auto const &data() const { return m_data; }
+  bool eof() const { return m_index == m_data.size(); }
+
+  void write(double value) { m_data.emplace_back(value); }
+
+  template <std::size_t N> void write(Utils::Vector<double, N> const &vector) {
+    m_data.insert(m_data.end(), vector.begin(), vector.end());
+  }
+
+  void write(std::vector<double> const &vector) {
+    m_data.insert(m_data.end(), vector.begin(), vector.end());
+  }
+
+  template <typename T> void write(std::optional<T> const &value) {
+    write(static_cast<double>(value.has_value()));
+    write(value.value_or(T{}));
+  }
+
+  void read(double &value) {
+    if (eof()) {
+      throw std::runtime_error("EOF found.");
+    }
+    value = m_data[m_index++];
+  }
+
+  template <std::size_t N> void read(Utils::Vector<double, N> &vector) {
+    for (auto &value : vector) {
+      read(value);
+    }
+  }
+
+  void read(std::vector<double> &vector) {
+    for (auto &value : vector) {
+      read(value);
+    }
+  }
+
+  template <typename T> void read(std::optional<T> &value) {
+    auto flag = 0.;
+    auto buffer = T{};
+    read(flag);
+    read(buffer);
+    value = (flag != 0.) ? std::optional<T>{buffer} : std::nullopt;
+  }
+};
+
 template <typename F1, typename F2, typename F3>
 void load_checkpoint_common(Context const &context, std::string const classname,
                             std::string const &filename, int mode,
@@ -245,6 +313,65 @@ void save_checkpoint_common(Context const &context, std::string const classname,
   }
 }
 
+/**
+ * @brief Read a lattice checkpoint with MPI-IO.
+ * Each rank reads the slab of its local domain, which was written by
+ * @ref save_checkpoint_mpiio_common on the same number of MPI ranks.
+ */
+template <typename F1, typename F2>
+void load_checkpoint_mpiio_common(Context const &context,
+                                  std::string const classname,
+                                  std::string const &prefix,
+                                  LatticeWalberla const &lattice,
+                                  F1 const read_data, F2 const on_success) {
+  auto const err_msg =
+      std::string("Error while reading " + classname + " checkpoint: ");
+  auto slab = CheckpointSlab(
+      Mpiio::mpi_mpiio_read_slab(prefix + ".data", prefix + ".doff"));
+
+  context.parallel_try_catch([&]() {
+    try {
+      auto const [lower_corner, upper_corner] = lattice.get_local_grid_range();
+      auto const expected_lower = Utils::Vector3d(lower_corner);
+      auto const expected_upper = Utils::Vector3d(upper_corner);
+      Utils::Vector3d read_lower, read_upper;
+      slab.read(read_lower);
+      slab.read(read_upper);
+      if (read_lower != expected_lower or read_upper != expected_upper) {
+        std::stringstream message;
+        message << "local domain mismatch, read [" << read_lower << "] to ["
+                << read_upper << "], expected [" << expected_lower << "] to ["
+                << expected_upper << "].";
+        throw std::runtime_error(message.str());
+      }
+      read_data(slab, lower_corner, upper_corner);
+      if (not slab.eof()) {
+        throw std::runtime_error("extra data found, expected EOF.");
+      }
+    } catch (std::runtime_error const &err) {
+      throw std::runtime_error(err_msg + err.what());
+    }
+  });
+  on_success();
+}
+
+/**
+ * @brief Write a lattice checkpoint with MPI-IO.
+ * Each rank writes the data of its local domain as one slab, see
+ * @ref Mpiio::mpi_mpiio_write_slab. No data goes through the head node.
+ */
+template <typename F1>
+void save_checkpoint_mpiio_common(std::string const &prefix,
+                                  LatticeWalberla const &lattice,
+                                  F1 const write_data) {
+  auto const [lower_corner, upper_corner] = lattice.get_local_grid_range();
+  CheckpointSlab slab;
+  slab.write(Utils::Vector3d(lower_corner));
+  slab.write(Utils::Vector3d(upper_corner));
+  write_data(slab, lower_corner, upper_corner);
+  Mpiio::mpi_mpiio_write_slab(prefix + ".data", prefix + ".doff", slab.data());
+}
+
 } // namespace ScriptInterface::walberla
 
 #endif // WALBERLA
@@ -28,6 +28,7 @@
 #include "LBFluidSlice.hpp"
 
 #include "EKContainer.hpp"
+#include "EKCG.hpp"
 #include "EKFFT.hpp"
 #include "EKNone.hpp"
 
@@ -67,6 +68,7 @@ void initialize(Utils::Factory<ObjectHandle> *om) {
 #ifdef WALBERLA_FFT
   om->register_new<EKFFT>("walberla::EKFFT");
 #endif // WALBERLA_FFT
+  om->register_new<EKCG>("walberla::EKCG");
   om->register_new<EKNone>("walberla::EKNone");
   om->register_new<EKVTKHandle>("walberla::EKVTKHandle");
 
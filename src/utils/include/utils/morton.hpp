@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace Utils {
+
+/** Number of bits per coordinate of a 3D Morton code. */
+inline constexpr unsigned int morton_bits = 21u;
+
+namespace detail {
+/** Insert two zero bits between the lowest 21 bits of @p x. */
+constexpr uint64_t morton_spread_bits(uint32_t x) {
+  auto v = static_cast<uint64_t>(x) & 0x1fffffu;
+  v = (v | (v << 32u)) & 0x1f00000000ffffu;
+  v = (v | (v << 16u)) & 0x1f0000ff0000ffu;
+  v = (v | (v << 8u)) & 0x100f00f00f00f00fu;
+  v = (v | (v << 4u)) & 0x10c30c30c30c30c3u;
+  v = (v | (v << 2u)) & 0x1249249249249249u;
+  return v;
+}
+} // namespace detail
+
+/**
+ * @brief Index of a point of a 3D grid along the Morton (Z-order) curve.
+ *
+ * The bits of the coordinates are interleaved, such that points with
+ * close indices are close in space. Only the lowest @ref morton_bits
+ * bits of each coordinate are used.
+ */
+constexpr uint64_t morton_code(uint32_t x, uint32_t y, uint32_t z) {
+  return detail::morton_spread_bits(x) |
+         (detail::morton_spread_bits(y) << 1u) |
+         (detail::morton_spread_bits(z) << 2u);
+}
+
+} // namespace Utils
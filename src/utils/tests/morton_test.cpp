@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Utils::morton_code test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "utils/morton.hpp"
+
+#include <cstdint>
+#include <random>
+
+/** Bit by bit interleaving. */
+static uint64_t morton_code_reference(uint32_t x, uint32_t y, uint32_t z) {
+  uint64_t code = 0u;
+  for (unsigned int bit = 0u; bit < Utils::morton_bits; ++bit) {
+    code |= static_cast<uint64_t>((x >> bit) & 1u) << (3u * bit);
+    code |= static_cast<uint64_t>((y >> bit) & 1u) << (3u * bit + 1u);
+    code |= static_cast<uint64_t>((z >> bit) & 1u) << (3u * bit + 2u);
+  }
+  return code;
+}
+
+BOOST_AUTO_TEST_CASE(unit_cube) {
+  static_assert(Utils::morton_code(0u, 0u, 0u) == 0u);
+  static_assert(Utils::morton_code(1u, 0u, 0u) == 1u);
+  static_assert(Utils::morton_code(0u, 1u, 0u) == 2u);
+  static_assert(Utils::morton_code(0u, 0u, 1u) == 4u);
+  static_assert(Utils::morton_code(1u, 1u, 1u) == 7u);
+  static_assert(Utils::morton_code(2u, 0u, 0u) == 8u);
+  BOOST_CHECK_EQUAL(Utils::morton_code(7u, 7u, 7u), 511u);
+}
+
+BOOST_AUTO_TEST_CASE(interleaving) {
+  auto constexpr max_coord = (1u << Utils::morton_bits) - 1u;
+  BOOST_CHECK_EQUAL(Utils::morton_code(max_coord, max_coord, max_coord),
+                    (uint64_t{1u} << (3u * Utils::morton_bits)) - 1u);
+  /* bits above the 21st are ignored */
+  BOOST_CHECK_EQUAL(Utils::morton_code(max_coord + 1u, 0u, 0u), 0u);
+  std::mt19937 gen(42u);
+  std::uniform_int_distribution<uint32_t> coord(0u, max_coord);
+  for (int i = 0; i < 1000; ++i) {
+    auto const x = coord(gen), y = coord(gen), z = coord(gen);
+    BOOST_CHECK_EQUAL(Utils::morton_code(x, y, z),
+                      morton_code_reference(x, y, z));
+  }
+}
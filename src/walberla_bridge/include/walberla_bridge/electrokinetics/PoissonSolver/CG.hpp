@@ -0,0 +1,543 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "CGSolver.hpp"
+
+#include <walberla_bridge/LatticeWalberla.hpp>
+
+#include <blockforest/communication/UniformBufferedScheme.h>
+#include <core/mpi/Reduce.h>
+#include <domain_decomposition/BlockDataID.h>
+#include <field/AddToStorage.h>
+#include <field/GhostLayerField.h>
+#include <field/communication/PackInfo.h>
+#include <stencil/D3Q27.h>
+#include <stencil/D3Q7.h>
+
+#include <utils/Vector.hpp>
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace walberla {
+
+/**
+ * @brief Jacobi-preconditioned conjugate gradient Poisson solver.
+ *
+ * The operator is the 7-point finite volume discretization of
+ * @f$ -\nabla \cdot (\epsilon_r \nabla \Phi) @f$, where the face
+ * permittivity is the harmonic mean of the two adjacent nodes. Faces of
+ * insulating nodes have zero permittivity. The potential of Dirichlet
+ * nodes is stored in the potential field and moved to the right-hand side.
+ * Without Dirichlet nodes, the system is singular like in the FFT solver:
+ * the mean charge is removed and the potential has zero mean.
+ *
+ * Each iteration only exchanges the ghost layers of the search direction
+ * with the face neighbors and reduces two scalars, and the previous
+ * potential is used as initial guess. Supports one block per MPI rank.
+ */
+template <typename FloatType> class CG : public CGSolver {
+private:
+  template <typename T> FloatType FloatType_c(T t) {
+    return numeric_cast<FloatType>(t);
+  }
+
+  using ScalarField = GhostLayerField<FloatType, 1>;
+  using FlagField = GhostLayerField<uint8_t, 1>;
+
+  static constexpr uint8_t fluid_flag = 0u;
+  static constexpr uint8_t dirichlet_flag = 1u;
+  static constexpr uint8_t neumann_flag = 2u;
+
+  static constexpr std::array<std::array<cell_idx_t, 3>, 6> neighbors{{
+      {{1, 0, 0}},
+      {{-1, 0, 0}},
+      {{0, 1, 0}},
+      {{0, -1, 0}},
+      {{0, 0, 1}},
+      {{0, 0, -1}},
+  }};
+
+  BlockDataID m_potential_field_id;
+  BlockDataID m_charge_field_id;
+  BlockDataID m_residual_field_id;
+  BlockDataID m_direction_field_id;
+  BlockDataID m_product_field_id;
+  BlockDataID m_diagonal_field_id;
+  BlockDataID m_permittivity_field_id;
+  BlockDataID m_flag_field_id;
+
+  std::shared_ptr<blockforest::StructuredBlockForest> m_blocks;
+
+  using FaceCommunicator = blockforest::communication::UniformBufferedScheme<
+      typename stencil::D3Q7>;
+  using FullCommunicator = blockforest::communication::UniformBufferedScheme<
+      typename stencil::D3Q27>;
+  std::shared_ptr<FaceCommunicator> m_direction_communication;
+  std::shared_ptr<FullCommunicator> m_full_communication;
+
+  double m_tolerance;
+  int m_max_iterations;
+  int m_iterations;
+  double m_residual;
+
+  /** Fields of the local block. */
+  struct Fields {
+    ScalarField &phi;
+    ScalarField &rho;
+    ScalarField &r;
+    ScalarField &p;
+    ScalarField &q;
+    ScalarField &diag;
+    ScalarField const &eps;
+    FlagField const &flags;
+  };
+
+  Fields get_fields() {
+    assert(++(m_blocks->begin()) == m_blocks->end());
+    auto &block = *(m_blocks->begin());
+    auto const get = [&block](BlockDataID const &id) -> ScalarField & {
+      return *(block.template getData<ScalarField>(id));
+    };
+    return {get(m_potential_field_id),
+            get(m_charge_field_id),
+            get(m_residual_field_id),
+            get(m_direction_field_id),
+            get(m_product_field_id),
+            get(m_diagonal_field_id),
+            get(m_permittivity_field_id),
+            *(block.template getData<FlagField>(m_flag_field_id))};
+  }
+
+  template <typename Kernel>
+  static void for_each_cell(ScalarField const &field, Kernel &&kernel) {
+    auto const n_x = static_cast<cell_idx_t>(field.xSize());
+    auto const n_y = static_cast<cell_idx_t>(field.ySize());
+    auto const n_z = static_cast<cell_idx_t>(field.zSize());
+    for (cell_idx_t z = 0; z < n_z; ++z) {
+      for (cell_idx_t y = 0; y < n_y; ++y) {
+        for (cell_idx_t x = 0; x < n_x; ++x) {
+          kernel(x, y, z);
+        }
+      }
+    }
+  }
+
+  /** @brief Permittivity of the face between two nodes. */
+  static FloatType face_weight(Fields const &f, cell_idx_t x, cell_idx_t y,
+                               cell_idx_t z,
+                               std::array<cell_idx_t, 3> const &dir) {
+    auto const xn = x + dir[0];
+    auto const yn = y + dir[1];
+    auto const zn = z + dir[2];
+    if (f.flags.get(x, y, z) == neumann_flag or
+        f.flags.get(xn, yn, zn) == neumann_flag) {
+      return FloatType{0};
+    }
+    auto const eps_a = f.eps.get(x, y, z);
+    auto const eps_b = f.eps.get(xn, yn, zn);
+    auto const sum = eps_a + eps_b;
+    if (sum <= FloatType{0}) {
+      return FloatType{0};
+    }
+    return FloatType{2} * eps_a * eps_b / sum;
+  }
+
+  /** @brief Whether a node is solved for. */
+  static bool is_active(Fields const &f, cell_idx_t x, cell_idx_t y,
+                        cell_idx_t z) {
+    return f.diag.get(x, y, z) > FloatType{0};
+  }
+
+  /** @brief Compute @p out = A @p in on the active nodes. */
+  static void apply_operator(Fields const &f, ScalarField const &in,
+                             ScalarField &out) {
+    for_each_cell(out, [&](cell_idx_t x, cell_idx_t y, cell_idx_t z) {
+      if (not is_active(f, x, y, z)) {
+        out.get(x, y, z) = FloatType{0};
+        return;
+      }
+      auto value = f.diag.get(x, y, z) * in.get(x, y, z);
+      for (auto const &dir : neighbors) {
+        auto const xn = x + dir[0];
+        auto const yn = y + dir[1];
+        auto const zn = z + dir[2];
+        if (f.flags.get(xn, yn, zn) == fluid_flag) {
+          value -= face_weight(f, x, y, z, dir) * in.get(xn, yn, zn);
+        }
+      }
+      out.get(x, y, z) = value;
+    });
+  }
+
+  static double all_reduce(double value) {
+    mpi::allReduceInplace(value, mpi::SUM);
+    return value;
+  }
+
+  static std::vector<double> all_reduce(std::vector<double> values) {
+    mpi::allReduceInplace(values, mpi::SUM);
+    return values;
+  }
+
+  template <typename Field, typename Setter>
+  void set_from_grid(BlockDataID const &field_id,
+                     std::vector<int> const &raster, Setter &&setter) {
+    auto const &lattice = get_lattice();
+    auto const grid_size = lattice.get_grid_dimensions();
+    auto const offset = lattice.get_local_grid_range().first;
+    auto const gl = static_cast<int>(lattice.get_ghost_layers());
+    assert(raster.size() ==
+           static_cast<std::size_t>(Utils::product(grid_size)));
+    auto const n_y = static_cast<std::size_t>(grid_size[1]);
+    auto const n_z = static_cast<std::size_t>(grid_size[2]);
+    for (auto &block : *m_blocks) {
+      auto field = block.template getData<Field>(field_id);
+      auto const size_i = static_cast<int>(field->xSize());
+      auto const size_j = static_cast<int>(field->ySize());
+      auto const size_k = static_cast<int>(field->zSize());
+      // ghost layers are included, such that no communication is needed
+      for (int i = -gl; i < size_i + gl; ++i) {
+        for (int j = -gl; j < size_j + gl; ++j) {
+          for (int k = -gl; k < size_k + gl; ++k) {
+            auto const node = offset + Utils::Vector3i{{i, j, k}};
+            auto const idx = (node + grid_size) % grid_size;
+            auto const index = static_cast<std::size_t>(idx[0]) * n_y * n_z +
+                               static_cast<std::size_t>(idx[1]) * n_z +
+                               static_cast<std::size_t>(idx[2]);
+            if (raster[index]) {
+              setter(block, Cell(i, j, k), index);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void set_flag_from_grid(std::vector<int> const &raster, uint8_t flag) {
+    set_from_grid<FlagField>(
+        m_flag_field_id, raster,
+        [this, flag](IBlock &block, Cell const &cell, std::size_t) {
+          auto flags = block.template getData<FlagField>(m_flag_field_id);
+          flags->get(cell) = flag;
+        });
+  }
+
+public:
+  CG(std::shared_ptr<LatticeWalberla> lattice, double permittivity,
+     double tolerance, int max_iterations)
+      : CGSolver(std::move(lattice), permittivity), m_tolerance(tolerance),
+        m_max_iterations(max_iterations), m_iterations(0), m_residual(0.) {
+    m_blocks = get_lattice().get_blocks();
+    auto const n_ghost_layers = get_lattice().get_ghost_layers();
+    auto const add_to_storage = [this, n_ghost_layers](std::string const &tag,
+                                                       FloatType value) {
+      return field::addToStorage<ScalarField>(m_blocks, tag, value, field::fzyx,
+                                              n_ghost_layers);
+    };
+    m_potential_field_id = add_to_storage("potential field", FloatType{0});
+    m_charge_field_id = add_to_storage("charge field", FloatType{0});
+    m_residual_field_id = add_to_storage("CG residual", FloatType{0});
+    m_direction_field_id = add_to_storage("CG direction", FloatType{0});
+    m_product_field_id = add_to_storage("CG product", FloatType{0});
+    m_diagonal_field_id = add_to_storage("CG diagonal", FloatType{0});
+    m_permittivity_field_id =
+        add_to_storage("relative permittivity field", FloatType{1});
+    m_flag_field_id = field::addToStorage<FlagField>(
+        m_blocks, "Poisson flag field", fluid_flag, field::fzyx,
+        n_ghost_layers);
+
+    m_direction_communication = std::make_shared<FaceCommunicator>(m_blocks);
+    m_direction_communication->addPackInfo(
+        std::make_shared<field::communication::PackInfo<ScalarField>>(
+            m_direction_field_id));
+    m_full_communication = std::make_shared<FullCommunicator>(m_blocks);
+    m_full_communication->addPackInfo(
+        std::make_shared<field::communication::PackInfo<ScalarField>>(
+            m_potential_field_id));
+  }
+  ~CG() override = default;
+
+  void reset_charge_field() override {
+    for (auto &block : *m_blocks) {
+      auto field = block.template getData<ScalarField>(m_charge_field_id);
+      WALBERLA_FOR_ALL_CELLS_XYZ(field, field->get(x, y, z) = FloatType{0};)
+    }
+  }
+
+  void add_charge_to_field(std::size_t id, double valency,
+                           bool is_double_precision) override {
+    auto const factor = FloatType_c(valency) / FloatType_c(get_permittivity());
+    auto const density_id = walberla::BlockDataID(id);
+    for (auto &block : *m_blocks) {
+      auto charge_field =
+          block.template getData<ScalarField>(m_charge_field_id);
+      if (is_double_precision) {
+        auto density_field =
+            block.template getData<walberla::GhostLayerField<double, 1>>(
+                density_id);
+        WALBERLA_FOR_ALL_CELLS_XYZ(
+            charge_field, charge_field->get(x, y, z) +=
+                          factor * FloatType_c(density_field->get(x, y, z));)
+      } else {
+        auto density_field =
+            block.template getData<walberla::GhostLayerField<float, 1>>(
+                density_id);
+        WALBERLA_FOR_ALL_CELLS_XYZ(
+            charge_field, charge_field->get(x, y, z) +=
+                          factor * FloatType_c(density_field->get(x, y, z));)
+      }
+    }
+  }
+
+  [[nodiscard]] std::size_t get_potential_field_id() const noexcept override {
+    return static_cast<std::size_t>(m_potential_field_id);
+  }
+
+  void set_dirichlet_boundary_from_grid(
+      std::vector<int> const &raster,
+      std::vector<double> const &values) override {
+    set_flag_from_grid(raster, dirichlet_flag);
+    set_from_grid<ScalarField>(
+        m_potential_field_id, raster,
+        [this, &values](IBlock &block, Cell const &cell, std::size_t index) {
+          auto phi = block.template getData<ScalarField>(m_potential_field_id);
+          auto const value = (values.size() == 1ul) ? values[0] : values[index];
+          phi->get(cell) = FloatType_c(value);
+        });
+  }
+
+  void set_neumann_boundary_from_grid(std::vector<int> const &raster) override {
+    set_flag_from_grid(raster, neumann_flag);
+  }
+
+  void set_relative_permittivity_from_grid(
+      std::vector<int> const &raster,
+      std::vector<double> const &values) override {
+    set_from_grid<ScalarField>(
+        m_permittivity_field_id, raster,
+        [this, &values](IBlock &block, Cell const &cell, std::size_t index) {
+          auto eps =
+              block.template getData<ScalarField>(m_permittivity_field_id);
+          auto const value = (values.size() == 1ul) ? values[0] : values[index];
+          eps->get(cell) = FloatType_c(value);
+        });
+  }
+
+  void clear_boundaries() override {
+    for (auto &block : *m_blocks) {
+      auto flags = block.template getData<FlagField>(m_flag_field_id);
+      auto eps = block.template getData<ScalarField>(m_permittivity_field_id);
+      WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ(
+          flags, flags->get(x, y, z) = fluid_flag;)
+      WALBERLA_FOR_ALL_CELLS_INCLUDING_GHOST_LAYER_XYZ(
+          eps, eps->get(x, y, z) = FloatType{1};)
+    }
+  }
+
+  void set_tolerance(double tolerance) override { m_tolerance = tolerance; }
+  [[nodiscard]] double get_tolerance() const noexcept override {
+    return m_tolerance;
+  }
+  void set_max_iterations(int max_iterations) override {
+    m_max_iterations = max_iterations;
+  }
+  [[nodiscard]] int get_max_iterations() const noexcept override {
+    return m_max_iterations;
+  }
+  [[nodiscard]] int get_iterations() const noexcept override {
+    return m_iterations;
+  }
+  [[nodiscard]] double get_residual() const noexcept override {
+    return m_residual;
+  }
+
+  void solve() override {
+    auto f = get_fields();
+    // potential of the Dirichlet nodes and initial guess in the ghost layers
+    ghost_communication();
+
+    // diagonal and right-hand side, with the Dirichlet nodes moved to it
+    auto local = std::vector<double>(3ul, 0.);
+    for_each_cell(f.phi, [&](cell_idx_t x, cell_idx_t y, cell_idx_t z) {
+      f.r.get(x, y, z) = FloatType{0};
+      f.diag.get(x, y, z) = FloatType{0};
+      if (f.flags.get(x, y, z) == dirichlet_flag) {
+        local[2] += 1.;
+      }
+      if (f.flags.get(x, y, z) != fluid_flag) {
+        return;
+      }
+      auto diag = FloatType{0};
+      auto rhs = f.rho.get(x, y, z);
+      for (auto const &dir : neighbors) {
+        auto const w = face_weight(f, x, y, z, dir);
+        diag += w;
+        if (f.flags.get(x + dir[0], y + dir[1], z + dir[2]) ==
+            dirichlet_flag) {
+          rhs += w * f.phi.get(x + dir[0], y + dir[1], z + dir[2]);
+        }
+      }
+      f.diag.get(x, y, z) = diag;
+      if (diag > FloatType{0}) {
+        f.r.get(x, y, z) = rhs;
+        local[0] += static_cast<double>(rhs);
+        local[1] += 1.;
+      } else {
+        // isolated node
+        f.phi.get(x, y, z) = FloatType{0};
+      }
+    });
+    auto const global = all_reduce(local);
+    auto const n_active = global[1];
+    auto const is_singular = (global[2] == 0.);
+    if (is_singular and n_active > 0.) {
+      // remove the mean charge, like the zero mode of the FFT solver
+      auto const mean = FloatType_c(global[0] / n_active);
+      for_each_cell(f.r, [&](cell_idx_t x, cell_idx_t y, cell_idx_t z) {
+        if (is_active(f, x, y, z)) {
+          f.r.get(x, y, z) -= mean;
+        }
+      });
+    }
+
+    // initial residual r = b - A phi and direction p = M^-1 r
+    apply_operator(f, f.phi, f.q);
+    local.assign(3ul, 0.);
+    for_each_cell(f.r, [&](cell_idx_t x, cell_idx_t y, cell_idx_t z) {
+      if (not is_active(f, x, y, z)) {
+        f.p.get(x, y, z) = FloatType{0};
+        return;
+      }
+      auto const b = f.r.get(x, y, z);
+      auto const r = b - f.q.get(x, y, z);
+      f.r.get(x, y, z) = r;
+      f.p.get(x, y, z) = r / f.diag.get(x, y, z);
+      local[0] += static_cast<double>(b) * static_cast<double>(b);
+      local[1] += static_cast<double>(r) * static_cast<double>(r);
+      local[2] +=
+          static_cast<double>(r) * static_cast<double>(f.p.get(x, y, z));
+    });
+    auto norms = all_reduce(local);
+    auto const norm_b_sq = norms[0];
+    auto r_sq = norms[1];
+    auto rz = norms[2];
+
+    m_iterations = 0;
+    if (norm_b_sq == 0.) {
+      // no charges and no potential difference
+      for_each_cell(f.phi, [&](cell_idx_t x, cell_idx_t y, cell_idx_t z) {
+        if (is_active(f, x, y, z)) {
+          f.phi.get(x, y, z) = FloatType{0};
+        }
+      });
+      r_sq = 0.;
+    }
+    auto const threshold = m_tolerance * m_tolerance * norm_b_sq;
+    while (r_sq > threshold and m_iterations < m_max_iterations) {
+      m_direction_communication->operator()();
+      apply_operator(f, f.p, f.q);
+      auto p_q = 0.;
+      for_each_cell(f.p, [&](cell_idx_t x, cell_idx_t y, cell_idx_t z) {
+        p_q += static_cast<double>(f.p.get(x, y, z)) *
+               static_cast<double>(f.q.get(x, y, z));
+      });
+      p_q = all_reduce(p_q);
+      if (p_q <= 0.) {
+        break;
+      }
+      auto const alpha = FloatType_c(rz / p_q);
+      local.assign(2ul, 0.);
+      for_each_cell(f.r, [&](cell_idx_t x, cell_idx_t y, cell_idx_t z) {
+        if (is_active(f, x, y, z)) {
+          f.phi.get(x, y, z) += alpha * f.p.get(x, y, z);
+          auto const r = f.r.get(x, y, z) - alpha * f.q.get(x, y, z);
+          f.r.get(x, y, z) = r;
+          local[0] += static_cast<double>(r) * static_cast<double>(r);
+          local[1] += static_cast<double>(r) * static_cast<double>(r) /
+                      static_cast<double>(f.diag.get(x, y, z));
+        }
+      });
+      norms = all_reduce(local);
+      r_sq = norms[0];
+      auto const beta = FloatType_c(norms[1] / rz);
+      rz = norms[1];
+      for_each_cell(f.p, [&](cell_idx_t x, cell_idx_t y, cell_idx_t z) {
+        if (is_active(f, x, y, z)) {
+          f.p.get(x, y, z) = f.r.get(x, y, z) / f.diag.get(x, y, z) +
+                             beta * f.p.get(x, y, z);
+        }
+      });
+      ++m_iterations;
+    }
+    m_residual = (norm_b_sq == 0.) ? 0. : std::sqrt(r_sq / norm_b_sq);
+
+    if (is_singular and n_active > 0.) {
+      auto sum = 0.;
+      for_each_cell(f.phi, [&](cell_idx_t x, cell_idx_t y, cell_idx_t z) {
+        if (is_active(f, x, y, z)) {
+          sum += static_cast<double>(f.phi.get(x, y, z));
+        }
+      });
+      auto const mean = FloatType_c(all_reduce(sum) / n_active);
+      for_each_cell(f.phi, [&](cell_idx_t x, cell_idx_t y, cell_idx_t z) {
+        if (is_active(f, x, y, z)) {
+          f.phi.get(x, y, z) -= mean;
+        }
+      });
+    }
+
+    // insulating nodes take the mean potential of their neighbors,
+    // such that the normal component of the field vanishes on the faces
+    ghost_communication();
+    for_each_cell(f.phi, [&](cell_idx_t x, cell_idx_t y, cell_idx_t z) {
+      if (f.flags.get(x, y, z) != neumann_flag) {
+        return;
+      }
+      auto sum = FloatType{0};
+      auto count = 0;
+      for (auto const &dir : neighbors) {
+        auto const xn = x + dir[0];
+        auto const yn = y + dir[1];
+        auto const zn = z + dir[2];
+        if (f.flags.get(xn, yn, zn) != neumann_flag) {
+          sum += f.phi.get(xn, yn, zn);
+          ++count;
+        }
+      }
+      f.phi.get(x, y, z) =
+          (count == 0) ? FloatType{0} : sum / static_cast<FloatType>(count);
+    });
+    ghost_communication();
+  }
+
+private:
+  void ghost_communication() { (*m_full_communication)(); }
+};
+
+} // namespace walberla
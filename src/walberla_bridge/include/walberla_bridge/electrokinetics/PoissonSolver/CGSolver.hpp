@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "PoissonSolver.hpp"
+
+#include <vector>
+
+namespace walberla {
+
+/**
+ * @brief Interface of the iterative Poisson solver.
+ *
+ * Solves @f$ -\nabla \cdot (\epsilon_r \nabla \Phi) = \rho / \epsilon @f$
+ * with a spatially varying relative permittivity @f$ \epsilon_r @f$.
+ * Nodes can hold a fixed potential (Dirichlet boundary) or be insulating
+ * (no electric flux through their faces, i.e. a Neumann boundary for the
+ * adjacent nodes). Grids are flattened in row-major order of the global
+ * lattice, with a raster value of 1 for the nodes to update; a single
+ * value is broadcast to all nodes of the raster.
+ */
+class CGSolver : public PoissonSolver {
+public:
+  using PoissonSolver::PoissonSolver;
+  ~CGSolver() override = default;
+
+  /** @brief Fix the potential of the raster nodes. */
+  virtual void
+  set_dirichlet_boundary_from_grid(std::vector<int> const &raster,
+                                   std::vector<double> const &values) = 0;
+
+  /** @brief Make the raster nodes insulating. */
+  virtual void
+  set_neumann_boundary_from_grid(std::vector<int> const &raster) = 0;
+
+  /** @brief Set the relative permittivity of the raster nodes. */
+  virtual void
+  set_relative_permittivity_from_grid(std::vector<int> const &raster,
+                                      std::vector<double> const &values) = 0;
+
+  /** @brief Remove all boundaries and reset the relative permittivity. */
+  virtual void clear_boundaries() = 0;
+
+  /** @brief Relative tolerance on the residual norm. */
+  virtual void set_tolerance(double tolerance) = 0;
+  [[nodiscard]] virtual double get_tolerance() const noexcept = 0;
+
+  /** @brief Maximal number of iterations per solve. */
+  virtual void set_max_iterations(int max_iterations) = 0;
+  [[nodiscard]] virtual int get_max_iterations() const noexcept = 0;
+
+  /** @brief Number of iterations of the last solve. */
+  [[nodiscard]] virtual int get_iterations() const noexcept = 0;
+
+  /** @brief Relative residual norm after the last solve. */
+  [[nodiscard]] virtual double get_residual() const noexcept = 0;
+};
+
+} // namespace walberla
@@ -78,8 +78,10 @@ public:
   /**
    * @brief Interpolate forces to the stored forces to be applied on nodes
    * in the next time step.
+   * @return False if any position is outside the local halo. The forces
+   * at these positions are not applied, the others are.
    */
-  virtual void
+  virtual bool
   add_forces_at_pos(std::vector<Utils::Vector3d> const &positions,
                     std::vector<Utils::Vector3d> const &forces) = 0;
 
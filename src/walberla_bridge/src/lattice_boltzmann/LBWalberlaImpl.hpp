@@ -65,6 +65,7 @@
 #include <utils/interpolation/bspline_3d.hpp>
 #include <utils/math/make_lin_space.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
@@ -340,6 +341,48 @@ protected:
     return {CellInterval(lower_bc->cell, upper_bc->cell)};
   }
 
+  /**
+   * @brief Run a kernel on the B-spline stencil of many positions.
+   *
+   * The local grid range is looked up once for the whole batch, and each
+   * stencil node is converted to a block-local cell by a constant offset,
+   * instead of searching the block of every node. Nodes with zero weight
+   * are skipped, since they might lie outside the ghost layers.
+   * Only one block per MPI rank is supported.
+   *
+   * @param pos     Positions in LB units
+   * @param kernel  Called with the position index, the node, the
+   *                block-local cell (empty if the node is outside the
+   *                ghost layers) and the weight
+   */
+  template <typename Kernel>
+  void interpolate_bspline_on_block(std::vector<Utils::Vector3d> const &pos,
+                                    Kernel &&kernel) const {
+    auto const &lattice = get_lattice();
+    assert(++(lattice.get_blocks()->begin()) == lattice.get_blocks()->end());
+    auto const gl = Utils::Vector3i::broadcast(
+        static_cast<int>(lattice.get_ghost_layers()));
+    auto const local_lower = std::get<0>(lattice.get_local_grid_range());
+    auto const local_upper = std::get<1>(lattice.get_local_grid_range());
+    auto const lower = local_lower - gl;
+    auto const upper = local_upper + gl;
+    for (std::size_t i = 0ul; i < pos.size(); ++i) {
+      interpolate_bspline_at_pos(
+          pos[i], [&](std::array<int, 3> const node, double weight) {
+            if (weight == 0.) {
+              return;
+            }
+            auto const global = Utils::Vector3i(node);
+            std::optional<Cell> cell{};
+            if (global >= lower and global < upper) {
+              auto const local = global - local_lower;
+              cell = Cell(local[0], local[1], local[2]);
+            }
+            kernel(i, node, cell, weight);
+          });
+    }
+  }
+
   /**
    * @brief Convenience function to add a field with a custom allocator.
    *
@@ -769,16 +812,46 @@ public:
     return Architecture == lbmpy::Arch::GPU;
   }
 
-  void add_forces_at_pos(std::vector<Utils::Vector3d> const &pos,
+  bool add_forces_at_pos(std::vector<Utils::Vector3d> const &pos,
                          std::vector<Utils::Vector3d> const &forces) override {
     assert(pos.size() == forces.size());
     if (pos.empty()) {
-      return;
+      return true;
     }
-    if constexpr (Architecture == lbmpy::Arch::CPU) {
+    auto const &local_block = *(get_lattice().get_blocks()->begin());
+    auto const halo_aabb = local_block.getAABB().getExtended(
+        real_c(get_lattice().get_ghost_layers()));
+    auto const in_local_halo = [&halo_aabb](Utils::Vector3d const &vec) {
+      return halo_aabb.contains(real_c(vec[0]), real_c(vec[1]),
+                                real_c(vec[2]));
+    };
+    if (not std::ranges::all_of(pos, in_local_halo)) {
+      // same as add_force_at_pos(): skip positions outside the local halo
+      std::vector<Utils::Vector3d> pos_in_halo;
+      std::vector<Utils::Vector3d> forces_in_halo;
       for (std::size_t i = 0ul; i < pos.size(); ++i) {
-        add_force_at_pos(pos[i], forces[i]);
+        if (in_local_halo(pos[i])) {
+          pos_in_halo.emplace_back(pos[i]);
+          forces_in_halo.emplace_back(forces[i]);
+        }
       }
+      add_forces_at_pos(pos_in_halo, forces_in_halo);
+      return false;
+    }
+    if constexpr (Architecture == lbmpy::Arch::CPU) {
+      auto &block = *(get_lattice().get_blocks()->begin());
+      auto force_field =
+          block.template uncheckedFastGetData<VectorField>(
+              m_force_to_be_applied_id);
+      interpolate_bspline_on_block(
+          pos, [&](std::size_t i, std::array<int, 3> const &,
+                   std::optional<Cell> const &cell, double weight) {
+            if (cell) {
+              auto const weighted_force =
+                  to_vector3<FloatType>(weight * forces[i]);
+              lbm::accessor::Vector::add(force_field, weighted_force, *cell);
+            }
+          });
     }
 #if defined(__CUDACC__)
     if constexpr (Architecture == lbmpy::Arch::GPU) {
@@ -808,6 +881,7 @@ public:
       lbm::accessor::Interpolation::set(field, host_pos, host_force, gl);
     }
 #endif
+    return true;
   }
 
   std::vector<Utils::Vector3d>
@@ -816,13 +890,26 @@ public:
       return {};
     }
     if constexpr (Architecture == lbmpy::Arch::CPU) {
-      std::vector<Utils::Vector3d> vel{};
-      vel.reserve(pos.size());
-      for (auto const &vec : pos) {
-        auto res = get_velocity_at_pos(vec, true);
-        assert(res.has_value());
-        vel.emplace_back(*res);
-      }
+      auto const &block = *(get_lattice().get_blocks()->begin());
+      auto const field =
+          block.template uncheckedFastGetData<VectorField>(m_velocity_field_id);
+      std::vector<Utils::Vector3d> vel(pos.size(), Utils::Vector3d{});
+      interpolate_bspline_on_block(
+          pos, [&](std::size_t i, std::array<int, 3> const &node,
+                   std::optional<Cell> const &cell, double weight) {
+            if (not cell) {
+              throw interpolation_illegal_access("velocity", pos[i], node,
+                                                 weight);
+            }
+            if (m_boundary->node_is_boundary(Utils::Vector3i(node))) {
+              auto const &v =
+                  m_boundary->get_node_value_at_boundary(Utils::Vector3i(node));
+              vel[i] += to_vector3d(v) * weight;
+            } else {
+              auto const v = lbm::accessor::Vector::get(field, *cell);
+              vel[i] += to_vector3d(v) * weight;
+            }
+          });
       return vel;
     }
 #if defined(__CUDACC__)
@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2024 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#define BOOST_TEST_MODULE EK walberla Poisson solver test
+#define BOOST_TEST_DYN_LINK
+#include "config/config.hpp"
+
+#ifdef WALBERLA
+
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include "tests_common.hpp"
+
+#include <walberla_bridge/BlockAndCell.hpp>
+#include <walberla_bridge/LatticeWalberla.hpp>
+#include <walberla_bridge/electrokinetics/PoissonSolver/CGSolver.hpp>
+#include <walberla_bridge/electrokinetics/ek_poisson_cg_init.hpp>
+
+#include <field/AddToStorage.h>
+#include <field/GhostLayerField.h>
+
+#include <utils/Vector.hpp>
+
+#include <boost/mpi/collectives/all_reduce.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+using Utils::Vector3i;
+
+static LatticeTestParameters params; // populated in main()
+
+static auto linear_index(Vector3i const &node) {
+  auto const &n = params.grid_dimensions;
+  return static_cast<std::size_t>((node[0] * n[1] + node[1]) * n[2] + node[2]);
+}
+
+/** @brief Raster of the xy-planes at the given z coordinates. */
+static auto make_planes(std::vector<int> const &z_values) {
+  std::vector<int> raster(static_cast<std::size_t>(
+      Utils::product(params.grid_dimensions)));
+  for (auto const &node : all_nodes_incl_ghosts(*params.lattice, false)) {
+    for (auto const z : z_values) {
+      if (node[2] == z) {
+        raster[linear_index(node)] = 1;
+      }
+    }
+  }
+  return raster;
+}
+
+/** @brief Potential on all nodes of the grid, gathered from all ranks. */
+template <typename FloatType>
+static auto get_potential(walberla::CGSolver const &solver) {
+  using PotentialField = walberla::GhostLayerField<FloatType, 1>;
+  auto const &lattice = *params.lattice;
+  auto const field_id = walberla::BlockDataID(solver.get_potential_field_id());
+  std::vector<double> values(static_cast<std::size_t>(
+      Utils::product(params.grid_dimensions)));
+  for (auto const &node : local_nodes_incl_ghosts(lattice, false)) {
+    auto const bc = walberla::get_block_and_cell(lattice, node, false);
+    BOOST_REQUIRE(bc);
+    auto const field = bc->block->template getData<PotentialField>(field_id);
+    values[linear_index(node)] = static_cast<double>(field->get(bc->cell));
+  }
+  boost::mpi::communicator world;
+  return boost::mpi::all_reduce(world, values, [](auto a, auto const &b) {
+    for (std::size_t i = 0u; i < a.size(); ++i) {
+      a[i] += b[i];
+    }
+    return a;
+  });
+}
+
+static auto make_solver(bool single_precision, double tolerance) {
+  return walberla::new_ek_poisson_cg(params.lattice, 1., tolerance, 1000,
+                                     single_precision);
+}
+
+/**
+ * Two electrodes at z = 0 and z = 9 impose a potential difference of 1.
+ * The faces between the electrodes form a series of capacitors with the
+ * given face permittivities, which carry the same electric flux.
+ */
+static auto capacitor_potential(std::array<double, 9> const &weights) {
+  auto const flux =
+      1. / std::accumulate(weights.begin(), weights.end(), 0.,
+                           [](double acc, double w) { return acc + 1. / w; });
+  std::vector<double> res{0.};
+  for (auto const w : weights) {
+    res.emplace_back(res.back() + flux / w);
+  }
+  return res;
+}
+
+BOOST_AUTO_TEST_CASE(capacitor) {
+  for (auto const single_precision : {false, true}) {
+    auto const solver_tol = (single_precision) ? 1e-6 : 1e-12;
+    auto const tol = (single_precision) ? 1e-4 : 1e-9;
+    auto solver = make_solver(single_precision, solver_tol);
+    solver->set_dirichlet_boundary_from_grid(make_planes({0}), {0.});
+    solver->set_dirichlet_boundary_from_grid(make_planes({9}), {1.});
+    solver->reset_charge_field();
+    solver->solve();
+    auto const n_iterations = solver->get_iterations();
+    BOOST_CHECK_GT(n_iterations, 0);
+    BOOST_CHECK_LE(solver->get_residual(), solver_tol);
+    auto const phi = (single_precision) ? get_potential<float>(*solver)
+                                        : get_potential<double>(*solver);
+    for (auto const &node : all_nodes_incl_ghosts(*params.lattice, false)) {
+      auto const z = static_cast<double>(node[2]);
+      auto const ref = (node[2] <= 9) ? z / 9. : (18. - z) / 9.;
+      BOOST_CHECK_SMALL(phi[linear_index(node)] - ref, tol);
+    }
+    // the previous potential is the initial guess
+    solver->solve();
+    BOOST_CHECK_LT(solver->get_iterations(), n_iterations);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(dielectric_slab) {
+  auto constexpr tol = 1e-10;
+  auto solver = make_solver(false, tol * 1e-2);
+  solver->set_dirichlet_boundary_from_grid(make_planes({0}), {0.});
+  solver->set_dirichlet_boundary_from_grid(make_planes({9}), {1.});
+  solver->set_relative_permittivity_from_grid(make_planes({3, 4, 5}), {4.});
+  solver->reset_charge_field();
+  solver->solve();
+  // harmonic mean of the permittivity on the faces
+  auto const ref = capacitor_potential({1., 1., 1.6, 4., 4., 1.6, 1., 1., 1.});
+  auto const phi = get_potential<double>(*solver);
+  for (auto const &node : all_nodes_incl_ghosts(*params.lattice, false)) {
+    if (node[2] <= 9) {
+      BOOST_CHECK_SMALL(phi[linear_index(node)] - ref[node[2]], tol);
+    }
+  }
+  // resetting the permittivity recovers the uniform field
+  solver->clear_boundaries();
+  solver->set_dirichlet_boundary_from_grid(make_planes({0}), {0.});
+  solver->set_dirichlet_boundary_from_grid(make_planes({9}), {1.});
+  solver->solve();
+  auto const phi_uniform = get_potential<double>(*solver);
+  for (auto const &node : all_nodes_incl_ghosts(*params.lattice, false)) {
+    if (node[2] <= 9) {
+      auto const z = static_cast<double>(node[2]);
+      BOOST_CHECK_SMALL(phi_uniform[linear_index(node)] - z / 9., tol);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(insulator) {
+  auto constexpr tol = 1e-10;
+  auto solver = make_solver(false, tol * 1e-2);
+  solver->set_dirichlet_boundary_from_grid(make_planes({0}), {0.});
+  solver->set_dirichlet_boundary_from_grid(make_planes({9}), {1.});
+  solver->set_neumann_boundary_from_grid(make_planes({4}));
+  solver->reset_charge_field();
+  solver->solve();
+  // the insulator disconnects the nodes between the electrodes from the
+  // electrode on its other side, and takes the mean potential of both sides
+  auto const phi = get_potential<double>(*solver);
+  for (auto const &node : all_nodes_incl_ghosts(*params.lattice, false)) {
+    auto const z = node[2];
+    auto const ref = (z < 4)    ? 0.
+                     : (z == 4) ? 0.5
+                     : (z <= 9) ? 1.
+                                : (18. - static_cast<double>(z)) / 9.;
+    BOOST_CHECK_SMALL(phi[linear_index(node)] - ref, tol);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(periodic_point_charge) {
+  using DensityField = walberla::GhostLayerField<double, 1>;
+  auto constexpr tol = 1e-9;
+  auto const permittivity = 0.5;
+  auto const valency = 2.;
+  auto solver = make_solver(false, 1e-12);
+  solver->set_permittivity(permittivity);
+  auto const &lattice = *params.lattice;
+  auto const density_id = walberla::field::addToStorage<DensityField>(
+      lattice.get_blocks(), "density", 0., walberla::field::fzyx,
+      lattice.get_ghost_layers());
+  auto const source = Vector3i{3, 4, 5};
+  if (auto const bc = walberla::get_block_and_cell(lattice, source, false)) {
+    bc->block->template getData<DensityField>(density_id)->get(bc->cell) = 1.;
+  }
+  solver->reset_charge_field();
+  solver->add_charge_to_field(static_cast<std::size_t>(density_id), valency,
+                              true);
+  solver->solve();
+  auto const phi = get_potential<double>(*solver);
+  auto const &n = params.grid_dimensions;
+  auto const n_nodes = static_cast<double>(Utils::product(n));
+  // the potential has zero mean
+  BOOST_CHECK_SMALL(std::accumulate(phi.begin(), phi.end(), 0.) / n_nodes,
+                    tol);
+  // -laplace(phi) = rho / epsilon with neutralizing background
+  auto const charge = valency / permittivity;
+  for (auto const &node : all_nodes_incl_ghosts(lattice, false)) {
+    auto value = 6. * phi[linear_index(node)];
+    for (auto const i : {0, 1, 2}) {
+      for (auto const shift : {-1, 1}) {
+        auto neighbor = node;
+        neighbor[i] = (neighbor[i] + shift + n[i]) % n[i];
+        value -= phi[linear_index(neighbor)];
+      }
+    }
+    auto const rho = ((node == source) ? charge : 0.) - charge / n_nodes;
+    BOOST_CHECK_SMALL(value - rho, tol);
+  }
+}
+
+int main(int argc, char **argv) {
+  int n_nodes;
+  Vector3i mpi_shape{};
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_size(MPI_COMM_WORLD, &n_nodes);
+  MPI_Dims_create(n_nodes, 3, mpi_shape.data());
+  walberla::mpi_init();
+
+  params.grid_dimensions = Vector3i{6, 6, 18};
+  params.box_dimensions = Utils::Vector3d{6, 6, 18};
+  params.lattice =
+      std::make_shared<LatticeWalberla>(params.grid_dimensions, mpi_shape, 1u);
+
+  auto const res = boost::unit_test::unit_test_main(init_unit_test, argc, argv);
+  MPI_Finalize();
+  return res;
+}
+
+#else // WALBERLA
+int main(int argc, char **argv) {}
+#endif
@@ -17,6 +17,7 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #
 import unittest as ut
+import unittest_decorators as utx
 import espressomd
 import numpy as np
 import tests_common
@@ -49,9 +50,17 @@ class CellSystem(ut.TestCase):
         for value in [True, False]:
             self.system.cell_system.use_verlet_lists = value
             self.assertEqual(self.system.cell_system.use_verlet_lists, value)
+        for value in [True, False]:
+            self.system.cell_system.overlap_ghost_communication = value
+            self.assertEqual(
+                self.system.cell_system.overlap_ghost_communication, value)
         for value in [0.1, 0.]:
             self.system.cell_system.skin = value
             self.assertEqual(self.system.cell_system.skin, value)
+        for value in [5, 0]:
+            self.system.cell_system.particle_sort_interval = value
+            self.assertEqual(
+                self.system.cell_system.particle_sort_interval, value)
         for key in ["decomposition_type", "n_square_types", "cutoff_regular",
                     "max_cut_nonbonded", "max_cut_bonded", "interaction_range"]:
             with self.assertRaisesRegex(RuntimeError, f"Parameter '{key}' is read-only"):
@@ -73,6 +82,9 @@ class CellSystem(ut.TestCase):
         with self.assertRaisesRegex(ValueError, "Parameter 'skin' must be >= 0"):
             system.cell_system.skin = -2.
         self.assertAlmostEqual(system.cell_system.skin, 0.1, delta=1e-12)
+        with self.assertRaisesRegex(ValueError, "Parameter 'particle_sort_interval' must be >= 0"):
+            system.cell_system.particle_sort_interval = -1
+        self.assertEqual(system.cell_system.particle_sort_interval, 0)
 
         node_grid = system.cell_system.node_grid
         with self.assertRaisesRegex(RuntimeError, "Provided argument of type .+ is not convertible to 'Utils::Vector<int, 3>'"):
@@ -93,6 +105,88 @@ class CellSystem(ut.TestCase):
             n_square_types={1}, cutoff_regular=0)
         self.check_node_grid()
 
+    @utx.skipIfMissingFeatures("LENNARD_JONES")
+    def test_load_balancing(self):
+        system = self.system
+        system.cell_system.set_regular_decomposition()
+        system.cell_system.node_grid = [self.n_nodes, 1, 1]
+        system.cell_system.skin = 0.1
+        system.time_step = 0.01
+        system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1., sigma=0.5, cutoff=0.6, shift="auto")
+        # all particles are in a slab at the lower end of the x-axis
+        grid = np.arange(0.25, 5., 0.55)
+        positions = [[x, y, z] for x in grid[:3] for y in grid for z in grid]
+        system.part.add(pos=positions)
+
+        with self.assertRaisesRegex(ValueError, "Parameter 'interval' must be >= 1"):
+            system.cell_system.start_load_balancing(interval=0)
+        self.assertFalse(system.cell_system.get_state()["load_balancing"])
+        system.cell_system.start_load_balancing(interval=10)
+        state = system.cell_system.get_state()
+        self.assertTrue(state["load_balancing"])
+        np.testing.assert_allclose(
+            state["domain_boundaries"][0],
+            np.linspace(0., 1., self.n_nodes + 1), atol=1e-12)
+        system.integrator.run(100)
+        boundaries = system.cell_system.get_state()["domain_boundaries"]
+        for values in boundaries:
+            self.assertEqual(values[0], 0.)
+            self.assertEqual(values[-1], 1.)
+            self.assertTrue(np.all(np.diff(values) > 0.))
+        if self.n_nodes > 1:
+            # the domains of the slab shrink
+            self.assertLess(boundaries[0][1], 1. / self.n_nodes)
+        self.assertEqual(len(system.part.all()), len(positions))
+        system.cell_system.stop_load_balancing()
+        state = system.cell_system.get_state()
+        self.assertFalse(state["load_balancing"])
+        self.assertNotIn("domain_boundaries", state)
+
+        # other cell systems restore the uniform partition
+        system.cell_system.start_load_balancing(interval=10)
+        system.cell_system.set_n_square()
+        self.assertFalse(system.cell_system.get_state()["load_balancing"])
+        with self.assertRaisesRegex(RuntimeError, "Load balancing requires the regular decomposition"):
+            system.cell_system.start_load_balancing(interval=10)
+        system.cell_system.set_regular_decomposition()
+        system.part.clear()
+        system.non_bonded_inter[0, 0].lennard_jones.deactivate()
+
+    @utx.skipIfMissingFeatures("LENNARD_JONES")
+    def test_particle_sort(self):
+        system = self.system
+        system.time_step = 0.01
+        system.cell_system.skin = 0.1
+        system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1., sigma=0.5, cutoff=0.6, shift="auto")
+        rng = np.random.default_rng(seed=42)
+        grid = np.arange(0.25, 5., 0.55)
+        positions = np.array([[x, y, z]
+                             for x in grid for y in grid for z in grid])
+        positions += rng.uniform(-0.05, 0.05, positions.shape)
+        velocities = rng.uniform(-1., 1., positions.shape)
+
+        def get_trajectory(sort_interval):
+            system.part.clear()
+            partcls = system.part.add(pos=positions, v=velocities)
+            system.cell_system.particle_sort_interval = sort_interval
+            system.integrator.run(50)
+            return np.copy(partcls.pos), np.copy(partcls.f)
+
+        # the particle order in memory doesn't change the trajectory
+        for setter in [system.cell_system.set_regular_decomposition,
+                       system.cell_system.set_n_square]:
+            setter()
+            pos_ref, f_ref = get_trajectory(0)
+            pos, f = get_trajectory(1)
+            np.testing.assert_allclose(pos, pos_ref, atol=1e-10)
+            np.testing.assert_allclose(f, f_ref, atol=1e-8)
+        system.cell_system.particle_sort_interval = 0
+        system.cell_system.set_regular_decomposition()
+        system.part.clear()
+        system.non_bonded_inter[0, 0].lennard_jones.deactivate()
+
 
 if __name__ == "__main__":
     ut.main()
@@ -88,6 +88,13 @@ class CoulombCloudWall(ut.TestCase):
         self.system.integrator.run(0)
         self.compare("p3m", prefactor=3., force_tol=2e-3, energy_tol=1e-3)
 
+    @utx.skipIfMissingFeatures(["P3M"])
+    def test_p3m_cpu_pencil_fft(self):
+        self.system.electrostatics.solver = espressomd.electrostatics.P3M(
+            **self.p3m_params, prefactor=3., tune=False, fft_backend="pencil")
+        self.system.integrator.run(0)
+        self.compare("p3m", prefactor=3., force_tol=2e-3, energy_tol=1e-3)
+
     @utx.skipIfMissingGPU()
     @utx.skipIfMissingFeatures(["P3M"])
     def test_p3m_gpu(self):
@@ -174,6 +174,8 @@ class Test(ut.TestCase):
             P3M(**{**p3m_params, 'timings': -2})
         with self.assertRaisesRegex(ValueError, "Parameter 'mesh' has to be an integer or integer list of length 3"):
             P3M(**{**p3m_params, 'mesh': [8, 8]})
+        with self.assertRaisesRegex(ValueError, "Unknown FFT backend 'slab'"):
+            P3M(**{**p3m_params, 'fft_backend': 'slab'})
         if espressomd.has_features(["CUDA"]) and espressomd.gpu_available():
             with self.assertRaisesRegex(ValueError, "P3M GPU only implemented in single-precision mode"):
                 P3MGPU(single_precision=False, **p3m_params)
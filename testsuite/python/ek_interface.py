@@ -26,6 +26,7 @@ import unittest_decorators as utx
 import espressomd
 import espressomd.lb
 import espressomd.electrokinetics
+import espressomd.shapes
 
 
 class EKTest:
@@ -190,6 +191,50 @@ class EKTest:
         self.assertIsInstance(self.system.ekcontainer.solver,
                               espressomd.electrokinetics.EKFFT)
 
+    def test_ek_cg_solver(self):
+        ek_solver = espressomd.electrokinetics.EKCG(
+            lattice=self.lattice, permittivity=0.01, tolerance=1e-4,
+            single_precision=self.ek_params["single_precision"])
+        self.assertEqual(ek_solver.lattice, self.lattice)
+        self.assertEqual(
+            ek_solver.single_precision,
+            self.ek_params["single_precision"])
+        self.assertAlmostEqual(ek_solver.permittivity, 0.01, delta=self.atol)
+        self.assertAlmostEqual(ek_solver.tolerance, 1e-4, delta=1e-10)
+        self.assertEqual(ek_solver.max_iterations, 1000)
+        self.assertEqual(ek_solver.iterations, 0)
+        ek_solver.permittivity = 0.05
+        ek_solver.tolerance = 1e-5
+        ek_solver.max_iterations = 200
+        self.assertAlmostEqual(ek_solver.permittivity, 0.05, delta=self.atol)
+        self.assertAlmostEqual(ek_solver.tolerance, 1e-5, delta=1e-10)
+        self.assertEqual(ek_solver.max_iterations, 200)
+
+        with self.assertRaisesRegex(ValueError, "Parameter 'tolerance' must be > 0"):
+            ek_solver.tolerance = 0.
+        with self.assertRaisesRegex(ValueError, "Parameter 'max_iterations' must be > 0"):
+            ek_solver.max_iterations = 0
+        with self.assertRaisesRegex(ValueError, "Parameter 'relative_permittivity' must be > 0"):
+            ek_solver.set_permittivity_from_shape(
+                shape=espressomd.shapes.Wall(normal=[1, 0, 0], dist=1.),
+                relative_permittivity=-1.)
+        with self.assertRaisesRegex(ValueError, "Cannot process potential value grid"):
+            ek_solver.add_dirichlet_boundary_from_shape(
+                shape=espressomd.shapes.Wall(normal=[1, 0, 0], dist=1.),
+                potential=[1., 2.])
+
+        wall = espressomd.shapes.Wall(normal=[1, 0, 0], dist=1.)
+        ek_solver.add_dirichlet_boundary_from_shape(shape=wall, potential=0.5)
+        ek_solver.add_neumann_boundary_from_shape(
+            shape=espressomd.shapes.Wall(normal=[-1, 0, 0], dist=-2.))
+        ek_solver.set_permittivity_from_shape(
+            shape=wall, relative_permittivity=np.full(self.lattice.shape, 2.))
+        ek_solver.clear_boundaries()
+
+        self.system.ekcontainer.solver = ek_solver
+        self.assertIsInstance(self.system.ekcontainer.solver,
+                              espressomd.electrokinetics.EKCG)
+
     def test_ek_none_solver(self):
         ek_solver = espressomd.electrokinetics.EKNone(
             lattice=self.lattice,
@@ -335,6 +335,31 @@ class H5mdTests(ut.TestCase):
             self.assertEqual(self.h5_params['mass_unit'], 'u')
         self.assertEqual(self.h5_params['force_unit'], 'm u ps-2')
         self.assertEqual(self.h5_params['velocity_unit'], 'm ps-1')
+        self.assertEqual(self.h5_params['buffer_size'], 1)
+
+    def test_buffering(self):
+        temp_file = self.temp_path / 'buffered.h5'
+        h5 = espressomd.io.writer.h5md.H5md(
+            file_path=str(temp_file), buffer_size=2)
+        self.assertEqual(h5.buffer_size, 2)
+        # the third frame is only written when the file is closed
+        for _ in range(3):
+            h5.write()
+        h5.close()
+        with h5py.File(temp_file, 'r') as cur:
+            self.assertEqual(len(cur['particles/atoms/id/step']), 3)
+            for frame in range(3):
+                for key in ('id/value', 'position/value', 'velocity/value',
+                            'id/time', 'box/edges/value',
+                            'lees_edwards/offset/value'):
+                    np.testing.assert_allclose(
+                        cur[f'particles/atoms/{key}'][frame],
+                        self.py_file[f'particles/atoms/{key}'][1])
+                np.testing.assert_array_equal(
+                    cur['connectivity/atoms/value'][frame], self.py_bonds)
+        with self.assertRaisesRegex(ValueError, "Parameter 'buffer_size' must be >= 1"):
+            espressomd.io.writer.h5md.H5md(
+                file_path=str(self.temp_path / 'unbuffered.h5'), buffer_size=0)
 
     def test_static_properties(self):
         # check list of output fields
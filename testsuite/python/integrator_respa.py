@@ -0,0 +1,157 @@
+#
+# Copyright (C) 2024 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+import espressomd
+import numpy as np
+import unittest as ut
+import unittest_decorators as utx
+
+
+class Test(ut.TestCase):
+
+    """
+    Check multiple time stepping of the long-range forces
+    in the velocity Verlet integrator.
+    """
+
+    system = espressomd.System(box_l=[10., 10., 10.])
+    system.time_step = 0.01
+    system.cell_system.skin = 0.4
+
+    def setUp(self):
+        np.random.seed(42)
+        pos = np.random.random((100, 3)) * self.system.box_l
+        self.system.part.add(pos=pos, v=np.random.normal(size=(100, 3)))
+
+    def tearDown(self):
+        if espressomd.has_features(["ELECTROSTATICS"]):
+            self.system.electrostatics.clear()
+        self.system.part.clear()
+        self.system.integrator.set_vv()
+        self.system.time_step = 0.01
+        if espressomd.has_features(["WCA"]):
+            self.system.non_bonded_inter[0, 0].wca.deactivate()
+
+    def trajectory(self, long_range_steps, n_steps):
+        system = self.system
+        partcls = system.part.all()
+        pos = np.copy(partcls.pos)
+        vel = np.copy(partcls.v)
+        system.integrator.set_vv(long_range_steps=long_range_steps)
+        system.integrator.run(n_steps)
+        traj = (np.copy(partcls.pos_folded), np.copy(partcls.v))
+        partcls.pos = pos
+        partcls.v = vel
+        return traj
+
+    def test_interface(self):
+        integrator = self.system.integrator
+        integrator.set_vv()
+        self.assertEqual(integrator.integrator.long_range_steps, 1)
+        integrator.set_vv(long_range_steps=4)
+        self.assertEqual(integrator.integrator.long_range_steps, 4)
+        integrator.set_nvt(long_range_steps=3)
+        self.assertEqual(integrator.integrator.long_range_steps, 3)
+        with self.assertRaisesRegex(ValueError, "Parameter 'long_range_steps' must be >= 1"):
+            integrator.set_vv(long_range_steps=0)
+        self.assertEqual(integrator.integrator.long_range_steps, 3)
+
+    @utx.skipIfMissingFeatures(["WCA"])
+    def test_short_range_only(self):
+        # without long-range solver, the trajectory must not change
+        self.system.non_bonded_inter[0, 0].wca.set_params(
+            epsilon=1., sigma=0.5)
+        self.system.part.all().pos = np.copy(
+            self.system.part.all().pos) * 0.1 + 4.5
+        pos_ref, vel_ref = self.trajectory(1, 50)
+        pos, vel = self.trajectory(3, 50)
+        np.testing.assert_allclose(pos, pos_ref, rtol=0., atol=1e-12)
+        np.testing.assert_allclose(vel, vel_ref, rtol=0., atol=1e-12)
+
+    @utx.skipIfMissingFeatures(["P3M", "WCA"])
+    def test_p3m(self):
+        import espressomd.electrostatics
+        system = self.system
+        system.non_bonded_inter[0, 0].wca.set_params(epsilon=1., sigma=1.)
+        system.part.all().q = 50 * [-1., 1.]
+        system.part.all().v = np.zeros((100, 3))
+        system.integrator.set_steepest_descent(
+            f_max=0., gamma=0.1, max_displacement=0.01)
+        system.integrator.run(200)
+        system.part.all().v = np.random.normal(size=(100, 3))
+        solver = espressomd.electrostatics.P3M(
+            prefactor=1., accuracy=1e-4, mesh=24, cao=5, r_cut=2.,
+            alpha=1.5, tune=False)
+        system.electrostatics.solver = solver
+        system.time_step = 0.002
+        pos_ref, vel_ref = self.trajectory(1, 60)
+        # the impulse scheme is a second-order perturbation
+        # of the single time step trajectory
+        pos, vel = self.trajectory(3, 60)
+        np.testing.assert_allclose(pos, pos_ref, rtol=0., atol=1e-3)
+        np.testing.assert_allclose(vel, vel_ref, rtol=0., atol=5e-2)
+        # the impulses change the trajectory
+        self.assertGreater(np.max(np.abs(vel - vel_ref)), 1e-8)
+        # the energy is conserved
+        system.integrator.set_vv(long_range_steps=3)
+        system.integrator.run(0)
+        energy_start = system.analysis.energy()
+        system.integrator.run(300)
+        energy_end = system.analysis.energy()
+        self.assertAlmostEqual(energy_end["total"], energy_start["total"],
+                               delta=1e-2 * energy_start["kinetic"])
+
+    @utx.skipIfMissingFeatures(["P3M", "EXTERNAL_FORCES"])
+    def test_stored_forces(self):
+        import espressomd.electrostatics
+        system = self.system
+        partcls = system.part.all()
+        grid = np.mgrid[0:5, 0:5, 0:4].reshape((3, -1)).T
+        partcls.pos = 2. * grid + np.random.random((100, 3))
+        partcls.q = 50 * [-1., 1.]
+        # fixed particles keep the positions, and thus the forces, constant
+        partcls.fix = 100 * [[True, True, True]]
+        solver = espressomd.electrostatics.P3M(
+            prefactor=1., accuracy=1e-4, mesh=24, cao=5, r_cut=2.,
+            alpha=1.5, tune=False)
+        system.electrostatics.solver = solver
+        system.integrator.set_vv()
+        system.integrator.run(0, recalc_forces=True)
+        f_total = np.copy(partcls.f)
+        system.integrator.set_vv(long_range_steps=3)
+        # the forces of an evaluation step contain the long-range forces
+        # multiplied by long_range_steps, the other steps lack them
+        system.integrator.run(0, recalc_forces=True)
+        f_eval = np.copy(partcls.f)
+        system.integrator.run(1)
+        f_short_range = np.copy(partcls.f)
+        system.integrator.run(1)
+        np.testing.assert_allclose(
+            np.copy(partcls.f), f_short_range, rtol=0., atol=1e-10)
+        f_long_range = f_total - f_short_range
+        self.assertGreater(np.max(np.abs(f_long_range)), 1e-3)
+        np.testing.assert_allclose(
+            f_eval, f_short_range + 3. * f_long_range, rtol=0., atol=1e-8)
+        system.integrator.run(1)
+        np.testing.assert_allclose(
+            np.copy(partcls.f), f_eval, rtol=0., atol=1e-8)
+
+
+
+if __name__ == "__main__":
+    ut.main()
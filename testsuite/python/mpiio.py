@@ -124,6 +124,9 @@ class MPIIOTest(ut.TestCase):
         if fields.get('bonds', False):
             exts.add('boff')
             exts.add('bond')
+        if fields.get('particles', False):
+            exts.add('part')
+            exts.add('poff')
         return {f'{prefix}.{ext}' for ext in exts}
 
     def check_files_exist(self, prefix, **fields):
@@ -169,6 +172,29 @@ class MPIIOTest(ut.TestCase):
         mpiio.read(prefix, **fields)
         self.check_sample_system(**fields)
 
+    def test_mpiio_particles(self):
+        prefix = self.generate_prefix(self.id())
+        mpiio = espressomd.io.mpiio.Mpiio(system=self.system)
+        self.add_particles()
+        for p in self.system.part:
+            if espressomd.has_features(['MASS']):
+                p.mass = 1.5 + p.id
+            if espressomd.has_features(['ELECTROSTATICS']):
+                p.q = -0.5 * p.id
+        mpiio.write(prefix, particles=True)
+        self.check_files_exist(prefix, particles=True)
+
+        # the full particle state contains all other fields
+        self.system.part.clear()
+        mpiio.read(prefix, particles=True)
+        self.check_sample_system(
+            types=True, positions=True, velocities=True, bonds=True)
+        for p in self.system.part:
+            if espressomd.has_features(['MASS']):
+                self.assertEqual(p.mass, 1.5 + p.id)
+            if espressomd.has_features(['ELECTROSTATICS']):
+                self.assertEqual(p.q, -0.5 * p.id)
+
     def test_mpiio_without_positions(self):
         prefix = self.generate_prefix(self.id())
         mpiio = espressomd.io.mpiio.Mpiio(system=self.system)
@@ -94,14 +94,16 @@ class FFT_test(ut.TestCase):
         self.system.time_step = 0.01
         self.add_charged_particles()
         for node_grid, p3m_params in FFT_PLANS[self.n_nodes]:
-            self.system.cell_system.node_grid = node_grid
-            solver = espressomd.electrostatics.P3M(
-                prefactor=2, accuracy=1e-6, tune=False, **p3m_params)
-            self.system.electrostatics.solver = solver
-            ref_energy = -75.871906
-            p3m_energy = self.system.analysis.energy()['coulomb']
-            self.system.electrostatics.clear()
-            np.testing.assert_allclose(p3m_energy, ref_energy, rtol=1e-4)
+            for fft_backend in ["legacy", "pencil"]:
+                self.system.cell_system.node_grid = node_grid
+                solver = espressomd.electrostatics.P3M(
+                    prefactor=2, accuracy=1e-6, tune=False,
+                    fft_backend=fft_backend, **p3m_params)
+                self.system.electrostatics.solver = solver
+                ref_energy = -75.871906
+                p3m_energy = self.system.analysis.energy()['coulomb']
+                self.system.electrostatics.clear()
+                np.testing.assert_allclose(p3m_energy, ref_energy, rtol=1e-4)
 
     @utx.skipIfMissingFeatures("P3M")
     @ut.skipIf(n_nodes < 2 or n_nodes >= 8, "only runs for 2 <= n_nodes <= 7")
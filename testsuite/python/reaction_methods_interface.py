@@ -81,6 +81,10 @@ class ReactionMethods(ut.TestCase):
             exclusion_range,
             delta=1e-10)
         self.assertEqual(method.search_algorithm, search_algorithm)
+        self.assertEqual(method.energy_algorithm, "full")
+        method.energy_algorithm = "local"
+        self.assertEqual(method.energy_algorithm, "local")
+        method.energy_algorithm = "full"
         if not isinstance(method, espressomd.reaction_methods.WidomInsertion):
             self.assertEqual(
                 list(method.exclusion_radius_per_type.keys()), [1])
@@ -338,6 +342,12 @@ class ReactionMethods(ut.TestCase):
         with self.assertRaisesRegex(ValueError, "Parameter 'type_mc' must be >= 0"):
             method.displacement_mc_move_for_particles_of_type(
                 type_mc=-1, particle_number_to_be_changed=1)
+        with self.assertRaisesRegex(ValueError, "Parameter 'type_mc' must be >= 0"):
+            method.displacement_mc_sweep_for_particles_of_type(
+                type_mc=-1, max_displacement=0.1)
+        with self.assertRaisesRegex(ValueError, "Parameter 'max_displacement' must be > 0"):
+            method.displacement_mc_sweep_for_particles_of_type(
+                type_mc=0, max_displacement=0.)
         with self.assertRaisesRegex(RuntimeError, "No chemical reaction is currently under way"):
             method.call_method("calculate_factorial_expression")
         with self.assertRaisesRegex(RuntimeError, "cannot be instantiated"):
@@ -355,6 +365,9 @@ class ReactionMethods(ut.TestCase):
         with self.assertRaisesRegex(ValueError, "Unknown search algorithm 'unknown'"):
             espressomd.reaction_methods.ReactionEnsemble(
                 kT=1., seed=12, exclusion_range=1., search_algorithm="unknown")
+        with self.assertRaisesRegex(ValueError, "Unknown energy algorithm 'unknown'"):
+            espressomd.reaction_methods.ReactionEnsemble(
+                kT=1., seed=12, exclusion_range=1., energy_algorithm="unknown")
         method = espressomd.reaction_methods.ReactionEnsemble(
             kT=1., exclusion_range=1., seed=12, exclusion_radius_per_type={1: 0.1})
         with self.assertRaisesRegex(ValueError, "Invalid excluded_radius value for type 2: radius -0.10"):
@@ -87,6 +87,45 @@ class TabulatedTest(ut.TestCase):
         with self.assertRaisesRegex(ValueError, "TabulatedPotential parameter 'force' must have the same size as parameter 'energy'"):
             espressomd.interactions.TabulatedNonBonded(
                 min=1., max=2., energy=[0.], force=[0., 0.])
+        with self.assertRaisesRegex(ValueError, "TabulatedPotential parameter 'interpolation' must be 'linear' or 'cubic'"):
+            espressomd.interactions.TabulatedNonBonded(
+                min=1., max=2., energy=[0., 0.], force=[0., 0.],
+                interpolation="quadratic")
+
+    @utx.skipIfMissingFeatures("TABULATED")
+    def test_non_bonded_cubic(self):
+        tab = self.system.non_bonded_inter[0, 0].tabulated
+        tab.set_params(min=self.min_, max=self.max_, energy=self.energy,
+                       force=self.force)
+        self.assertEqual(tab.get_params()['interpolation'], 'linear')
+        tab.set_params(min=self.min_, max=self.max_, energy=self.energy,
+                       force=self.force, interpolation='cubic')
+        self.assertEqual(tab.get_params()['interpolation'], 'cubic')
+        # splines reproduce linear tables
+        self.check()
+
+        # splines are more accurate than linear interpolation
+        def lj_force(r):
+            return 24. * (2. * r**-13 - r**-7)
+
+        r_table = np.linspace(1., 2.5, 50)
+        r_check = np.linspace(1., 2.4, 47) + 0.01
+        errors = {}
+        p0, p1 = self.system.part.all()
+        for interpolation in ['linear', 'cubic']:
+            tab.set_params(min=1., max=2.5, force=lj_force(r_table),
+                           energy=np.zeros_like(r_table),
+                           interpolation=interpolation)
+            forces = []
+            for r in r_check:
+                p1.pos = p0.pos + [0., 0., r]
+                self.system.integrator.run(0)
+                forces.append(-p0.f[2])
+            errors[interpolation] = np.max(
+                np.abs(np.array(forces) - lj_force(r_check)))
+        self.assertLess(errors['cubic'], 0.1 * errors['linear'])
+
+        tab.deactivate()
 
     @utx.skipIfMissingFeatures("TABULATED")
     def test_bonded(self):
@@ -78,6 +78,15 @@ class CheckpointTest(ut.TestCase):
                 'THERM.SDM' in modes or 'INT.SDM' in modes):
             cls.ref_periodicity = np.array([False, False, False])
 
+    def test_mpiio_files(self):
+        # particles and lattice populations are written with MPI-IO
+        suffixes = ["head", "pref", "id", "part", "poff"]
+        if has_lb_mode:
+            suffixes += ["lb.data", "lb.doff", "ek0.data", "ek0.doff"]
+        for suffix in suffixes:
+            path = self.path_cpt_root / f"1.system.{suffix}"
+            self.assertTrue(path.is_file(), msg=f"missing file {path}")
+
     @utx.skipIfMissingFeatures(["WALBERLA"])
     @ut.skipIf(not has_lb_mode, "Skipping test due to missing LB mode.")
     def test_lb_fluid(self):
@@ -85,9 +94,32 @@ class CheckpointTest(ut.TestCase):
         cpt_mode = 0 if 'LB.ASCII' in modes else 1
         cpt_root = pathlib.Path(self.checkpoint.checkpoint_dir)
         cpt_path = str(cpt_root / "lb") + "{}.cpt"
+        precision = 8 if not lbf.single_precision else 5
+        m = np.pi / 12
+        grid_3D = np.fromfunction(
+            lambda i, j, k: np.cos(i * m) * np.cos(j * m) * np.cos(k * m),
+            lbf.shape, dtype=float)
+
+        # LB populations and boundaries were loaded with MPI-IO
+        np.testing.assert_almost_equal(
+            np.copy(lbf[:, :, :].population),
+            np.einsum('abc,d->abcd', grid_3D, np.arange(1, 20)),
+            decimal=precision)
+        np.testing.assert_almost_equal(
+            np.copy(lbf[:, :, :].last_applied_force),
+            np.einsum('abc,d->abcd', grid_3D, np.arange(1, 4)),
+            decimal=precision)
+        np.testing.assert_equal(
+            np.copy(lbf[0, :, :].is_boundary.astype(int)), 1)
+        np.testing.assert_equal(
+            np.copy(lbf[-1, :, :].is_boundary.astype(int)), 1)
+        np.testing.assert_equal(
+            np.copy(lbf[1:-1, :, :].is_boundary.astype(int)), 0)
 
-        # LB boundaries are loaded at the same time as LB populations
-        np.testing.assert_equal(np.copy(lbf[:, :, :].velocity), 0.)
+        # reset the fluid to check the LB checkpoint files
+        lbf.clear_boundaries()
+        lbf[:, :, :].population = np.ones((*lbf.shape, 19))
+        lbf[:, :, :].last_applied_force = np.zeros((*lbf.shape, 3))
         np.testing.assert_equal(
             np.copy(lbf[:, :, :].is_boundary.astype(int)), 0)
 
@@ -109,14 +141,9 @@ class CheckpointTest(ut.TestCase):
 
         # load the valid LB checkpoint file
         lbf.load_checkpoint(cpt_path.format(""), cpt_mode)
-        precision = 8 if not lbf.single_precision else 5
-        m = np.pi / 12
         nx = lbf.shape[0]
         ny = lbf.shape[1]
         nz = lbf.shape[2]
-        grid_3D = np.fromfunction(
-            lambda i, j, k: np.cos(i * m) * np.cos(j * m) * np.cos(k * m),
-            (nx, ny, nz), dtype=float)
         for i in range(nx):
             for j in range(ny):
                 for k in range(nz):
@@ -178,6 +205,19 @@ class CheckpointTest(ut.TestCase):
         self.assertIsInstance(system.ekcontainer.solver,
                               espressomd.electrokinetics.EKNone)
 
+        # EK densities and boundaries were loaded with MPI-IO
+        m = np.pi / 12
+        grid_3D = np.fromfunction(
+            lambda i, j, k: np.cos(i * m) * np.cos(j * m) * np.cos(k * m),
+            ek_species.lattice.shape, dtype=float)
+        np.testing.assert_almost_equal(
+            np.copy(ek_species[:, :, :].density), grid_3D, decimal=8)
+        np.testing.assert_equal(
+            np.copy(ek_species[0, :, :].is_boundary), True)
+        np.testing.assert_equal(
+            np.copy(ek_species[1:-1, :, :].is_boundary), False)
+        ek_species[:, :, :].density = np.zeros(ek_species.lattice.shape)
+
         # check exception mechanism with corrupted LB checkpoint files
         with self.assertRaisesRegex(RuntimeError, 'EOF found'):
             ek_species.load_checkpoint(
@@ -198,13 +238,9 @@ class CheckpointTest(ut.TestCase):
         ek_species.load_checkpoint(cpt_path.format(""), cpt_mode)
 
         precision = 8 if "LB.WALBERLA" in modes else 5
-        m = np.pi / 12
         nx = ek_species.lattice.shape[0]
         ny = ek_species.lattice.shape[1]
         nz = ek_species.lattice.shape[2]
-        grid_3D = np.fromfunction(
-            lambda i, j, k: np.cos(i * m) * np.cos(j * m) * np.cos(k * m),
-            (nx, ny, nz), dtype=float)
         for i in range(nx):
             for j in range(ny):
                 for k in range(nz):
@@ -51,6 +51,21 @@ class TuneSkin(ut.TestCase):
             adjust_max_skin=True)
         self.assertAlmostEqual(skin, self.system.cell_system.skin, delta=1e-12)
 
+    def test_online_tuning(self):
+        system = self.system
+        system.part.add(pos=[[0.1, 0.2, 0.3], [0.5, 1.2, 0.9]])
+        skin = system.cell_system.tune_skin_online(tol=0.05, int_steps=3)
+        self.assertAlmostEqual(skin, system.cell_system.skin, delta=1e-12)
+        self.assertTrue(system.cell_system.get_state()["verlet_skin_tuning"])
+        system.integrator.run(200)
+        self.assertFalse(system.cell_system.get_state()["verlet_skin_tuning"])
+        self.assertGreater(system.cell_system.skin, 0.)
+        system.part.clear()
+        with self.assertRaisesRegex(ValueError, "Parameter 'int_steps' must be >= 2"):
+            system.cell_system.tune_skin_online(tol=0.05, int_steps=1)
+        with self.assertRaisesRegex(ValueError, "Parameter 'tol' must be > 0"):
+            system.cell_system.tune_skin_online(tol=0., int_steps=3)
+
 
 if __name__ == "__main__":
     ut.main()
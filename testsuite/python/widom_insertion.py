@@ -92,6 +92,10 @@ class WidomInsertionTest(ut.TestCase):
             product_coefficients=[1],
             default_charges={self.TYPE_HA: self.CHARGE_HA})
 
+    def tearDown(self):
+        self.system.part.clear()
+        self.Widom.delete_reaction(reaction_id=0)
+
     def test_widom_insertion(self):
 
         num_samples = 10000
@@ -119,5 +123,47 @@ class WidomInsertionTest(ut.TestCase):
         )
 
 
+    def test_widom_insertion_batched(self):
+        # one sample of the average Boltzmann factor per batch of insertions
+        boltzmann_factor_samples = [
+            self.Widom.calculate_particle_insertion_boltzmann_factor(
+                reaction_id=0, n_insertions=1000) for _ in range(32)]
+
+        mu_ex_mean, _ = self.Widom.calculate_excess_chemical_potential(
+            boltzmann_factor_samples=boltzmann_factor_samples)
+
+        self.assertAlmostEqual(mu_ex_mean, self.target_mu_ex, delta=1e-3)
+        # test particles are never added to the system
+        self.assertEqual(len(self.system.part), 1)
+
+        with self.assertRaisesRegex(ValueError, "Invalid value for 'n_insertions'"):
+            self.Widom.calculate_particle_insertion_boltzmann_factor(
+                reaction_id=0, n_insertions=0)
+
+    def test_energy_algorithm(self):
+        # both algorithms draw the same trial moves from the same seed
+        widom_local = espressomd.reaction_methods.WidomInsertion(
+            kT=self.TEMPERATURE, seed=1, energy_algorithm="local")
+        widom_full = espressomd.reaction_methods.WidomInsertion(
+            kT=self.TEMPERATURE, seed=1, energy_algorithm="full")
+        for widom in (widom_local, widom_full):
+            widom.set_non_interacting_type(type=1)
+            widom.add_reaction(
+                reactant_types=[],
+                reactant_coefficients=[],
+                product_types=[self.TYPE_HA],
+                product_coefficients=[1],
+                default_charges={self.TYPE_HA: self.CHARGE_HA})
+        self.system.part.add(pos=np.random.random((20, 3)) * self.BOX_L,
+                             type=[self.TYPE_HA] * 20)
+        for _ in range(50):
+            energy_local = widom_local.calculate_particle_insertion_potential_energy(
+                reaction_id=0)
+            energy_full = widom_full.calculate_particle_insertion_potential_energy(
+                reaction_id=0)
+            np.testing.assert_allclose(
+                energy_local, energy_full, rtol=1e-8, atol=1e-8)
+
+
 if __name__ == "__main__":
     ut.main()